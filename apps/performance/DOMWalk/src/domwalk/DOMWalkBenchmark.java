@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package domwalk;
+
+import com.sun.webkit.dom.DocumentImpl;
+import com.sun.webkit.dom.NodeImpl;
+import java.util.List;
+import java.util.function.LongSupplier;
+import javafx.application.Application;
+import javafx.application.Platform;
+import javafx.concurrent.Worker;
+import javafx.scene.web.WebEngine;
+import javafx.stage.Stage;
+import org.w3c.dom.Document;
+import org.w3c.dom.Node;
+import org.w3c.dom.NodeList;
+
+/**
+ * Walks a document of roughly 100k nodes through the Java DOM bindings and
+ * reports the time taken by the per-node accessors, by querySelectorAll("*")
+ * and by the bulk entry points in com.sun.webkit.dom.NodeImpl.
+ *
+ * The bulk entry points are not exported, so run with:
+ *
+ *   java --add-exports javafx.web/com.sun.webkit.dom=ALL-UNNAMED \
+ *        domwalk.DOMWalkBenchmark [nodeCount] [iterations]
+ */
+public class DOMWalkBenchmark extends Application {
+
+    private int nodeCount = 100000;
+    private int iterations = 5;
+
+    @Override public void start(Stage primaryStage) throws Exception {
+        List<String> args = getParameters().getUnnamed();
+        if (args.size() > 0) nodeCount = Integer.parseInt(args.get(0));
+        if (args.size() > 1) iterations = Integer.parseInt(args.get(1));
+
+        WebEngine engine = new WebEngine();
+        engine.getLoadWorker().stateProperty().addListener((ov, o, state) -> {
+            if (state == Worker.State.SUCCEEDED) {
+                run(engine.getDocument());
+                Platform.exit();
+            } else if (state == Worker.State.FAILED) {
+                System.err.println("Failed to load the test document");
+                Platform.exit();
+            }
+        });
+        engine.loadContent(buildContent(nodeCount));
+    }
+
+    // Each row is a <div> element with a text child, i.e. two nodes.
+    private static String buildContent(int nodeCount) {
+        StringBuilder sb = new StringBuilder("<html><body>");
+        for (int i = 0; i < nodeCount / 2; i++) {
+            sb.append("<div class='row'>item ").append(i).append("</div>");
+        }
+        return sb.append("</body></html>").toString();
+    }
+
+    private void run(Document document) {
+        for (int i = 0; i < iterations; i++) {
+            time("per-node walk", () -> walk(document));
+            time("querySelectorAll", () -> selectAll(document));
+            time("bulk walk", () -> bulkWalk(document));
+        }
+    }
+
+    private static long walk(Node node) {
+        long length = node.getNodeName().length();
+        String text = node.getTextContent();
+        if (text != null) length += text.length();
+        for (Node child = node.getFirstChild(); child != null; child = child.getNextSibling()) {
+            length += walk(child);
+        }
+        return length;
+    }
+
+    private static long selectAll(Document document) {
+        NodeList all = ((DocumentImpl) document).querySelectorAll("*");
+        long length = 0;
+        for (int i = 0; i < all.getLength(); i++) {
+            length += all.item(i).getNodeName().length();
+        }
+        return length;
+    }
+
+    private static long bulkWalk(Document document) {
+        Node[] nodes = ((NodeImpl) document).getSubtree();
+        long length = 0;
+        for (String name : NodeImpl.getNodeNames(nodes)) {
+            length += name.length();
+        }
+        for (String text : NodeImpl.getTextContents(nodes)) {
+            if (text != null) length += text.length();
+        }
+        return length;
+    }
+
+    private static void time(String name, LongSupplier walk) {
+        long start = System.nanoTime();
+        long result = walk.getAsLong();
+        long elapsed = System.nanoTime() - start;
+        System.out.printf("%-20s %8.2f ms (%d)%n", name, elapsed / 1e6, result);
+    }
+
+    public static void main(String[] args) {
+        launch(args);
+    }
+}
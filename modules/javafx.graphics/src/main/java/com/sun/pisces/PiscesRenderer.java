@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2011, 2018, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2011, 2019, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -77,6 +77,7 @@ public final class PiscesRenderer {
 
     private long nativePtr = 0L;
     private AbstractSurface surface;
+    private int bandThreads = 1;
 
     /**
      * Creates a renderer that will write into a given surface.
@@ -305,6 +306,26 @@ public final class PiscesRenderer {
 
     private native void setClipImpl(int minX, int minY, int width, int height);
 
+    /**
+     * Lets rectangle fills, images, masks, alpha rows and clears of large
+     * areas be rendered in horizontal bands on up to {@code threads}
+     * threads. The pixels are the same as when rendering on the calling
+     * thread only, which is what a threads value of 1, the default, does.
+     */
+    public void setBandThreads(int threads) {
+        if (threads < 1) {
+            throw new IllegalArgumentException("threads must be positive");
+        }
+        this.bandThreads = threads;
+        this.setBandThreadsImpl(threads);
+    }
+
+    private native void setBandThreadsImpl(int threads);
+
+    public int getBandThreads() {
+        return bandThreads;
+    }
+
     /**
      * Resets the clip rectangle.  Each primitive will be clipped only
      * to the destination image bounds.
@@ -368,6 +389,30 @@ public final class PiscesRenderer {
 
     private native void fillAlphaMaskImpl(byte[] mask, int x, int y, int width, int height, int offset, int stride);
 
+    /**
+     * Fills height rows of coverage, as emitAndClearAlphaRow() would fill
+     * them one by one. Row i covers pixels rowBounds[2*i] to
+     * rowBounds[2*i+1] of line y + i, with their coverage in mask at
+     * offset i * width + px - x. The paint of a row starts at its first
+     * pixel, so the result is the same as emitting the rows one at a time,
+     * but large areas can be painted in bands, see setBandThreads().
+     */
+    public void fillAlphaRows(byte[] mask, int[] rowBounds, int x, int y, int width, int height) {
+        if (mask == null) {
+            throw new NullPointerException("Mask is NULL");
+        }
+        if (rowBounds == null) {
+            throw new NullPointerException("Row bounds are NULL");
+        }
+        this.inputImageCheck(width, height, 0, width, mask.length);
+        if (rowBounds.length < 2 * height) {
+            throw new IllegalArgumentException("Row bounds are too short");
+        }
+        this.fillAlphaRowsImpl(mask, rowBounds, x, y, width, height);
+    }
+
+    private native void fillAlphaRowsImpl(byte[] mask, int[] rowBounds, int x, int y, int width, int height);
+
     public void setLCDGammaCorrection(float gamma) {
         if (gamma <= 0) {
             throw new IllegalArgumentException("Gamma must be greater than zero");
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2010, 2017, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2010, 2019, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -87,6 +87,7 @@ public final class PrismSettings {
     public static final boolean forceUploadingPainter;
     public static final boolean forceAlphaTestShader;
     public static final boolean forceNonAntialiasedShape;
+    public static final int swBandThreads;
 
     public static enum RasterizerType {
         JavaPisces("Java-based Pisces Rasterizer"),
@@ -370,6 +371,15 @@ public final class PrismSettings {
         glyphCacheHeight = getInt(systemProperties, "prism.glyphCacheHeight", 1024,
                 "Try -Dprism.glyphCacheHeight=<number>");
 
+        /*
+         * Number of threads the software pipeline may split fills of large
+         * areas over, "true" uses all processors. Rendering stays on the
+         * render thread only by default.
+         */
+        swBandThreads = Math.max(1, getInt(systemProperties, "prism.sw.bandthreads", 1,
+                Runtime.getRuntime().availableProcessors(),
+                "Try -Dprism.sw.bandthreads=<number>"));
+
         /*
          * Performance Logger flags
          * Enable the performance logger, print on exit, print on first paint etc.
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2012, 2014, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2012, 2019, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -36,6 +36,7 @@ import com.sun.prism.impl.PrismSettings;
 import java.nio.ByteBuffer;
 import java.security.AccessController;
 import java.security.PrivilegedAction;
+import java.util.Arrays;
 
 public class NativePiscesRasterizer implements ShapeRasterizer {
     private static MaskData emptyData = MaskData.create(new byte[1], 0, 0, 1, 1);
@@ -53,6 +54,12 @@ public class NativePiscesRasterizer implements ShapeRasterizer {
     private boolean lastAntialiasedShape;
     private boolean firstTimeAASetting = true;
 
+    // Grow-only arrays handed to produceFillAlphasBatch
+    private float batchCoords[] = new float[0];
+    private byte batchCommands[] = new byte[0];
+    private int batchShapes[] = new int[0];
+    private double batchTransforms[] = new double[0];
+
     native static void init(int subpixelLgPositionsX, int subpixelLgPositionsY);
 
     native static void produceFillAlphas(float coords[], byte commands[], int nsegs, boolean nonzero,
@@ -65,6 +72,10 @@ public class NativePiscesRasterizer implements ShapeRasterizer {
                                            double mxx, double mxy, double mxt,
                                            double myx, double myy, double myt,
                                            int bounds[], byte mask[]);
+    native static int produceFillAlphasBatch(float coords[], byte commands[],
+                                             int shapes[], int nshapes,
+                                             double transforms[], int bounds[],
+                                             byte atlas[], int atlasWidth, int atlasHeight);
 
     static {
         AccessController.doPrivileged((PrivilegedAction<Void>) () -> {
@@ -81,18 +92,21 @@ public class NativePiscesRasterizer implements ShapeRasterizer {
         });
     }
 
-    @Override
-    public MaskData getMaskData(Shape shape, BasicStroke stroke,
-                                RectBounds xformBounds, BaseTransform xform,
-                                boolean close, boolean antialiasedShape)
-    {
-
+    private void setAntialiasing(boolean antialiasedShape) {
         if (firstTimeAASetting || (lastAntialiasedShape != antialiasedShape)) {
             int subpixelLgPositions = antialiasedShape ? 3 : 0;
             NativePiscesRasterizer.init(subpixelLgPositions, subpixelLgPositions);
             firstTimeAASetting = false;
             lastAntialiasedShape = antialiasedShape;
         }
+    }
+
+    @Override
+    public MaskData getMaskData(Shape shape, BasicStroke stroke,
+                                RectBounds xformBounds, BaseTransform xform,
+                                boolean close, boolean antialiasedShape)
+    {
+        setAntialiasing(antialiasedShape);
 
         if (stroke != null && stroke.getType() != BasicStroke.TYPE_CENTERED) {
             // RT-27427
@@ -179,4 +193,90 @@ public class NativePiscesRasterizer implements ShapeRasterizer {
         cachedData.update(cachedBuffer, x, y, w, h);
         return cachedData;
     }
+
+    /**
+     * Fills {@code count} shapes, starting at {@code shapes[offset]}, into
+     * a single mask atlas with one native call. Rasterizing many small shapes
+     * this way avoids the cost of a call and of pinning the arrays for each
+     * of them.
+     *
+     * The masks are laid out left to right in rows of the atlas. On return,
+     * {@code maskBounds[6*i]} through {@code maskBounds[6*i+3]} hold the
+     * device bounds x0, y0, x1, y1 of the mask of the i-th shape of the
+     * batch, and {@code maskBounds[6*i+4]}, {@code maskBounds[6*i+5]} the
+     * position of the mask in the atlas. An empty mask has empty bounds.
+     *
+     * @return the number of shapes rasterized, which is less than
+     * {@code count} once the atlas is full. It is 0 if the mask of the
+     * first shape is larger than the atlas, that shape should go through
+     * {@link #getMaskData} instead.
+     */
+    public int getFillMasks(Shape shapes[], BaseTransform xforms[],
+                            int offset, int count, boolean antialiasedShape,
+                            byte atlas[], int atlasWidth, int atlasHeight,
+                            int maskBounds[])
+    {
+        setAntialiasing(antialiasedShape);
+
+        if (batchShapes.length < 3 * count) {
+            batchShapes = new int[3 * count];
+            batchTransforms = new double[6 * count];
+        }
+
+        RectBounds xformBounds = new RectBounds();
+        int numCoords = 0;
+        int numCommands = 0;
+        for (int i = 0; i < count; i++) {
+            Shape shape = shapes[offset + i];
+            BaseTransform xform = xforms[offset + i];
+            Path2D p2d = (shape instanceof Path2D) ? (Path2D) shape : new Path2D(shape);
+            byte commands[] = p2d.getCommandsNoClone();
+            int ncmds = p2d.getNumCommands();
+            int ncoords = 0;
+            for (int c = 0; c < ncmds; c++) {
+                switch (commands[c]) {
+                    case SEG_MOVETO: case SEG_LINETO: ncoords += 2; break;
+                    case SEG_QUADTO: ncoords += 4; break;
+                    case SEG_CUBICTO: ncoords += 6; break;
+                    default: break;
+                }
+            }
+
+            if (batchCoords.length < numCoords + ncoords) {
+                batchCoords = Arrays.copyOf(batchCoords, Math.max(2 * batchCoords.length, numCoords + ncoords));
+            }
+            if (batchCommands.length < numCommands + ncmds) {
+                batchCommands = Arrays.copyOf(batchCommands, Math.max(2 * batchCommands.length, numCommands + ncmds));
+            }
+            System.arraycopy(p2d.getFloatCoordsNoClone(), 0, batchCoords, numCoords, ncoords);
+            System.arraycopy(commands, 0, batchCommands, numCommands, ncmds);
+            numCoords += ncoords;
+            numCommands += ncmds;
+
+            batchShapes[3 * i] = ncoords;
+            batchShapes[3 * i + 1] = ncmds;
+            batchShapes[3 * i + 2] = (p2d.getWindingRule() == Path2D.WIND_NON_ZERO) ? 1 : 0;
+
+            if (xform == null || xform.isIdentity()) {
+                xform = BaseTransform.IDENTITY_TRANSFORM;
+            }
+            batchTransforms[6 * i] = xform.getMxx();
+            batchTransforms[6 * i + 1] = xform.getMxy();
+            batchTransforms[6 * i + 2] = xform.getMxt();
+            batchTransforms[6 * i + 3] = xform.getMyx();
+            batchTransforms[6 * i + 4] = xform.getMyy();
+            batchTransforms[6 * i + 5] = xform.getMyt();
+
+            xformBounds = (RectBounds) xform.transform(shape.getBounds(), xformBounds);
+            maskBounds[6 * i] = (int) Math.floor(xformBounds.getMinX());
+            maskBounds[6 * i + 1] = (int) Math.floor(xformBounds.getMinY());
+            maskBounds[6 * i + 2] = (int) Math.ceil(xformBounds.getMaxX());
+            maskBounds[6 * i + 3] = (int) Math.ceil(xformBounds.getMaxY());
+        }
+
+        return produceFillAlphasBatch(batchCoords, batchCommands,
+                                      batchShapes, count,
+                                      batchTransforms, maskBounds,
+                                      atlas, atlasWidth, atlasHeight);
+    }
 }
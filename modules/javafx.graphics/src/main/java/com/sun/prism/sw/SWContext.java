@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2011, 2017, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2011, 2019, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -170,6 +170,7 @@ final class SWContext {
                 }
                 alphaConsumer.initConsumer(outpix_xmin, outpix_ymin, w, h, pr);
                 renderer.produceAlphas(alphaConsumer);
+                alphaConsumer.finishConsumer();
             } finally {
                 if (renderer != null) {
                     renderer.dispose();
@@ -184,6 +185,11 @@ final class SWContext {
     }
 
     static final class DirectRTMarlinAlphaConsumer implements MarlinAlphaConsumer {
+        // Shapes covering fewer pixels are emitted row by row
+        private static final int BAND_MIN_PIXELS = 256 * 256;
+        // Largest number of coverage bytes buffered before painting them
+        private static final int BAND_BUFFER_SIZE = 1 << 22;
+
         private byte alpha_map[];
         private int x;
         private int y;
@@ -193,6 +199,16 @@ final class SWContext {
 
         private PiscesRenderer pr;
 
+        // When the renderer paints in bands, the coverage of up to
+        // bufferRows rows from bufferY on is collected here and painted
+        // with fillAlphaRows() instead of emitted one row at a time.
+        private boolean buffered;
+        private byte buffer[];
+        private int bufferRowBounds[];
+        private int bufferY;
+        private int bufferRows;
+        private int bufferedRows;
+
         public void initConsumer(int x, int y, int w, int h, PiscesRenderer pr) {
             this.x = x;
             this.y = y;
@@ -200,6 +216,68 @@ final class SWContext {
             this.h = h;
             rowNum = 0;
             this.pr = pr;
+
+            buffered = (pr.getBandThreads() > 1) && ((long) w * h >= BAND_MIN_PIXELS);
+            if (buffered) {
+                bufferRows = Math.max(1, Math.min(h, BAND_BUFFER_SIZE / w));
+                if ((buffer == null) || (buffer.length < w * bufferRows)) {
+                    buffer = new byte[w * bufferRows];
+                }
+                if ((bufferRowBounds == null) || (bufferRowBounds.length < 2 * bufferRows)) {
+                    bufferRowBounds = new int[2 * bufferRows];
+                }
+                startBuffer(y);
+            }
+        }
+
+        /**
+         * Paints the rows still buffered, must be called once the shape has
+         * produced all of its alphas.
+         */
+        public void finishConsumer() {
+            if (buffered) {
+                flushBuffer();
+            }
+        }
+
+        private void startBuffer(int pix_y) {
+            bufferY = pix_y;
+            bufferedRows = 0;
+            // rows the rasterizer skips stay empty
+            for (int i = 0; i < bufferRows; i++) {
+                bufferRowBounds[2 * i] = x;
+                bufferRowBounds[2 * i + 1] = x - 1;
+            }
+        }
+
+        private void flushBuffer() {
+            if (bufferedRows > 0) {
+                pr.fillAlphaRows(buffer, bufferRowBounds, x, bufferY, w, bufferedRows);
+            }
+        }
+
+        // Does what emitAndClearAlphaRow() does to the alphaDeltas, but
+        // keeps the coverage of the row instead of painting it.
+        private void bufferRow(final int[] alphaDeltas, final int pix_y,
+                               final int pix_from, final int pix_to)
+        {
+            if (pix_y - bufferY >= bufferRows) {
+                flushBuffer();
+                startBuffer(pix_y);
+            }
+            final int row = pix_y - bufferY;
+            final int from = pix_from - x;
+            final int to = Math.min(pix_to - x, w - 1);
+            final int offset = row * w;
+            int aval = 0;
+            for (int i = from; i <= to; i++) {
+                aval += alphaDeltas[i];
+                alphaDeltas[i] = 0;
+                buffer[offset + i] = alpha_map[aval];
+            }
+            bufferRowBounds[2 * row] = pix_from;
+            bufferRowBounds[2 * row + 1] = x + to;
+            bufferedRows = row + 1;
         }
 
         @Override
@@ -247,7 +325,11 @@ final class SWContext {
                                               final int pix_from, final int pix_to)
         {
             // pix_from indicates the first alpha coverage != 0 within [x; pix_to[
-            pr.emitAndClearAlphaRow(alpha_map, alphaDeltas, pix_y, pix_from, pix_to, (pix_from - x), rowNum);
+            if (buffered) {
+                bufferRow(alphaDeltas, pix_y, pix_from, pix_to);
+            } else {
+                pr.emitAndClearAlphaRow(alpha_map, alphaDeltas, pix_y, pix_from, pix_to, (pix_from - x), rowNum);
+            }
             rowNum++;
 
             // clear properly the end of the alphaDeltas:
@@ -308,6 +390,7 @@ final class SWContext {
                 }
                 alphaConsumer.initConsumer(outpix_xmin, outpix_ymin, w, h, pr);
                 renderer.produceAlphas(alphaConsumer);
+                alphaConsumer.finishConsumer();
             } finally {
                 if (renderer != null) {
                     renderer.dispose();
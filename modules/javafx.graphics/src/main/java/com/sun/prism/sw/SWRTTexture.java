@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2011, 2014, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2011, 2019, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -115,6 +115,9 @@ class SWRTTexture extends SWArgbPreTexture implements RTTexture {
     public Graphics createGraphics() {
         if (pr == null) {
             pr = new PiscesRenderer(this.surface);
+            if (PrismSettings.swBandThreads > 1) {
+                pr.setBandThreads(PrismSettings.swBandThreads);
+            }
         }
         return new SWGraphics(this, getResourceFactory().getContext(), pr);
     }
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2011, 2018, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2011, 2019, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -53,6 +53,12 @@ static void renderer_finalize(JNIEnv *env, jobject objectHandle);
 static void fillAlphaMask(Renderer* rdr, jint minX, jint minY, jint maxX, jint maxY,
     JNIEnv *env, jobject this, jint maskType, jbyteArray jmask, jint x, jint y,
     jint maskWidth, jint maskHeight, jint offset, jint stride);
+static void emitRectRows(Renderer* rdr, jint rows, void* args);
+static void skipRectRows(Renderer* rdr, jint rows, void* args);
+static void emitMaskRows(Renderer* rdr, jint rows, void* args);
+static void skipMaskRows(Renderer* rdr, jint rows, void* args);
+static void emitAlphaRows(Renderer* rdr, jint rows, void* args);
+static void skipAlphaRows(Renderer* rdr, jint rows, void* args);
 
 JNIEXPORT void JNICALL
 Java_com_sun_pisces_PiscesRenderer_initialize(JNIEnv* env, jobject objectHandle)
@@ -109,6 +115,17 @@ Java_com_sun_pisces_PiscesRenderer_setClipImpl(JNIEnv* env, jobject objectHandle
     }
 }
 
+JNIEXPORT void JNICALL
+Java_com_sun_pisces_PiscesRenderer_setBandThreadsImpl(JNIEnv* env, jobject objectHandle,
+        jint threads) {
+    Renderer* rdr;
+    rdr = (Renderer*)JLongToPointer(
+              (*env)->GetLongField(env, objectHandle,
+                                   fieldIds[RENDERER_NATIVE_PTR]));
+
+    renderer_setBandThreads(rdr, threads);
+}
+
 JNIEXPORT void JNICALL
 Java_com_sun_pisces_PiscesRenderer_setColorImpl(JNIEnv* env, jobject objectHandle,
         jint red, jint green, jint blue, jint alpha) {
@@ -384,6 +401,44 @@ toPiscesCoords(unsigned int ff) {
     return (int)gg;
 }
 
+/*
+ * Arguments of emitRectRows() and skipRectRows()
+ */
+typedef struct _RectRows {
+    jint x_from, x_to;
+    jint surfaceWidth;
+} RectRows;
+
+static void
+emitRectRows(Renderer* rdr, jint rows, void* args) {
+    RectRows* rect = (RectRows*)args;
+    jint rows_being_rendered;
+
+    while (rows > 0) {
+        rows_being_rendered = MIN(rows, NUM_ALPHA_ROWS);
+
+        if (rdr->_genPaint) {
+            size_t l = (rect->x_to - rect->x_from + 1) * rows_being_rendered;
+            ALLOC3(rdr->_paint, jint, l);
+            rdr->_genPaint(rdr, rows_being_rendered);
+        }
+        rdr->_emitLine(rdr, rows_being_rendered, 0x10000);
+
+        rows -= rows_being_rendered;
+        skipRectRows(rdr, rows_being_rendered, args);
+    }
+}
+
+static void
+skipRectRows(Renderer* rdr, jint rows, void* args) {
+    RectRows* rect = (RectRows*)args;
+
+    rdr->_currX = rect->x_from;
+    rdr->_currY += rows;
+    rdr->_currImageOffset = rdr->_currY * rect->surfaceWidth;
+    rdr->_rowNum += rows;
+}
+
 static void
 fillRect(JNIEnv *env, jobject this, Renderer* rdr,
     jint x, jint y, jint w, jint h,
@@ -393,7 +448,7 @@ fillRect(JNIEnv *env, jobject this, Renderer* rdr,
     jobject surfaceHandle;
     jint x_from, x_to, y_from, y_to;
     jint lfrac, rfrac, tfrac, bfrac;
-    jint rows_to_render_by_loop, rows_being_rendered;
+    jint rows_to_render_by_loop;
 
     lfrac = (0x10000 - (x & 0xFFFF)) & 0xFFFF;
     rfrac = (x + w) & 0xFFFF;
@@ -523,21 +578,14 @@ fillRect(JNIEnv *env, jobject this, Renderer* rdr,
         }
 
         // emit "full" lines that are in the middle
-        while (rows_to_render_by_loop > 0) {
-            rows_being_rendered = MIN(rows_to_render_by_loop, NUM_ALPHA_ROWS);
-
-            if (rdr->_genPaint) {
-                size_t l = (x_to - x_from + 1) * rows_being_rendered;
-                ALLOC3(rdr->_paint, jint, l);
-                rdr->_genPaint(rdr, rows_being_rendered);
-            }
-            rdr->_emitLine(rdr, rows_being_rendered, 0x10000);
-
-            rows_to_render_by_loop -= rows_being_rendered;
-            rdr->_currX = x_from;
-            rdr->_currY += rows_being_rendered;
-            rdr->_currImageOffset = rdr->_currY * surface->width;
-            rdr->_rowNum += rows_being_rendered;
+        if (rows_to_render_by_loop > 0) {
+            RectRows rect;
+            rect.x_from = x_from;
+            rect.x_to = x_to;
+            rect.surfaceWidth = surface->width;
+            renderer_emitRowsInBands(rdr, x_to - x_from + 1,
+                rows_to_render_by_loop, NUM_ALPHA_ROWS,
+                emitRectRows, skipRectRows, &rect);
         }
 
         // emit fractional bottom line
@@ -754,18 +802,59 @@ JNIEXPORT void JNICALL Java_com_sun_pisces_PiscesRenderer_fillLCDAlphaMaskImpl
         x, y, maskWidth, maskHeight, maskOffset, stride);
 }
 
+/*
+ * Arguments of emitMaskRows() and skipMaskRows()
+ */
+typedef struct _MaskRows {
+    jint x;
+    jint width;
+    jint maskWidth;
+    jint surfaceWidth;
+} MaskRows;
+
+static void
+emitMaskRows(Renderer* rdr, jint rows, void* args) {
+    MaskRows* mask = (MaskRows*)args;
+    jint rowsBeingRendered;
+
+    while (rows > 0) {
+        rowsBeingRendered = 1; //MIN(rows, NUM_ALPHA_ROWS);
+
+        rdr->_currImageOffset = rdr->_currY * mask->surfaceWidth;
+        if (rdr->_genPaint) {
+            size_t l = (mask->width * rowsBeingRendered);
+            ALLOC3(rdr->_paint, jint, l);
+            rdr->_genPaint(rdr, rowsBeingRendered);
+        }
+        rdr->_emitRows(rdr, rowsBeingRendered);
+
+        rows -= rowsBeingRendered;
+        skipMaskRows(rdr, rowsBeingRendered, args);
+    }
+}
+
+static void
+skipMaskRows(Renderer* rdr, jint rows, void* args) {
+    MaskRows* mask = (MaskRows*)args;
+
+    rdr->_maskOffset += mask->maskWidth * rows;
+    rdr->_rowNum += rows;
+    // rows after the first have always started at the x of the mask
+    rdr->_currX = mask->x;
+    rdr->_currY += rows;
+}
+
 static void fillAlphaMask(Renderer* rdr, jint minX, jint minY, jint maxX, jint maxY,
     JNIEnv *env, jobject this, jint maskType, jbyteArray jmask,
     jint x, jint y, jint maskWidth, jint maskHeight, jint offset, jint stride)
 {
-    jint rowsToBeRendered, rowsBeingRendered;
-
     Surface* surface;
     jobject surfaceHandle;
 
     if (maxX >= minX && maxY >= minY)
     {
         jbyte* mask;
+        MaskRows rows;
 
         SURFACE_FROM_RENDERER(surface, env, surfaceHandle, this);
         ACQUIRE_SURFACE(surface, env, surfaceHandle);
@@ -792,25 +881,12 @@ static void fillAlphaMask(Renderer* rdr, jint minX, jint minY, jint maxX, jint m
             rdr->_rowNum = 0;
             rdr->_maskOffset = offset;
 
-            rowsToBeRendered = height;
-
-            while (rowsToBeRendered > 0) {
-                rowsBeingRendered = 1; //MIN(rowsToBeRendered, NUM_ALPHA_ROWS);
-
-                rdr->_currImageOffset = rdr->_currY * surface->width;
-                if (rdr->_genPaint) {
-                    size_t l = (width * rowsBeingRendered);
-                    ALLOC3(rdr->_paint, jint, l);
-                    rdr->_genPaint(rdr, rowsBeingRendered);
-                }
-                rdr->_emitRows(rdr, rowsBeingRendered);
-
-                rdr->_maskOffset += maskWidth;
-                rdr->_rowNum += rowsBeingRendered;
-                rowsToBeRendered -= rowsBeingRendered;
-                rdr->_currX = x;
-                rdr->_currY += rowsBeingRendered;
-            }
+            rows.x = x;
+            rows.width = width;
+            rows.maskWidth = maskWidth;
+            rows.surfaceWidth = surface->width;
+            renderer_emitRowsInBands(rdr, width, height, 1,
+                emitMaskRows, skipMaskRows, &rows);
 
             renderer_removeMask(rdr);
             (*env)->ReleasePrimitiveArrayCritical(env, jmask, mask, 0);
@@ -827,3 +903,125 @@ static void fillAlphaMask(Renderer* rdr, jint minX, jint minY, jint maxX, jint m
     }
 }
 
+/*
+ * Arguments of emitAlphaRows() and skipAlphaRows()
+ */
+typedef struct _AlphaRows {
+    jint x, y;
+    jint maskWidth;
+    jint* rowBounds;
+    jint surfaceWidth;
+} AlphaRows;
+
+static void
+emitAlphaRows(Renderer* rdr, jint rows, void* args) {
+    AlphaRows* alphaRows = (AlphaRows*)args;
+
+    while (rows > 0) {
+        jint row = rdr->_currY - alphaRows->y;
+        jint x_from = alphaRows->rowBounds[2 * row];
+        jint x_to = alphaRows->rowBounds[2 * row + 1];
+
+        // the same clipping as emitAndClearAlphaRowImpl(), and the mask
+        x_from = MAX(x_from, MAX(alphaRows->x, rdr->_clip_bbMinX));
+        x_to = MIN(x_to, MIN(alphaRows->x + alphaRows->maskWidth - 1,
+                             rdr->_clip_bbMaxX));
+
+        if (x_to >= x_from &&
+            rdr->_currY >= rdr->_clip_bbMinY &&
+            rdr->_currY <= rdr->_clip_bbMaxY)
+        {
+            rdr->_minTouched = x_from;
+            rdr->_maxTouched = x_to;
+            rdr->_currX = x_from;
+            rdr->_alphaWidth = x_to - x_from + 1;
+            rdr->_maskOffset = row * alphaRows->maskWidth + x_from - alphaRows->x;
+            rdr->_currImageOffset = rdr->_currY * alphaRows->surfaceWidth;
+
+            if (rdr->_genPaint) {
+                size_t l = (x_to - x_from + 1);
+                ALLOC3(rdr->_paint, jint, l);
+                rdr->_genPaint(rdr, 1);
+            }
+            rdr->_emitRows(rdr, 1);
+        }
+
+        rows--;
+        skipAlphaRows(rdr, 1, args);
+    }
+}
+
+static void
+skipAlphaRows(Renderer* rdr, jint rows, void* args) {
+    rdr->_currY += rows;
+    rdr->_rowNum += rows;
+}
+
+/*
+ * Class:     com_sun_pisces_PiscesRenderer
+ * Method:    fillAlphaRowsImpl
+ * Signature: ([B[IIIII)V
+ */
+JNIEXPORT void JNICALL Java_com_sun_pisces_PiscesRenderer_fillAlphaRowsImpl
+(JNIEnv *env, jobject this, jbyteArray jmask, jintArray jrowBounds,
+ jint x, jint y, jint maskWidth, jint maskHeight)
+{
+    Renderer* rdr;
+    Surface* surface;
+    jobject surfaceHandle;
+    jint minY, maxY;
+
+    rdr = (Renderer*)JLongToPointer((*env)->GetLongField(env, this, fieldIds[RENDERER_NATIVE_PTR]));
+
+    minY = MAX(y, rdr->_clip_bbMinY);
+    maxY = MIN(y + maskHeight - 1, rdr->_clip_bbMaxY);
+    if (maskWidth <= 0 || maxY < minY) {
+        return;
+    }
+
+    SURFACE_FROM_RENDERER(surface, env, surfaceHandle, this);
+    ACQUIRE_SURFACE(surface, env, surfaceHandle);
+
+    {
+        jbyte* mask = (jbyte*)(*env)->GetPrimitiveArrayCritical(env, jmask, NULL);
+        if (mask != NULL) {
+            jint* rowBounds = (jint*)(*env)->GetPrimitiveArrayCritical(env, jrowBounds, NULL);
+            if (rowBounds != NULL) {
+                AlphaRows rows;
+
+                renderer_setMask(rdr, ALPHA_MASK, mask, maskWidth, maskHeight, JNI_FALSE);
+
+                INVALIDATE_RENDERER_SURFACE(rdr);
+                VALIDATE_BLITTING(rdr);
+
+                rdr->_currY = minY;
+                rdr->_imageScanlineStride = surface->width;
+                rdr->_imagePixelStride = 1;
+                rdr->_rowNum = 0;
+
+                rows.x = x;
+                rows.y = y;
+                rows.maskWidth = maskWidth;
+                rows.rowBounds = rowBounds;
+                rows.surfaceWidth = surface->width;
+                renderer_emitRowsInBands(rdr, maskWidth, maxY - minY + 1, 1,
+                    emitAlphaRows, skipAlphaRows, &rows);
+
+                renderer_removeMask(rdr);
+                (*env)->ReleasePrimitiveArrayCritical(env, jrowBounds, rowBounds, 0);
+            } else {
+                setMemErrorFlag();
+            }
+            (*env)->ReleasePrimitiveArrayCritical(env, jmask, mask, 0);
+        } else {
+            setMemErrorFlag();
+        }
+    }
+
+    RELEASE_SURFACE(surface, env, surfaceHandle);
+
+    if (JNI_TRUE == readAndClearMemErrorFlag()) {
+        JNI_ThrowNew(env, "java/lang/OutOfMemoryError",
+                     "Allocation of internal renderer buffer failed.");
+    }
+}
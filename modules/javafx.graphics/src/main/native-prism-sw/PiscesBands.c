@@ -0,0 +1,188 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#include <PiscesBands.h>
+
+#include <PiscesUtil.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <process.h>
+#else
+#include <pthread.h>
+#endif
+
+typedef struct _BandJob {
+    BandFunc *func;
+    void *data;
+    jint bandCount;
+    jint nextBand;
+    jint pendingBands;
+} BandJob;
+
+#ifdef _WIN32
+
+static SRWLOCK lock = SRWLOCK_INIT;
+static CONDITION_VARIABLE workAvailable = CONDITION_VARIABLE_INIT;
+static CONDITION_VARIABLE jobDone = CONDITION_VARIABLE_INIT;
+
+#define LOCK() AcquireSRWLockExclusive(&lock)
+#define UNLOCK() ReleaseSRWLockExclusive(&lock)
+#define WAIT(cond) SleepConditionVariableSRW(&(cond), &lock, INFINITE, 0)
+#define SIGNAL(cond) WakeConditionVariable(&(cond))
+#define BROADCAST(cond) WakeAllConditionVariable(&(cond))
+
+#else
+
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t workAvailable = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t jobDone = PTHREAD_COND_INITIALIZER;
+
+#define LOCK() pthread_mutex_lock(&lock)
+#define UNLOCK() pthread_mutex_unlock(&lock)
+#define WAIT(cond) pthread_cond_wait(&(cond), &lock)
+#define SIGNAL(cond) pthread_cond_signal(&(cond))
+#define BROADCAST(cond) pthread_cond_broadcast(&(cond))
+
+#endif
+
+// Guarded by lock
+static BandJob *currentJob = NULL;
+static jint workerCount = 0;
+
+/*
+ * Runs bands of the current job until there are none left. Called with
+ * lock held, returns with lock held.
+ */
+static void
+runJobBands(BandJob *job) {
+    while (job->nextBand < job->bandCount) {
+        jint band = job->nextBand++;
+        UNLOCK();
+        job->func(job->data, band);
+        LOCK();
+        if (--job->pendingBands == 0) {
+            SIGNAL(jobDone);
+        }
+    }
+}
+
+#ifdef _WIN32
+static unsigned __stdcall
+#else
+static void *
+#endif
+workerMain(void *arg) {
+    LOCK();
+    for (;;) {
+        while (currentJob == NULL ||
+               currentJob->nextBand >= currentJob->bandCount)
+        {
+            WAIT(workAvailable);
+        }
+        runJobBands(currentJob);
+    }
+    // The workers live as long as the process
+#ifdef _WIN32
+    return 0;
+#else
+    return NULL;
+#endif
+}
+
+/*
+ * Starts workers until there are count of them. Called with lock held.
+ */
+static void
+startWorkers(jint count) {
+    while (workerCount < count) {
+#ifdef _WIN32
+        HANDLE thread = (HANDLE)_beginthreadex(NULL, 0, workerMain, NULL, 0, NULL);
+        if (thread == 0) {
+            return;
+        }
+        CloseHandle(thread);
+#else
+        pthread_t thread;
+        pthread_attr_t attr;
+        int result;
+        pthread_attr_init(&attr);
+        pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+        result = pthread_create(&thread, &attr, workerMain, NULL);
+        pthread_attr_destroy(&attr);
+        if (result != 0) {
+            return;
+        }
+#endif
+        workerCount++;
+    }
+}
+
+jint
+pisces_getBandCount(jint threads, jint width, jint height) {
+    if (threads <= 1 || width <= 0 || height < 2 * MIN_BAND_ROWS ||
+        (jlong)width * height < MIN_BAND_PIXELS)
+    {
+        return 1;
+    }
+    return MIN(MIN(threads, MAX_BAND_THREADS), height / MIN_BAND_ROWS);
+}
+
+void
+pisces_runBands(BandFunc *func, void *data, jint bandCount) {
+    BandJob job;
+    jint band;
+
+    if (bandCount > 1) {
+        LOCK();
+        // One operation at a time, a renderer on another thread runs its
+        // bands by itself meanwhile.
+        if (currentJob == NULL) {
+            startWorkers(bandCount - 1);
+            if (workerCount > 0) {
+                job.func = func;
+                job.data = data;
+                job.bandCount = bandCount;
+                job.nextBand = 0;
+                job.pendingBands = bandCount;
+
+                currentJob = &job;
+                BROADCAST(workAvailable);
+                runJobBands(&job);
+                while (job.pendingBands > 0) {
+                    WAIT(jobDone);
+                }
+                currentJob = NULL;
+                UNLOCK();
+                return;
+            }
+        }
+        UNLOCK();
+    }
+
+    for (band = 0; band < bandCount; band++) {
+        func(data, band);
+    }
+}
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/**
+ * @file PiscesBands.h
+ * Runs a rendering operation in horizontal bands of rows on a small pool
+ * of worker threads. The pool is shared by all renderers and only used
+ * by renderers which had bands enabled through
+ * PiscesRenderer.setBandThreads().
+ */
+
+#ifndef PISCES_BANDS_H
+#define PISCES_BANDS_H
+
+#include <PiscesDefs.h>
+
+/**
+ * @def MAX_BAND_THREADS
+ * Largest number of threads, the calling thread included, an operation
+ * is run on.
+ */
+#define MAX_BAND_THREADS 32
+
+/**
+ * @def MIN_BAND_ROWS
+ * Smallest number of rows in a band.
+ */
+#define MIN_BAND_ROWS 16
+
+/**
+ * @def MIN_BAND_PIXELS
+ * Operations which touch fewer pixels than this run on the calling thread,
+ * waking up the workers would cost more than it saves.
+ */
+#define MIN_BAND_PIXELS (256 * 256)
+
+typedef void BandFunc(void *data, jint band);
+
+/**
+ * Returns into how many bands an operation on a width x height area should
+ * be split, when it may use up to threads threads. Returns 1 if it should
+ * be run on the calling thread.
+ */
+jint pisces_getBandCount(jint threads, jint width, jint height);
+
+/**
+ * Calls func(data, band) for every band in [0, bandCount) and returns when
+ * all calls have returned. The calling thread runs bands too. If the
+ * workers can't be started, or are busy with another operation, all bands
+ * run on the calling thread.
+ */
+void pisces_runBands(BandFunc *func, void *data, jint bandCount);
+
+#endif
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2011, 2014, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2011, 2019, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -24,6 +24,7 @@
  */
 
 #include <PiscesBlit.h>
+#include <PiscesBlitKernels.h>
 
 #include <PiscesUtil.h>
 #include <PiscesRenderer.h>
@@ -33,10 +34,17 @@
 
 #include <limits.h>
 
+#if PISCES_SIMD_SSE2
+#include <emmintrin.h>
+#endif
+
 #define HALF_ALPHA (MAX_ALPHA >> 1)
 #define ALPHA_SHIFT 8
 #define HALF_1_SHIFT_23 (jint)(1L << 23)
 
+// Number of pixels the blits hand to a blend kernel at a time
+#define BLIT_SPAN 64
+
 static jfloat currentGamma = -1;
 static jint gammaArray[256];
 static jint invGammaArray[256];
@@ -257,6 +265,14 @@ emitLineSourceOver8888_pre(Renderer *rdr, jint height, jint frac) {
     } else {
         jint lalpha = (lfrac * alpha) >> 16;
         jint ralpha = (rfrac * alpha) >> 16;
+        BlendColorSpanFunc *blendColorSpan = getBlitKernels()->blendColorSpan;
+        unsigned char aval[BLIT_SPAN];
+        jint x, n;
+        if (blendColorSpan != NULL) {
+            // The blend kernels need contiguous pixels
+            assert(imagePixelStride == 1);
+            memset(aval, alpha, sizeof(aval));
+        }
         for (j = 0; j < height; j++) {
             iidx = imageOffset + minX * imagePixelStride;
             a = intData + iidx;
@@ -264,10 +280,18 @@ emitLineSourceOver8888_pre(Renderer *rdr, jint height, jint frac) {
                 blendSrcOver8888_pre(a, lalpha, cred, cgreen, cblue);
                 a += imagePixelStride;
             }
-            am = a + w;
-            while (a < am) {
-                blendSrcOver8888_pre(a, alpha, cred, cgreen, cblue);
-                a += imagePixelStride;
+            if (blendColorSpan != NULL) {
+                for (x = 0; x < w; x += n) {
+                    n = MIN(w - x, BLIT_SPAN);
+                    blendColorSpan(a + x, aval, n, cred, cgreen, cblue);
+                }
+                a += MAX(w, 0);
+            } else {
+                am = a + w;
+                while (a < am) {
+                    blendSrcOver8888_pre(a, alpha, cred, cgreen, cblue);
+                    a += imagePixelStride;
+                }
             }
             if (rfrac) {
                 blendSrcOver8888_pre(a, ralpha, cred, cgreen, cblue);
@@ -296,12 +320,22 @@ emitLinePTSourceOver8888_pre(Renderer *rdr, jint height, jint frac) {
     jint lfrac = (jint)(llfrac >> 16);
     jint rfrac = (jint)(lrfrac >> 16);
 
+    BlendPaintSpanFunc *blendPaintSpan = getBlitKernels()->blendPaintSpan;
+    unsigned short pfrac[BLIT_SPAN];
+    jint i, x, n;
+
     minX = rdr->_minTouched;
     maxX = rdr->_maxTouched;
     paint_stride = w = rdr->_alphaWidth;
     w -= (lfrac) ? 1 : 0;
     w -= (rfrac) ? 1 : 0;
 
+    if (blendPaintSpan != NULL && frac != 0x10000) {
+        for (i = 0; i < BLIT_SPAN; i++) {
+            pfrac[i] = (unsigned short)(frac >> 8);
+        }
+    }
+
     for (j = 0; j < height; j++) {
         aidx = paint_offset;
         iidx = imageOffset + minX * imagePixelStride;
@@ -312,30 +346,48 @@ emitLinePTSourceOver8888_pre(Renderer *rdr, jint height, jint frac) {
             a += imagePixelStride;
             aidx++;
         }
-        am = a + w;
-        if (frac == 0x10000) { // full coverage
-            while (a < am) {
-                cval = paint[aidx];
-                palpha = A(cval);
-                switch (palpha) {
-                case 0:
-                    break;
-                case MAX_ALPHA:
-                    *a = cval;
-                    break;
-                default:
-                    blendSrcOver8888_pre_pre_fullFrac(a, palpha, R(cval), G(cval), B(cval));
-                    break;
+        if (blendPaintSpan != NULL) {
+            // The blend kernels need contiguous pixels
+            assert(imagePixelStride == 1);
+            for (x = 0; x < w; x += n) {
+                n = MIN(w - x, BLIT_SPAN);
+                if (frac == 0x10000) { // full coverage
+                    // Transparent paint leaves the pixel alone, any other
+                    // paint is blended as it is.
+                    for (i = 0; i < n; i++) {
+                        pfrac[i] = A(paint[aidx + x + i]) ? 256 : 0;
+                    }
                 }
-                a += imagePixelStride;
-                aidx++;
+                blendPaintSpan(a + x, paint + aidx + x, pfrac, n);
             }
+            a += MAX(w, 0);
+            aidx += MAX(w, 0);
         } else {
-            while (a < am) {
-                cval = paint[aidx];
-                blendSrcOver8888_pre_pre(a, frac >> 8, A(cval), R(cval), G(cval), B(cval));
-                a += imagePixelStride;
-                aidx++;
+            am = a + w;
+            if (frac == 0x10000) { // full coverage
+                while (a < am) {
+                    cval = paint[aidx];
+                    palpha = A(cval);
+                    switch (palpha) {
+                    case 0:
+                        break;
+                    case MAX_ALPHA:
+                        *a = cval;
+                        break;
+                    default:
+                        blendSrcOver8888_pre_pre_fullFrac(a, palpha, R(cval), G(cval), B(cval));
+                        break;
+                    }
+                    a += imagePixelStride;
+                    aidx++;
+                }
+            } else {
+                while (a < am) {
+                    cval = paint[aidx];
+                    blendSrcOver8888_pre_pre(a, frac >> 8, A(cval), R(cval), G(cval), B(cval));
+                    a += imagePixelStride;
+                    aidx++;
+                }
             }
         }
         if (rfrac) {
@@ -552,6 +604,53 @@ blitPTSrcMask8888_pre(Renderer *rdr, jint height) {
     }
 }
 
+static void
+blitSrcOverSpans8888_pre(Renderer *rdr, jint height, BlendColorSpanFunc *blendColorSpan) {
+    jint i, j, x, n;
+    jint minX, maxX, w;
+    jint aval_relative;
+
+    jint *intData = rdr->_data;
+    jint imageOffset = rdr->_currImageOffset;
+    jint imageScanlineStride = rdr->_imageScanlineStride;
+    jint *alpha = rdr->_rowAAInt;
+
+    jint *a;
+
+    jint calpha = rdr->_calpha;
+    jint cred = rdr->_cred;
+    jint cgreen = rdr->_cgreen;
+    jint cblue = rdr->_cblue;
+    jbyte *alphaMap = rdr->alphaMap;
+
+    unsigned char aval[BLIT_SPAN];
+
+    minX = rdr->_minTouched;
+    maxX = rdr->_maxTouched;
+    w = (maxX >= minX) ? (maxX - minX + 1) : 0;
+
+    // The blend kernels need contiguous pixels
+    assert(rdr->_imagePixelStride == 1);
+
+    for (j = 0; j < height; j++) {
+        a = intData + imageOffset + minX;
+
+        aval_relative = 0;
+        for (x = 0; x < w; x += n) {
+            n = MIN(w - x, BLIT_SPAN);
+            for (i = 0; i < n; i++) {
+                aval_relative += alpha[x + i];
+                alpha[x + i] = 0;
+                aval[i] = (aval_relative == 0) ? 0 :
+                    ((((alphaMap[aval_relative] & 0xff) + 1) * calpha) >> 8);
+            }
+            blendColorSpan(a + x, aval, n, cred, cgreen, cblue);
+        }
+
+        imageOffset += imageScanlineStride;
+    }
+}
+
 void
 blitSrcOver8888_pre(Renderer *rdr, jint height) {
     jint j;
@@ -575,6 +674,13 @@ blitSrcOver8888_pre(Renderer *rdr, jint height) {
     jint cblue = rdr->_cblue;
     jbyte *alphaMap = rdr->alphaMap;
 
+    BlendColorSpanFunc *blendColorSpan = getBlitKernels()->blendColorSpan;
+
+    if (blendColorSpan != NULL) {
+        blitSrcOverSpans8888_pre(rdr, height, blendColorSpan);
+        return;
+    }
+
     minX = rdr->_minTouched;
     maxX = rdr->_maxTouched;
     w = (maxX >= minX) ? (maxX - minX + 1) : 0;
@@ -605,6 +711,54 @@ blitSrcOver8888_pre(Renderer *rdr, jint height) {
     }
 }
 
+static void
+blitSrcOverMaskSpans8888_pre(Renderer *rdr, jint height, BlendColorSpanFunc *blendColorSpan) {
+    jint i, j, x, n;
+    jint minX, maxX, w;
+
+    jint *intData = rdr->_data;
+    jint imageOffset = rdr->_currImageOffset;
+    jint imageScanlineStride = rdr->_imageScanlineStride;
+    jbyte *alpha = rdr->_mask_byteData;
+    jint alphaOffset = rdr->_maskOffset;
+    jint alphaStride = rdr->_alphaWidth;
+
+    jint *a;
+    jbyte *m;
+
+    jint calpha = rdr->_calpha;
+    jint cred = rdr->_cred;
+    jint cgreen = rdr->_cgreen;
+    jint cblue = rdr->_cblue;
+
+    unsigned char aval[BLIT_SPAN];
+
+    minX = rdr->_minTouched;
+    maxX = rdr->_maxTouched;
+    w = (maxX >= minX) ? (maxX - minX + 1) : 0;
+
+    // The blend kernels need contiguous pixels
+    assert(rdr->_imagePixelStride == 1);
+
+    for (j = 0; j < height; j++) {
+        a = intData + imageOffset + minX;
+        m = alpha + alphaOffset;
+
+        for (x = 0; x < w; x += n) {
+            n = MIN(w - x, BLIT_SPAN);
+            for (i = 0; i < n; i++) {
+                // run in integers otherwise it overflows
+                jint mval = m[x + i] & 0xff;
+                aval[i] = (mval == 0) ? 0 : (((mval + 1) * calpha) >> 8);
+            }
+            blendColorSpan(a + x, aval, n, cred, cgreen, cblue);
+        }
+
+        imageOffset += imageScanlineStride;
+        alphaOffset += alphaStride;
+    }
+}
+
 void
 blitSrcOverMask8888_pre(Renderer *rdr, jint height) {
     jint j;
@@ -626,6 +780,13 @@ blitSrcOverMask8888_pre(Renderer *rdr, jint height) {
     jint cgreen = rdr->_cgreen;
     jint cblue = rdr->_cblue;
 
+    BlendColorSpanFunc *blendColorSpan = getBlitKernels()->blendColorSpan;
+
+    if (blendColorSpan != NULL) {
+        blitSrcOverMaskSpans8888_pre(rdr, height, blendColorSpan);
+        return;
+    }
+
     minX = rdr->_minTouched;
     maxX = rdr->_maxTouched;
     w = (maxX >= minX) ? (maxX - minX + 1) : 0;
@@ -709,6 +870,59 @@ blitSrcOverLCDMask8888_pre(Renderer *rdr, jint height) {
     }
 }
 
+static void
+blitPTSrcOverSpans8888_pre(Renderer *rdr, jint height, BlendPaintSpanFunc *blendPaintSpan) {
+    jint i, j, x, n;
+    jint minX, maxX, w;
+    jint aval_relative;
+
+    jint *intData = rdr->_data;
+    jint imageOffset = rdr->_currImageOffset;
+    jint imageScanlineStride = rdr->_imageScanlineStride;
+    jint *alpha = rdr->_rowAAInt;
+
+    jint *a;
+
+    jbyte *alphaMap = rdr->alphaMap;
+
+    jint* paint = rdr->_paint;
+    jint malpha;
+
+    unsigned short frac[BLIT_SPAN];
+
+    minX = rdr->_minTouched;
+    maxX = rdr->_maxTouched;
+    w = (maxX >= minX) ? (maxX - minX + 1) : 0;
+
+    assert(w <= (jint)rdr->_paint_length);
+    // The blend kernels need contiguous pixels
+    assert(rdr->_imagePixelStride == 1);
+
+    for (j = 0; j < height; j++) {
+        a = intData + imageOffset + minX;
+
+        aval_relative = 0;
+        for (x = 0; x < w; x += n) {
+            n = MIN(w - x, BLIT_SPAN);
+            for (i = 0; i < n; i++) {
+                aval_relative += alpha[x + i];
+                alpha[x + i] = 0;
+                frac[i] = 0;
+                if (aval_relative) {
+                    // Pixels which end up fully transparent are left alone
+                    malpha = alphaMap[aval_relative] & 0xff;
+                    if ((((malpha + 1) * A(paint[x + i])) >> 8) > 0) {
+                        frac[i] = (unsigned short)(malpha + 1);
+                    }
+                }
+            }
+            blendPaintSpan(a + x, paint + x, frac, n);
+        }
+
+        imageOffset += imageScanlineStride;
+    }
+}
+
 void
 blitPTSrcOver8888_pre(Renderer *rdr, jint height) {
     jint j;
@@ -729,6 +943,13 @@ blitPTSrcOver8888_pre(Renderer *rdr, jint height) {
     jint* paint = rdr->_paint;
     jint palpha, malpha;
 
+    BlendPaintSpanFunc *blendPaintSpan = getBlitKernels()->blendPaintSpan;
+
+    if (blendPaintSpan != NULL) {
+        blitPTSrcOverSpans8888_pre(rdr, height, blendPaintSpan);
+        return;
+    }
+
     minX = rdr->_minTouched;
     maxX = rdr->_maxTouched;
     w = (maxX >= minX) ? (maxX - minX + 1) : 0;
@@ -767,6 +988,53 @@ blitPTSrcOver8888_pre(Renderer *rdr, jint height) {
     }
 }
 
+static void
+blitPTSrcOverMaskSpans8888_pre(Renderer *rdr, jint height, BlendPaintSpanFunc *blendPaintSpan) {
+    jint i, j, x, n;
+    jint minX, maxX, w;
+
+    jint *intData = rdr->_data;
+    jint imageOffset = rdr->_currImageOffset;
+    jint imageScanlineStride = rdr->_imageScanlineStride;
+    jbyte *alpha = rdr->_mask_byteData;
+    jint alphaOffset = rdr->_maskOffset;
+
+    jint *a;
+    jbyte *m;
+
+    jint* paint = rdr->_paint;
+    jint malpha;
+
+    unsigned short frac[BLIT_SPAN];
+
+    minX = rdr->_minTouched;
+    maxX = rdr->_maxTouched;
+    w = (maxX >= minX) ? (maxX - minX + 1) : 0;
+
+    // The blend kernels need contiguous pixels
+    assert(rdr->_imagePixelStride == 1);
+
+    for (j = 0; j < height; j++) {
+        a = intData + imageOffset + minX;
+        m = alpha + alphaOffset;
+
+        for (x = 0; x < w; x += n) {
+            n = MIN(w - x, BLIT_SPAN);
+            for (i = 0; i < n; i++) {
+                malpha = m[x + i] & 0xff;
+                frac[i] = 0;
+                // Pixels which end up fully transparent are left alone
+                if (malpha && (((malpha + 1) * A(paint[x + i])) >> 8) > 0) {
+                    frac[i] = (unsigned short)(malpha + 1);
+                }
+            }
+            blendPaintSpan(a + x, paint + x, frac, n);
+        }
+
+        imageOffset += imageScanlineStride;
+    }
+}
+
 void
 blitPTSrcOverMask8888_pre(Renderer *rdr, jint height) {
     jint j;
@@ -785,6 +1053,13 @@ blitPTSrcOverMask8888_pre(Renderer *rdr, jint height) {
     jint* paint = rdr->_paint;
     jint palpha, malpha;
 
+    BlendPaintSpanFunc *blendPaintSpan = getBlitKernels()->blendPaintSpan;
+
+    if (blendPaintSpan != NULL) {
+        blitPTSrcOverMaskSpans8888_pre(rdr, height, blendPaintSpan);
+        return;
+    }
+
     minX = rdr->_minTouched;
     maxX = rdr->_maxTouched;
     w = (maxX >= minX) ? (maxX - minX + 1) : 0;
@@ -1032,3 +1307,215 @@ void initGammaArrays(jfloat gamma) {
     }
 }
 
+
+/* BLEND KERNELS */
+
+// The SIMD kernels finish the last pixels of a span with these
+void
+blendColorSpan8888_pre_scalar(jint *intData, const unsigned char *aval, jint n,
+                              jint sred, jint sgreen, jint sblue)
+{
+    jint solid_pixel = 0xff000000 | (sred << 16) | (sgreen << 8) | sblue;
+    jint i;
+    for (i = 0; i < n; i++) {
+        if (aval[i] == MAX_ALPHA) {
+            intData[i] = solid_pixel;
+        } else if (aval[i] > 0) {
+            blendSrcOver8888_pre(&intData[i], aval[i], sred, sgreen, sblue);
+        }
+    }
+}
+
+void
+blendPaintSpan8888_pre_scalar(jint *intData, const jint *paint,
+                              const unsigned short *frac, jint n)
+{
+    jint i;
+    for (i = 0; i < n; i++) {
+        if (frac[i] > 0) {
+            jint cval = paint[i];
+            jint palpha = A(cval);
+            if (frac[i] == 256 && palpha == MAX_ALPHA) {
+                intData[i] = cval;
+            } else {
+                blendSrcOver8888_pre_pre(&intData[i], frac[i], palpha,
+                    R(cval), G(cval), B(cval));
+            }
+        }
+    }
+}
+
+#if PISCES_SIMD_SSE2
+
+// div255 of 8 lanes, see PiscesBlitKernels.h
+static INLINE __m128i div255_sse2(__m128i x) {
+    __m128i y = _mm_add_epi16(x, _mm_set1_epi16(1));
+    return _mm_srli_epi16(_mm_add_epi16(y, _mm_srli_epi16(y, 8)), 8);
+}
+
+// The kernels blend 4 pixels at a time, with the channels of 2 pixels
+// in the 16 bit lanes of a register in B, G, R, A order.
+void
+blendColorSpan8888_pre_sse2(jint *intData, const unsigned char *aval, jint n,
+                            jint sred, jint sgreen, jint sblue)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i max = _mm_set1_epi16(MAX_ALPHA);
+    const __m128i src = _mm_set_epi16(MAX_ALPHA, sred, sgreen, sblue,
+                                      MAX_ALPHA, sred, sgreen, sblue);
+    const __m128i solid = _mm_set1_epi32(0xff000000 | (sred << 16) |
+                                         (sgreen << 8) | sblue);
+    jint i;
+
+    for (i = 0; i + 4 <= n; i += 4) {
+        __m128i a, a_lo, a_hi, d, d_lo, d_hi;
+        jint avals;
+        memcpy(&avals, aval + i, sizeof(avals));
+        if (avals == 0) {
+            continue;
+        }
+        if (avals == -1) {
+            _mm_storeu_si128((__m128i *)(intData + i), solid);
+            continue;
+        }
+        a = _mm_unpacklo_epi8(_mm_cvtsi32_si128(avals), zero);
+        a = _mm_unpacklo_epi16(a, a);
+        a_lo = _mm_unpacklo_epi32(a, a);
+        a_hi = _mm_unpackhi_epi32(a, a);
+        d = _mm_loadu_si128((__m128i *)(intData + i));
+        d_lo = _mm_unpacklo_epi8(d, zero);
+        d_hi = _mm_unpackhi_epi8(d, zero);
+        d_lo = div255_sse2(_mm_add_epi16(_mm_mullo_epi16(src, a_lo),
+                _mm_mullo_epi16(_mm_sub_epi16(max, a_lo), d_lo)));
+        d_hi = div255_sse2(_mm_add_epi16(_mm_mullo_epi16(src, a_hi),
+                _mm_mullo_epi16(_mm_sub_epi16(max, a_hi), d_hi)));
+        _mm_storeu_si128((__m128i *)(intData + i), _mm_packus_epi16(d_lo, d_hi));
+    }
+    blendColorSpan8888_pre_scalar(intData + i, aval + i, n - i, sred, sgreen, sblue);
+}
+
+void
+blendPaintSpan8888_pre_sse2(jint *intData, const jint *paint,
+                            const unsigned short *frac, jint n)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i max = _mm_set1_epi16(MAX_ALPHA);
+    jint i;
+
+    for (i = 0; i + 4 <= n; i += 4) {
+        __m128i f, f_lo, f_hi, p, p_lo, p_hi, d, d_lo, d_hi, ia_lo, ia_hi;
+        jlong fracs;
+        memcpy(&fracs, frac + i, sizeof(fracs));
+        if (fracs == 0) {
+            continue;
+        }
+        f = _mm_loadl_epi64((const __m128i *)(frac + i));
+        f = _mm_unpacklo_epi16(f, f);
+        f_lo = _mm_unpacklo_epi32(f, f);
+        f_hi = _mm_unpackhi_epi32(f, f);
+        // (c * frac) >> 8 for the paint, alpha included
+        p = _mm_loadu_si128((const __m128i *)(paint + i));
+        p_lo = _mm_srli_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(p, zero), f_lo), 8);
+        p_hi = _mm_srli_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(p, zero), f_hi), 8);
+        // 255 minus that alpha in every lane of the pixel
+        ia_lo = _mm_sub_epi16(max, _mm_shufflehi_epi16(
+                _mm_shufflelo_epi16(p_lo, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3)));
+        ia_hi = _mm_sub_epi16(max, _mm_shufflehi_epi16(
+                _mm_shufflelo_epi16(p_hi, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3)));
+        d = _mm_loadu_si128((__m128i *)(intData + i));
+        d_lo = _mm_add_epi16(p_lo, div255_sse2(_mm_mullo_epi16(ia_lo, _mm_unpacklo_epi8(d, zero))));
+        d_hi = _mm_add_epi16(p_hi, div255_sse2(_mm_mullo_epi16(ia_hi, _mm_unpackhi_epi8(d, zero))));
+        _mm_storeu_si128((__m128i *)(intData + i), _mm_packus_epi16(d_lo, d_hi));
+    }
+    blendPaintSpan8888_pre_scalar(intData + i, paint + i, frac + i, n - i);
+}
+
+#endif
+
+static const BlitKernels blitKernels[BLIT_KERNEL_COUNT] = {
+    // The blits run their per pixel loops, which beat the scalar span
+    // kernels when there is nothing to vectorize
+    { NULL, NULL },
+#if PISCES_SIMD_SSE2
+    { blendColorSpan8888_pre_sse2, blendPaintSpan8888_pre_sse2 },
+#else
+    { NULL, NULL },
+#endif
+#if PISCES_SIMD_AVX2
+    { blendColorSpan8888_pre_avx2, blendPaintSpan8888_pre_avx2 },
+#else
+    { NULL, NULL },
+#endif
+#if PISCES_SIMD_NEON
+    { blendColorSpan8888_pre_neon, blendPaintSpan8888_pre_neon },
+#else
+    { NULL, NULL },
+#endif
+};
+
+static const char *const blitKernelNames[BLIT_KERNEL_COUNT] = {
+    "scalar", "SSE2", "AVX2", "NEON"
+};
+
+static volatile jint currentBlitKernel = -1;
+
+jboolean
+isBlitKernelSupported(jint kernel) {
+    switch (kernel) {
+    case BLIT_KERNEL_SCALAR:
+        return XNI_TRUE;
+    case BLIT_KERNEL_SSE2:
+        return PISCES_SIMD_SSE2 ? XNI_TRUE : XNI_FALSE;
+    case BLIT_KERNEL_AVX2:
+#if PISCES_SIMD_AVX2
+        return isAVX2Supported();
+#else
+        return XNI_FALSE;
+#endif
+    case BLIT_KERNEL_NEON:
+        return PISCES_SIMD_NEON ? XNI_TRUE : XNI_FALSE;
+    default:
+        return XNI_FALSE;
+    }
+}
+
+jint
+getBlitKernel() {
+    jint kernel = currentBlitKernel;
+    if (kernel < 0) {
+        // Every thread arrives at the same answer, no need to lock.
+        if (isBlitKernelSupported(BLIT_KERNEL_AVX2)) {
+            kernel = BLIT_KERNEL_AVX2;
+        } else if (isBlitKernelSupported(BLIT_KERNEL_SSE2)) {
+            kernel = BLIT_KERNEL_SSE2;
+        } else if (isBlitKernelSupported(BLIT_KERNEL_NEON)) {
+            kernel = BLIT_KERNEL_NEON;
+        } else {
+            kernel = BLIT_KERNEL_SCALAR;
+        }
+        currentBlitKernel = kernel;
+    }
+    return kernel;
+}
+
+const BlitKernels *
+getBlitKernels() {
+    return &blitKernels[getBlitKernel()];
+}
+
+jboolean
+setBlitKernel(jint kernel) {
+    if (!isBlitKernelSupported(kernel)) {
+        return XNI_FALSE;
+    }
+    currentBlitKernel = kernel;
+    return XNI_TRUE;
+}
+
+const char *
+getBlitKernelName(jint kernel) {
+    if (kernel < 0 || kernel >= BLIT_KERNEL_COUNT) {
+        return "unknown";
+    }
+    return blitKernelNames[kernel];
+}
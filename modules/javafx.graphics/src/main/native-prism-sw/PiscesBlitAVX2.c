@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#include <PiscesBlit.h>
+#include <PiscesBlitKernels.h>
+
+#include <PiscesSysutils.h>
+
+#if PISCES_SIMD_AVX2
+
+#include <immintrin.h>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define AVX2_FUNCTION
+#else
+#define AVX2_FUNCTION __attribute__((target("avx2")))
+#endif
+
+jboolean
+isAVX2Supported() {
+#if defined(_MSC_VER)
+    int info[4];
+
+    __cpuid(info, 0);
+    if (info[0] < 7) {
+        return XNI_FALSE;
+    }
+
+    // The OS has to save the YMM registers too.
+    __cpuid(info, 1);
+    if ((info[2] & (1 << 27)) == 0 || (_xgetbv(0) & 6) != 6) {
+        return XNI_FALSE;
+    }
+
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0 ? XNI_TRUE : XNI_FALSE;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") ? XNI_TRUE : XNI_FALSE;
+#endif
+}
+
+// div255 of 16 lanes, see PiscesBlitKernels.h
+AVX2_FUNCTION static INLINE __m256i div255_avx2(__m256i x) {
+    __m256i y = _mm256_add_epi16(x, _mm256_set1_epi16(1));
+    return _mm256_srli_epi16(_mm256_add_epi16(y, _mm256_srli_epi16(y, 8)), 8);
+}
+
+// Packs the channels of pixels 0-3 and 4-7 back to 8 pixels in order.
+AVX2_FUNCTION static INLINE __m256i pack_avx2(__m256i lo, __m256i hi) {
+    return _mm256_permute4x64_epi64(_mm256_packus_epi16(lo, hi), _MM_SHUFFLE(3, 1, 2, 0));
+}
+
+// The kernels blend 8 pixels at a time, with the channels of 4 pixels
+// in the 16 bit lanes of a register in B, G, R, A order.
+AVX2_FUNCTION void
+blendColorSpan8888_pre_avx2(jint *intData, const unsigned char *aval, jint n,
+                            jint sred, jint sgreen, jint sblue)
+{
+    const __m256i max = _mm256_set1_epi16(MAX_ALPHA);
+    const __m256i src = _mm256_set_epi16(MAX_ALPHA, sred, sgreen, sblue,
+                                         MAX_ALPHA, sred, sgreen, sblue,
+                                         MAX_ALPHA, sred, sgreen, sblue,
+                                         MAX_ALPHA, sred, sgreen, sblue);
+    const __m256i solid = _mm256_set1_epi32(0xff000000 | (sred << 16) |
+                                            (sgreen << 8) | sblue);
+    const __m128i spread_lo = _mm_set_epi8(3, 3, 3, 3, 2, 2, 2, 2,
+                                           1, 1, 1, 1, 0, 0, 0, 0);
+    const __m128i spread_hi = _mm_set_epi8(7, 7, 7, 7, 6, 6, 6, 6,
+                                           5, 5, 5, 5, 4, 4, 4, 4);
+    jint i;
+
+    for (i = 0; i + 8 <= n; i += 8) {
+        __m128i a;
+        __m256i a_lo, a_hi, d, d_lo, d_hi;
+        jlong avals;
+        memcpy(&avals, aval + i, sizeof(avals));
+        if (avals == 0) {
+            continue;
+        }
+        if (avals == -1) {
+            _mm256_storeu_si256((__m256i *)(intData + i), solid);
+            continue;
+        }
+        a = _mm_loadl_epi64((const __m128i *)(aval + i));
+        a_lo = _mm256_cvtepu8_epi16(_mm_shuffle_epi8(a, spread_lo));
+        a_hi = _mm256_cvtepu8_epi16(_mm_shuffle_epi8(a, spread_hi));
+        d = _mm256_loadu_si256((__m256i *)(intData + i));
+        d_lo = _mm256_cvtepu8_epi16(_mm256_castsi256_si128(d));
+        d_hi = _mm256_cvtepu8_epi16(_mm256_extracti128_si256(d, 1));
+        d_lo = div255_avx2(_mm256_add_epi16(_mm256_mullo_epi16(src, a_lo),
+                _mm256_mullo_epi16(_mm256_sub_epi16(max, a_lo), d_lo)));
+        d_hi = div255_avx2(_mm256_add_epi16(_mm256_mullo_epi16(src, a_hi),
+                _mm256_mullo_epi16(_mm256_sub_epi16(max, a_hi), d_hi)));
+        _mm256_storeu_si256((__m256i *)(intData + i), pack_avx2(d_lo, d_hi));
+    }
+    blendColorSpan8888_pre_scalar(intData + i, aval + i, n - i, sred, sgreen, sblue);
+}
+
+// Spreads 4 fractions over the 4 lanes of their pixels.
+AVX2_FUNCTION static INLINE __m256i spreadFrac_avx2(const unsigned short *frac) {
+    __m256i f = _mm256_cvtepu16_epi64(_mm_loadl_epi64((const __m128i *)frac));
+    return _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(f, 0), 0);
+}
+
+// 255 minus the alpha of every pixel, in all of its lanes
+AVX2_FUNCTION static INLINE __m256i invAlpha_avx2(__m256i p) {
+    return _mm256_sub_epi16(_mm256_set1_epi16(MAX_ALPHA), _mm256_shufflehi_epi16(
+            _mm256_shufflelo_epi16(p, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3)));
+}
+
+AVX2_FUNCTION void
+blendPaintSpan8888_pre_avx2(jint *intData, const jint *paint,
+                            const unsigned short *frac, jint n)
+{
+    jint i;
+
+    for (i = 0; i + 8 <= n; i += 8) {
+        __m256i p, p_lo, p_hi, d, d_lo, d_hi;
+        __m128i fracs = _mm_loadu_si128((const __m128i *)(frac + i));
+        if (_mm_testz_si128(fracs, fracs)) {
+            continue;
+        }
+        // (c * frac) >> 8 for the paint, alpha included
+        p = _mm256_loadu_si256((const __m256i *)(paint + i));
+        p_lo = _mm256_srli_epi16(_mm256_mullo_epi16(
+                _mm256_cvtepu8_epi16(_mm256_castsi256_si128(p)), spreadFrac_avx2(frac + i)), 8);
+        p_hi = _mm256_srli_epi16(_mm256_mullo_epi16(
+                _mm256_cvtepu8_epi16(_mm256_extracti128_si256(p, 1)), spreadFrac_avx2(frac + i + 4)), 8);
+        d = _mm256_loadu_si256((__m256i *)(intData + i));
+        d_lo = _mm256_add_epi16(p_lo, div255_avx2(_mm256_mullo_epi16(invAlpha_avx2(p_lo),
+                _mm256_cvtepu8_epi16(_mm256_castsi256_si128(d)))));
+        d_hi = _mm256_add_epi16(p_hi, div255_avx2(_mm256_mullo_epi16(invAlpha_avx2(p_hi),
+                _mm256_cvtepu8_epi16(_mm256_extracti128_si256(d, 1)))));
+        _mm256_storeu_si256((__m256i *)(intData + i), pack_avx2(d_lo, d_hi));
+    }
+    blendPaintSpan8888_pre_scalar(intData + i, paint + i, frac + i, n - i);
+}
+
+#endif
@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/**
+ * @file PiscesBlitKernels.h
+ * Span kernels of the source over blits in PiscesBlit.c.
+ *
+ * When the CPU supports SSE2, AVX2 or NEON, the blits work out the alpha
+ * of every pixel and leave the blending of contiguous spans to a kernel
+ * for that instruction set. The best one is chosen at first use. Without
+ * any of them the kernel is BLIT_KERNEL_SCALAR and the blits keep their
+ * per pixel loops.
+ * All kernels produce the same pixels as those loops: every product
+ * and every div255 argument fits in 16 bits, with div255(x) computed as
+ * (y + (y >> 8)) >> 8 where y = x + 1. This equals (x*257 + 257) >> 16
+ * for all x up to 255*255. The kernels assume premultiplied paint, where
+ * no color component is larger than alpha.
+ */
+
+#ifndef PISCES_BLIT_KERNELS_H
+#define PISCES_BLIT_KERNELS_H
+
+#include <PiscesDefs.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PISCES_SIMD_SSE2 1
+#else
+#define PISCES_SIMD_SSE2 0
+#endif
+
+#if (defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)) && \
+    (defined(__clang__) || (defined(__GNUC__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))) || \
+     (defined(_MSC_VER) && _MSC_VER >= 1700))
+#define PISCES_SIMD_AVX2 1
+#else
+#define PISCES_SIMD_AVX2 0
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(__aarch64__)
+#define PISCES_SIMD_NEON 1
+#else
+#define PISCES_SIMD_NEON 0
+#endif
+
+#define BLIT_KERNEL_SCALAR 0
+#define BLIT_KERNEL_SSE2   1
+#define BLIT_KERNEL_AVX2   2
+#define BLIT_KERNEL_NEON   3
+#define BLIT_KERNEL_COUNT  4
+
+/**
+ * Blends n pixels of the non premultiplied color (sred, sgreen, sblue)
+ * over intData. aval[i] is the alpha the color has at pixel i, 0 leaves
+ * the pixel as it is.
+ */
+typedef void BlendColorSpanFunc(jint *intData, const unsigned char *aval, jint n,
+                                jint sred, jint sgreen, jint sblue);
+
+/**
+ * Blends n premultiplied paint pixels over intData, each of them scaled
+ * by frac[i] / 256 first. 256 blends the paint pixel as it is, 0 leaves
+ * the destination pixel as it is.
+ */
+typedef void BlendPaintSpanFunc(jint *intData, const jint *paint,
+                                const unsigned short *frac, jint n);
+
+typedef struct _BlitKernels {
+    BlendColorSpanFunc *blendColorSpan;
+    BlendPaintSpanFunc *blendPaintSpan;
+} BlitKernels;
+
+/**
+ * Returns the kernels to blend with. Both are NULL for BLIT_KERNEL_SCALAR,
+ * the blits then blend pixel by pixel.
+ */
+const BlitKernels *getBlitKernels();
+
+/**
+ * Returns the BLIT_KERNEL_* constant of the kernels in use.
+ */
+jint getBlitKernel();
+
+/**
+ * Makes the blits use the given kernels, for testing. Returns XNI_FALSE
+ * if the CPU does not support them.
+ */
+jboolean setBlitKernel(jint kernel);
+
+jboolean isBlitKernelSupported(jint kernel);
+
+const char *getBlitKernelName(jint kernel);
+
+/*
+ * Scalar versions of the kernels, the SIMD kernels blend the pixels left
+ * over at the end of a span with them.
+ */
+void blendColorSpan8888_pre_scalar(jint *intData, const unsigned char *aval, jint n,
+                                   jint sred, jint sgreen, jint sblue);
+void blendPaintSpan8888_pre_scalar(jint *intData, const jint *paint,
+                                   const unsigned short *frac, jint n);
+
+#if PISCES_SIMD_SSE2
+void blendColorSpan8888_pre_sse2(jint *intData, const unsigned char *aval, jint n,
+                                 jint sred, jint sgreen, jint sblue);
+void blendPaintSpan8888_pre_sse2(jint *intData, const jint *paint,
+                                 const unsigned short *frac, jint n);
+#endif
+
+#if PISCES_SIMD_AVX2
+jboolean isAVX2Supported();
+void blendColorSpan8888_pre_avx2(jint *intData, const unsigned char *aval, jint n,
+                                 jint sred, jint sgreen, jint sblue);
+void blendPaintSpan8888_pre_avx2(jint *intData, const jint *paint,
+                                 const unsigned short *frac, jint n);
+#endif
+
+#if PISCES_SIMD_NEON
+void blendColorSpan8888_pre_neon(jint *intData, const unsigned char *aval, jint n,
+                                 jint sred, jint sgreen, jint sblue);
+void blendPaintSpan8888_pre_neon(jint *intData, const jint *paint,
+                                 const unsigned short *frac, jint n);
+#endif
+
+#endif
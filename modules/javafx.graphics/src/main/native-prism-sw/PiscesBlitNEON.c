@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#include <PiscesBlit.h>
+#include <PiscesBlitKernels.h>
+
+#include <PiscesSysutils.h>
+
+#if PISCES_SIMD_NEON
+
+#include <arm_neon.h>
+
+// div255 of 8 lanes narrowed to bytes, see PiscesBlitKernels.h
+static INLINE uint8x8_t div255_neon(uint16x8_t x) {
+    uint16x8_t y = vaddq_u16(x, vdupq_n_u16(1));
+    return vshrn_n_u16(vsraq_n_u16(y, y, 8), 8);
+}
+
+// The kernels blend 8 pixels at a time, vld4 splits them into one
+// register per channel in B, G, R, A order.
+void
+blendColorSpan8888_pre_neon(jint *intData, const unsigned char *aval, jint n,
+                            jint sred, jint sgreen, jint sblue)
+{
+    const uint8x8_t max = vdup_n_u8(MAX_ALPHA);
+    const uint8x8_t r = vdup_n_u8((uint8_t)sred);
+    const uint8x8_t g = vdup_n_u8((uint8_t)sgreen);
+    const uint8x8_t b = vdup_n_u8((uint8_t)sblue);
+    const uint32x4_t solid = vdupq_n_u32(0xff000000 | (sred << 16) |
+                                         (sgreen << 8) | sblue);
+    jint i;
+
+    for (i = 0; i + 8 <= n; i += 8) {
+        uint8x8_t a, ia;
+        uint8x8x4_t d;
+        jlong avals;
+        memcpy(&avals, aval + i, sizeof(avals));
+        if (avals == 0) {
+            continue;
+        }
+        if (avals == -1) {
+            vst1q_u32((uint32_t *)(intData + i), solid);
+            vst1q_u32((uint32_t *)(intData + i + 4), solid);
+            continue;
+        }
+        a = vld1_u8(aval + i);
+        ia = vsub_u8(max, a);
+        d = vld4_u8((const uint8_t *)(intData + i));
+        d.val[0] = div255_neon(vmlal_u8(vmull_u8(b, a), ia, d.val[0]));
+        d.val[1] = div255_neon(vmlal_u8(vmull_u8(g, a), ia, d.val[1]));
+        d.val[2] = div255_neon(vmlal_u8(vmull_u8(r, a), ia, d.val[2]));
+        d.val[3] = div255_neon(vmlal_u8(vmull_u8(max, a), ia, d.val[3]));
+        vst4_u8((uint8_t *)(intData + i), d);
+    }
+    blendColorSpan8888_pre_scalar(intData + i, aval + i, n - i, sred, sgreen, sblue);
+}
+
+void
+blendPaintSpan8888_pre_neon(jint *intData, const jint *paint,
+                            const unsigned short *frac, jint n)
+{
+    const uint16x8_t max = vdupq_n_u16(MAX_ALPHA);
+    jint i, c;
+
+    for (i = 0; i + 8 <= n; i += 8) {
+        uint16x8_t f, pa, ia;
+        uint8x8x4_t p, d;
+        jlong fracs[2];
+        memcpy(fracs, frac + i, sizeof(fracs));
+        if ((fracs[0] | fracs[1]) == 0) {
+            continue;
+        }
+        f = vld1q_u16(frac + i);
+        p = vld4_u8((const uint8_t *)(paint + i));
+        d = vld4_u8((const uint8_t *)(intData + i));
+        // (c * frac) >> 8 for the paint, alpha included
+        pa = vshrq_n_u16(vmulq_u16(vmovl_u8(p.val[3]), f), 8);
+        ia = vsubq_u16(max, pa);
+        for (c = 0; c < 3; c++) {
+            uint16x8_t pc = vshrq_n_u16(vmulq_u16(vmovl_u8(p.val[c]), f), 8);
+            uint16x8_t dc = vmulq_u16(ia, vmovl_u8(d.val[c]));
+            d.val[c] = vqmovn_u16(vaddq_u16(pc, vmovl_u8(div255_neon(dc))));
+        }
+        d.val[3] = vqmovn_u16(vaddq_u16(pa,
+                vmovl_u8(div255_neon(vmulq_u16(ia, vmovl_u8(d.val[3]))))));
+        vst4_u8((uint8_t *)(intData + i), d);
+    }
+    blendPaintSpan8888_pre_scalar(intData + i, paint + i, frac + i, n - i);
+}
+
+#endif
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2011, 2016, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2011, 2019, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -31,6 +31,7 @@
 
 #include <PiscesRenderer.h>
 
+#include <PiscesBands.h>
 #include <PiscesUtil.h>
 #include <PiscesBlit.h>
 #include <PiscesPaint.h>
@@ -96,9 +97,19 @@
         assert((rdr->_rendererState & INVALID_BLITTING_MASK) == 0);            \
     }
 
+/**
+ * Emits the next rows rows of an operation and moves the renderer past
+ * them, see renderer_emitRowsInBands().
+ */
+typedef void RowsFunc(Renderer* rdr, jint rows, void* args);
+
 static INLINE Renderer* renderer_create(Surface* surface);
 static INLINE void renderer_dispose(Renderer* rdr);
 
+static INLINE void renderer_setBandThreads(Renderer* rdr, jint threads);
+static void renderer_emitRowsInBands(Renderer* rdr, jint width, jint rows,
+        jint align, RowsFunc* emitRows, RowsFunc* skipRows, void* args);
+
 static INLINE void renderer_setClip(Renderer* rdr, jint minX, jint minY,
                                     jint width, jint height);
 
@@ -114,6 +125,8 @@ static INLINE void renderer_setRadialGradient(Renderer* rdr, jint cx, jint cy,
         Transform6 *transform);
 
 static Renderer* createCommon(Surface* surface);
+static void emitRowBand(void* data, jint band);
+static void clearRectBand(void* data, jint band);
 static void setPaintMode(Renderer* rdr, jint newPaintMode);
 static void setAntialiasing(Renderer* rdr, jint subpixelLgPositionsX,
                             jint subpixelLgPositionsY);
@@ -147,6 +160,100 @@ renderer_dispose(Renderer* rdr) {
     my_free(rdr);
 }
 
+/**
+ * Lets operations on large areas run in horizontal bands on up to threads
+ * threads. 1 renders everything on the calling thread, which is the
+ * default.
+ */
+static INLINE void
+renderer_setBandThreads(Renderer* rdr, jint threads) {
+    rdr->_bandThreads = MAX(1, MIN(threads, MAX_BAND_THREADS));
+}
+
+typedef struct _RowBands {
+    Renderer* copies;
+    jint rows;
+    jint bandCount;
+    jint align;
+    RowsFunc* emitRows;
+    RowsFunc* skipRows;
+    void* args;
+} RowBands;
+
+/*
+ * Returns the first row of a band. Bands start on a multiple of align, so
+ * they are split into the same chunks of rows as when emitted at once.
+ */
+static INLINE jint
+rowBandStart(RowBands* bands, jint band) {
+    jint row = (jint)((jlong)bands->rows * band / bands->bandCount);
+    return (band == bands->bandCount) ? bands->rows : row - row % bands->align;
+}
+
+static void
+emitRowBand(void* data, jint band) {
+    RowBands* bands = (RowBands*)data;
+    Renderer* rdr = &bands->copies[band];
+    jint start = rowBandStart(bands, band);
+    jint end = rowBandStart(bands, band + 1);
+
+    if (start < end) {
+        if (start > 0) {
+            bands->skipRows(rdr, start, bands->args);
+        }
+        bands->emitRows(rdr, end - start, bands->args);
+    }
+}
+
+/**
+ * Emits rows rows, width pixels wide, with emitRows(). If the renderer has
+ * bands enabled and the area is large enough, the rows are split into
+ * bands which are emitted in parallel by copies of the renderer, each
+ * with its own paint buffer. Every row of an operation has to depend on
+ * nothing but the renderer state skipRows() sets up for it, then the
+ * pixels are the same either way. Leaves the renderer past the rows.
+ */
+static void
+renderer_emitRowsInBands(Renderer* rdr, jint width, jint rows, jint align,
+                         RowsFunc* emitRows, RowsFunc* skipRows, void* args)
+{
+    RowBands bands;
+    jint bandCount = pisces_getBandCount(rdr->_bandThreads, width, rows);
+    jint i;
+
+    if (bandCount > 1) {
+        bands.copies = my_malloc(Renderer, bandCount);
+        if (bands.copies == NULL) {
+            bandCount = 1;
+        }
+    }
+    if (bandCount <= 1) {
+        emitRows(rdr, rows, args);
+        return;
+    }
+
+    for (i = 0; i < bandCount; i++) {
+        bands.copies[i] = *rdr;
+        bands.copies[i]._paint = NULL;
+        bands.copies[i]._paint_length = 0;
+    }
+    bands.rows = rows;
+    bands.bandCount = bandCount;
+    bands.align = MAX(align, 1);
+    bands.emitRows = emitRows;
+    bands.skipRows = skipRows;
+    bands.args = args;
+
+    pisces_runBands(emitRowBand, &bands, bandCount);
+
+    for (i = 0; i < bandCount; i++) {
+        my_free(bands.copies[i]._paint);
+    }
+    my_free(bands.copies);
+
+    skipRows(rdr, rows, args);
+}
+
 /**
  * This function sets clip-rect. Any part of object which is determined outside
  * of clip-rect is cliped == not drawn to destination surface.
@@ -416,6 +523,12 @@ renderer_removeMask(Renderer* rdr)
     rdr->_rendererState |= INVALID_BLITTING_MASK | INVALID_MASK_DEPENDED_ROUTINES;
 }
 
+typedef struct _ClearRectBands {
+    Renderer* rdr;
+    jint x, y, w, h;
+    jint bandCount;
+} ClearRectBands;
+
 static INLINE void
 renderer_clearRect(Renderer* rdr, jint x, jint y, jint w, jint h) {
     jint maxX = x + w - 1;
@@ -436,10 +549,35 @@ renderer_clearRect(Renderer* rdr, jint x, jint y, jint w, jint h) {
     maxY = MIN(maxY, rdr->_clip_bbMaxY);
 
     if ((x <= maxX) && (y <= maxY)) {
-        rdr->_clearRect(rdr, x, y, maxX - x + 1, maxY - y + 1);
+        jint bw = maxX - x + 1;
+        jint bh = maxY - y + 1;
+        jint bandCount = pisces_getBandCount(rdr->_bandThreads, bw, bh);
+        if (bandCount > 1) {
+            ClearRectBands bands;
+            bands.rdr = rdr;
+            bands.x = x;
+            bands.y = y;
+            bands.w = bw;
+            bands.h = bh;
+            bands.bandCount = bandCount;
+            pisces_runBands(clearRectBand, &bands, bandCount);
+        } else {
+            rdr->_clearRect(rdr, x, y, bw, bh);
+        }
     }
 }
 
+static void
+clearRectBand(void* data, jint band) {
+    ClearRectBands* bands = (ClearRectBands*)data;
+    jint start = (jint)((jlong)bands->h * band / bands->bandCount);
+    jint end = (jint)((jlong)bands->h * (band + 1) / bands->bandCount);
+
+    // _clearRect() only reads the renderer
+    bands->rdr->_clearRect(bands->rdr, bands->x, bands->y + start,
+                           bands->w, end - start);
+}
+
 static Renderer*
 createCommon(Surface* surface) {
     Renderer* rdr = (Renderer*)my_malloc(Renderer, 1);
@@ -469,6 +607,9 @@ createCommon(Surface* surface) {
     // initialize renderer state
     rdr->_rendererState = INVALID_ALL;
 
+    // render on the calling thread only
+    rdr->_bandThreads = 1;
+
     return rdr;
 }
 
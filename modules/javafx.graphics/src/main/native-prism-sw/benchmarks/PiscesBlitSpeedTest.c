@@ -0,0 +1,292 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+// Times the source over blits of PiscesBlit.c with every blend kernel the
+// CPU supports and checks that they all produce the same pixels as the
+// scalar kernel. The scalar kernel runs the per pixel loops the blits use
+// when there is no SIMD support, so the speedups are relative to those.
+// The scenes stand in for what the software pipeline draws
+// most: antialiased text and shapes in a solid color, masks, and shapes
+// and rectangles filled with a gradient or a texture. From the
+// native-prism-sw directory it builds standalone like so:
+// gcc -o PiscesBlitSpeedTest -O2 -I. -I<gensrc headers> -I$JAVA_HOME/include -I$JAVA_HOME/include/<os> benchmarks/PiscesBlitSpeedTest.c PiscesBlit.c PiscesBlitAVX2.c PiscesBlitNEON.c -lm
+// where <gensrc headers> holds the javah generated com_sun_pisces_RendererBase.h.
+//
+// Usage: PiscesBlitSpeedTest [<iterations>]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <PiscesBlit.h>
+#include <PiscesBlitKernels.h>
+
+#define WIDTH   1024
+#define HEIGHT  256
+
+typedef enum {
+    SOLID_AA, SOLID_MASK, GRADIENT_AA, TEXTURE_MASK, SOLID_LINE, TEXTURE_LINE,
+    SCENE_COUNT
+} Scene;
+
+static const char *const sceneNames[SCENE_COUNT] = {
+    "solid AA", "solid mask", "gradient AA", "texture mask",
+    "solid line", "texture line"
+};
+
+static jint background[WIDTH * HEIGHT];
+static jint image[WIDTH * HEIGHT];
+static jint coverageDeltas[HEIGHT][WIDTH];
+static jbyte mask[WIDTH * HEIGHT];
+static jint gradient[WIDTH];
+static jint texture[HEIGHT][WIDTH];
+static jbyte alphaMap[256];
+static jint rowAAInt[WIDTH];
+static jint paint[WIDTH];
+
+static unsigned int seed = 1;
+
+static jint
+nextRandom(jint bound) {
+    seed = seed * 1103515245 + 12345;
+    return (jint)((seed >> 8) % (unsigned int)bound);
+}
+
+static jint
+premultiply(jint a, jint r, jint g, jint b) {
+    return (a << 24) | (((r * a + 127) / 255) << 16) |
+           (((g * a + 127) / 255) << 8) | ((b * a + 127) / 255);
+}
+
+// Coverage of a row of glyph like runs: fully covered stems between
+// partially covered edges, with gaps between them.
+static void
+generateCoverage(unsigned char *coverage) {
+    jint x = 0;
+    memset(coverage, 0, WIDTH);
+    while (x < WIDTH) {
+        jint gap = nextRandom(24);
+        jint run = nextRandom(12);
+        x += gap;
+        if (x < WIDTH) {
+            coverage[x++] = (unsigned char)(1 + nextRandom(254));
+        }
+        while (run-- > 0 && x < WIDTH) {
+            coverage[x++] = 255;
+        }
+        if (x < WIDTH) {
+            coverage[x++] = (unsigned char)(1 + nextRandom(254));
+        }
+    }
+}
+
+static void
+generateScenes() {
+    unsigned char coverage[WIDTH];
+    jint x, y, last;
+
+    for (x = 0; x < 256; x++) {
+        alphaMap[x] = (jbyte)x;
+    }
+    for (y = 0; y < HEIGHT; y++) {
+        generateCoverage(coverage);
+        last = 0;
+        for (x = 0; x < WIDTH; x++) {
+            coverageDeltas[y][x] = coverage[x] - last;
+            last = coverage[x];
+        }
+        generateCoverage(coverage);
+        memcpy(mask + y * WIDTH, coverage, WIDTH);
+    }
+    for (x = 0; x < WIDTH; x++) {
+        // Opaque on the left, fading out to the right
+        jint a = 255 - (x * 255) / (WIDTH - 1);
+        gradient[x] = premultiply(x < WIDTH / 4 ? 255 : a, x & 0xff, 0x80, 255 - (x & 0xff));
+    }
+    for (y = 0; y < HEIGHT; y++) {
+        for (x = 0; x < WIDTH; x++) {
+            // Mostly opaque with transparent and translucent patches
+            jint a = nextRandom(8) == 0 ? 0 : nextRandom(4) == 0 ? nextRandom(256) : 255;
+            texture[y][x] = premultiply(a, nextRandom(256), nextRandom(256), nextRandom(256));
+        }
+    }
+    for (x = 0; x < WIDTH * HEIGHT; x++) {
+        background[x] = premultiply(nextRandom(256), nextRandom(256),
+                                    nextRandom(256), nextRandom(256));
+    }
+}
+
+static void
+setupRenderer(Renderer *rdr) {
+    memset(rdr, 0, sizeof(Renderer));
+    rdr->_data = image;
+    rdr->_width = WIDTH;
+    rdr->_height = HEIGHT;
+    rdr->_imageScanlineStride = WIDTH;
+    rdr->_imagePixelStride = 1;
+    rdr->_alphaWidth = WIDTH;
+    rdr->_minTouched = 0;
+    rdr->_maxTouched = WIDTH - 1;
+    rdr->alphaMap = alphaMap;
+    rdr->_rowAAInt = rowAAInt;
+    rdr->_mask_byteData = mask;
+    rdr->_paint = paint;
+    rdr->_paint_length = WIDTH;
+    rdr->_calpha = 200;
+    rdr->_cred = 0x20;
+    rdr->_cgreen = 0x60;
+    rdr->_cblue = 0xc0;
+}
+
+// Draws the scene over the background one row at a time, the way the
+// renderer emits rows.
+static void
+drawScene(Renderer *rdr, Scene scene) {
+    jint y;
+    for (y = 0; y < HEIGHT; y++) {
+        rdr->_currImageOffset = y * WIDTH;
+        switch (scene) {
+        case SOLID_AA:
+            memcpy(rowAAInt, coverageDeltas[y], sizeof(rowAAInt));
+            blitSrcOver8888_pre(rdr, 1);
+            break;
+        case SOLID_MASK:
+            rdr->_maskOffset = y * WIDTH;
+            blitSrcOverMask8888_pre(rdr, 1);
+            break;
+        case GRADIENT_AA:
+            memcpy(rowAAInt, coverageDeltas[y], sizeof(rowAAInt));
+            memcpy(paint, gradient, sizeof(paint));
+            blitPTSrcOver8888_pre(rdr, 1);
+            break;
+        case TEXTURE_MASK:
+            rdr->_maskOffset = y * WIDTH;
+            memcpy(paint, texture[y], sizeof(paint));
+            blitPTSrcOverMask8888_pre(rdr, 1);
+            break;
+        case SOLID_LINE:
+            rdr->_el_lfrac = 0x4000;
+            rdr->_el_rfrac = 0xc000;
+            emitLineSourceOver8888_pre(rdr, 1, (y & 1) ? 0x10000 : 0x8000);
+            break;
+        case TEXTURE_LINE:
+            rdr->_el_lfrac = 0x4000;
+            rdr->_el_rfrac = 0xc000;
+            memcpy(paint, texture[y], sizeof(paint));
+            emitLinePTSourceOver8888_pre(rdr, 1, (y & 1) ? 0x10000 : 0x8000);
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+static unsigned long long
+checksum() {
+    unsigned long long hash = 14695981039346656037ULL;
+    jint i;
+    for (i = 0; i < WIDTH * HEIGHT; i++) {
+        hash = (hash ^ (unsigned int)image[i]) * 1099511628211ULL;
+    }
+    return hash;
+}
+
+static double
+now() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+// Returns the best time of a frame in milliseconds
+static double
+timeScene(Renderer *rdr, Scene scene, jint iterations) {
+    double best = 0;
+    jint i;
+    for (i = 0; i < iterations; i++) {
+        double start;
+        memcpy(image, background, sizeof(image));
+        start = now();
+        drawScene(rdr, scene);
+        start = now() - start;
+        if (i == 0 || start < best) {
+            best = start;
+        }
+    }
+    return best;
+}
+
+int
+main(int argc, char **argv) {
+    Renderer *rdr = (Renderer *)malloc(sizeof(Renderer));
+    unsigned long long expected[SCENE_COUNT];
+    double scalarTimes[SCENE_COUNT];
+    jint iterations = (argc > 1) ? atoi(argv[1]) : 50;
+    jint kernel, scene;
+    int failed = 0;
+
+    if (rdr == NULL || iterations <= 0) {
+        printf("Usage: PiscesBlitSpeedTest [<iterations>]\n");
+        return 1;
+    }
+
+    generateScenes();
+    setupRenderer(rdr);
+    printf("%dx%d, best of %d frames, default kernel: %s\n", WIDTH, HEIGHT,
+           iterations, getBlitKernelName(getBlitKernel()));
+
+    for (kernel = 0; kernel < BLIT_KERNEL_COUNT; kernel++) {
+        if (!setBlitKernel(kernel)) {
+            continue;
+        }
+        printf("%s\n", getBlitKernelName(kernel));
+        for (scene = 0; scene < SCENE_COUNT; scene++) {
+            unsigned long long hash;
+            double time;
+            int mismatch;
+
+            memcpy(image, background, sizeof(image));
+            drawScene(rdr, (Scene)scene);
+            hash = checksum();
+            if (kernel == BLIT_KERNEL_SCALAR) {
+                expected[scene] = hash;
+            }
+            mismatch = hash != expected[scene];
+            failed |= mismatch;
+
+            time = timeScene(rdr, (Scene)scene, iterations);
+            if (kernel == BLIT_KERNEL_SCALAR) {
+                scalarTimes[scene] = time;
+            }
+            printf("    %-14s %8.3f ms %5.2fx  %016llx%s\n", sceneNames[scene],
+                   time, scalarTimes[scene] / time, hash,
+                   mismatch ? "  MISMATCH" : "");
+        }
+    }
+
+    free(rdr);
+    return failed;
+}
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2012, 2013, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2012, 2019, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -36,6 +36,8 @@ typedef struct {
     jint width;
     jint height;
     jbyte *alphas;
+    // Distance in bytes between the starts of two rows of alphas
+    jint stride;
 //    public void setMaxAlpha(jint maxalpha);
 //    public void setAndClearRelativeAlphas(jint alphaDeltas[], jint pix_y,
 //                                          jint firstdelta, jint lastdelta);
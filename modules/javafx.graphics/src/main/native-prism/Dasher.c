@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2012, 2014, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2012, 2019, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -96,7 +96,6 @@ void Dasher_init(Dasher *pDasher,
 
     this.firstSegmentsBufferSIZE = 7;
     this.firstSegmentsBuffer = new_float(this.firstSegmentsBufferSIZE);
-    this.firstSegidx = 0;
 
     this.out = out;
     Dasher_reset(pDasher, dash, numdashes, phase);
@@ -154,6 +153,7 @@ void Dasher_reset(Dasher *pDasher, jfloat dash[], jint ndashes, jfloat phase) {
     this.startDashOn = this.dashOn;
     this.startIdx = sidx;
     this.starting = JNI_TRUE;
+    this.firstSegidx = 0;
 }
 
 void Dasher_destroy(Dasher *pDasher) {
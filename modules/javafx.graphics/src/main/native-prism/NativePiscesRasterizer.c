@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2012, 2016, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2012, 2019, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -47,6 +47,16 @@
 #define AIOOBException "java/lang/ArrayIndexOutOfBoundsException"
 #define IError         "java/lang/InternalError"
 
+#ifdef _MSC_VER
+#define THREAD_LOCAL __declspec(thread)
+#else
+#define THREAD_LOCAL __thread
+#endif
+
+// Scratch memory a thread keeps between shapes, larger arenas are released
+// once the shape which needed them is done.
+#define MAX_RETAINED_SCRATCH_SIZE (1024 * 1024)
+
 #define CheckNPE(env, a)                                \
     do {                                                \
         if (a == NULL) {                                \
@@ -63,6 +73,77 @@
         }                                               \
     } while (0)
 
+/*
+ * The rasterizer objects of the calling thread. They are initialized on first
+ * use and only reset for the following shapes, so that the edge, bucket and
+ * crossing arrays of the Renderer and the scratch arrays of the Stroker and
+ * the Dasher are allocated once and grow as needed.
+ */
+typedef struct {
+    Renderer renderer;
+    Stroker stroker;
+    Dasher dasher;
+    jboolean rendererInitialized;
+    jboolean strokerInitialized;
+    jboolean dasherInitialized;
+} RasterizerContext;
+
+static THREAD_LOCAL RasterizerContext threadContext;
+
+static Renderer *getRenderer(RasterizerContext *pContext,
+                             jint pix_boundsX, jint pix_boundsY,
+                             jint pix_boundsWidth, jint pix_boundsHeight,
+                             jint windingRule)
+{
+    if (!pContext->rendererInitialized) {
+        Renderer_init(&pContext->renderer);
+        pContext->rendererInitialized = JNI_TRUE;
+    }
+    Renderer_reset(&pContext->renderer,
+                   pix_boundsX, pix_boundsY, pix_boundsWidth, pix_boundsHeight,
+                   windingRule);
+    return &pContext->renderer;
+}
+
+static Stroker *getStroker(RasterizerContext *pContext, PathConsumer *out,
+                           jfloat linewidth, jint linecap, jint linejoin,
+                           jfloat miterlimit)
+{
+    if (!pContext->strokerInitialized) {
+        Stroker_init(&pContext->stroker, out,
+                     linewidth, linecap, linejoin, miterlimit);
+        pContext->strokerInitialized = JNI_TRUE;
+    } else {
+        Stroker_reset(&pContext->stroker, out,
+                      linewidth, linecap, linejoin, miterlimit);
+    }
+    return &pContext->stroker;
+}
+
+static Dasher *getDasher(RasterizerContext *pContext, PathConsumer *out,
+                         jfloat *dashes, jint numdashes, jfloat dashphase)
+{
+    if (!pContext->dasherInitialized) {
+        Dasher_init(&pContext->dasher, out, dashes, numdashes, dashphase);
+        pContext->dasherInitialized = JNI_TRUE;
+    } else {
+        // The Dasher always feeds the Stroker of the same context
+        Dasher_reset(&pContext->dasher, dashes, numdashes, dashphase);
+    }
+    return &pContext->dasher;
+}
+
+static void trimContext(RasterizerContext *pContext) {
+    if (Renderer_getScratchSize(&pContext->renderer) > MAX_RETAINED_SCRATCH_SIZE) {
+        Renderer_destroy(&pContext->renderer);
+    }
+    if (pContext->strokerInitialized &&
+        (pContext->stroker.reverse.curvesSIZE * sizeof(jfloat) > MAX_RETAINED_SCRATCH_SIZE))
+    {
+        Stroker_destroy(&pContext->stroker);
+        pContext->strokerInitialized = JNI_FALSE;
+    }
+}
 
 static void Throw(JNIEnv *env, char *throw_class_name, char *detail) {
     jclass throw_class = (*env)->FindClass(env, throw_class_name);
@@ -71,12 +152,74 @@ static void Throw(JNIEnv *env, char *throw_class_name, char *detail) {
     }
 }
 
+static char * feedCommands
+    (PathConsumer *consumer,
+     jfloat *coords, jint coordSize,
+     jbyte *commands, jint numCommands)
+{
+    char *failure = NULL;
+    jint cmdoff, coordoff = 0;
+    for (cmdoff = 0; cmdoff < numCommands && failure == NULL; cmdoff++) {
+        switch (commands[cmdoff]) {
+            case SEG_MOVETO:
+                if (coordoff + 2 > coordSize) {
+                    failure = "[not enough coordinates for moveTo";
+                } else {
+                    consumer->moveTo(consumer,
+                                     coords[coordoff+0], coords[coordoff+1]);
+                    coordoff += 2;
+                }
+                break;
+            case SEG_LINETO:
+                if (coordoff + 2 > coordSize) {
+                    failure = "[not enough coordinates for lineTo";
+                } else {
+                    consumer->lineTo(consumer,
+                                     coords[coordoff+0], coords[coordoff+1]);
+                    coordoff += 2;
+                }
+                break;
+            case SEG_QUADTO:
+                if (coordoff + 4 > coordSize) {
+                    failure = "[not enough coordinates for quadTo";
+                } else {
+                    consumer->quadTo(consumer,
+                                     coords[coordoff+0], coords[coordoff+1],
+                                     coords[coordoff+2], coords[coordoff+3]);
+                    coordoff += 4;
+                }
+                break;
+            case SEG_CUBICTO:
+                if (coordoff + 6 > coordSize) {
+                    failure = "[not enough coordinates for curveTo";
+                } else {
+                    consumer->curveTo(consumer,
+                                      coords[coordoff+0], coords[coordoff+1],
+                                      coords[coordoff+2], coords[coordoff+3],
+                                      coords[coordoff+4], coords[coordoff+5]);
+                    coordoff += 6;
+                }
+                break;
+            case SEG_CLOSE:
+                consumer->closePath(consumer);
+                break;
+            default:
+                failure = "unrecognized Path segment";
+                break;
+        }
+    }
+    if (failure == NULL) {
+        consumer->pathDone(consumer);
+    }
+    return failure;
+}
+
 static char * feedConsumer
     (JNIEnv *env, PathConsumer *consumer,
      jfloatArray coordsArray, jint coordSize,
      jbyteArray commandsArray, jint numCommands)
 {
-    char *failure = NULL;
+    char *failure;
     jfloat *coords;
 
     coords = (*env)->GetPrimitiveArrayCritical(env, coordsArray, 0);
@@ -87,66 +230,24 @@ static char * feedConsumer
         if (commands == NULL) {
             failure = "";
         } else {
-            jint cmdoff, coordoff = 0;
-            for (cmdoff = 0; cmdoff < numCommands && failure == NULL; cmdoff++) {
-                switch (commands[cmdoff]) {
-                    case SEG_MOVETO:
-                        if (coordoff + 2 > coordSize) {
-                            failure = "[not enough coordinates for moveTo";
-                        } else {
-                            consumer->moveTo(consumer,
-                                             coords[coordoff+0], coords[coordoff+1]);
-                            coordoff += 2;
-                        }
-                        break;
-                    case SEG_LINETO:
-                        if (coordoff + 2 > coordSize) {
-                            failure = "[not enough coordinates for lineTo";
-                        } else {
-                            consumer->lineTo(consumer,
-                                             coords[coordoff+0], coords[coordoff+1]);
-                            coordoff += 2;
-                        }
-                        break;
-                    case SEG_QUADTO:
-                        if (coordoff + 4 > coordSize) {
-                            failure = "[not enough coordinates for quadTo";
-                        } else {
-                            consumer->quadTo(consumer,
-                                             coords[coordoff+0], coords[coordoff+1],
-                                             coords[coordoff+2], coords[coordoff+3]);
-                            coordoff += 4;
-                        }
-                        break;
-                    case SEG_CUBICTO:
-                        if (coordoff + 6 > coordSize) {
-                            failure = "[not enough coordinates for curveTo";
-                        } else {
-                            consumer->curveTo(consumer,
-                                              coords[coordoff+0], coords[coordoff+1],
-                                              coords[coordoff+2], coords[coordoff+3],
-                                              coords[coordoff+4], coords[coordoff+5]);
-                            coordoff += 6;
-                        }
-                        break;
-                    case SEG_CLOSE:
-                        consumer->closePath(consumer);
-                        break;
-                    default:
-                        failure = "unrecognized Path segment";
-                        break;
-                }
-            }
+            failure = feedCommands(consumer, coords, coordSize, commands, numCommands);
             (*env)->ReleasePrimitiveArrayCritical(env, commandsArray, commands, JNI_ABORT);
         }
         (*env)->ReleasePrimitiveArrayCritical(env, coordsArray, coords, JNI_ABORT);
-        if (failure == NULL) {
-            consumer->pathDone(consumer);
-        }
     }
     return failure;
 }
 
+static void throwFailure(JNIEnv *env, char *failure) {
+    if (*failure != 0) {
+        if (*failure == '[') {
+            Throw(env, AIOOBException, failure + 1);
+        } else {
+            Throw(env, IError, failure);
+        }
+    }
+}
+
 /*
  * Class:     com_sun_prism_impl_shape_NativePiscesRasterizer
  * Method:    init
@@ -174,7 +275,7 @@ Java_com_sun_prism_impl_shape_NativePiscesRasterizer_produceFillAlphas
 {
     jint bounds[4];
     Transformer transformer;
-    Renderer renderer;
+    Renderer *pRenderer;
     PathConsumer *consumer;
     char *failure;
     jint coordSize;
@@ -188,16 +289,15 @@ Java_com_sun_prism_impl_shape_NativePiscesRasterizer_produceFillAlphas
 
     (*env)->GetIntArrayRegion(env, boundsArray, 0, 4, bounds);
     coordSize = (*env)->GetArrayLength(env, coordsArray);
-    Renderer_init(&renderer);
-    Renderer_reset(&renderer,
-                   bounds[0], bounds[1], bounds[2] - bounds[0], bounds[3] - bounds[1],
-                   nonzero ? WIND_NON_ZERO : WIND_EVEN_ODD);
-    consumer = Transformer_init(&transformer, &renderer.consumer,
+    pRenderer = getRenderer(&threadContext,
+                            bounds[0], bounds[1], bounds[2] - bounds[0], bounds[3] - bounds[1],
+                            nonzero ? WIND_NON_ZERO : WIND_EVEN_ODD);
+    consumer = Transformer_init(&transformer, &pRenderer->consumer,
                                 mxx, mxy, mxt, myx, myy, myt);
     failure = feedConsumer(env, consumer,
                            coordsArray, coordSize, commandsArray, numCommands);
     if (failure == NULL) {
-        Renderer_getOutputBounds(&renderer, bounds);
+        Renderer_getOutputBounds(pRenderer, bounds);
         (*env)->SetIntArrayRegion(env, boundsArray, 0, 4, bounds);
         if (bounds[0] < bounds[2] && bounds[1] < bounds[3]) {
             AlphaConsumer ac = {
@@ -206,24 +306,21 @@ Java_com_sun_prism_impl_shape_NativePiscesRasterizer_produceFillAlphas
                 bounds[2] - bounds[0],
                 bounds[3] - bounds[1],
             };
+            ac.stride = ac.width;
             if ((*env)->GetArrayLength(env, maskArray) / ac.width < ac.height) {
                 Throw(env, AIOOBException, "maskArray");
             } else {
                 ac.alphas = (*env)->GetPrimitiveArrayCritical(env, maskArray, 0);
                 if (ac.alphas != NULL) {
-                    Renderer_produceAlphas(&renderer, &ac);
+                    Renderer_produceAlphas(pRenderer, &ac);
                     (*env)->ReleasePrimitiveArrayCritical(env, maskArray, ac.alphas, 0);
                 }
             }
         }
-    } else if (*failure != 0) {
-        if (*failure == '[') {
-            Throw(env, AIOOBException, failure + 1);
-        } else {
-            Throw(env, IError, failure);
-        }
+    } else {
+        throwFailure(env, failure);
     }
-    Renderer_destroy(&renderer);
+    trimContext(&threadContext);
 }
 
 /*
@@ -241,9 +338,8 @@ Java_com_sun_prism_impl_shape_NativePiscesRasterizer_produceStrokeAlphas
      jintArray boundsArray, jbyteArray maskArray)
 {
     jint bounds[4];
-    Stroker stroker;
-    Dasher dasher;
-    Renderer renderer;
+    Stroker *pStroker;
+    Renderer *pRenderer;
     Transformer transformer;
     PathConsumer *consumer;
     jint coordSize;
@@ -259,34 +355,32 @@ Java_com_sun_prism_impl_shape_NativePiscesRasterizer_produceStrokeAlphas
 
     (*env)->GetIntArrayRegion(env, boundsArray, 0, 4, bounds);
     coordSize = (*env)->GetArrayLength(env, coordsArray);
-    Renderer_init(&renderer);
-    Renderer_reset(&renderer,
-                   bounds[0], bounds[1], bounds[2] - bounds[0], bounds[3] - bounds[1],
-                   WIND_NON_ZERO);
-    consumer = Transformer_init(&transformer, &renderer.consumer,
+    pRenderer = getRenderer(&threadContext,
+                            bounds[0], bounds[1], bounds[2] - bounds[0], bounds[3] - bounds[1],
+                            WIND_NON_ZERO);
+    consumer = Transformer_init(&transformer, &pRenderer->consumer,
                                 mxx, mxy, mxt, myx, myy, myt);
-    Stroker_init(&stroker, consumer, linewidth, linecap, linejoin, miterlimit);
+    pStroker = getStroker(&threadContext, consumer,
+                          linewidth, linecap, linejoin, miterlimit);
     if (dashArray == NULL) {
         dashes = NULL;
-        consumer = &stroker.consumer;
+        consumer = &pStroker->consumer;
     } else {
         jint numdashes = (*env)->GetArrayLength(env, dashArray);
         dashes = (*env)->GetPrimitiveArrayCritical(env, dashArray, 0);
         if (dashes == NULL) {
             return;
         }
-        Dasher_init(&dasher, &stroker.consumer, dashes, numdashes, dashphase);
-        consumer = &dasher.consumer;
+        consumer = &getDasher(&threadContext, &pStroker->consumer,
+                              dashes, numdashes, dashphase)->consumer;
     }
     failure = feedConsumer(env, consumer,
                            coordsArray, coordSize, commandsArray, numCommands);
     if (dashArray != NULL) {
         (*env)->ReleasePrimitiveArrayCritical(env, dashArray, dashes, JNI_ABORT);
-        Dasher_destroy(&dasher);
     }
-    Stroker_destroy(&stroker);
     if (failure == NULL) {
-        Renderer_getOutputBounds(&renderer, bounds);
+        Renderer_getOutputBounds(pRenderer, bounds);
         (*env)->SetIntArrayRegion(env, boundsArray, 0, 4, bounds);
         if (bounds[0] < bounds[2] && bounds[1] < bounds[3]) {
             AlphaConsumer ac = {
@@ -295,22 +389,184 @@ Java_com_sun_prism_impl_shape_NativePiscesRasterizer_produceStrokeAlphas
                 bounds[2] - bounds[0],
                 bounds[3] - bounds[1],
             };
+            ac.stride = ac.width;
             if ((*env)->GetArrayLength(env, maskArray) / ac.width < ac.height) {
                 Throw(env, AIOOBException, "Mask");
             } else {
                 ac.alphas = (*env)->GetPrimitiveArrayCritical(env, maskArray, 0);
                 if (ac.alphas != NULL) {
-                    Renderer_produceAlphas(&renderer, &ac);
+                    Renderer_produceAlphas(pRenderer, &ac);
                     (*env)->ReleasePrimitiveArrayCritical(env, maskArray, ac.alphas, 0);
                 }
             }
         }
-    } else if (*failure != 0) {
-        if (*failure == '[') {
-            Throw(env, AIOOBException, failure + 1);
-        } else {
-            Throw(env, IError, failure);
+    } else {
+        throwFailure(env, failure);
+    }
+    trimContext(&threadContext);
+}
+
+/*
+ * Class:     com_sun_prism_impl_shape_NativePiscesRasterizer
+ * Method:    produceFillAlphasBatch
+ * Signature: ([F[B[II[D[I[BII)I
+ *
+ * Fills numShapes paths into a single mask atlas. The paths are stored one
+ * after the other in coordsArray and commandsArray, and described by three
+ * entries of shapesArray each: the number of coordinates, the number of
+ * commands and a non-zero winding flag. transformsArray holds the six
+ * coefficients mxx, mxy, mxt, myx, myy, myt of each path.
+ *
+ * boundsArray holds six entries per path. The first four are the device
+ * bounds to rasterize the path into, they are replaced with the bounds of
+ * its mask, and the last two receive the position of the mask in the atlas.
+ * The masks are laid out left to right in rows of the atlas, an empty mask
+ * gets no space.
+ *
+ * Returns the number of paths rasterized, which is less than numShapes if
+ * the next mask does not fit in the remaining space of the atlas.
+ */
+JNIEXPORT jint JNICALL
+Java_com_sun_prism_impl_shape_NativePiscesRasterizer_produceFillAlphasBatch
+    (JNIEnv *env, jclass klass,
+     jfloatArray coordsArray, jbyteArray commandsArray,
+     jintArray shapesArray, jint numShapes,
+     jdoubleArray transformsArray, jintArray boundsArray,
+     jbyteArray atlasArray, jint atlasWidth, jint atlasHeight)
+{
+    jint *shapes, *bounds;
+    jdouble *transforms;
+    jfloat *coords;
+    jbyte *commands, *atlas;
+    jint coordSize, commandsSize;
+    jint coordoff = 0, cmdoff = 0;
+    jint shelfX = 0, shelfY = 0, shelfHeight = 0;
+    jint count = 0;
+    char *failure = NULL;
+
+    if (coordsArray == NULL || commandsArray == NULL || shapesArray == NULL ||
+        transformsArray == NULL || boundsArray == NULL || atlasArray == NULL)
+    {
+        Throw(env, NPException, "");
+        return 0;
+    }
+    if (numShapes < 0 || atlasWidth < 0 || atlasHeight < 0 ||
+        (*env)->GetArrayLength(env, shapesArray) / 3 < numShapes ||
+        (*env)->GetArrayLength(env, transformsArray) / 6 < numShapes ||
+        (*env)->GetArrayLength(env, boundsArray) / 6 < numShapes ||
+        (atlasWidth > 0 && (*env)->GetArrayLength(env, atlasArray) / atlasWidth < atlasHeight))
+    {
+        Throw(env, AIOOBException, "");
+        return 0;
+    }
+    coordSize = (*env)->GetArrayLength(env, coordsArray);
+    commandsSize = (*env)->GetArrayLength(env, commandsArray);
+
+    // All the arrays stay pinned while the whole batch is rasterized
+    shapes = (*env)->GetPrimitiveArrayCritical(env, shapesArray, 0);
+    transforms = (*env)->GetPrimitiveArrayCritical(env, transformsArray, 0);
+    bounds = (*env)->GetPrimitiveArrayCritical(env, boundsArray, 0);
+    coords = (*env)->GetPrimitiveArrayCritical(env, coordsArray, 0);
+    commands = (*env)->GetPrimitiveArrayCritical(env, commandsArray, 0);
+    atlas = (*env)->GetPrimitiveArrayCritical(env, atlasArray, 0);
+
+    if (shapes != NULL && transforms != NULL && bounds != NULL &&
+        coords != NULL && commands != NULL && atlas != NULL)
+    {
+        for (count = 0; count < numShapes; count++) {
+            jint *shape = shapes + 3 * count;
+            jdouble *tx = transforms + 6 * count;
+            jint *b = bounds + 6 * count;
+            jint outBounds[4];
+            Transformer transformer;
+            Renderer *pRenderer;
+            PathConsumer *consumer;
+            jint w, h;
+
+            if (shape[0] < 0 || shape[1] < 0 ||
+                shape[0] > coordSize - coordoff || shape[1] > commandsSize - cmdoff)
+            {
+                failure = "[shapes";
+                break;
+            }
+
+            pRenderer = getRenderer(&threadContext,
+                                    b[0], b[1], b[2] - b[0], b[3] - b[1],
+                                    shape[2] ? WIND_NON_ZERO : WIND_EVEN_ODD);
+            consumer = Transformer_init(&transformer, &pRenderer->consumer,
+                                        tx[0], tx[1], tx[2], tx[3], tx[4], tx[5]);
+            failure = feedCommands(consumer, coords + coordoff, shape[0],
+                                   commands + cmdoff, shape[1]);
+            if (failure != NULL) {
+                break;
+            }
+
+            Renderer_getOutputBounds(pRenderer, outBounds);
+            w = outBounds[2] - outBounds[0];
+            h = outBounds[3] - outBounds[1];
+            if (w > 0 && h > 0) {
+                if (shelfX + w > atlasWidth) {
+                    shelfX = 0;
+                    shelfY += shelfHeight;
+                    shelfHeight = 0;
+                }
+                if (w > atlasWidth || shelfY + h > atlasHeight) {
+                    break;
+                }
+                {
+                    AlphaConsumer ac = {
+                        outBounds[0],
+                        outBounds[1],
+                        w,
+                        h,
+                    };
+                    ac.alphas = atlas + shelfY * atlasWidth + shelfX;
+                    ac.stride = atlasWidth;
+                    Renderer_produceAlphas(pRenderer, &ac);
+                }
+                b[4] = shelfX;
+                b[5] = shelfY;
+                shelfX += w;
+                if (h > shelfHeight) {
+                    shelfHeight = h;
+                }
+            } else {
+                b[4] = b[5] = 0;
+            }
+            b[0] = outBounds[0];
+            b[1] = outBounds[1];
+            b[2] = outBounds[2];
+            b[3] = outBounds[3];
+
+            coordoff += shape[0];
+            cmdoff += shape[1];
         }
+    } else {
+        failure = "";
+    }
+
+    if (atlas != NULL) {
+        (*env)->ReleasePrimitiveArrayCritical(env, atlasArray, atlas, 0);
+    }
+    if (commands != NULL) {
+        (*env)->ReleasePrimitiveArrayCritical(env, commandsArray, commands, JNI_ABORT);
+    }
+    if (coords != NULL) {
+        (*env)->ReleasePrimitiveArrayCritical(env, coordsArray, coords, JNI_ABORT);
+    }
+    if (bounds != NULL) {
+        (*env)->ReleasePrimitiveArrayCritical(env, boundsArray, bounds, 0);
+    }
+    if (transforms != NULL) {
+        (*env)->ReleasePrimitiveArrayCritical(env, transformsArray, transforms, JNI_ABORT);
+    }
+    if (shapes != NULL) {
+        (*env)->ReleasePrimitiveArrayCritical(env, shapesArray, shapes, JNI_ABORT);
+    }
+
+    if (failure != NULL) {
+        throwFailure(env, failure);
     }
-    Renderer_destroy(&renderer);
+    trimContext(&threadContext);
+    return count;
 }
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2012, 2016, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2012, 2019, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -32,6 +32,24 @@
 #include "Renderer.h"
 #include "AlphaConsumer.h"
 
+// SSE2 and NEON are part of the x86-64 and ARMv8 baselines, so the vector
+// code is chosen at compile time. RENDERER_NO_SIMD forces the scalar code.
+#if !defined(RENDERER_NO_SIMD)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define RENDERER_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define RENDERER_NEON
+#include <arm_neon.h>
+#endif
+#endif
+
+// Rows which start more edges than this sort them with a merge sort and
+// merge them with the edges that are already active, since an insertion
+// sort of edges arriving in path order is quadratic. Runs this short are
+// insertion sorted.
+#define INSERTION_SORT_MAX  16
+
 //public final class Renderer implements PathConsumer2D {
 
 //    private final class ScanlineIterator {
@@ -58,6 +76,11 @@ static void ScanlineIterator_destroy(ScanlineIterator *pIterator) {
     free(this.edgePtrs);
     this.edgePtrs = NULL;
     this.edgePtrsSIZE = 0;
+    free(this.auxCrossings);
+    this.auxCrossings = NULL;
+    free(this.auxEdgePtrs);
+    this.auxEdgePtrs = NULL;
+    this.auxSIZE = 0;
 }
 
 static void ScanlineIterator_reset(ScanlineIterator *pIterator,
@@ -70,8 +93,69 @@ static void ScanlineIterator_reset(ScanlineIterator *pIterator,
     this.edgeCount = 0;
 }
 
+// Inserts the crossings in [from, to) into the sorted crossings in
+// [0, from), moving the edge pointers along with them.
+static void insertCrossings(jint *xings, jint *ptrs, jint from, jint to) {
+    jint i;
+    for (i = from; i < to; i++) {
+        jint cross = xings[i];
+        jint ecur = ptrs[i];
+        jint j = i;
+        while (--j >= 0) {
+            jint jcross = xings[j];
+            if (jcross <= cross) {
+                break;
+            }
+            xings[j+1] = jcross;
+            ptrs[j+1] = ptrs[j];
+        }
+        xings[j+1] = cross;
+        ptrs[j+1] = ecur;
+    }
+}
+
+// Merges the sorted runs [0, mid) and [mid, n). The first run is copied
+// to aux, which must hold mid elements.
+static void mergeCrossings(jint *xings, jint *ptrs, jint mid, jint n,
+                           jint *auxX, jint *auxP)
+{
+    jint i = 0, j = mid, k = 0;
+    if (mid == 0 || xings[mid-1] <= xings[mid]) {
+        return;
+    }
+    memcpy(auxX, xings, mid * sizeof(jint));
+    memcpy(auxP, ptrs, mid * sizeof(jint));
+    while (i < mid && j < n) {
+        if (xings[j] < auxX[i]) {
+            xings[k] = xings[j];
+            ptrs[k++] = ptrs[j++];
+        } else {
+            xings[k] = auxX[i];
+            ptrs[k++] = auxP[i++];
+        }
+    }
+    while (i < mid) {
+        xings[k] = auxX[i];
+        ptrs[k++] = auxP[i++];
+    }
+}
+
+static void sortCrossings(jint *xings, jint *ptrs, jint n,
+                          jint *auxX, jint *auxP)
+{
+    jint mid;
+    if (n <= INSERTION_SORT_MAX) {
+        insertCrossings(xings, ptrs, 1, n);
+        return;
+    }
+    mid = n >> 1;
+    sortCrossings(xings, ptrs, mid, auxX, auxP);
+    sortCrossings(xings + mid, ptrs + mid, n - mid, auxX, auxP);
+    mergeCrossings(xings, ptrs, mid, n, auxX, auxP);
+}
+
 static jint ScanlineIterator_next(ScanlineIterator *pIterator, Renderer *pRenderer) {
-    jint i, ecur;
+    jint i, ecur, activeCount;
     jint *xings;
     // NOTE: make function that convert from y value to bucket idx?
     jint cury = this.nextY++;
@@ -92,6 +176,9 @@ static jint ScanlineIterator_next(ScanlineIterator *pIterator, Renderer *pRender
         }
         count = newCount;
     }
+    // The edges still active were sorted on the previous row and are
+    // mostly still in order.
+    activeCount = count;
     if (this.edgePtrsSIZE < count + (bucketcount >> 1)) {
         jint newSize = (count + (bucketcount >> 1)) * 2;
         jint *newPtrs = new_int(newSize);
@@ -123,22 +210,28 @@ static jint ScanlineIterator_next(ScanlineIterator *pIterator, Renderer *pRender
         jint ecur = ptrs[i];
         jfloat curx = edges[ecur+CURX];
         jint cross = ((jint) ceil(curx - 0.5f)) << 1;
-        jint j;
         edges[ecur+CURX] = curx + edges[ecur+SLOPE];
         if (edges[ecur+OR] > 0) {
             cross |= 1;
         }
-        j = i;
-        while (--j >= 0) {
-            jint jcross = xings[j];
-            if (jcross <= cross) {
-                break;
-            }
-            xings[j+1] = jcross;
-            ptrs[j+1] = ptrs[j];
+        xings[i] = cross;
+    }
+    if (count - activeCount <= INSERTION_SORT_MAX) {
+        insertCrossings(xings, ptrs, 1, count);
+    } else {
+        if (this.auxSIZE < count) {
+            free(this.auxCrossings);
+            free(this.auxEdgePtrs);
+            this.auxCrossings = new_int(this.edgePtrsSIZE);
+            this.auxEdgePtrs = new_int(this.edgePtrsSIZE);
+            this.auxSIZE = this.edgePtrsSIZE;
         }
-        xings[j+1] = cross;
-        ptrs[j+1] = ecur;
+        insertCrossings(xings, ptrs, 1, activeCount);
+        sortCrossings(xings + activeCount, ptrs + activeCount,
+                      count - activeCount,
+                      this.auxCrossings, this.auxEdgePtrs);
+        mergeCrossings(xings, ptrs, activeCount, count,
+                       this.auxCrossings, this.auxEdgePtrs);
     }
     return count;
 }
@@ -359,6 +452,8 @@ static jbyte *alphaMap = NULL;
 static jint alphaMax;
 static jbyte *altAlphaMap = NULL;
 static jint altAlphaMax;
+// log2(alphaMax), the vector code computes alphaMap[a] with shifts.
+static jint lgAlphaMax;
 
 static void setMaxAlpha(jint maxalpha);
 
@@ -371,6 +466,7 @@ void Renderer_setup(jint subpixelLgPositionsX, jint subpixelLgPositionsY) {
     SUBPIXEL_MASK_Y = SUBPIXEL_POSITIONS_Y - 1;
 //    MAX_AA_ALPHA = (SUBPIXEL_POSITIONS_X * SUBPIXEL_POSITIONS_Y);
     setMaxAlpha((SUBPIXEL_POSITIONS_X * SUBPIXEL_POSITIONS_Y));
+    lgAlphaMax = SUBPIXEL_LG_POSITIONS_X + SUBPIXEL_LG_POSITIONS_Y;
 }
 
 void Renderer_init(Renderer *pRenderer) {
@@ -390,6 +486,16 @@ void Renderer_reset(Renderer *pRenderer,
                     jint windingRule)
 {
     jint numBuckets;
+    jint dirtyFrom = 0, dirtyTo = 0;
+
+    // addLine only writes to the buckets from sampleRowMin to sampleRowMax
+    // and every other bucket is still clear, so this is all that needs to
+    // be cleared when the buckets are reused. A shape without edges leaves
+    // sampleRowMin >= sampleRowMax.
+    if (this.sampleRowMin < this.sampleRowMax) {
+        dirtyFrom = (this.sampleRowMin - this.boundsMinY) * 2;
+        dirtyTo = (this.sampleRowMax - this.boundsMinY) * 2 + 2;
+    }
 
     this.windingRule = windingRule;
 
@@ -408,12 +514,11 @@ void Renderer_reset(Renderer *pRenderer,
         // The last 2 entries are ignored and only used to store unused
         // values for segments ending on the last line of the bounds
         // so we can avoid having to check the bounds on this array.
+        free(this.edgeBuckets);
         this.edgeBuckets = new_int(numBuckets*2 + 2);
         this.edgeBucketsSIZE = numBuckets*2 + 2;
     } else {
-        // Only need to fill the first numBuckets*2 entries since the
-        // last 2 entries are write-only for overflow avoidance only.
-        Arrays_fill(this.edgeBuckets, 0, numBuckets*2, 0);
+        Arrays_fill(this.edgeBuckets, dirtyFrom, dirtyTo, 0);
     }
     if (this.edges == NULL) {
         this.edges = new_float(SIZEOF_EDGE * 32);
@@ -430,6 +535,22 @@ void Renderer_destroy(Renderer *pRenderer) {
     free(pRenderer->edges);
     pRenderer->edges = NULL;
     pRenderer->edgesSIZE = 0;
+    free(pRenderer->alphaRow);
+    pRenderer->alphaRow = NULL;
+    pRenderer->alphaRowSIZE = 0;
+    if (pRenderer->iterator.crossings != NULL) {
+        ScanlineIterator_destroy(&pRenderer->iterator);
+    }
+}
+
+// Returns the number of bytes held by the arrays which a reset Renderer keeps.
+size_t Renderer_getScratchSize(Renderer *pRenderer) {
+    return pRenderer->edgeBucketsSIZE * sizeof(jint)
+         + pRenderer->edgesSIZE * sizeof(jfloat)
+         + pRenderer->alphaRowSIZE * sizeof(jint)
+         + pRenderer->iterator.crossingsSIZE * sizeof(jint)
+         + pRenderer->iterator.edgePtrsSIZE * sizeof(jint)
+         + pRenderer->iterator.auxSIZE * 2 * sizeof(jint);
 }
 
 static jfloat tosubpixx(jfloat pix_x) {
@@ -513,17 +634,17 @@ void Renderer_produceAlphas(Renderer *pRenderer, AlphaConsumer *pAC) {
     jint bboxx0, bboxx1;
     jint pix_minX, pix_maxX;
     jint y;
-    ScanlineIterator it;
+    ScanlineIterator *pIt = &this.iterator;
 
     // add 2 to better deal with the last pixel in a pixel row.
     jint width = pAC->width;
-    jint savedAlpha[1024];
     jint *alpha;
-    if (1024 < width+2) {
-        alpha = new_int(width+2);
-    } else {
-        alpha = savedAlpha;
+    if (this.alphaRowSIZE < width+2) {
+        free(this.alphaRow);
+        this.alphaRow = new_int(width+2);
+        this.alphaRowSIZE = width+2;
     }
+    alpha = this.alphaRow;
     Arrays_fill(alpha, 0, width+2, 0);
 
     bboxx0 = pAC->originX << SUBPIXEL_LG_POSITIONS_X;
@@ -539,14 +660,19 @@ void Renderer_produceAlphas(Renderer *pRenderer, AlphaConsumer *pAC) {
     pix_minX = bboxx0 >> SUBPIXEL_LG_POSITIONS_Y;
 
     y = this.boundsMinY; // needs to be declared here so we emit the last row properly.
-    ScanlineIterator_init(&it, pRenderer);
-    for ( ; ScanlineIterator_hasNext(&it, pRenderer); ) {
-        jint numCrossings = ScanlineIterator_next(&it, pRenderer);
-        jint *crossings = it.crossings;
+    // The crossing arrays are kept by the Renderer for the next shapes.
+    if (pIt->crossings == NULL) {
+        ScanlineIterator_init(pIt, pRenderer);
+    } else {
+        ScanlineIterator_reset(pIt, pRenderer);
+    }
+    for ( ; ScanlineIterator_hasNext(pIt, pRenderer); ) {
+        jint numCrossings = ScanlineIterator_next(pIt, pRenderer);
+        jint *crossings = pIt->crossings;
         jint sum, prev;
         jint i;
 
-        y = ScanlineIterator_curY(&it);
+        y = ScanlineIterator_curY(pIt);
 
         if (numCrossings > 0) {
             jint lowx = crossings[0] >> 1;
@@ -610,8 +736,6 @@ void Renderer_produceAlphas(Renderer *pRenderer, AlphaConsumer *pAC) {
         setAndClearRelativeAlphas(pAC, alpha, y >> SUBPIXEL_LG_POSITIONS_Y,
                                   pix_minX, pix_maxX);
     }
-    ScanlineIterator_destroy(&it);
-    if (alpha != savedAlpha) free (alpha);
 }
 
 //@Override
@@ -661,11 +785,75 @@ static void setAndClearRelativeAlphas(AlphaConsumer *pAC,
 //    System.out.println("setting row "+(pix_y - y)+
 //                       " out of "+width+" x "+height);
     jint w = pAC->width;
-    jint off = (pix_y - pAC->originY) * w;
+    jint off = (pix_y - pAC->originY) * pAC->stride;
     jbyte *out = pAC->alphas;
     jint a = 0;
-    jint i;
-    for (i = 0; i < w; i++) {
+    jint i = 0;
+    // The vector loops take 8 pixels at a time. alphaRow holds the change
+    // in coverage from one pixel to the next, so each group is prefix
+    // summed in two steps and offset by the coverage carried over from the
+    // previous group. alphaMax is a power of 2, which lets
+    // (a*255 + alphaMax/2) >> lgAlphaMax give exactly alphaMap[a].
+#if defined(RENDERER_SSE2)
+    {
+        __m128i zero = _mm_setzero_si128();
+        __m128i half = _mm_set1_epi32(alphaMax >> 1);
+        __m128i shift = _mm_cvtsi32_si128(lgAlphaMax);
+        __m128i carry = zero;
+        for (; i + 8 <= w; i += 8) {
+            __m128i lo = _mm_loadu_si128((__m128i *) (alphaRow + i));
+            __m128i hi = _mm_loadu_si128((__m128i *) (alphaRow + i + 4));
+            _mm_storeu_si128((__m128i *) (alphaRow + i), zero);
+            _mm_storeu_si128((__m128i *) (alphaRow + i + 4), zero);
+            lo = _mm_add_epi32(lo, _mm_slli_si128(lo, 4));
+            lo = _mm_add_epi32(lo, _mm_slli_si128(lo, 8));
+            lo = _mm_add_epi32(lo, carry);
+            carry = _mm_shuffle_epi32(lo, 0xff);
+            hi = _mm_add_epi32(hi, _mm_slli_si128(hi, 4));
+            hi = _mm_add_epi32(hi, _mm_slli_si128(hi, 8));
+            hi = _mm_add_epi32(hi, carry);
+            carry = _mm_shuffle_epi32(hi, 0xff);
+            lo = _mm_sub_epi32(_mm_slli_epi32(lo, 8), lo);
+            hi = _mm_sub_epi32(_mm_slli_epi32(hi, 8), hi);
+            lo = _mm_srl_epi32(_mm_add_epi32(lo, half), shift);
+            hi = _mm_srl_epi32(_mm_add_epi32(hi, half), shift);
+            _mm_storel_epi64((__m128i *) (out + off + i),
+                             _mm_packus_epi16(_mm_packs_epi32(lo, hi), zero));
+        }
+        a = _mm_cvtsi128_si32(carry);
+    }
+#elif defined(RENDERER_NEON)
+    {
+        int32x4_t zero = vdupq_n_s32(0);
+        int32x4_t half = vdupq_n_s32(alphaMax >> 1);
+        int32x4_t shift = vdupq_n_s32(-lgAlphaMax);
+        int32x4_t carry = zero;
+        for (; i + 8 <= w; i += 8) {
+            int32x4_t lo = vld1q_s32(alphaRow + i);
+            int32x4_t hi = vld1q_s32(alphaRow + i + 4);
+            int16x8_t packed;
+            vst1q_s32(alphaRow + i, zero);
+            vst1q_s32(alphaRow + i + 4, zero);
+            lo = vaddq_s32(lo, vextq_s32(zero, lo, 3));
+            lo = vaddq_s32(lo, vextq_s32(zero, lo, 2));
+            lo = vaddq_s32(lo, carry);
+            carry = vdupq_n_s32(vgetq_lane_s32(lo, 3));
+            hi = vaddq_s32(hi, vextq_s32(zero, hi, 3));
+            hi = vaddq_s32(hi, vextq_s32(zero, hi, 2));
+            hi = vaddq_s32(hi, carry);
+            carry = vdupq_n_s32(vgetq_lane_s32(hi, 3));
+            lo = vsubq_s32(vshlq_n_s32(lo, 8), lo);
+            hi = vsubq_s32(vshlq_n_s32(hi, 8), hi);
+            lo = vshlq_s32(vaddq_s32(lo, half), shift);
+            hi = vshlq_s32(vaddq_s32(hi, half), shift);
+            packed = vcombine_s16(vmovn_s32(lo), vmovn_s32(hi));
+            vst1_u8((uint8_t *) (out + off + i),
+                    vmovn_u16(vreinterpretq_u16_s16(packed)));
+        }
+        a = vgetq_lane_s32(carry, 0);
+    }
+#endif
+    for (; i < w; i++) {
         a += alphaRow[i];
         alphaRow[i] = 0;
         out[off+i] = alphaMap[a];
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2012, 2014, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2012, 2019, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -42,6 +42,11 @@ typedef struct {
     jint edgePtrsSIZE;
     jint edgeCount;
 
+    // scratch space for sorting rows that start many edges
+    jint *auxCrossings;
+    jint *auxEdgePtrs;
+    jint auxSIZE;
+
     // crossing bounds. The bounds are not necessarily tight (the scan line
     // at minY, for example, might have no crossings). The x bounds will
     // be accumulated as crossings are computed.
@@ -82,6 +87,10 @@ typedef struct {
     jint edgeBucketsSIZE;
     jint numEdges;
 
+    // Accumulates the coverage of a pixel row in produceAlphas
+    jint *alphaRow;
+    jint alphaRowSIZE;
+
     // Bounds of the drawing region, at subpixel precision.
     jint boundsMinX, boundsMinY, boundsMaxX, boundsMaxY;
 
@@ -108,6 +117,8 @@ extern void Renderer_reset(Renderer *pRenderer,
 
 extern void Renderer_destroy(Renderer *pRenderer);
 
+extern size_t Renderer_getScratchSize(Renderer *pRenderer);
+
 extern void Renderer_getOutputBounds(Renderer *pRenderer, jint bounds[]);
 
 extern void Renderer_produceAlphas(Renderer *pRenderer, AlphaConsumer *pAC);
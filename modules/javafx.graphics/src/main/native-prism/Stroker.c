@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2012, 2013, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2012, 2019, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -139,7 +139,7 @@ extern void PolyStack_pop(PolyStack *pStack, PathConsumer *io);
     }
      */
 
-extern void Stroker_reset(Stroker *pStroker, jfloat lineWidth,
+extern void Stroker_reset(Stroker *pStroker, PathConsumer *out, jfloat lineWidth,
                           jint capStyle, jint joinStyle, jfloat miterLimit);
 
 void Stroker_init(Stroker *pStroker,
@@ -158,16 +158,21 @@ void Stroker_init(Stroker *pStroker,
                       Stroker_closePath,
                       Stroker_pathDone);
 
-    this.out = out;
-    Stroker_reset(pStroker, lineWidth, capStyle, joinStyle, miterLimit);
     PolyStack_init(&pStroker->reverse);
+    Stroker_reset(pStroker, out, lineWidth, capStyle, joinStyle, miterLimit);
 }
 
-void Stroker_reset(Stroker *pStroker, jfloat lineWidth,
+// Prepares an initialized Stroker for another path, keeping the memory
+// allocated by its PolyStack.
+void Stroker_reset(Stroker *pStroker, PathConsumer *out, jfloat lineWidth,
                    jint capStyle, jint joinStyle, jfloat miterLimit)
 {
     jfloat limit;
 
+    this.out = out;
+    this.reverse.end = 0;
+    this.reverse.numCurves = 0;
+
     this.lineWidth2 = lineWidth / 2;
     this.capStyle = capStyle;
     this.joinStyle = joinStyle;
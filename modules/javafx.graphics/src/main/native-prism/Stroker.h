@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2012, 2013, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2012, 2019, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -102,7 +102,7 @@ typedef struct {
     Curve c;
 } Stroker;
 
-extern void Stroker_reset(Stroker *pStroker, jfloat lineWidth,
+extern void Stroker_reset(Stroker *pStroker, PathConsumer *out, jfloat lineWidth,
                           jint capStyle, jint joinStyle, jfloat miterLimit);
 
 extern void Stroker_init(Stroker *pStroker,
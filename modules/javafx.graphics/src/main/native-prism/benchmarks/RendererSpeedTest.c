@@ -0,0 +1,301 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+// Times Renderer_produceAlphas on synthetic paths that stand in for the
+// shapes Prism fills most: text outlines, maps and charts. From the
+// native-prism directory it builds standalone like so:
+// gcc -o RendererSpeedTest -O2 -I. -I$JAVA_HOME/include -I$JAVA_HOME/include/<os> benchmarks/RendererSpeedTest.c Renderer.c Curve.c Helpers.c -lm
+// Adding -DRENDERER_NO_SIMD builds the scalar coverage code. Both builds
+// must print the same checksums, compare their times to see the gain.
+//
+// Usage: RendererSpeedTest [<iterations>]
+
+#include <jni.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "Renderer.h"
+
+#define WIDTH   1024
+#define HEIGHT  768
+
+typedef enum { MOVE, LINE, QUAD, CUBIC, CLOSE } SegType;
+
+typedef struct {
+    SegType type;
+    jfloat pts[6];
+} Segment;
+
+typedef struct {
+    Segment *segs;
+    jint numSegs;
+    jint capacity;
+    jint windingRule;
+} Path;
+
+typedef struct {
+    const char *name;
+    Path *paths;
+    jint numPaths;
+} Scene;
+
+static uint32_t seed = 1;
+
+static jfloat rnd(jfloat max) {
+    seed = seed * 1103515245 + 12345;
+    return (seed >> 8) / 16777216.0f * max;
+}
+
+static Segment *addSeg(Path *path, SegType type) {
+    if (path->numSegs == path->capacity) {
+        path->capacity = path->capacity ? path->capacity * 2 : 64;
+        path->segs = realloc(path->segs, path->capacity * sizeof(Segment));
+    }
+    path->segs[path->numSegs].type = type;
+    return &path->segs[path->numSegs++];
+}
+
+static void moveTo(Path *path, jfloat x, jfloat y) {
+    Segment *s = addSeg(path, MOVE);
+    s->pts[0] = x; s->pts[1] = y;
+}
+
+static void lineTo(Path *path, jfloat x, jfloat y) {
+    Segment *s = addSeg(path, LINE);
+    s->pts[0] = x; s->pts[1] = y;
+}
+
+static void quadTo(Path *path, jfloat cx, jfloat cy, jfloat x, jfloat y) {
+    Segment *s = addSeg(path, QUAD);
+    s->pts[0] = cx; s->pts[1] = cy; s->pts[2] = x; s->pts[3] = y;
+}
+
+static void closePath(Path *path) {
+    addSeg(path, CLOSE);
+}
+
+// An ellipse of 8 quads, clockwise or not, like the bowls of a glyph.
+static void addBowl(Path *path, jfloat cx, jfloat cy, jfloat rx, jfloat ry,
+                    int clockwise)
+{
+    int i;
+    jfloat k = (jfloat) tan(M_PI / 8);
+    moveTo(path, cx + rx, cy);
+    for (i = 1; i <= 8; i++) {
+        double a0 = (clockwise ? -1 : 1) * (i - 0.5) * M_PI / 4;
+        double a1 = (clockwise ? -1 : 1) * i * M_PI / 4;
+        jfloat c = (jfloat) sqrt(1 + k * k);
+        quadTo(path, cx + rx * c * (jfloat) cos(a0), cy + ry * c * (jfloat) sin(a0),
+               cx + rx * (jfloat) cos(a1), cy + ry * (jfloat) sin(a1));
+    }
+    closePath(path);
+}
+
+// Lines of 14px text, one path per glyph: a curved outline with a counter
+// and a stem, placed on a grid with some jitter.
+static void buildText(Scene *scene) {
+    jint cols = WIDTH / 9, rows = HEIGHT / 18, i;
+    scene->name = "text";
+    scene->numPaths = cols * rows;
+    scene->paths = calloc(scene->numPaths, sizeof(Path));
+    for (i = 0; i < scene->numPaths; i++) {
+        Path *path = &scene->paths[i];
+        jfloat x = (i % cols) * 9 + 1 + rnd(0.5f);
+        jfloat y = (i / cols) * 18 + 4 + rnd(0.5f);
+        jfloat w = 3 + rnd(1.5f), h = 4 + rnd(1.5f);
+        path->windingRule = WIND_NON_ZERO;
+        addBowl(path, x + w, y + h + 3, w, h, 0);
+        addBowl(path, x + w, y + h + 3, w * 0.55f, h * 0.6f, 1);
+        moveTo(path, x + 2 * w - 1.2f, y);
+        lineTo(path, x + 2 * w + 0.2f, y);
+        lineTo(path, x + 2 * w + 0.2f, y + 2 * h + 3);
+        lineTo(path, x + 2 * w - 1.2f, y + 2 * h + 3);
+        closePath(path);
+    }
+}
+
+// Country like polygons with jagged borders of a few thousand points.
+static void buildMap(Scene *scene) {
+    jint i, j;
+    scene->name = "map";
+    scene->numPaths = 24;
+    scene->paths = calloc(scene->numPaths, sizeof(Path));
+    for (i = 0; i < scene->numPaths; i++) {
+        Path *path = &scene->paths[i];
+        jfloat cx = 100 + rnd(WIDTH - 200), cy = 100 + rnd(HEIGHT - 200);
+        jfloat r = 60 + rnd(220);
+        jint n = 1500 + (jint) rnd(2500);
+        path->windingRule = WIND_EVEN_ODD;
+        for (j = 0; j < n; j++) {
+            double a = 2 * M_PI * j / n;
+            jfloat rr = r * (0.7f + 0.3f * (jfloat) sin(a * 7 + i)) + rnd(r * 0.08f);
+            jfloat x = cx + rr * (jfloat) cos(a), y = cy + rr * (jfloat) sin(a);
+            if (j == 0) {
+                moveTo(path, x, y);
+            } else {
+                lineTo(path, x, y);
+            }
+        }
+        closePath(path);
+    }
+}
+
+// Area charts of noisy series, one point per pixel column, so that each
+// row crosses hundreds of edges.
+static void buildChart(Scene *scene) {
+    jint i, x;
+    scene->name = "chart";
+    scene->numPaths = 6;
+    scene->paths = calloc(scene->numPaths, sizeof(Path));
+    for (i = 0; i < scene->numPaths; i++) {
+        Path *path = &scene->paths[i];
+        jfloat base = HEIGHT - 10.0f, level = HEIGHT * (0.3f + 0.1f * i);
+        path->windingRule = WIND_NON_ZERO;
+        moveTo(path, 0, base);
+        for (x = 0; x <= WIDTH; x++) {
+            level += rnd(40) - 20;
+            if (level < 20) level = 20;
+            if (level > base - 20) level = base - 20;
+            lineTo(path, (jfloat) x, level - rnd(HEIGHT * 0.25f));
+        }
+        lineTo(path, WIDTH, base);
+        closePath(path);
+    }
+}
+
+static void feedPath(PathConsumer *out, const Path *path) {
+    jint i;
+    for (i = 0; i < path->numSegs; i++) {
+        const Segment *s = &path->segs[i];
+        switch (s->type) {
+            case MOVE:
+                out->moveTo(out, s->pts[0], s->pts[1]);
+                break;
+            case LINE:
+                out->lineTo(out, s->pts[0], s->pts[1]);
+                break;
+            case QUAD:
+                out->quadTo(out, s->pts[0], s->pts[1], s->pts[2], s->pts[3]);
+                break;
+            case CUBIC:
+                out->curveTo(out, s->pts[0], s->pts[1], s->pts[2], s->pts[3],
+                             s->pts[4], s->pts[5]);
+                break;
+            case CLOSE:
+                out->closePath(out);
+                break;
+        }
+    }
+    out->pathDone(out);
+}
+
+// Fills every path of the scene into its own mask, as the
+// NativePiscesRasterizer entry points do. Returns a checksum of the masks
+// when asked to.
+static uint64_t renderScene(Renderer *pRenderer, const Scene *scene,
+                            jbyte *mask, jboolean checksum)
+{
+    uint64_t hash = 1469598103934665603ULL;
+    jint i, j;
+    for (i = 0; i < scene->numPaths; i++) {
+        jint bounds[4];
+        Renderer_reset(pRenderer, 0, 0, WIDTH, HEIGHT,
+                       scene->paths[i].windingRule);
+        feedPath(&pRenderer->consumer, &scene->paths[i]);
+        Renderer_getOutputBounds(pRenderer, bounds);
+        if (bounds[0] < bounds[2] && bounds[1] < bounds[3]) {
+            AlphaConsumer ac;
+            ac.originX = bounds[0];
+            ac.originY = bounds[1];
+            ac.width = bounds[2] - bounds[0];
+            ac.height = bounds[3] - bounds[1];
+            ac.alphas = mask;
+            ac.stride = ac.width;
+            Renderer_produceAlphas(pRenderer, &ac);
+            for (j = 0; checksum && j < ac.width * ac.height; j++) {
+                hash = (hash ^ (uint8_t) mask[j]) * 1099511628211ULL;
+            }
+        }
+    }
+    return hash;
+}
+
+static double now() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+int main(int argc, char **argv) {
+    jint iterations = 50;
+    Scene scenes[3];
+    Renderer renderer;
+    jbyte *mask = malloc(WIDTH * HEIGHT);
+    int i, aa, s;
+
+    if (argc > 2 || (argc == 2 && (iterations = atoi(argv[1])) <= 0)) {
+        printf("Usage: RendererSpeedTest [<iterations>]\n");
+        return 1;
+    }
+
+    buildText(&scenes[0]);
+    buildMap(&scenes[1]);
+    buildChart(&scenes[2]);
+
+#if defined(RENDERER_NO_SIMD)
+    printf("scalar coverage, %d iterations\n", iterations);
+#else
+    printf("vector coverage, %d iterations\n", iterations);
+#endif
+    Renderer_init(&renderer);
+    for (aa = 1; aa >= 0; aa--) {
+        // The subpixel grids used by NativePiscesRasterizer.
+        Renderer_setup(aa ? 3 : 0, aa ? 3 : 0);
+        for (s = 0; s < 3; s++) {
+            uint64_t hash = renderScene(&renderer, &scenes[s], mask, JNI_TRUE);
+            double total = 0, best = 0;
+            for (i = 0; i < iterations; i++) {
+                double start = now(), elapsed;
+                renderScene(&renderer, &scenes[s], mask, JNI_FALSE);
+                elapsed = now() - start;
+                total += elapsed;
+                if (i == 0 || elapsed < best) {
+                    best = elapsed;
+                }
+            }
+            printf("%-6s %-5s %5d paths %8.3f ms/frame, best %8.3f ms  checksum %016llx\n",
+                   aa ? "aa" : "non-aa", scenes[s].name, scenes[s].numPaths,
+                   total * 1000 / iterations, best * 1000,
+                   (unsigned long long) hash);
+        }
+    }
+    Renderer_destroy(&renderer);
+    free(mask);
+    return 0;
+}
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2015, 2019, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -53,4 +53,15 @@ public class NativePiscesRasterizerShim {
                 bounds, mask);
     }
 
+    public static int produceFillAlphasBatch(float coords[], byte commands[],
+                                             int shapes[], int nshapes,
+                                             double transforms[], int bounds[],
+                                             byte atlas[], int atlasWidth, int atlasHeight) {
+        return NativePiscesRasterizer.produceFillAlphasBatch(
+                coords, commands,
+                shapes, nshapes,
+                transforms, bounds,
+                atlas, atlasWidth, atlasHeight);
+    }
+
 }
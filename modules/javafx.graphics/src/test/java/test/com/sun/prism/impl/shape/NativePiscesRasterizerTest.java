@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2012, 2015, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2012, 2019, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -25,10 +25,21 @@
 
 package test.com.sun.prism.impl.shape;
 
+import com.sun.javafx.geom.Ellipse2D;
+import com.sun.javafx.geom.Path2D;
 import com.sun.javafx.geom.PathIterator;
+import com.sun.javafx.geom.RoundRectangle2D;
+import com.sun.javafx.geom.Shape;
+import com.sun.javafx.geom.transform.BaseTransform;
 import com.sun.prism.BasicStroke;
+import com.sun.prism.impl.shape.MaskData;
+import com.sun.prism.impl.shape.NativePiscesRasterizer;
 import com.sun.prism.impl.shape.NativePiscesRasterizerShim;
+import java.nio.ByteBuffer;
 import org.junit.Test;
+import static org.junit.Assert.assertArrayEquals;
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertTrue;
 
 public class NativePiscesRasterizerTest {
     static final int JOIN_BEVEL = BasicStroke.JOIN_BEVEL;
@@ -56,6 +67,14 @@ public class NativePiscesRasterizerTest {
     static final byte movecubic_arr[] = { SEG_MOVETO, SEG_CUBICTO };
     static final int bounds10[] = { 0, 0, 10, 10 };
     static final byte mask1k[] = new byte[1024];
+    static final int moveshape_arr[] = { 2, 1, 1 };
+    static final double identity_arr[] = { 1, 0, 0, 0, 1, 0 };
+    static final byte atlas10x10[] = new byte[100];
+
+    // The batch native writes the mask bounds back, so each test gets its own
+    static int[] batchBounds10() {
+        return new int[] { 0, 0, 10, 10, 0, 0 };
+    }
 
     @Test(expected=java.lang.NullPointerException.class)
     public void FillNullCoords() {
@@ -259,4 +278,238 @@ public class NativePiscesRasterizerTest {
                                                    1, 0, 0, 0, 1, 0,
                                                    bounds10, mask1k);
     }
+
+    @Test(expected=java.lang.NullPointerException.class)
+    public void BatchNullCoords() {
+        NativePiscesRasterizerShim.produceFillAlphasBatch(null, move_arr,
+                                                      moveshape_arr, 1,
+                                                      identity_arr, batchBounds10(),
+                                                      atlas10x10, 10, 10);
+    }
+
+    @Test(expected=java.lang.NullPointerException.class)
+    public void BatchNullCommands() {
+        NativePiscesRasterizerShim.produceFillAlphasBatch(coords6, null,
+                                                      moveshape_arr, 1,
+                                                      identity_arr, batchBounds10(),
+                                                      atlas10x10, 10, 10);
+    }
+
+    @Test(expected=java.lang.NullPointerException.class)
+    public void BatchNullShapes() {
+        NativePiscesRasterizerShim.produceFillAlphasBatch(coords6, move_arr,
+                                                      null, 1,
+                                                      identity_arr, batchBounds10(),
+                                                      atlas10x10, 10, 10);
+    }
+
+    @Test(expected=java.lang.NullPointerException.class)
+    public void BatchNullTransforms() {
+        NativePiscesRasterizerShim.produceFillAlphasBatch(coords6, move_arr,
+                                                      moveshape_arr, 1,
+                                                      null, batchBounds10(),
+                                                      atlas10x10, 10, 10);
+    }
+
+    @Test(expected=java.lang.NullPointerException.class)
+    public void BatchNullBounds() {
+        NativePiscesRasterizerShim.produceFillAlphasBatch(coords6, move_arr,
+                                                      moveshape_arr, 1,
+                                                      identity_arr, null,
+                                                      atlas10x10, 10, 10);
+    }
+
+    @Test(expected=java.lang.NullPointerException.class)
+    public void BatchNullAtlas() {
+        NativePiscesRasterizerShim.produceFillAlphasBatch(coords6, move_arr,
+                                                      moveshape_arr, 1,
+                                                      identity_arr, batchBounds10(),
+                                                      null, 10, 10);
+    }
+
+    @Test(expected=java.lang.ArrayIndexOutOfBoundsException.class)
+    public void BatchNegativeCount() {
+        NativePiscesRasterizerShim.produceFillAlphasBatch(coords6, move_arr,
+                                                      moveshape_arr, -1,
+                                                      identity_arr, batchBounds10(),
+                                                      atlas10x10, 10, 10);
+    }
+
+    @Test(expected=java.lang.ArrayIndexOutOfBoundsException.class)
+    public void BatchShortShapes() {
+        NativePiscesRasterizerShim.produceFillAlphasBatch(coords6, move_arr,
+                                                      new int[] { 2, 1 }, 1,
+                                                      identity_arr, batchBounds10(),
+                                                      atlas10x10, 10, 10);
+    }
+
+    @Test(expected=java.lang.ArrayIndexOutOfBoundsException.class)
+    public void BatchShortTransforms() {
+        NativePiscesRasterizerShim.produceFillAlphasBatch(coords6, move_arr,
+                                                      moveshape_arr, 1,
+                                                      new double[5], batchBounds10(),
+                                                      atlas10x10, 10, 10);
+    }
+
+    @Test(expected=java.lang.ArrayIndexOutOfBoundsException.class)
+    public void BatchShortBounds() {
+        NativePiscesRasterizerShim.produceFillAlphasBatch(coords6, move_arr,
+                                                      moveshape_arr, 1,
+                                                      identity_arr, new int[5],
+                                                      atlas10x10, 10, 10);
+    }
+
+    @Test(expected=java.lang.ArrayIndexOutOfBoundsException.class)
+    public void BatchShortAtlas() {
+        NativePiscesRasterizerShim.produceFillAlphasBatch(coords6, move_arr,
+                                                      moveshape_arr, 1,
+                                                      identity_arr, batchBounds10(),
+                                                      new byte[99], 10, 10);
+    }
+
+    @Test(expected=java.lang.ArrayIndexOutOfBoundsException.class)
+    public void BatchShortCommands() {
+        NativePiscesRasterizerShim.produceFillAlphasBatch(coords6, move_arr,
+                                                      new int[] { 2, 2, 1 }, 1,
+                                                      identity_arr, batchBounds10(),
+                                                      atlas10x10, 10, 10);
+    }
+
+    @Test(expected=java.lang.ArrayIndexOutOfBoundsException.class)
+    public void BatchShortCoords() {
+        NativePiscesRasterizerShim.produceFillAlphasBatch(coords6, move_arr,
+                                                      new int[] { 7, 1, 1 }, 1,
+                                                      identity_arr, batchBounds10(),
+                                                      atlas10x10, 10, 10);
+    }
+
+    @Test(expected=java.lang.ArrayIndexOutOfBoundsException.class)
+    public void BatchShortMoveCoords() {
+        NativePiscesRasterizerShim.produceFillAlphasBatch(coords1, move_arr,
+                                                      new int[] { 1, 1, 1 }, 1,
+                                                      identity_arr, batchBounds10(),
+                                                      atlas10x10, 10, 10);
+    }
+
+    @Test
+    public void BatchBadCommands() {
+        byte badcmd_arr[] = new byte[2];
+        badcmd_arr[0] = SEG_MOVETO;
+        for (int i = 0; i < 256; i++) {
+            switch (i) {
+                case SEG_MOVETO:
+                case SEG_LINETO:
+                case SEG_QUADTO:
+                case SEG_CUBICTO:
+                case SEG_CLOSE:
+                    continue;
+                default:
+                    badcmd_arr[1] = (byte) i;
+                    try {
+                        NativePiscesRasterizerShim.produceFillAlphasBatch(coords6, badcmd_arr,
+                                                                      new int[] { 6, 2, 1 }, 1,
+                                                                      identity_arr, batchBounds10(),
+                                                                      atlas10x10, 10, 10);
+                        throw new RuntimeException("allowed bad command: "+i);
+                    } catch (InternalError e) {
+                    }
+                    break;
+            }
+        }
+    }
+
+    @Test
+    public void BatchMatchesSingleShapeMasks() {
+        Path2D triangle = new Path2D();
+        triangle.moveTo(0, 0);
+        triangle.lineTo(17, 3);
+        triangle.lineTo(5, 11);
+        triangle.closePath();
+        Shape shapes[] = {
+            new Ellipse2D(0, 0, 13, 9),
+            new RoundRectangle2D(2.5f, 1.25f, 20, 12, 6, 6),
+            triangle,
+            new Ellipse2D(3, 4, 30, 30),
+        };
+        BaseTransform xforms[] = {
+            BaseTransform.IDENTITY_TRANSFORM,
+            BaseTransform.getTranslateInstance(10.5, 20.25),
+            BaseTransform.getRotateInstance(0.3, 5, 5),
+            BaseTransform.getScaleInstance(0.75, 1.5),
+        };
+        for (boolean aa : new boolean[] { true, false }) {
+            NativePiscesRasterizer batch = new NativePiscesRasterizer();
+            NativePiscesRasterizer single = new NativePiscesRasterizer();
+            int atlasWidth = 128, atlasHeight = 128;
+            byte atlas[] = new byte[atlasWidth * atlasHeight];
+            int maskBounds[] = new int[6 * shapes.length];
+            int count = batch.getFillMasks(shapes, xforms, 0, shapes.length, aa,
+                                           atlas, atlasWidth, atlasHeight, maskBounds);
+            assertEquals(shapes.length, count);
+
+            for (int i = 0; i < count; i++) {
+                MaskData data = single.getMaskData(shapes[i], null, null,
+                                                   xforms[i], true, aa);
+                int x = maskBounds[6 * i], y = maskBounds[6 * i + 1];
+                int w = maskBounds[6 * i + 2] - x, h = maskBounds[6 * i + 3] - y;
+                assertTrue(w > 0 && h > 0);
+                assertEquals(data.getOriginX(), x);
+                assertEquals(data.getOriginY(), y);
+                assertEquals(data.getWidth(), w);
+                assertEquals(data.getHeight(), h);
+
+                ByteBuffer expected = data.getMaskBuffer();
+                int ax = maskBounds[6 * i + 4], ay = maskBounds[6 * i + 5];
+                for (int row = 0; row < h; row++) {
+                    byte expectedRow[] = new byte[w];
+                    byte actualRow[] = new byte[w];
+                    for (int col = 0; col < w; col++) {
+                        expectedRow[col] = expected.get(row * w + col);
+                    }
+                    System.arraycopy(atlas, (ay + row) * atlasWidth + ax,
+                                     actualRow, 0, w);
+                    assertArrayEquals("shape " + i + " row " + row + " aa " + aa,
+                                      expectedRow, actualRow);
+                }
+            }
+        }
+    }
+
+    @Test
+    public void BatchAtlasFull() {
+        Shape shapes[] = {
+            new Ellipse2D(0, 0, 8, 8),
+            new Ellipse2D(0, 0, 8, 8),
+            new Ellipse2D(0, 0, 8, 8),
+        };
+        BaseTransform xforms[] = new BaseTransform[shapes.length];
+        NativePiscesRasterizer rasterizer = new NativePiscesRasterizer();
+        int maskBounds[] = new int[6 * shapes.length];
+
+        // Only one 8x8 mask fits in a 10x10 atlas
+        assertEquals(1, rasterizer.getFillMasks(shapes, xforms, 0, 3, true,
+                                                new byte[100], 10, 10, maskBounds));
+        assertEquals(0, maskBounds[4]);
+        assertEquals(0, maskBounds[5]);
+        // The caller flushes the atlas and continues with the rest
+        assertEquals(1, rasterizer.getFillMasks(shapes, xforms, 1, 2, true,
+                                                new byte[100], 10, 10, maskBounds));
+
+        // Two shelves of a 16x16 atlas hold all three
+        assertEquals(3, rasterizer.getFillMasks(shapes, xforms, 0, 3, true,
+                                                new byte[256], 16, 16, maskBounds));
+        assertArrayEquals(new int[] { 0, 0, 8, 0, 0, 8 },
+                          new int[] { maskBounds[4], maskBounds[5],
+                                      maskBounds[10], maskBounds[11],
+                                      maskBounds[16], maskBounds[17] });
+    }
+
+    @Test
+    public void BatchFirstMaskLargerThanAtlas() {
+        Shape shapes[] = { new Ellipse2D(0, 0, 20, 20) };
+        BaseTransform xforms[] = { BaseTransform.IDENTITY_TRANSFORM };
+        NativePiscesRasterizer rasterizer = new NativePiscesRasterizer();
+        assertEquals(0, rasterizer.getFillMasks(shapes, xforms, 0, 1, true,
+                                                new byte[100], 10, 10, new int[6]));
+    }
 }
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2010, 2016, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2010, 2019, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -25,18 +25,32 @@
 package com.sun.media.jfxmedia.locator;
 
 import com.sun.media.jfxmedia.MediaError;
+import com.sun.media.jfxmedia.logging.Logger;
 import com.sun.media.jfxmediaimpl.MediaUtils;
 import java.io.BufferedReader;
+import java.io.ByteArrayInputStream;
 import java.io.IOException;
+import java.io.InputStream;
 import java.io.InputStreamReader;
 import java.net.*;
 import java.nio.channels.Channels;
 import java.nio.channels.ReadableByteChannel;
 import java.nio.charset.Charset;
+import java.security.AccessController;
+import java.security.PrivilegedAction;
 import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.Iterator;
+import java.util.LinkedHashMap;
 import java.util.List;
+import java.util.Map;
 import java.util.concurrent.BlockingQueue;
+import java.util.concurrent.CancellationException;
 import java.util.concurrent.CountDownLatch;
+import java.util.concurrent.ExecutionException;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.Future;
 import java.util.concurrent.LinkedBlockingQueue;
 import java.util.concurrent.Semaphore;
 
@@ -52,14 +66,29 @@ final class HLSConnectionHolder extends ConnectionHolder {
     private boolean isPlaylistClosed = false;
     private boolean isBitrateAdjustable = false;
     private long startTime = -1;
+    private int segmentLength = -1;
+    private long segmentDownloadTime = -1; // -1 if the segment is read from the network
+    private final SegmentPrefetcher prefetcher = LOOKAHEAD > 0 ? new SegmentPrefetcher(LOOKAHEAD) : null;
     private static final long HLS_VALUE_FLOAT_MULTIPLIER = 1000;
     private static final int HLS_PROP_GET_DURATION = 1;
     private static final int HLS_PROP_GET_HLS_MODE = 2;
     private static final int HLS_PROP_GET_MIMETYPE = 3;
+    private static final int HLS_PROP_GET_LOOKAHEAD = 4;
     private static final int HLS_VALUE_MIMETYPE_MP2T = 1;
     private static final int HLS_VALUE_MIMETYPE_MP3 = 2;
     private static final String CHARSET_UTF_8 = "UTF-8";
     private static final String CHARSET_US_ASCII = "US-ASCII";
+    private static final int DEFAULT_LOOKAHEAD = 2;
+    private static final int MAX_LOOKAHEAD = 8;
+    private static final int LOOKAHEAD;
+
+    static {
+        LOOKAHEAD = AccessController.doPrivileged((PrivilegedAction<Integer>) () -> {
+            // Number of segments downloaded ahead of playback, e.g., -Djfxmedia.hls.lookahead=4, 0 disables prefetching
+            int lookahead = Integer.getInteger("jfxmedia.hls.lookahead", DEFAULT_LOOKAHEAD);
+            return Math.max(0, Math.min(lookahead, MAX_LOOKAHEAD));
+        });
+    }
 
     HLSConnectionHolder(URI uri) throws IOException {
         playlistThread.setPlaylistURI(uri);
@@ -81,6 +110,10 @@ final class HLSConnectionHolder extends ConnectionHolder {
         if (isBitrateAdjustable && read == -1) {
             long readTime = System.currentTimeMillis() - startTime;
             startTime = -1;
+            // A prefetched segment is read from memory, its download time tells the bandwidth
+            if (segmentDownloadTime >= 0) {
+                readTime = segmentDownloadTime;
+            }
             adjustBitrate(readTime);
         }
 
@@ -116,6 +149,9 @@ final class HLSConnectionHolder extends ConnectionHolder {
     @Override
     public void closeConnection() {
         currentPlaylist.close();
+        if (prefetcher != null) {
+            prefetcher.close();
+        }
         super.closeConnection();
         resetConnection();
         playlistThread.putState(PlaylistThread.STATE_EXIT);
@@ -135,6 +171,8 @@ final class HLSConnectionHolder extends ConnectionHolder {
             return 1;
         } else if (prop == HLS_PROP_GET_MIMETYPE) {
             return currentPlaylist.getMimeType();
+        } else if (prop == HLS_PROP_GET_LOOKAHEAD) {
+            return LOOKAHEAD;
         }
 
         return -1;
@@ -169,18 +207,33 @@ final class HLSConnectionHolder extends ConnectionHolder {
             return -1;
         }
 
-        try {
-            URI uri = new URI(mediaFile);
-            urlConnection = uri.toURL().openConnection();
-            channel = openChannel();
-        } catch (Exception e) {
-            return -1;
+        Segment segment = null;
+        if (prefetcher != null) {
+            segment = prefetcher.take(mediaFile);
+            // Keep the next segments downloading while this one plays
+            prefetcher.prefetch(currentPlaylist.getUpcomingMediaFiles(LOOKAHEAD));
+        }
+
+        if (segment != null) {
+            channel = Channels.newChannel(new ByteArrayInputStream(segment.data));
+            segmentLength = segment.data.length;
+            segmentDownloadTime = segment.downloadTime;
+        } else {
+            try {
+                URI uri = new URI(mediaFile);
+                urlConnection = uri.toURL().openConnection();
+                channel = openChannel();
+            } catch (Exception e) {
+                return -1;
+            }
+            segmentLength = urlConnection.getContentLength();
+            segmentDownloadTime = -1;
         }
 
         if (currentPlaylist.isCurrentMediaFileDiscontinuity()) {
-            return (-1 * urlConnection.getContentLength());
+            return (-1 * segmentLength);
         } else {
-            return urlConnection.getContentLength();
+            return segmentLength;
         }
     }
 
@@ -189,7 +242,7 @@ final class HLSConnectionHolder extends ConnectionHolder {
     }
 
     private void adjustBitrate(long readTime) {
-        int avgBitrate = (int)(((long) urlConnection.getContentLength() * 8 * 1000) / readTime);
+        int avgBitrate = (int)(((long) segmentLength * 8 * 1000) / Math.max(readTime, 1));
 
         Playlist playlist = variantPlaylist.getPlaylistBasedOnBitrate(avgBitrate);
         if (playlist != null && playlist != currentPlaylist) {
@@ -211,6 +264,131 @@ final class HLSConnectionHolder extends ConnectionHolder {
         return mediaFile;
     }
 
+    private static final class Segment {
+
+        private final byte[] data;
+        private final long downloadTime;
+
+        private Segment(byte[] data, long downloadTime) {
+            this.data = data;
+            this.downloadTime = downloadTime;
+        }
+    }
+
+    /**
+     * Downloads the segments coming up next in parallel, so that the request
+     * latency is not paid again at every segment boundary. Segments are held
+     * in memory until loadNextSegment() takes them.
+     */
+    private static final class SegmentPrefetcher {
+
+        private final ExecutorService executor;
+        private final Map<String, Future<Segment>> pending = new LinkedHashMap<String, Future<Segment>>();
+        private int hits = 0;
+        private int misses = 0;
+        private long waitTime = 0;
+        private long prefetchedBytes = 0;
+
+        private SegmentPrefetcher(int lookahead) {
+            executor = Executors.newFixedThreadPool(lookahead, (Runnable r) -> {
+                Thread thread = new Thread(r, "JFXMedia HLS Prefetch Thread");
+                thread.setDaemon(true);
+                return thread;
+            });
+        }
+
+        // Starts downloading the media files not requested yet and drops the
+        // ones which are no longer coming up, e.g., after a seek or a switch
+        // to another variant.
+        private synchronized void prefetch(List<String> mediaFiles) {
+            if (executor.isShutdown()) {
+                return;
+            }
+
+            Iterator<Map.Entry<String, Future<Segment>>> iterator = pending.entrySet().iterator();
+            while (iterator.hasNext()) {
+                Map.Entry<String, Future<Segment>> entry = iterator.next();
+                if (!mediaFiles.contains(entry.getKey())) {
+                    entry.getValue().cancel(true);
+                    iterator.remove();
+                }
+            }
+
+            for (String mediaFile : mediaFiles) {
+                if (!pending.containsKey(mediaFile)) {
+                    pending.put(mediaFile, executor.submit(() -> download(mediaFile)));
+                }
+            }
+        }
+
+        // Returns the prefetched media file, waiting for its download to
+        // complete, or null if it was not prefetched or its download failed.
+        private Segment take(String mediaFile) {
+            Future<Segment> future;
+            synchronized (this) {
+                future = pending.remove(mediaFile);
+            }
+
+            Segment segment = null;
+            long start = System.currentTimeMillis();
+            if (future != null) {
+                try {
+                    segment = future.get();
+                } catch (InterruptedException e) {
+                    Thread.currentThread().interrupt();
+                } catch (ExecutionException | CancellationException e) {
+                }
+            }
+
+            synchronized (this) {
+                if (segment != null) {
+                    hits++;
+                    waitTime += System.currentTimeMillis() - start;
+                    prefetchedBytes += segment.data.length;
+                } else {
+                    misses++;
+                }
+            }
+
+            return segment;
+        }
+
+        private synchronized void close() {
+            for (Future<Segment> future : pending.values()) {
+                future.cancel(true);
+            }
+            pending.clear();
+            executor.shutdownNow();
+
+            if (Logger.canLog(Logger.DEBUG)) {
+                Logger.logMsg(Logger.DEBUG, "HLSConnectionHolder", "close",
+                        "Prefetched segments: " + hits + ", missed: " + misses
+                        + ", bytes: " + prefetchedBytes + ", wait time: " + waitTime + " ms");
+            }
+        }
+
+        private static Segment download(String mediaFile) throws IOException, URISyntaxException {
+            long start = System.currentTimeMillis();
+            URLConnection connection = new URI(mediaFile).toURL().openConnection();
+            try (InputStream stream = connection.getInputStream()) {
+                byte[] data;
+                int length = connection.getContentLength();
+                if (length > 0) {
+                    data = new byte[length];
+                    int read = stream.readNBytes(data, 0, length);
+                    if (read < length) {
+                        data = Arrays.copyOf(data, read);
+                    }
+                } else {
+                    data = stream.readAllBytes();
+                }
+                return new Segment(data, System.currentTimeMillis() - start);
+            } finally {
+                Locator.closeConnection(connection);
+            }
+        }
+    }
+
     private class PlaylistThread extends Thread {
 
         public static final int STATE_INIT = 0;
@@ -794,6 +972,22 @@ final class HLSConnectionHolder extends ConnectionHolder {
             }
         }
 
+        // Returns up to count media files following the current one, without
+        // waiting for a live playlist to grow.
+        private List<String> getUpcomingMediaFiles(int count) {
+            List<String> upcoming = new ArrayList<String>(count);
+            synchronized (lock) {
+                for (int i = mediaFileIndex + 1; i < mediaFiles.size() && upcoming.size() < count; i++) {
+                    if (baseURI != null) {
+                        upcoming.add(baseURI + mediaFiles.get(i));
+                    } else {
+                        upcoming.add(mediaFiles.get(i));
+                    }
+                }
+            }
+            return upcoming;
+        }
+
         private double getDuration() {
             return duration;
         }
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2010, 2014, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2010, 2019, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -37,6 +37,10 @@ final class NativeVideoBuffer implements VideoDataBuffer {
     private long nativePeer;
     private final AtomicInteger holdCount;
     private NativeVideoBuffer cachedBGRARep;
+    // The planes and strides of a frame never change, so they are fetched
+    // once. Renderers upload the planes directly on every texture update.
+    private ByteBuffer[] cachedPlaneBuffers;
+    private int[] cachedPlaneStrides;
 
     private static native void nativeDisposeBuffer(long handle);
 
@@ -89,6 +93,9 @@ final class NativeVideoBuffer implements VideoDataBuffer {
                     cachedBGRARep = null;
                 }
 
+                cachedPlaneBuffers = null;
+                cachedPlaneStrides = null;
+
                 // last reference released, dispose and clear our native handle
                 MediaDisposer.removeResourceDisposer((Long)nativePeer);
                 nativeDisposeBuffer(nativePeer);
@@ -112,11 +119,27 @@ final class NativeVideoBuffer implements VideoDataBuffer {
     @Override
     public ByteBuffer getBufferForPlane(int plane) {
         if (0 != nativePeer) {
-            ByteBuffer buffer = nativeGetBufferForPlane(nativePeer, plane);
-            // NewDirectByteBuffer sets BIG_ENDIAN to be consistent with ByteBuffer
-            // So we need to force native order
-            buffer.order(java.nio.ByteOrder.nativeOrder());
-            return buffer;
+            ByteBuffer[] buffers = cachedPlaneBuffers;
+            if (null == buffers) {
+                buffers = new ByteBuffer[Math.max(nativeGetPlaneCount(nativePeer), 1)];
+                cachedPlaneBuffers = buffers;
+            }
+            if (plane < 0 || plane >= buffers.length) {
+                return nativeGetBufferForPlane(nativePeer, plane);
+            }
+
+            ByteBuffer buffer = buffers[plane];
+            if (null == buffer) {
+                buffer = nativeGetBufferForPlane(nativePeer, plane);
+                if (null == buffer) {
+                    return null;
+                }
+                buffers[plane] = buffer;
+            }
+            // Hand out a view so callers can move its position freely.
+            // NewDirectByteBuffer and duplicate() set BIG_ENDIAN to be
+            // consistent with ByteBuffer, so we need to force native order
+            return buffer.duplicate().order(java.nio.ByteOrder.nativeOrder());
         } else if (DEBUG_DISPOSED_BUFFERS) {
             throw new NullPointerException("method called on disposed NativeVideoBuffer");
         }
@@ -197,7 +220,7 @@ final class NativeVideoBuffer implements VideoDataBuffer {
     @Override
     public int getStrideForPlane(int planeIndex) {
         if (0 != nativePeer) {
-            int[] strides = nativeGetPlaneStrides(nativePeer);
+            int[] strides = getCachedPlaneStrides();
             return strides[planeIndex];
         } else if (DEBUG_DISPOSED_BUFFERS) {
             throw new NullPointerException("method called on disposed NativeVideoBuffer");
@@ -208,13 +231,23 @@ final class NativeVideoBuffer implements VideoDataBuffer {
     @Override
     public int[] getPlaneStrides() {
         if (0 != nativePeer) {
-            return nativeGetPlaneStrides(nativePeer);
+            int[] strides = getCachedPlaneStrides();
+            return null == strides ? null : strides.clone();
         } else if (DEBUG_DISPOSED_BUFFERS) {
             throw new NullPointerException("method called on disposed NativeVideoBuffer");
         }
         return null;
     }
 
+    private int[] getCachedPlaneStrides() {
+        int[] strides = cachedPlaneStrides;
+        if (null == strides) {
+            strides = nativeGetPlaneStrides(nativePeer);
+            cachedPlaneStrides = strides;
+        }
+        return strides;
+    }
+
     @Override
     public VideoDataBuffer convertToFormat(VideoFormat newFormat) {
         if (0 != nativePeer) {
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2010, 2018, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2010, 2019, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -66,6 +66,14 @@ static GstStaticPadTemplate source_template =
 //#define DEBUG_OUTPUT
 //#define VERBOSE_DEBUG
 
+enum
+{
+    PROP_0,
+    PROP_THREAD_COUNT,
+    PROP_STATS_INTERVAL,
+    PROP_STATS
+};
+
 /***********************************************************************************
  * Substitution for
  * G_DEFINE_TYPE(VideoDecoder, videodecoder, BaseDecoder, TYPE_BASEDECODER);
@@ -106,13 +114,20 @@ static GstStateChangeReturn videodecoder_change_state(GstElement* element, GstSt
 static gboolean             videodecoder_sink_event(GstPad *pad, GstObject *parent, GstEvent *event);
 static GstFlowReturn        videodecoder_chain(GstPad *pad, GstObject *parent, GstBuffer *buf);
 
+static void                 videodecoder_set_property(GObject *object, guint property_id, const GValue *value, GParamSpec *pspec);
+static void                 videodecoder_get_property(GObject *object, guint property_id, GValue *value, GParamSpec *pspec);
+
 static void                 videodecoder_init_state(VideoDecoder *decoder);
 static void                 videodecoder_state_reset(VideoDecoder *decoder);
+static void                 videodecoder_stats_reset(VideoDecoder *decoder);
+static void                 videodecoder_init_context(BaseDecoder *base);
+static void                 videodecoder_drain(VideoDecoder *decoder);
 
 static gboolean videodecoder_configure(VideoDecoder *decoder, GstCaps *sink_caps);
 
 static void videodecoder_class_init(VideoDecoderClass *klass)
 {
+    GObjectClass *gobject_class = G_OBJECT_CLASS(klass);
     GstElementClass *element_class = GST_ELEMENT_CLASS(klass);
 
     gst_element_class_set_metadata(element_class,
@@ -127,6 +142,35 @@ static void videodecoder_class_init(VideoDecoderClass *klass)
             gst_static_pad_template_get(&sink_template));
 
     element_class->change_state = videodecoder_change_state;
+    BASEDECODER_CLASS(klass)->init_context = videodecoder_init_context;
+
+    gobject_class->set_property = videodecoder_set_property;
+    gobject_class->get_property = videodecoder_get_property;
+
+    g_object_class_install_property (gobject_class, PROP_THREAD_COUNT,
+                                     g_param_spec_int ("thread-count",
+                                                       "Thread count",
+                                                       "Number of decoding threads, 0 for one per core. Applies when the decoder is opened.",
+                                                       0  /* minimum value */,
+                                                       64 /* maximum value */,
+                                                       0  /* default value */,
+                                                       G_PARAM_READWRITE));
+
+    g_object_class_install_property (gobject_class, PROP_STATS_INTERVAL,
+                                     g_param_spec_uint ("stats-interval",
+                                                        "Statistics interval",
+                                                        "Interval in milliseconds between " AV_VIDEO_DECODER_STATS_MESSAGE " element messages, 0 to post none.",
+                                                        0  /* minimum value */,
+                                                        G_MAXUINT /* maximum value */,
+                                                        0  /* default value */,
+                                                        G_PARAM_READWRITE));
+
+    g_object_class_install_property (gobject_class, PROP_STATS,
+                                     g_param_spec_boxed ("stats",
+                                                         "Statistics",
+                                                         "Decode statistics since the element went to PAUSED.",
+                                                         GST_TYPE_STRUCTURE,
+                                                         G_PARAM_READABLE));
 }
 
 static void videodecoder_init(VideoDecoder *decoder)
@@ -143,6 +187,137 @@ static void videodecoder_init(VideoDecoder *decoder)
     base->srcpad = gst_pad_new_from_static_template(&source_template, "src");
     gst_pad_use_fixed_caps(base->srcpad);
     gst_element_add_pad(GST_ELEMENT(decoder), base->srcpad);
+
+    decoder->thread_count = 0;
+    decoder->stats_interval = 0;
+    videodecoder_stats_reset(decoder);
+}
+
+/***********************************************************************************
+ * Properties and statistics
+ ***********************************************************************************/
+static void videodecoder_set_property(GObject *object, guint property_id, const GValue *value, GParamSpec *pspec)
+{
+    VideoDecoder *decoder = VIDEODECODER(object);
+
+    switch (property_id)
+    {
+        case PROP_THREAD_COUNT:
+            decoder->thread_count = g_value_get_int(value);
+            break;
+        case PROP_STATS_INTERVAL:
+            decoder->stats_interval = g_value_get_uint(value);
+            break;
+        default:
+            G_OBJECT_WARN_INVALID_PROPERTY_ID(object, property_id, pspec);
+            break;
+    }
+}
+
+static GstStructure* videodecoder_get_stats(VideoDecoder *decoder)
+{
+    GST_OBJECT_LOCK(decoder);
+    GstStructure *s = gst_structure_new(AV_VIDEO_DECODER_STATS_MESSAGE,
+                                        "thread-count", G_TYPE_INT, decoder->active_thread_count,
+                                        "frame-threading", G_TYPE_BOOLEAN, decoder->frame_threading,
+                                        "frames-decoded", G_TYPE_UINT64, decoder->frames_decoded,
+                                        "decode-time", G_TYPE_UINT64, decoder->decode_time,
+                                        "frames-per-second", G_TYPE_DOUBLE,
+                                        decoder->decode_time > 0 ? (gdouble)decoder->frames_decoded * GST_SECOND / decoder->decode_time : 0.0,
+                                        "average-latency", G_TYPE_UINT64,
+                                        decoder->latency_count > 0 ? decoder->latency_total / decoder->latency_count : (GstClockTime)0,
+                                        "max-latency", G_TYPE_UINT64, decoder->latency_max,
+                                        NULL);
+    GST_OBJECT_UNLOCK(decoder);
+    return s;
+}
+
+static void videodecoder_get_property(GObject *object, guint property_id, GValue *value, GParamSpec *pspec)
+{
+    VideoDecoder *decoder = VIDEODECODER(object);
+
+    switch (property_id)
+    {
+        case PROP_THREAD_COUNT:
+            g_value_set_int(value, decoder->thread_count);
+            break;
+        case PROP_STATS_INTERVAL:
+            g_value_set_uint(value, decoder->stats_interval);
+            break;
+        case PROP_STATS:
+            g_value_take_boxed(value, videodecoder_get_stats(decoder));
+            break;
+        default:
+            G_OBJECT_WARN_INVALID_PROPERTY_ID(object, property_id, pspec);
+            break;
+    }
+}
+
+static void videodecoder_stats_reset(VideoDecoder *decoder)
+{
+    GST_OBJECT_LOCK(decoder);
+    decoder->frames_decoded = 0;
+    decoder->decode_time = 0;
+    decoder->push_time = 0;
+    decoder->latency_total = 0;
+    decoder->latency_max = 0;
+    decoder->latency_count = 0;
+    decoder->last_stats = gst_util_get_timestamp();
+    GST_OBJECT_UNLOCK(decoder);
+}
+
+// Remembers when a buffer arrived, so that the latency of the frame it turns
+// into can be measured. Frame threading and reordering delay frames by
+// several buffers.
+static void videodecoder_buffer_received(VideoDecoder *decoder, GstBuffer *buf)
+{
+    if (!GST_BUFFER_TIMESTAMP_IS_VALID(buf))
+        return;
+
+    VideoDecoderPending *pending = &decoder->pending[decoder->pending_next];
+    decoder->pending_next = (decoder->pending_next + 1) % VIDEODECODER_PENDING_SIZE;
+    pending->timestamp = GST_BUFFER_TIMESTAMP(buf);
+    pending->received = gst_util_get_timestamp();
+    pending->push_time = decoder->push_time;
+}
+
+// Accounts for a decoded frame. The time spent pushing earlier frames
+// downstream, which includes waiting for the sink, is not counted as latency.
+static void videodecoder_frame_decoded(VideoDecoder *decoder, gint64 timestamp)
+{
+    GstClockTime now = gst_util_get_timestamp();
+    int i;
+
+    GST_OBJECT_LOCK(decoder);
+    decoder->frames_decoded++;
+    for (i = 0; timestamp != AV_NOPTS_VALUE && i < VIDEODECODER_PENDING_SIZE; i++)
+    {
+        VideoDecoderPending *pending = &decoder->pending[i];
+        if (pending->timestamp == (GstClockTime)timestamp)
+        {
+            GstClockTime latency = now - pending->received - (decoder->push_time - pending->push_time);
+            decoder->latency_total += latency;
+            decoder->latency_count++;
+            if (latency > decoder->latency_max)
+                decoder->latency_max = latency;
+            pending->timestamp = GST_CLOCK_TIME_NONE;
+            break;
+        }
+    }
+    GST_OBJECT_UNLOCK(decoder);
+}
+
+static void videodecoder_post_stats(VideoDecoder *decoder)
+{
+    guint interval = decoder->stats_interval;
+    GstClockTime now = gst_util_get_timestamp();
+
+    if (interval == 0 || now - decoder->last_stats < interval * GST_MSECOND)
+        return;
+
+    decoder->last_stats = now;
+    gst_element_post_message(GST_ELEMENT(decoder),
+                             gst_message_new_element(GST_OBJECT(decoder), videodecoder_get_stats(decoder)));
 }
 
 
@@ -162,6 +337,7 @@ videodecoder_change_state(GstElement* element, GstStateChange transition)
         case GST_STATE_CHANGE_READY_TO_PAUSED:
             // Clear the VideoDecoder state.
             videodecoder_state_reset(decoder);
+            videodecoder_stats_reset(decoder);
             break;
         default:
             break;
@@ -208,6 +384,12 @@ static gboolean videodecoder_sink_event(GstPad *pad, GstObject *parent, GstEvent
             BASEDECODER(decoder)->is_flushing = FALSE;
             break;
 
+        case GST_EVENT_EOS:
+            // Push the frames the decoder still holds before EOS.
+            if (!BASEDECODER(decoder)->is_flushing)
+                videodecoder_drain(decoder);
+            break;
+
         case GST_EVENT_CAPS:
         {
             GstCaps *caps;
@@ -262,10 +444,22 @@ static void videodecoder_init_state(VideoDecoder *decoder)
     decoder->uv_blocksize = 0;
     decoder->frame_size = 0;
     decoder->discont = FALSE;
+    decoder->active_thread_count = 0;
+    decoder->frame_threading = FALSE;
 
     basedecoder_init_state(BASEDECODER(decoder));
 }
 
+static void videodecoder_init_context(BaseDecoder *base)
+{
+    BASEDECODER_CLASS(parent_class)->init_context(base);
+
+    // Decode several frames at once when the stream allows it, and the
+    // slices of a frame in parallel otherwise.
+    base->context->thread_count = VIDEODECODER(base)->thread_count;
+    base->context->thread_type = FF_THREAD_FRAME | FF_THREAD_SLICE;
+}
+
 static gboolean videodecoder_configure(VideoDecoder *decoder, GstCaps *sink_caps)
 {
     BaseDecoder *base = BASEDECODER(decoder);
@@ -286,13 +480,28 @@ static gboolean videodecoder_configure(VideoDecoder *decoder, GstCaps *sink_caps
 #else
     base->is_initialized = basedecoder_open_decoder(BASEDECODER(decoder), CODEC_ID_H264);
 #endif
+
+    if (base->is_initialized)
+    {
+        GST_OBJECT_LOCK(decoder);
+        decoder->active_thread_count = base->context->thread_count;
+        decoder->frame_threading = (base->context->active_thread_type & FF_THREAD_FRAME) != 0;
+        GST_OBJECT_UNLOCK(decoder);
+    }
+
     return base->is_initialized;
 }
 
 static void videodecoder_state_reset(VideoDecoder *decoder)
 {
+    int i;
+
     decoder->frame_finished = 1;
     basedecoder_flush(BASEDECODER(decoder));
+
+    for (i = 0; i < VIDEODECODER_PENDING_SIZE; i++)
+        decoder->pending[i].timestamp = GST_CLOCK_TIME_NONE;
+    decoder->pending_next = 0;
 }
 
 static gboolean videodecoder_configure_sourcepad(VideoDecoder *decoder)
@@ -357,6 +566,116 @@ static gboolean videodecoder_configure_sourcepad(VideoDecoder *decoder)
 
     return TRUE;
 }
+static int videodecoder_decode(VideoDecoder *decoder)
+{
+    BaseDecoder  *base = BASEDECODER(decoder);
+    GstClockTime  start = gst_util_get_timestamp();
+
+    int num_dec = avcodec_decode_video2(base->context, base->frame, &decoder->frame_finished, &decoder->packet);
+
+    GstClockTime elapsed = gst_util_get_timestamp() - start;
+    GST_OBJECT_LOCK(decoder);
+    decoder->decode_time += elapsed;
+    GST_OBJECT_UNLOCK(decoder);
+
+    return num_dec;
+}
+
+static GstFlowReturn videodecoder_push_frame(VideoDecoder *decoder, GstClockTime duration, gboolean discont)
+{
+    BaseDecoder   *base = BASEDECODER(decoder);
+    GstFlowReturn  result = GST_FLOW_OK;
+    GstMapInfo     info2;
+
+    videodecoder_frame_decoded(decoder, base->frame->reordered_opaque);
+
+    if (!videodecoder_configure_sourcepad(decoder))
+        return GST_FLOW_ERROR;
+
+    GstBuffer *outbuf = gst_buffer_new_allocate(NULL, decoder->frame_size, NULL);
+    if (outbuf == NULL)
+    {
+        gst_element_message_full(GST_ELEMENT(decoder), GST_MESSAGE_ERROR,
+                                 GST_STREAM_ERROR, GST_STREAM_ERROR_DECODE,
+                                 ("Decoded video buffer allocation failed"), NULL,
+                                 ("videodecoder.c"), ("videodecoder_push_frame"), 0);
+        return GST_FLOW_OK;
+    }
+
+    GST_BUFFER_OFFSET(outbuf) = base->context->frame_number;
+    if (base->frame->reordered_opaque != AV_NOPTS_VALUE)
+    {
+        GST_BUFFER_TIMESTAMP(outbuf) = base->frame->reordered_opaque;
+        GST_BUFFER_DURATION(outbuf) = duration; // Duration for video usually same
+    }
+
+    if (!gst_buffer_map(outbuf, &info2, GST_MAP_WRITE))
+    {
+        // INLINE - gst_buffer_unref()
+        gst_buffer_unref(outbuf);
+        gst_element_message_full(GST_ELEMENT(decoder), GST_MESSAGE_ERROR, GST_RESOURCE_ERROR, GST_RESOURCE_ERROR_NO_SPACE_LEFT,
+                         g_strdup("Decoded video buffer allocation failed"), NULL, ("videodecoder.c"), ("videodecoder_push_frame"), 0);
+        return GST_FLOW_OK;
+    }
+
+    // Copy image by parts from different arrays.
+    memcpy(info2.data,                     base->frame->data[0], decoder->u_offset);
+    memcpy(info2.data + decoder->u_offset, base->frame->data[1], decoder->uv_blocksize);
+    memcpy(info2.data + decoder->v_offset, base->frame->data[2], decoder->uv_blocksize);
+
+    gst_buffer_unmap(outbuf, &info2);
+
+    GST_BUFFER_OFFSET_END(outbuf) = GST_BUFFER_OFFSET_NONE;
+
+    if (decoder->discont || discont)
+    {
+#ifdef DEBUG_OUTPUT
+        g_print("Video discont: frame size=%dx%d\n", base->context->width, base->context->height);
+#endif
+        GST_BUFFER_FLAG_SET(outbuf, GST_BUFFER_FLAG_DISCONT);
+        decoder->discont = FALSE;
+    }
+
+
+#ifdef VERBOSE_DEBUG
+    g_print("videodecoder: pushing buffer ts=%.4f sec", (double)GST_BUFFER_TIMESTAMP(outbuf)/GST_SECOND);
+#endif
+    GstClockTime start = gst_util_get_timestamp();
+    result = gst_pad_push(base->srcpad, outbuf);
+    GstClockTime elapsed = gst_util_get_timestamp() - start;
+#ifdef VERBOSE_DEBUG
+    g_print(" done, res=%s\n", gst_flow_get_name(result));
+#endif
+
+    GST_OBJECT_LOCK(decoder);
+    decoder->push_time += elapsed;
+    GST_OBJECT_UNLOCK(decoder);
+
+    videodecoder_post_stats(decoder);
+
+    return result;
+}
+
+// With frame threading libavcodec holds up to thread_count - 1 frames, on
+// top of the frames held for reordering. Empty packets return them.
+static void videodecoder_drain(VideoDecoder *decoder)
+{
+    BaseDecoder *base = BASEDECODER(decoder);
+
+    if (!base->is_initialized)
+        return;
+
+    do
+    {
+        av_init_packet(&decoder->packet);
+        decoder->packet.data = NULL;
+        decoder->packet.size = 0;
+
+        if (videodecoder_decode(decoder) < 0 || decoder->frame_finished <= 0)
+            break;
+    } while (videodecoder_push_frame(decoder, GST_CLOCK_TIME_NONE, FALSE) == GST_FLOW_OK);
+}
+
 /***********************************************************************************
  * chain
  ***********************************************************************************/
@@ -367,7 +686,6 @@ static GstFlowReturn videodecoder_chain(GstPad *pad, GstObject *parent, GstBuffe
     GstFlowReturn  result = GST_FLOW_OK;
     int            num_dec = NO_DATA_USED;
     GstMapInfo     info;
-    GstMapInfo     info2;
     gboolean       unmap_buf = FALSE;
 
     if (base->is_flushing)  // Reject buffers in flushing state.
@@ -389,6 +707,7 @@ static GstFlowReturn videodecoder_chain(GstPad *pad, GstObject *parent, GstBuffe
     }
 
     unmap_buf = TRUE;
+    videodecoder_buffer_received(decoder, buf);
 
     if (!base->is_hls)
     {
@@ -399,7 +718,7 @@ static GstFlowReturn videodecoder_chain(GstPad *pad, GstObject *parent, GstBuffe
                 base->context->reordered_opaque = GST_BUFFER_TIMESTAMP(buf);
             else
                 base->context->reordered_opaque = AV_NOPTS_VALUE;
-            num_dec = avcodec_decode_video2(base->context, base->frame, &decoder->frame_finished, &decoder->packet);
+            num_dec = videodecoder_decode(decoder);
             av_free_packet(&decoder->packet);
         }
         else
@@ -418,7 +737,7 @@ static GstFlowReturn videodecoder_chain(GstPad *pad, GstObject *parent, GstBuffe
         else
             base->context->reordered_opaque = AV_NOPTS_VALUE;
 
-        num_dec = avcodec_decode_video2(base->context, base->frame, &decoder->frame_finished, &decoder->packet);
+        num_dec = videodecoder_decode(decoder);
     }
 
     if (num_dec < 0)
@@ -431,69 +750,7 @@ static GstFlowReturn videodecoder_chain(GstPad *pad, GstObject *parent, GstBuffe
     }
 
     if (decoder->frame_finished > 0)
-    {
-        if (!videodecoder_configure_sourcepad(decoder))
-            result = GST_FLOW_ERROR;
-        else
-        {
-            GstBuffer *outbuf = gst_buffer_new_allocate(NULL, decoder->frame_size, NULL);
-            if (outbuf == NULL)
-            {
-                if (result != GST_FLOW_FLUSHING)
-                {
-                    gst_element_message_full(GST_ELEMENT(decoder), GST_MESSAGE_ERROR,
-                                             GST_STREAM_ERROR, GST_STREAM_ERROR_DECODE,
-                                             ("Decoded video buffer allocation failed"), NULL,
-                                             ("videodecoder.c"), ("videodecoder_chain"), 0);
-                }
-            }
-            else
-            {
-                GST_BUFFER_OFFSET(outbuf) = base->context->frame_number;
-                if (base->frame->reordered_opaque != AV_NOPTS_VALUE)
-                {
-                    GST_BUFFER_TIMESTAMP(outbuf) = base->frame->reordered_opaque;
-                    GST_BUFFER_DURATION(outbuf) = GST_BUFFER_DURATION(buf); // Duration for video usually same
-                }
-
-                if (!gst_buffer_map(outbuf, &info2, GST_MAP_WRITE))
-                {
-                    // INLINE - gst_buffer_unref()
-                    gst_buffer_unref(outbuf);
-                    gst_element_message_full(GST_ELEMENT(decoder), GST_MESSAGE_ERROR, GST_RESOURCE_ERROR, GST_RESOURCE_ERROR_NO_SPACE_LEFT,
-                                     g_strdup("Decoded video buffer allocation failed"), NULL, ("videodecoder.c"), ("videodecoder_chain"), 0);
-                    goto _exit;
-                }
-
-                // Copy image by parts from different arrays.
-                memcpy(info2.data,                     base->frame->data[0], decoder->u_offset);
-                memcpy(info2.data + decoder->u_offset, base->frame->data[1], decoder->uv_blocksize);
-                memcpy(info2.data + decoder->v_offset, base->frame->data[2], decoder->uv_blocksize);
-
-                gst_buffer_unmap(outbuf, &info2);
-
-                GST_BUFFER_OFFSET_END(outbuf) = GST_BUFFER_OFFSET_NONE;
-
-                if (decoder->discont || GST_BUFFER_IS_DISCONT(buf))
-                {
-#ifdef DEBUG_OUTPUT
-                    g_print("Video discont: frame size=%dx%d\n", base->context->width, base->context->height);
-#endif
-                    GST_BUFFER_FLAG_SET(outbuf, GST_BUFFER_FLAG_DISCONT);
-                    decoder->discont = FALSE;
-                }
-
-
-#ifdef VERBOSE_DEBUG
-                g_print("videodecoder: pushing buffer ts=%.4f sec", (double)GST_BUFFER_TIMESTAMP(outbuf)/GST_SECOND);
-#endif
-                result = gst_pad_push(base->srcpad, outbuf);
-#ifdef VERBOSE_DEBUG
-                g_print(" done, res=%s\n", gst_flow_get_name(result));
-#endif
-            }
-        }
-    }
+        result = videodecoder_push_frame(decoder, GST_BUFFER_DURATION(buf), GST_BUFFER_IS_DISCONT(buf));
 
 _exit:
     if (unmap_buf)
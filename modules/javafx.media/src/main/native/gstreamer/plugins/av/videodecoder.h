@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2010, 2014, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2010, 2019, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -43,9 +43,22 @@ G_BEGIN_DECLS
 
 #define AV_VIDEO_DECODER_PLUGIN_NAME "avvideodecoder"
 
+// Name of the element message carrying the "stats" structure.
+#define AV_VIDEO_DECODER_STATS_MESSAGE "avvideodecoder-stats"
+
+// Number of buffers whose arrival time is remembered to measure latency.
+#define VIDEODECODER_PENDING_SIZE 32
+
 typedef struct _VideoDecoder      VideoDecoder;
 typedef struct _VideoDecoderClass VideoDecoderClass;
 
+typedef struct
+{
+    GstClockTime timestamp;     // input buffer timestamp
+    GstClockTime received;      // when the buffer reached the decoder
+    GstClockTime push_time;     // value of VideoDecoder.push_time at that moment
+} VideoDecoderPending;
+
 struct _VideoDecoder {
     BaseDecoder parent;
 
@@ -60,6 +73,23 @@ struct _VideoDecoder {
     int         uv_blocksize;
 
     AVPacket       packet;
+
+    gint        thread_count;   // "thread-count", 0 lets libavcodec pick
+    guint       stats_interval; // "stats-interval" in milliseconds, 0 posts no messages
+
+    // Decode statistics, guarded by the object lock.
+    gint         active_thread_count;
+    gboolean     frame_threading;
+    guint64      frames_decoded;
+    GstClockTime decode_time;   // time spent in avcodec_decode_video2()
+    GstClockTime push_time;     // time spent pushing frames downstream
+    GstClockTime latency_total; // buffer arrival to frame output, without push_time
+    GstClockTime latency_max;
+    guint64      latency_count;
+    GstClockTime last_stats;    // when the last stats message was posted
+
+    VideoDecoderPending pending[VIDEODECODER_PENDING_SIZE];
+    guint        pending_next;
 };
 
 struct _VideoDecoderClass
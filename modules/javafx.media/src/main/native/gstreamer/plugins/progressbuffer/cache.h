@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2010, 2013, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2010, 2019, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -35,10 +35,19 @@ void      cache_static_init(void); // Must be called only once from the Progress
 Cache*    create_cache();
 void      destroy_cache(Cache* instance);
 
+/* Creates a cache that keeps up to size bytes in memory instead of a file.
+ * Returns NULL if the memory can't be allocated or the platform has no memory
+ * cache, create_cache() should be used then.
+ */
+Cache*    create_memory_cache(gint64 size);
+
+// Sets the largest size of the buffers returned by cache_read_buffer().
+void           cache_set_read_chunk_size(Cache* cache, guint size);
+
 // Writes a buffer.
 void           cache_write_buffer(Cache* cache, GstBuffer* buffer);
 
-/* Reads a buffer of the fixed size from the current read position.
+/* Reads a buffer of up to the read chunk size from the current read position.
  * Returns the read position after the operation has been made.
  * buffer parameter contains the target buffer with offset and size values set
  * This method is used in push mode.
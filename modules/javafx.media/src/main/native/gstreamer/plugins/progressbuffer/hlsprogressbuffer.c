@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2010, 2018, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2010, 2019, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -35,10 +35,22 @@ GST_DEBUG_CATEGORY (hls_progress_buffer_debug);
 #define ELEMENT_DESCRIPTION "JFX HLS Progress buffer element"
 
 /***********************************************************************************
- * Element structures are hidden from outside
+ * Properties
  ***********************************************************************************/
-#define NUM_OF_CACHED_SEGMENTS 3
+enum
+{
+    PROP_0,
+    PROP_CACHED_SEGMENTS,
+    PROP_BUFFERED_SEGMENTS,
+    PROP_BUFFERED_BYTES
+};
+
+#define DEFAULT_CACHED_SEGMENTS 3
+#define MAX_CACHED_SEGMENTS     16
 
+/***********************************************************************************
+ * Element structures are hidden from outside
+ ***********************************************************************************/
 struct _HLSProgressBuffer
 {
     GstElement    parent;
@@ -50,11 +62,13 @@ struct _HLSProgressBuffer
     GCond        add_cond;
     GCond        del_cond;
 
-    Cache*        cache[NUM_OF_CACHED_SEGMENTS];
-    guint         cache_size[NUM_OF_CACHED_SEGMENTS];
-    gboolean      cache_write_ready[NUM_OF_CACHED_SEGMENTS];
+    Cache*        cache[MAX_CACHED_SEGMENTS];
+    guint         cache_size[MAX_CACHED_SEGMENTS];
+    gboolean      cache_write_ready[MAX_CACHED_SEGMENTS];
     gint          cache_write_index;
     gint          cache_read_index;
+    gint          cached_segments;  // Ring size, only the first cached_segments caches exist
+    guint64       buffered_bytes;   // Received but not yet pushed downstream
 
     gboolean      send_new_segment;
     gboolean      set_src_caps;
@@ -115,6 +129,10 @@ static GstStaticPadTemplate source_template = GST_STATIC_PAD_TEMPLATE ("src",
 /***********************************************************************************
  * Instance init and forward declarations
  ***********************************************************************************/
+static void                 hls_progress_buffer_set_property (GObject *object, guint property_id,
+                                                              const GValue *value, GParamSpec *pspec);
+static void                 hls_progress_buffer_get_property (GObject *object, guint property_id,
+                                                              GValue *value, GParamSpec *pspec);
 static void                 hls_progress_buffer_finalize (GObject *object);
 static GstStateChangeReturn hls_progress_buffer_change_state (GstElement *element, GstStateChange transition);
 static GstFlowReturn        hls_progress_buffer_chain(GstPad *pad, GstObject *parent, GstBuffer *data);
@@ -145,9 +163,38 @@ static void hls_progress_buffer_class_init (HLSProgressBufferClass *klass)
     gst_element_class_add_pad_template (element_class,
         gst_static_pad_template_get (&source_template));
 
+    gobject_class->set_property = hls_progress_buffer_set_property;
+    gobject_class->get_property = hls_progress_buffer_get_property;
     gobject_class->finalize = hls_progress_buffer_finalize;
     GST_ELEMENT_CLASS (klass)->change_state = hls_progress_buffer_change_state;
 
+    g_object_class_install_property (gobject_class, PROP_CACHED_SEGMENTS,
+                                     g_param_spec_uint ("cached-segments",
+                                                        "Cached segments",
+                                                        "Number of segments received ahead of playback, can only be changed before the first segment.",
+                                                        2  /* minimum value */,
+                                                        MAX_CACHED_SEGMENTS /* maximum value */,
+                                                        DEFAULT_CACHED_SEGMENTS  /* default value */,
+                                                        G_PARAM_READWRITE));
+
+    g_object_class_install_property (gobject_class, PROP_BUFFERED_SEGMENTS,
+                                     g_param_spec_uint ("buffered-segments",
+                                                        "Buffered segments",
+                                                        "Number of segments held, including the one being received.",
+                                                        0  /* minimum value */,
+                                                        MAX_CACHED_SEGMENTS /* maximum value */,
+                                                        0  /* default value */,
+                                                        G_PARAM_READABLE));
+
+    g_object_class_install_property (gobject_class, PROP_BUFFERED_BYTES,
+                                     g_param_spec_uint64 ("buffered-bytes",
+                                                          "Buffered bytes",
+                                                          "Number of bytes received and not pushed downstream yet.",
+                                                          0  /* minimum value */,
+                                                          G_MAXUINT64 /* maximum value */,
+                                                          0  /* default value */,
+                                                          G_PARAM_READABLE));
+
     cache_static_init();
 }
 
@@ -174,15 +221,17 @@ static void hls_progress_buffer_init(HLSProgressBuffer *element)
     g_cond_init(&element->add_cond);
     g_cond_init(&element->del_cond);
 
-    for (i = 0; i < NUM_OF_CACHED_SEGMENTS; i++)
+    for (i = 0; i < MAX_CACHED_SEGMENTS; i++)
     {
-        element->cache[i] = create_cache();
+        element->cache[i] = (i < DEFAULT_CACHED_SEGMENTS) ? create_cache() : NULL;
         element->cache_size[i] = 0;
         element->cache_write_ready[i] = TRUE;
     }
 
     element->cache_write_index = -1;
     element->cache_read_index = 0;
+    element->cached_segments = DEFAULT_CACHED_SEGMENTS;
+    element->buffered_bytes = 0;
 
     element->send_new_segment = TRUE;
     element->set_src_caps = TRUE;
@@ -193,6 +242,91 @@ static void hls_progress_buffer_init(HLSProgressBuffer *element)
     element->srcresult = GST_FLOW_OK;
 }
 
+/**
+ * hls_progress_buffer_set_property()
+ *
+ * Function to set properties on the element.
+ */
+static void hls_progress_buffer_set_property (GObject *object, guint property_id,
+                                              const GValue *value, GParamSpec *pspec)
+{
+    HLSProgressBuffer *element = HLS_PROGRESS_BUFFER(object);
+    switch (property_id)
+    {
+        case PROP_CACHED_SEGMENTS:
+        {
+            gint cached_segments = (gint)g_value_get_uint(value);
+            int i = 0;
+
+            g_mutex_lock(&element->lock);
+            // The ring is indexed modulo its size, it cannot be resized once segments are in it.
+            if (element->cache_write_index == -1)
+            {
+                for (i = element->cached_segments; i < cached_segments; i++)
+                {
+                    if (!element->cache[i])
+                        element->cache[i] = create_cache();
+                    element->cache_size[i] = 0;
+                    element->cache_write_ready[i] = TRUE;
+                }
+                element->cached_segments = cached_segments;
+            }
+            else
+                GST_WARNING_OBJECT(element, "Cannot change cached-segments after the first segment");
+            g_mutex_unlock(&element->lock);
+        }
+            break;
+
+        default:
+            G_OBJECT_WARN_INVALID_PROPERTY_ID(object, property_id, pspec);
+            break;
+    }
+}
+
+/**
+ * hls_progress_buffer_get_property()
+ *
+ * Function to get properties from the element.
+ */
+static void hls_progress_buffer_get_property (GObject *object, guint property_id,
+                                              GValue *value, GParamSpec *pspec)
+{
+    HLSProgressBuffer *element = HLS_PROGRESS_BUFFER(object);
+    switch (property_id)
+    {
+        case PROP_CACHED_SEGMENTS:
+            g_value_set_uint(value, (guint)element->cached_segments);
+            break;
+
+        case PROP_BUFFERED_SEGMENTS:
+        {
+            guint buffered_segments = 0;
+            int i = 0;
+
+            g_mutex_lock(&element->lock);
+            for (i = 0; i < element->cached_segments; i++)
+            {
+                if (!element->cache_write_ready[i])
+                    buffered_segments++;
+            }
+            g_mutex_unlock(&element->lock);
+
+            g_value_set_uint(value, buffered_segments);
+        }
+            break;
+
+        case PROP_BUFFERED_BYTES:
+            g_mutex_lock(&element->lock);
+            g_value_set_uint64(value, element->buffered_bytes);
+            g_mutex_unlock(&element->lock);
+            break;
+
+        default:
+            G_OBJECT_WARN_INVALID_PROPERTY_ID(object, property_id, pspec);
+            break;
+    }
+}
+
 /**
  * hls_progress_buffer_finalize()
  *
@@ -203,7 +337,7 @@ static void hls_progress_buffer_finalize (GObject *object)
     HLSProgressBuffer *element = HLS_PROGRESS_BUFFER(object);
     int i = 0;
 
-    for (i = 0; i < NUM_OF_CACHED_SEGMENTS; i++)
+    for (i = 0; i < MAX_CACHED_SEGMENTS; i++)
     {
         if (element->cache[i])
             destroy_cache(element->cache[i]);
@@ -281,7 +415,8 @@ static void hls_progress_buffer_flush_data(HLSProgressBuffer *element)
 
     element->cache_write_index = -1;
     element->cache_read_index = 0;
-    for (i = 0; i < NUM_OF_CACHED_SEGMENTS; i++)
+    element->buffered_bytes = 0;
+    for (i = 0; i < (guint)element->cached_segments; i++)
     {
         if (element->cache[i])
         {
@@ -319,6 +454,7 @@ static GstFlowReturn hls_progress_buffer_chain(GstPad *pad, GstObject *parent, G
     if (element->srcresult != GST_FLOW_FLUSHING)
     {
         cache_write_buffer(element->cache[element->cache_write_index], data);
+        element->buffered_bytes += gst_buffer_get_size(data);
         g_cond_signal(&element->add_cond);
     }
     g_mutex_unlock(&element->lock);
@@ -411,10 +547,14 @@ static void hls_progress_buffer_loop(void *data)
         GstBuffer *buffer = NULL;
         guint64 read_position = cache_read_buffer(element->cache[element->cache_read_index], &buffer);
 
+        if (buffer)
+            element->buffered_bytes -= MIN(element->buffered_bytes, gst_buffer_get_size(buffer));
+
         if (read_position == element->cache_size[element->cache_read_index])
         {
             element->cache_write_ready[element->cache_read_index] = TRUE;
-            element->cache_read_index = (element->cache_read_index + 1) % NUM_OF_CACHED_SEGMENTS;
+            element->cache_read_index = (element->cache_read_index + 1) % element->cached_segments;
+            GST_DEBUG_OBJECT(element, "Segment played out, %" G_GUINT64_FORMAT " bytes buffered", element->buffered_bytes);
             send_hls_not_full_message(element);
             g_cond_signal(&element->del_cond);
         }
@@ -506,7 +646,7 @@ static gboolean hls_progress_buffer_sink_event(GstPad *pad, GstObject *parent, G
 
             // Get and prepare next write segment
             g_mutex_lock(&element->lock);
-            element->cache_write_index = (element->cache_write_index + 1) % NUM_OF_CACHED_SEGMENTS;
+            element->cache_write_index = (element->cache_write_index + 1) % element->cached_segments;
 
             while (element->srcresult == GST_FLOW_OK && !element->cache_write_ready[element->cache_write_index])
             {
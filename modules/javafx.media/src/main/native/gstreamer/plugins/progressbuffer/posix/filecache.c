@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2010, 2015, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2010, 2019, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -26,12 +26,48 @@
 #include <cache.h>
 #include <sys/types.h>
 #include <sys/stat.h>
+#include <sys/mman.h>
 #include <fcntl.h>
 #include <unistd.h>
+#include <string.h>
+#include <errno.h>
+
+/*
+ * The cache is a temporary file, or a single memory block for content that
+ * is known to be small. Incoming buffers are collected in a write buffer and
+ * written to the file WRITE_BUFFER_SIZE bytes at a time. The file is mapped
+ * into memory in windows of MAP_WINDOW_SIZE bytes, and the buffers read from
+ * the cache wrap the mapped data instead of copying it.
+ *
+ * Read buffers keep their window, and the store it belongs to, alive after
+ * the cache moved on or was destroyed. Data is only ever overwritten when the
+ * write position is moved back, which the progress buffers do by rewinding
+ * to 0 for a new segment. If read buffers are still alive at that point the
+ * cache switches to a new store, so their contents never change.
+ */
+#define DEFAULT_READ_CHUNK_SIZE (64 * 1024)
+#define WRITE_BUFFER_SIZE       (64 * 1024)
+#define MAP_WINDOW_SIZE         (4 * 1024 * 1024) // a multiple of any page size
 
-#define DEFAULT_BUFFER_SIZE 4096
 static const char *tempDir = NULL;
 
+typedef struct _CacheStore
+{
+    volatile gint refcount;  // one for the cache and one for every window
+    volatile gint buffers;   // read buffers that are still alive
+    guint8*       memory;    // the data of a memory store, NULL for a file
+    gint64        capacity;  // size of memory
+} CacheStore;
+
+typedef struct _CacheWindow
+{
+    volatile gint refcount;  // one for the cache and one for every read buffer
+    CacheStore*   store;
+    guint8*       data;
+    gint64        offset;    // of data in the store
+    gint64        size;
+} CacheWindow;
+
 struct _Cache
 {
     char*   filename;
@@ -40,6 +76,14 @@ struct _Cache
 
     gint64  read_position;
     gint64  write_position;
+
+    guint   read_chunk_size;
+
+    CacheStore*  store;
+    CacheWindow* window;       // the window last read from
+
+    guint8* write_buffer;
+    guint   write_buffer_size; // bytes in write_buffer, they go right before write_position
 };
 
 void cache_static_init(void)
@@ -47,30 +91,142 @@ void cache_static_init(void)
     tempDir = g_get_tmp_dir();
 }
 
-Cache* create_cache()
+/***********************************************************************************
+ * Stores and windows
+ ***********************************************************************************/
+static CacheStore* cache_store_new(gint64 capacity)
 {
-    Cache* result= (Cache*)g_try_malloc(sizeof(Cache));
-    if (result)
+    CacheStore* store = (CacheStore*)g_try_malloc(sizeof(CacheStore));
+    if (store)
     {
-        result->filename = g_build_filename(tempDir, "jfxmpbXXXXXX", NULL);
-        if (result->filename == NULL)
-            goto _error_exit;
-        else
+        store->refcount = 1;
+        store->buffers = 0;
+        store->memory = NULL;
+        store->capacity = capacity;
+
+        if (capacity > 0)
         {
-        result->writeHandle = g_mkstemp_full(result->filename, O_RDWR, S_IRUSR|S_IWUSR);
-            result->readHandle = open(result->filename, O_RDONLY, 0);
+            store->memory = (guint8*)g_try_malloc(capacity);
+            if (!store->memory)
+            {
+                g_free(store);
+                return NULL;
+            }
+        }
+    }
+    return store;
+}
 
-            if(result->writeHandle < 0 || result->readHandle < 0)
-                goto _error_exit;
+static void cache_store_unref(CacheStore* store)
+{
+    if (g_atomic_int_dec_and_test(&store->refcount))
+    {
+        g_free(store->memory);
+        g_free(store);
+    }
+}
+
+static CacheWindow* cache_window_new(Cache* cache, gint64 position)
+{
+    CacheWindow* window = (CacheWindow*)g_try_malloc(sizeof(CacheWindow));
+    if (!window)
+        return NULL;
 
-        if (unlink(result->filename) < 0)
+    if (cache->store->memory)
+    {
+        window->data = cache->store->memory;
+        window->offset = 0;
+        window->size = cache->store->capacity;
+    }
+    else
+    {
+        window->offset = position - position % MAP_WINDOW_SIZE;
+        window->size = MAP_WINDOW_SIZE;
+        // Mapping past the end of the file is fine as long as those pages are
+        // not touched, only data that was written out is ever handed out.
+        window->data = (guint8*)mmap(NULL, MAP_WINDOW_SIZE, PROT_READ, MAP_SHARED,
+                                     cache->readHandle, (off_t)window->offset);
+        if (window->data == MAP_FAILED)
         {
-            close (result->writeHandle);
-            close (result->readHandle);
-        goto _error_exit;
+            GST_WARNING("mmap() failed: %s", g_strerror(errno));
+            g_free(window);
+            return NULL;
         }
+    }
 
-            result->read_position = result->write_position = 0;
+    window->refcount = 1;
+    window->store = cache->store;
+    g_atomic_int_inc(&window->store->refcount);
+    return window;
+}
+
+static void cache_window_unref(CacheWindow* window)
+{
+    if (g_atomic_int_dec_and_test(&window->refcount))
+    {
+        if (!window->store->memory)
+            munmap(window->data, window->size);
+        cache_store_unref(window->store);
+        g_free(window);
+    }
+}
+
+static void cache_window_buffer_free(gpointer data)
+{
+    CacheWindow* window = (CacheWindow*)data;
+    g_atomic_int_add(&window->store->buffers, -1);
+    cache_window_unref(window);
+}
+
+static gboolean cache_open_file(Cache* cache)
+{
+    cache->filename = g_build_filename(tempDir, "jfxmpbXXXXXX", NULL);
+    if (cache->filename == NULL)
+        return FALSE;
+
+    cache->writeHandle = g_mkstemp_full(cache->filename, O_RDWR, S_IRUSR|S_IWUSR);
+    cache->readHandle = open(cache->filename, O_RDONLY, 0);
+
+    if (cache->writeHandle < 0 || cache->readHandle < 0 || unlink(cache->filename) < 0)
+    {
+        if (cache->writeHandle >= 0)
+            close(cache->writeHandle);
+        if (cache->readHandle >= 0)
+            close(cache->readHandle);
+        g_free(cache->filename);
+        cache->filename = NULL;
+        return FALSE;
+    }
+    return TRUE;
+}
+
+static void cache_close_file(Cache* cache)
+{
+    if (cache->filename)
+    {
+        close(cache->writeHandle);
+        close(cache->readHandle);
+        g_free(cache->filename);
+        cache->filename = NULL;
+    }
+}
+
+static Cache* cache_new(gint64 capacity)
+{
+    Cache* result = (Cache*)g_try_malloc0(sizeof(Cache));
+    if (result)
+    {
+        result->read_chunk_size = DEFAULT_READ_CHUNK_SIZE;
+        result->readHandle = result->writeHandle = -1;
+
+        result->store = cache_store_new(capacity);
+        if (!result->store)
+            goto _error_exit;
+
+        if (capacity == 0 && !cache_open_file(result))
+        {
+            cache_store_unref(result->store);
+            goto _error_exit;
         }
     }
     return result;
@@ -80,90 +236,294 @@ _error_exit:
     return NULL;
 }
 
+Cache* create_cache()
+{
+    return cache_new(0);
+}
+
+Cache* create_memory_cache(gint64 size)
+{
+    return size > 0 ? cache_new(size) : NULL;
+}
+
 void destroy_cache(Cache* instance)
 {
-    close(instance->writeHandle);
-    close(instance->readHandle);
-    g_free(instance->filename);
+    if (instance->window)
+        cache_window_unref(instance->window);
+    cache_store_unref(instance->store);
+    cache_close_file(instance);
+    g_free(instance->write_buffer);
 
     g_free(instance);
 }
 
-void cache_write_buffer(Cache* cache, GstBuffer* buffer)
+void cache_set_read_chunk_size(Cache* cache, guint size)
 {
-    GstMapInfo info;
-    if (gst_buffer_map(buffer, &info, GST_MAP_READ))
+    cache->read_chunk_size = MAX(size, 1);
+}
+
+/***********************************************************************************
+ * Writing
+ ***********************************************************************************/
+// Writes size bytes that end at cache->write_position, returns the number written.
+static gsize cache_write_file(Cache* cache, const guint8* data, gsize size)
+{
+    gint64 offset = cache->write_position - size;
+    gsize written = 0;
+
+    while (written < size)
     {
-        ssize_t written = write(cache->writeHandle, info.data, info.size);
-        if (written > 0)
-            cache->write_position += written;
-        gst_buffer_unmap(buffer, &info);
+        ssize_t result = pwrite(cache->writeHandle, data + written, size - written, (off_t)(offset + written));
+        if (result < 0 && errno == EINTR)
+            continue;
+        if (result <= 0)
+            break;
+        written += result;
     }
+    return written;
 }
 
-gint64 cache_read_buffer(Cache* cache, GstBuffer** buffer)
+// Unwritten data is dropped, like the old write() based cache did.
+static void cache_flush(Cache* cache)
 {
-    guint8 *data = (guint8*)g_try_malloc(DEFAULT_BUFFER_SIZE);
-    *buffer = NULL;
-
-    if (data)
+    if (cache->write_buffer_size > 0)
     {
-        ssize_t size = 0;
-        if ((cache->write_position - cache->read_position) > 0 &&
-            (cache->write_position - cache->read_position) < DEFAULT_BUFFER_SIZE)
-            size = cache->write_position - cache->read_position;
-        else
-            size = DEFAULT_BUFFER_SIZE;
+        gsize size = cache->write_buffer_size;
+        gsize written = cache_write_file(cache, cache->write_buffer, size);
 
-        ssize_t read_bytes = read(cache->readHandle, data, size);
-        if (read_bytes > 0)
+        cache->write_buffer_size = 0;
+        if (written < size)
         {
-            *buffer = gst_buffer_new_wrapped_full(0, data, DEFAULT_BUFFER_SIZE, 0, read_bytes, data, g_free);
-            if (*buffer != NULL)
-                GST_BUFFER_OFFSET(*buffer) = cache->read_position;
-
-            cache->read_position += read_bytes;
-            return cache->read_position;
+            GST_WARNING("Dropped %" G_GSIZE_FORMAT " bytes, the cache file could not be written", size - written);
+            cache->write_position -= size - written;
         }
-        else // read error, deleting buffer to avoid leaking.
-            g_free(data);
     }
+}
 
-    return 0;
+static void cache_replace_store(Cache* cache, CacheStore* store)
+{
+    if (cache->window)
+    {
+        cache_window_unref(cache->window);
+        cache->window = NULL;
+    }
+    cache_store_unref(cache->store);
+    cache->store = store;
 }
 
-GstFlowReturn cache_read_buffer_from_position(Cache* cache, gint64 start_position, guint size, GstBuffer** buffer)
+/* Moves the data of a memory store into a larger one. Content is only
+ * larger than expected if a segment starts before the one the cache was
+ * created for.
+ */
+static gboolean cache_grow_store(Cache* cache, gint64 size)
 {
-    GstFlowReturn result = GST_FLOW_ERROR;
-    *buffer = NULL;
+    CacheStore* store = cache_store_new(MAX(size, 2 * cache->store->capacity));
+    if (store == NULL)
+        return FALSE;
 
-    if (cache_set_read_position(cache, start_position))
-    {
-        guint8 *data = (guint8*)g_try_malloc(size);
-        if (data)
+    memcpy(store->memory, cache->store->memory, cache->write_position);
+    cache_replace_store(cache, store);
+    return TRUE;
+}
+
+void cache_write_buffer(Cache* cache, GstBuffer* buffer)
+{
+    GstMapInfo info;
+    if (gst_buffer_map(buffer, &info, GST_MAP_READ))
     {
-        ssize_t read_bytes = read(cache->readHandle, data, size);
-            if (read_bytes == size)
+        if (cache->store->memory)
+        {
+            if (cache->write_position + (gint64)info.size > cache->store->capacity &&
+                !cache_grow_store(cache, cache->write_position + info.size))
+            {
+                GST_WARNING("Memory cache is full, dropped %" G_GSIZE_FORMAT " bytes", info.size);
+                gst_buffer_unmap(buffer, &info);
+                return;
+            }
+
+            memcpy(cache->store->memory + cache->write_position, info.data, info.size);
+            cache->write_position += info.size;
+        }
+        else if (info.size >= WRITE_BUFFER_SIZE)
+        {
+            gsize written;
+
+            cache_flush(cache);
+            cache->write_position += info.size;
+            written = cache_write_file(cache, info.data, info.size);
+            cache->write_position -= info.size - written;
+        }
+        else
+        {
+            if (cache->write_buffer == NULL)
             {
-                *buffer = gst_buffer_new_wrapped_full(0, data, size, 0, read_bytes, data, g_free);
-                if (*buffer != NULL)
+                cache->write_buffer = (guint8*)g_try_malloc(WRITE_BUFFER_SIZE);
+                if (cache->write_buffer == NULL)
                 {
-                    GST_BUFFER_OFFSET(*buffer) = cache->read_position;
-                    result = GST_FLOW_OK;
+                    gst_buffer_unmap(buffer, &info);
+                    return;
                 }
             }
-            else
-            g_free(data); // Wrong size, deleting buffer to avoid leaking.
+            if (cache->write_buffer_size + info.size > WRITE_BUFFER_SIZE)
+                cache_flush(cache);
 
-            cache->read_position += read_bytes;
+            memcpy(cache->write_buffer + cache->write_buffer_size, info.data, info.size);
+            cache->write_buffer_size += info.size;
+            cache->write_position += info.size;
+        }
+        gst_buffer_unmap(buffer, &info);
     }
+}
+
+/***********************************************************************************
+ * Reading
+ ***********************************************************************************/
+// Returns the window that contains position, NULL if it can't be mapped.
+static CacheWindow* cache_get_window(Cache* cache, gint64 position)
+{
+    CacheWindow* window = cache->window;
+
+    if (window && window->store == cache->store &&
+        position >= window->offset && position < window->offset + window->size)
+        return window;
+
+    window = cache_window_new(cache, position);
+    if (window)
+    {
+        if (cache->window)
+            cache_window_unref(cache->window);
+        cache->window = window;
     }
-    return result;
+    return window;
 }
 
-static inline gboolean cache_set_handler_position(int handle, guint64 position)
+/* Wraps size bytes at position without copying them. size must not be larger
+ * than what is left in the window that contains position.
+ */
+static GstBuffer* cache_wrap_data(CacheWindow* window, gint64 position, guint size)
 {
-    return lseek(handle, position, SEEK_SET) >= 0;
+    GstBuffer* buffer;
+
+    g_atomic_int_inc(&window->refcount);
+    g_atomic_int_inc(&window->store->buffers);
+
+    buffer = gst_buffer_new_wrapped_full(GST_MEMORY_FLAG_READONLY, window->data + (position - window->offset),
+                                         size, 0, size, window, cache_window_buffer_free);
+    if (buffer == NULL)
+        cache_window_buffer_free(window);
+    return buffer;
+}
+
+// Copies size bytes at position, which may span windows.
+static GstBuffer* cache_copy_data(Cache* cache, gint64 position, guint size)
+{
+    guint8 *data = (guint8*)g_try_malloc(size);
+    guint copied = 0;
+
+    if (data == NULL)
+        return NULL;
+
+    while (copied < size)
+    {
+        CacheWindow* window = cache_get_window(cache, position + copied);
+        guint chunk;
+
+        if (window == NULL)
+        {
+            g_free(data);
+            return NULL;
+        }
+        chunk = (guint)MIN((gint64)(size - copied), window->offset + window->size - (position + copied));
+        memcpy(data + copied, window->data + (position + copied - window->offset), chunk);
+        copied += chunk;
+    }
+    return gst_buffer_new_wrapped_full(0, data, size, 0, size, data, g_free);
+}
+
+gint64 cache_read_buffer(Cache* cache, GstBuffer** buffer)
+{
+    CacheWindow* window;
+    gint64 available = cache->write_position - cache->write_buffer_size - cache->read_position;
+    guint size;
+
+    *buffer = NULL;
+
+    // Only flush once the reader caught up with the file.
+    if (available <= 0)
+    {
+        cache_flush(cache);
+        available = cache->write_position - cache->read_position;
+        if (available <= 0)
+            return 0;
+    }
+
+    window = cache_get_window(cache, cache->read_position);
+    if (window == NULL)
+        return 0;
+
+    // Buffers end at the window boundary so they never need a copy.
+    size = (guint)MIN(MIN(available, (gint64)cache->read_chunk_size),
+                      window->offset + window->size - cache->read_position);
+
+    *buffer = cache_wrap_data(window, cache->read_position, size);
+    if (*buffer == NULL)
+        return 0;
+
+    GST_BUFFER_OFFSET(*buffer) = cache->read_position;
+    cache->read_position += size;
+    return cache->read_position;
+}
+
+GstFlowReturn cache_read_buffer_from_position(Cache* cache, gint64 start_position, guint size, GstBuffer** buffer)
+{
+    CacheWindow* window;
+    *buffer = NULL;
+
+    if (!cache_set_read_position(cache, start_position) || start_position + size > cache->write_position)
+        return GST_FLOW_ERROR;
+
+    if (start_position + size > cache->write_position - cache->write_buffer_size)
+        cache_flush(cache);
+
+    window = cache_get_window(cache, start_position);
+    if (window == NULL)
+        return GST_FLOW_ERROR;
+
+    if (start_position + size <= window->offset + window->size)
+        *buffer = cache_wrap_data(window, start_position, size);
+    else
+        *buffer = cache_copy_data(cache, start_position, size);
+
+    if (*buffer == NULL)
+        return GST_FLOW_ERROR;
+
+    GST_BUFFER_OFFSET(*buffer) = start_position;
+    cache->read_position += size;
+    return GST_FLOW_OK;
+}
+
+/***********************************************************************************
+ * Positions
+ ***********************************************************************************/
+// Moves to a new, empty store, so the read buffers of the old one stay intact.
+static gboolean cache_detach_store(Cache* cache)
+{
+    CacheStore* store = cache_store_new(cache->store->capacity);
+    if (store == NULL)
+        return FALSE;
+
+    if (!store->memory)
+    {
+        cache_close_file(cache);
+        if (!cache_open_file(cache))
+        {
+            cache_store_unref(store);
+            return FALSE;
+        }
+    }
+
+    cache_replace_store(cache, store);
+    return TRUE;
 }
 
 gboolean cache_set_write_position(Cache* cache, gint64 position)
@@ -171,9 +531,17 @@ gboolean cache_set_write_position(Cache* cache, gint64 position)
     gboolean result = (position == cache->write_position);
     if (!result)
     {
-        result = cache_set_handler_position(cache->writeHandle, position);
-        if (result)
-            cache->write_position = position;
+        cache_flush(cache);
+
+        if (position < 0 || (cache->store->memory && position > cache->store->capacity))
+            return FALSE;
+
+        // All the data is about to be overwritten.
+        if (position == 0 && g_atomic_int_get(&cache->store->buffers) > 0 && !cache_detach_store(cache))
+            return FALSE;
+
+        cache->write_position = position;
+        result = TRUE;
     }
     return result;
 }
@@ -181,11 +549,10 @@ gboolean cache_set_write_position(Cache* cache, gint64 position)
 gboolean cache_set_read_position(Cache* cache, gint64 position)
 {
     gboolean result = (position == cache->read_position);
-    if (!result)
+    if (!result && position >= 0)
     {
-        result = cache_set_handler_position(cache->readHandle, position);
-        if (result)
-            cache->read_position = position;
+        cache->read_position = position;
+        result = TRUE;
     }
     return result;
 }
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2010, 2018, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2010, 2019, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -48,9 +48,14 @@ enum
     PROP_THRESHOLD,
     PROP_BANDWIDTH,
     PROP_PREBUFFER_TIME,
-    PROP_WAIT_TOLERANCE
+    PROP_WAIT_TOLERANCE,
+    PROP_READ_CHUNK_SIZE,
+    PROP_MEMORY_CACHE_SIZE
 };
 
+#define DEFAULT_READ_CHUNK_SIZE   (64 * 1024)
+#define DEFAULT_MEMORY_CACHE_SIZE (4 * 1024 * 1024)
+
 /***********************************************************************************
  * Element structures are hidden from outside
  ***********************************************************************************/
@@ -85,6 +90,8 @@ struct _ProgressBuffer
     gdouble       bandwidth; // property accessible.
     gdouble       prebuffer_time; // property controlled.
     gdouble       wait_tolerance; // property controlled.
+    guint         read_chunk_size; // property controlled.
+    gint64        memory_cache_size; // property controlled.
     GTimer        *bandwidth_timer;
 
     gboolean      unexpected;
@@ -237,6 +244,24 @@ static void progress_buffer_class_init (ProgressBufferClass *klass)
                                                           2.0  /* default value */,
                                                           G_PARAM_READWRITE | G_PARAM_CONSTRUCT));
 
+    g_object_class_install_property (gobject_class, PROP_READ_CHUNK_SIZE,
+                                     g_param_spec_uint ("read-chunk-size",
+                                                        "Read chunk size",
+                                                        "Largest size of the buffers pushed downstream in bytes.",
+                                                        4096  /* minimum value */,
+                                                        4 * 1024 * 1024 /* maximum value */,
+                                                        DEFAULT_READ_CHUNK_SIZE  /* default value */,
+                                                        G_PARAM_READWRITE | G_PARAM_CONSTRUCT));
+
+    g_object_class_install_property (gobject_class, PROP_MEMORY_CACHE_SIZE,
+                                     g_param_spec_int64 ("memory-cache-size",
+                                                         "Memory cache size",
+                                                         "Content of up to this many bytes is cached in memory instead of a temporary file, 0 disables.",
+                                                         0  /* minimum value */,
+                                                         G_MAXINT32 /* maximum value */,
+                                                         DEFAULT_MEMORY_CACHE_SIZE  /* default value */,
+                                                         G_PARAM_READWRITE | G_PARAM_CONSTRUCT));
+
     cache_static_init();
 }
 
@@ -288,6 +313,12 @@ static void progress_buffer_set_property (GObject *object, guint property_id,
         case PROP_WAIT_TOLERANCE:
             element->wait_tolerance = g_value_get_double(value);
             break;
+        case PROP_READ_CHUNK_SIZE:
+            element->read_chunk_size = g_value_get_uint(value);
+            break;
+        case PROP_MEMORY_CACHE_SIZE:
+            element->memory_cache_size = g_value_get_int64(value);
+            break;
 
         default:
             break;
@@ -321,6 +352,14 @@ static void progress_buffer_get_property (GObject *object, guint property_id,
             g_value_set_double(value, element->wait_tolerance);
             break;
 
+        case PROP_READ_CHUNK_SIZE:
+            g_value_set_uint(value, element->read_chunk_size);
+            break;
+
+        case PROP_MEMORY_CACHE_SIZE:
+            g_value_set_int64(value, element->memory_cache_size);
+            break;
+
         default:
             break;
     }
@@ -627,7 +666,11 @@ static GstFlowReturn progress_buffer_enqueue_item(ProgressBuffer *element, GstMi
                     if (element->cache)
                         destroy_cache(element->cache);
 
-                    element->cache = create_cache();
+                    element->cache = NULL;
+                    if (segment.stop - segment.start <= element->memory_cache_size)
+                        element->cache = create_memory_cache(segment.stop - segment.start);
+                    if (!element->cache)
+                        element->cache = create_cache();
                     if (!element->cache)
                     {
                         gst_element_message_full(GST_ELEMENT(element), GST_MESSAGE_ERROR, GST_RESOURCE_ERROR, GST_RESOURCE_ERROR_OPEN_READ_WRITE,
@@ -636,6 +679,7 @@ static GstFlowReturn progress_buffer_enqueue_item(ProgressBuffer *element, GstMi
                         gst_event_unref(event); // INLINE - gst_event_unref()
                         return GST_FLOW_ERROR;
                     }
+                    cache_set_read_chunk_size(element->cache, element->read_chunk_size);
                 }
                 else
                 {
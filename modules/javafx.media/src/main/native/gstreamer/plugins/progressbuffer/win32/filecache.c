@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2010, 2015, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2010, 2019, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -26,7 +26,7 @@
 #include <cache.h>
 #include <windows.h>
 
-#define DEFAULT_BUFFER_SIZE 4096
+#define DEFAULT_READ_CHUNK_SIZE (64 * 1024)
 static char tempDir[MAX_PATH];
 
 struct _Cache
@@ -37,6 +37,8 @@ struct _Cache
 
     gint64  read_position;
     gint64  write_position;
+
+    guint   read_chunk_size;
 };
 
 void cache_static_init(void)
@@ -67,6 +69,7 @@ Cache* create_cache()
                 goto _error_exit;
 
             result->read_position = result->write_position = 0;
+            result->read_chunk_size = DEFAULT_READ_CHUNK_SIZE;
         }
     }
     return result;
@@ -76,6 +79,12 @@ _error_exit:
     return NULL;
 }
 
+// Memory caches are only implemented for posix.
+Cache* create_memory_cache(gint64 size)
+{
+    return NULL;
+}
+
 void destroy_cache(Cache* instance)
 {
     CloseHandle(instance->writeHandle);
@@ -84,6 +93,11 @@ void destroy_cache(Cache* instance)
     g_free(instance);
 }
 
+void cache_set_read_chunk_size(Cache* cache, guint size)
+{
+    cache->read_chunk_size = MAX(size, 1);
+}
+
 void cache_write_buffer(Cache* cache, GstBuffer* buffer)
 {
     DWORD written = 0;
@@ -100,17 +114,19 @@ gint64 cache_read_buffer(Cache* cache, GstBuffer** buffer)
 {
     DWORD read = 0;
     DWORD size = 0;
-    guint8 *data = (guint8*)g_try_malloc(DEFAULT_BUFFER_SIZE);
+    guint8 *data;
     *buffer = NULL;
 
-    if ((cache->write_position - cache->read_position) > 0 && (cache->write_position - cache->read_position) < DEFAULT_BUFFER_SIZE)
+    if ((cache->write_position - cache->read_position) > 0 && (cache->write_position - cache->read_position) < cache->read_chunk_size)
         size = cache->write_position - cache->read_position;
     else
-        size = DEFAULT_BUFFER_SIZE;
+        size = cache->read_chunk_size;
+
+    data = (guint8*)g_try_malloc(size);
 
     if (data && ReadFile(cache->readHandle, data, size, &read, NULL))
     {
-        *buffer = gst_buffer_new_wrapped_full(0, data, DEFAULT_BUFFER_SIZE, 0, read, data, g_free);
+        *buffer = gst_buffer_new_wrapped_full(0, data, size, 0, read, data, g_free);
         if (*buffer != NULL)
             GST_BUFFER_OFFSET(*buffer) = cache->read_position;
 
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2010, 2013, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2010, 2019, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -32,6 +32,25 @@
 extern "C" {
 #endif
 
+    /*
+     * Implementations of the converters. The best one the CPU supports is
+     * picked the first time a frame is converted.
+     */
+    typedef enum {
+        COLOR_CONVERT_KERNEL_SCALAR,
+        COLOR_CONVERT_KERNEL_SSE2,
+        COLOR_CONVERT_KERNEL_AVX2,
+        COLOR_CONVERT_KERNEL_NEON,
+        COLOR_CONVERT_KERNEL_COUNT
+    } ColorConvertKernel;
+
+    int                ColorConvert_IsKernelSupported(ColorConvertKernel kernel);
+    ColorConvertKernel ColorConvert_GetKernel(void);
+    const char*        ColorConvert_GetKernelName(ColorConvertKernel kernel);
+
+    // Forces the given kernel, for testing. Returns 0 if it is not supported.
+    int                ColorConvert_SetKernel(ColorConvertKernel kernel);
+
     int ColorConvert_YCbCr420p_to_ARGB32(uint8_t *argb,
                                          int32_t argb_stride,
                                          int32_t width,
@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#include "ColorConverterKernels.h"
+
+#if ENABLE_SIMD_AVX2
+
+#include <immintrin.h>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define AVX2_FUNCTION
+#else
+#define AVX2_FUNCTION __attribute__((target("avx2")))
+#endif
+
+int ColorConvert_IsAVX2Supported(void)
+{
+#if defined(_MSC_VER)
+    int info[4];
+
+    __cpuid(info, 0);
+    if (info[0] < 7)
+        return 0;
+
+    // The OS has to save the YMM registers too.
+    __cpuid(info, 1);
+    if ((info[2] & (1 << 27)) == 0 || (_xgetbv(0) & 6) != 6)
+        return 0;
+
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+/*
+ * Converts 16 pixels. u and v hold the chroma sample of every pixel, that is
+ * each sample twice.
+ */
+AVX2_FUNCTION static void convert16(uint8_t *dst, int32_t format, __m128i y, __m128i u, __m128i v,
+                                    __m128i a, int32_t premultiply)
+{
+    const __m256i x_c0 = _mm256_set1_epi16(COLOR_CONVERT_C0);
+    const __m256i x_c1 = _mm256_set1_epi16(COLOR_CONVERT_C1);
+    const __m256i x_c4 = _mm256_set1_epi16(COLOR_CONVERT_C4);
+    const __m256i x_c5 = _mm256_set1_epi16(COLOR_CONVERT_C5);
+    const __m256i x_c8 = _mm256_set1_epi16(COLOR_CONVERT_C8);
+    const __m256i x_coff0 = _mm256_set1_epi16(COLOR_CONVERT_COFF0);
+    const __m256i x_coff1 = _mm256_set1_epi16(COLOR_CONVERT_COFF1);
+    const __m256i x_coff2 = _mm256_set1_epi16(COLOR_CONVERT_COFF2);
+    __m256i x_y, x_u, x_v, x_b, x_g, x_r, x_temp;
+    __m128i b, g, r, lo, hi, lo1, hi1;
+
+    // Samples go in the high byte, mulhi then gives (sample * c) >> 8.
+    x_y = _mm256_slli_epi16(_mm256_cvtepu8_epi16(y), 8);
+    x_u = _mm256_slli_epi16(_mm256_cvtepu8_epi16(u), 8);
+    x_v = _mm256_slli_epi16(_mm256_cvtepu8_epi16(v), 8);
+
+    x_y = _mm256_mulhi_epu16(x_y, x_c0);
+
+    x_temp = _mm256_add_epi16(_mm256_mulhi_epu16(x_u, x_c1), x_coff0);
+    x_b = _mm256_srai_epi16(_mm256_add_epi16(x_y, x_temp), 5);
+
+    x_temp = _mm256_add_epi16(_mm256_mulhi_epu16(x_u, x_c4), _mm256_mulhi_epu16(x_v, x_c5));
+    x_temp = _mm256_sub_epi16(x_coff1, x_temp);
+    x_g = _mm256_srai_epi16(_mm256_add_epi16(x_y, x_temp), 5);
+
+    x_temp = _mm256_add_epi16(_mm256_mulhi_epu16(x_v, x_c8), x_coff2);
+    x_r = _mm256_srai_epi16(_mm256_add_epi16(x_y, x_temp), 5);
+
+    if (premultiply) {
+        const __m256i x_zero = _mm256_setzero_si256();
+        const __m256i x_max = _mm256_set1_epi16(0xff);
+        __m256i x_a = _mm256_add_epi16(_mm256_cvtepu8_epi16(a), _mm256_set1_epi16(1));
+
+        x_b = _mm256_min_epi16(_mm256_max_epi16(x_b, x_zero), x_max);
+        x_g = _mm256_min_epi16(_mm256_max_epi16(x_g, x_zero), x_max);
+        x_r = _mm256_min_epi16(_mm256_max_epi16(x_r, x_zero), x_max);
+        x_b = _mm256_srli_epi16(_mm256_mullo_epi16(x_b, x_a), 8);
+        x_g = _mm256_srli_epi16(_mm256_mullo_epi16(x_g, x_a), 8);
+        x_r = _mm256_srli_epi16(_mm256_mullo_epi16(x_r, x_a), 8);
+    }
+
+    /* pack: 16=>8 */
+    b = _mm_packus_epi16(_mm256_castsi256_si128(x_b), _mm256_extracti128_si256(x_b, 1));
+    g = _mm_packus_epi16(_mm256_castsi256_si128(x_g), _mm256_extracti128_si256(x_g, 1));
+    r = _mm_packus_epi16(_mm256_castsi256_si128(x_r), _mm256_extracti128_si256(x_r, 1));
+
+    if (format == COLOR_CONVERT_ARGB) {
+        lo = _mm_unpacklo_epi8(a, r);
+        hi = _mm_unpackhi_epi8(a, r);
+        lo1 = _mm_unpacklo_epi8(g, b);
+        hi1 = _mm_unpackhi_epi8(g, b);
+    } else {
+        lo = _mm_unpacklo_epi8(b, g);
+        hi = _mm_unpackhi_epi8(b, g);
+        lo1 = _mm_unpacklo_epi8(r, a);
+        hi1 = _mm_unpackhi_epi8(r, a);
+    }
+
+    _mm_storeu_si128((__m128i*)dst, _mm_unpacklo_epi16(lo, lo1));
+    _mm_storeu_si128((__m128i*)(dst + 16), _mm_unpackhi_epi16(lo, lo1));
+    _mm_storeu_si128((__m128i*)(dst + 32), _mm_unpacklo_epi16(hi, hi1));
+    _mm_storeu_si128((__m128i*)(dst + 48), _mm_unpackhi_epi16(hi, hi1));
+}
+
+AVX2_FUNCTION void ColorConvert_Row_avx2(uint8_t *dst, int32_t format, int32_t width,
+                                         const uint8_t *y, const uint8_t *u, const uint8_t *v,
+                                         const uint8_t *a, int32_t packed)
+{
+    const __m128i x_opaque = _mm_set1_epi8((char)0xff);
+    __m128i x_y, x_u, x_v;
+    int32_t i = 0;
+
+    if (!packed) {
+        for (; i <= width - 16; i += 16) {
+            x_y = _mm_loadu_si128((const __m128i*)(y + i));
+            x_u = _mm_loadl_epi64((const __m128i*)(u + i / 2));
+            x_v = _mm_loadl_epi64((const __m128i*)(v + i / 2));
+            convert16(dst + 4 * i, format, x_y,
+                      _mm_unpacklo_epi8(x_u, x_u), _mm_unpacklo_epi8(x_v, x_v),
+                      a ? _mm_loadu_si128((const __m128i*)(a + i)) : x_opaque,
+                      a != NULL && format == COLOR_CONVERT_BGRA_PRE);
+        }
+
+        if (i < width)
+            ColorConvert_Row_scalar(dst + 4 * i, format, width - i, y + i, u + i / 2, v + i / 2,
+                                    a ? a + i : NULL, packed);
+    } else {
+        const uint8_t *base;
+        int32_t yo, uo, vo;
+
+        if (ColorConvert_PackedLayout(y, u, v, &base, &yo, &uo, &vo)) {
+            // Gather the 8 luma and the twice repeated 4 chroma samples of
+            // 4 groups into the low half of a register.
+            const __m128i x_ymask = _mm_setr_epi8(yo, yo + 2, yo + 4, yo + 6, yo + 8, yo + 10, yo + 12, yo + 14,
+                                                  -1, -1, -1, -1, -1, -1, -1, -1);
+            const __m128i x_umask = _mm_setr_epi8(uo, uo, uo + 4, uo + 4, uo + 8, uo + 8, uo + 12, uo + 12,
+                                                  -1, -1, -1, -1, -1, -1, -1, -1);
+            const __m128i x_vmask = _mm_setr_epi8(vo, vo, vo + 4, vo + 4, vo + 8, vo + 8, vo + 12, vo + 12,
+                                                  -1, -1, -1, -1, -1, -1, -1, -1);
+            __m128i x_in0, x_in1;
+
+            for (; i <= width - 16; i += 16) {
+                x_in0 = _mm_loadu_si128((const __m128i*)(base + 2 * i));
+                x_in1 = _mm_loadu_si128((const __m128i*)(base + 2 * i + 16));
+                x_y = _mm_unpacklo_epi64(_mm_shuffle_epi8(x_in0, x_ymask), _mm_shuffle_epi8(x_in1, x_ymask));
+                x_u = _mm_unpacklo_epi64(_mm_shuffle_epi8(x_in0, x_umask), _mm_shuffle_epi8(x_in1, x_umask));
+                x_v = _mm_unpacklo_epi64(_mm_shuffle_epi8(x_in0, x_vmask), _mm_shuffle_epi8(x_in1, x_vmask));
+                convert16(dst + 4 * i, format, x_y, x_u, x_v, x_opaque, 0);
+            }
+        }
+
+        if (i < width)
+            ColorConvert_Row_scalar(dst + 4 * i, format, width - i, y + 2 * i, u + 2 * i, v + 2 * i,
+                                    NULL, packed);
+    }
+}
+
+#endif // ENABLE_SIMD_AVX2
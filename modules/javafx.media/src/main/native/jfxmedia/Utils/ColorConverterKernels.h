@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#ifndef __COLOR_CONVERTER_KERNELS_H__
+#define __COLOR_CONVERTER_KERNELS_H__
+
+/*
+ * Row kernels shared by the converters in ColorConverter.c. Every kernel
+ * computes the same fixed point arithmetic as the original SSE2 code, so
+ * all of them produce identical output:
+ *
+ *   yy = (Y * C0) >> 8
+ *   B  = clamp((yy + ((U * C1) >> 8) + COFF0) >> 5)
+ *   G  = clamp((yy + COFF1 - ((U * C4) >> 8) - ((V * C5) >> 8)) >> 5)
+ *   R  = clamp((yy + ((V * C8) >> 8) + COFF2) >> 5)
+ *
+ * and premultiplies BGRA output by (c * (A + 1)) >> 8 when there is alpha.
+ * All the intermediate values fit in 16 bits.
+ */
+
+#include <stdint.h>
+
+#if (defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)) && \
+    (defined(__clang__) || (defined(__GNUC__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))) || \
+     (defined(_MSC_VER) && _MSC_VER >= 1700))
+#define ENABLE_SIMD_AVX2 1
+#else
+#define ENABLE_SIMD_AVX2 0
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(__aarch64__)
+#define ENABLE_SIMD_NEON 1
+#else
+#define ENABLE_SIMD_NEON 0
+#endif
+
+/* 1.1644  * 8192 */
+#define COLOR_CONVERT_C0     0x2543
+/* 2.0184  * 8192 */
+#define COLOR_CONVERT_C1     0x4097
+/* abs( -0.3920 * 8192 ) */
+#define COLOR_CONVERT_C4     0xc8b
+/* abs( -0.8132 * 8192 ) */
+#define COLOR_CONVERT_C5     0x1a06
+/* 1.5966  * 8192 */
+#define COLOR_CONVERT_C8     0x3317
+/* -276.9856 * 32 */
+#define COLOR_CONVERT_COFF0  (-0x22a0)
+/* 135.6352  * 32 */
+#define COLOR_CONVERT_COFF1  0x10f4
+/* -222.9952 * 32 */
+#define COLOR_CONVERT_COFF2  (-0x1be0)
+
+/* Destination layouts */
+#define COLOR_CONVERT_ARGB      0   /* A, R, G, B bytes, alpha is not premultiplied */
+#define COLOR_CONVERT_BGRA_PRE  1   /* B, G, R, A bytes, alpha is premultiplied */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Converts one row of width pixels. If packed is 0 the planes are planar
+ * with one chroma sample per two pixels. Otherwise they are interleaved
+ * 4:2:2 like UYVY or YUY2: luma samples are 2 bytes apart and each chroma
+ * sample is 4 bytes from the next one. a may be NULL for opaque pixels.
+ */
+typedef void (*ColorConvertRowFunc)(uint8_t *dst, int32_t format, int32_t width,
+                                    const uint8_t *y, const uint8_t *u, const uint8_t *v,
+                                    const uint8_t *a, int32_t packed);
+
+void ColorConvert_Row_scalar(uint8_t *dst, int32_t format, int32_t width,
+                             const uint8_t *y, const uint8_t *u, const uint8_t *v,
+                             const uint8_t *a, int32_t packed);
+
+/*
+ * Finds the start of the 4 byte groups of packed 4:2:2 data and the offset
+ * of the first luma sample and of the chroma samples within a group.
+ * Returns 0 if y, u and v do not describe such a layout.
+ */
+int ColorConvert_PackedLayout(const uint8_t *y, const uint8_t *u, const uint8_t *v,
+                              const uint8_t **base, int32_t *y_offset,
+                              int32_t *u_offset, int32_t *v_offset);
+
+#if ENABLE_SIMD_AVX2
+int  ColorConvert_IsAVX2Supported(void);
+void ColorConvert_Row_avx2(uint8_t *dst, int32_t format, int32_t width,
+                           const uint8_t *y, const uint8_t *u, const uint8_t *v,
+                           const uint8_t *a, int32_t packed);
+#endif
+
+#if ENABLE_SIMD_NEON
+void ColorConvert_Row_neon(uint8_t *dst, int32_t format, int32_t width,
+                           const uint8_t *y, const uint8_t *u, const uint8_t *v,
+                           const uint8_t *a, int32_t packed);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __COLOR_CONVERTER_KERNELS_H__
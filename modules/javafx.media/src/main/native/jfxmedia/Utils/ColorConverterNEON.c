@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#include "ColorConverterKernels.h"
+
+#if ENABLE_SIMD_NEON
+
+#include <arm_neon.h>
+
+/*
+ * vqdmulh computes (2 * a * b) >> 16, so with the sample shifted left by 7
+ * it gives the same (sample * c) >> 8 as the x86 kernels.
+ */
+#define MUL_HI(x, c) vqdmulhq_n_s16(x, c)
+#define WIDEN(x) vreinterpretq_s16_u16(vshll_n_u8(x, 7))
+
+static uint8x8_t premultiply(uint8x8_t c, uint8x8_t a)
+{
+    return vshrn_n_u16(vaddw_u8(vmull_u8(c, a), c), 8);
+}
+
+/*
+ * Converts 16 pixels from 16 luma and 8 chroma samples.
+ */
+static void convert16(uint8_t *dst, int32_t format, uint8x16_t y, uint8x8_t u, uint8x8_t v,
+                      uint8x16_t a, int32_t alpha)
+{
+    int16x8_t x_u = WIDEN(u);
+    int16x8_t x_v = WIDEN(v);
+    int16x8_t x_cb, x_cg, x_cr, x_y;
+    int16x8x2_t x_b2, x_g2, x_r2;
+    uint8x8_t b[2], g[2], r[2];
+    int32_t h;
+
+    x_cb = vaddq_s16(MUL_HI(x_u, COLOR_CONVERT_C1), vdupq_n_s16(COLOR_CONVERT_COFF0));
+    x_cg = vsubq_s16(vdupq_n_s16(COLOR_CONVERT_COFF1),
+                     vaddq_s16(MUL_HI(x_u, COLOR_CONVERT_C4), MUL_HI(x_v, COLOR_CONVERT_C5)));
+    x_cr = vaddq_s16(MUL_HI(x_v, COLOR_CONVERT_C8), vdupq_n_s16(COLOR_CONVERT_COFF2));
+
+    // Every chroma sample covers two pixels.
+    x_b2 = vzipq_s16(x_cb, x_cb);
+    x_g2 = vzipq_s16(x_cg, x_cg);
+    x_r2 = vzipq_s16(x_cr, x_cr);
+
+    for (h = 0; h < 2; h++) {
+        x_y = MUL_HI(WIDEN(h ? vget_high_u8(y) : vget_low_u8(y)), COLOR_CONVERT_C0);
+        b[h] = vqmovun_s16(vshrq_n_s16(vaddq_s16(x_y, x_b2.val[h]), 5));
+        g[h] = vqmovun_s16(vshrq_n_s16(vaddq_s16(x_y, x_g2.val[h]), 5));
+        r[h] = vqmovun_s16(vshrq_n_s16(vaddq_s16(x_y, x_r2.val[h]), 5));
+
+        if (alpha && format == COLOR_CONVERT_BGRA_PRE) {
+            uint8x8_t x_a = h ? vget_high_u8(a) : vget_low_u8(a);
+            b[h] = premultiply(b[h], x_a);
+            g[h] = premultiply(g[h], x_a);
+            r[h] = premultiply(r[h], x_a);
+        }
+    }
+
+    if (format == COLOR_CONVERT_ARGB) {
+        uint8x16x4_t argb;
+        argb.val[0] = a;
+        argb.val[1] = vcombine_u8(r[0], r[1]);
+        argb.val[2] = vcombine_u8(g[0], g[1]);
+        argb.val[3] = vcombine_u8(b[0], b[1]);
+        vst4q_u8(dst, argb);
+    } else {
+        uint8x16x4_t bgra;
+        bgra.val[0] = vcombine_u8(b[0], b[1]);
+        bgra.val[1] = vcombine_u8(g[0], g[1]);
+        bgra.val[2] = vcombine_u8(r[0], r[1]);
+        bgra.val[3] = a;
+        vst4q_u8(dst, bgra);
+    }
+}
+
+void ColorConvert_Row_neon(uint8_t *dst, int32_t format, int32_t width,
+                           const uint8_t *y, const uint8_t *u, const uint8_t *v,
+                           const uint8_t *a, int32_t packed)
+{
+    const uint8x16_t x_opaque = vdupq_n_u8(0xff);
+    int32_t i = 0;
+
+    if (!packed) {
+        for (; i <= width - 16; i += 16) {
+            convert16(dst + 4 * i, format, vld1q_u8(y + i), vld1_u8(u + i / 2), vld1_u8(v + i / 2),
+                      a ? vld1q_u8(a + i) : x_opaque, a != NULL);
+        }
+
+        if (i < width)
+            ColorConvert_Row_scalar(dst + 4 * i, format, width - i, y + i, u + i / 2, v + i / 2,
+                                    a ? a + i : NULL, packed);
+    } else {
+        const uint8_t *base;
+        int32_t yo, uo, vo;
+
+        if (ColorConvert_PackedLayout(y, u, v, &base, &yo, &uo, &vo)) {
+            for (; i <= width - 16; i += 16) {
+                // Split 8 groups into their 4 bytes.
+                uint8x8x4_t in = vld4_u8(base + 2 * i);
+                uint8x8x2_t x_y = vzip_u8(in.val[yo], in.val[yo + 2]);
+
+                convert16(dst + 4 * i, format, vcombine_u8(x_y.val[0], x_y.val[1]),
+                          in.val[uo], in.val[vo], x_opaque, 0);
+            }
+        }
+
+        if (i < width)
+            ColorConvert_Row_scalar(dst + 4 * i, format, width - i, y + 2 * i, u + 2 * i, v + 2 * i,
+                                    NULL, packed);
+    }
+}
+
+#endif // ENABLE_SIMD_NEON
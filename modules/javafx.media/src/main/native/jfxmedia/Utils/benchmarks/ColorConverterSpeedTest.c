@@ -0,0 +1,286 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * Checks that every ColorConverter kernel this CPU supports produces the same
+ * bytes as the scalar one and measures their throughput. From the jfxmedia
+ * source root it builds standalone like so:
+ * cc -o ColorConverterSpeedTest -O2 -DTARGET_OS_LINUX=1 -msse2 -I. Utils/benchmarks/ColorConverterSpeedTest.c Utils/ColorConverter.c Utils/ColorConverterAVX2.c Utils/ColorConverterNEON.c
+ * On ARM drop -msse2 and add -mfpu=neon where NEON is not the default.
+ *
+ * Usage: ColorConverterSpeedTest [<width> <height> [<frames>]]
+ * The default converts 200 frames of 1920x1080.
+ */
+
+#include <Utils/ColorConverter.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define ALIGN16(x) (((x) + 15) & ~15)
+
+typedef struct {
+    int32_t width;
+    int32_t height;
+    uint8_t *y, *u, *v, *a;     // planar 4:2:0 with alpha
+    uint8_t *uyvy;              // packed 4:2:2
+    int32_t y_stride, uv_stride, uyvy_stride;
+} Source;
+
+typedef int (*Converter)(const Source *src, uint8_t *dst, int32_t dst_stride);
+
+static int convert_420_argb(const Source *s, uint8_t *dst, int32_t dst_stride)
+{
+    return ColorConvert_YCbCr420p_to_ARGB32(dst, dst_stride, s->width, s->height, s->y, s->v, s->u, s->a,
+                                            s->y_stride, s->uv_stride, s->uv_stride, s->y_stride);
+}
+
+static int convert_420_argb_no_alpha(const Source *s, uint8_t *dst, int32_t dst_stride)
+{
+    return ColorConvert_YCbCr420p_to_ARGB32_no_alpha(dst, dst_stride, s->width, s->height, s->y, s->v, s->u,
+                                                     s->y_stride, s->uv_stride, s->uv_stride);
+}
+
+static int convert_420_bgra(const Source *s, uint8_t *dst, int32_t dst_stride)
+{
+    return ColorConvert_YCbCr420p_to_BGRA32(dst, dst_stride, s->width, s->height, s->y, s->v, s->u, s->a,
+                                            s->y_stride, s->uv_stride, s->uv_stride, s->y_stride);
+}
+
+static int convert_420_bgra_no_alpha(const Source *s, uint8_t *dst, int32_t dst_stride)
+{
+    return ColorConvert_YCbCr420p_to_BGRA32_no_alpha(dst, dst_stride, s->width, s->height, s->y, s->v, s->u,
+                                                     s->y_stride, s->uv_stride, s->uv_stride);
+}
+
+// The layout CGstVideoFrame and CVVideoFrame pass for UYVY.
+static int convert_422_argb_no_alpha(const Source *s, uint8_t *dst, int32_t dst_stride)
+{
+    return ColorConvert_YCbCr422p_to_ARGB32_no_alpha(dst, dst_stride, s->width, s->height,
+                                                     s->uyvy + 1, s->uyvy + 2, s->uyvy,
+                                                     s->uyvy_stride, s->uyvy_stride);
+}
+
+static int convert_422_bgra_no_alpha(const Source *s, uint8_t *dst, int32_t dst_stride)
+{
+    return ColorConvert_YCbCr422p_to_BGRA32_no_alpha(dst, dst_stride, s->width, s->height,
+                                                     s->uyvy + 1, s->uyvy + 2, s->uyvy,
+                                                     s->uyvy_stride, s->uyvy_stride);
+}
+
+static const struct {
+    const char *name;
+    Converter convert;
+} converters[] = {
+    { "YCbCr420p_to_ARGB32", convert_420_argb },
+    { "YCbCr420p_to_ARGB32_no_alpha", convert_420_argb_no_alpha },
+    { "YCbCr420p_to_BGRA32", convert_420_bgra },
+    { "YCbCr420p_to_BGRA32_no_alpha", convert_420_bgra_no_alpha },
+    { "YCbCr422p_to_ARGB32_no_alpha", convert_422_argb_no_alpha },
+    { "YCbCr422p_to_BGRA32_no_alpha", convert_422_bgra_no_alpha },
+};
+
+#define CONVERTER_COUNT (sizeof(converters) / sizeof(converters[0]))
+
+static void *alloc_aligned(size_t size)
+{
+    uint8_t *p = (uint8_t*)malloc(size + 16 + sizeof(void*));
+    uint8_t *aligned;
+
+    if (p == NULL) {
+        printf("Out of memory\n");
+        exit(1);
+    }
+    aligned = (uint8_t*)ALIGN16((intptr_t)(p + sizeof(void*)));
+    ((void**)aligned)[-1] = p;
+    return aligned;
+}
+
+static void free_aligned(void *p)
+{
+    free(((void**)p)[-1]);
+}
+
+static uint32_t seed = 1;
+
+static void fill_random(uint8_t *p, size_t size)
+{
+    size_t i;
+    for (i = 0; i < size; i++) {
+        seed = seed * 1103515245 + 12345;
+        p[i] = (uint8_t)(seed >> 16);
+    }
+}
+
+static void init_source(Source *s, int32_t width, int32_t height)
+{
+    s->width = width;
+    s->height = height;
+    s->y_stride = ALIGN16(width);
+    s->uv_stride = ALIGN16((width + 1) / 2);
+    s->uyvy_stride = ALIGN16(2 * (width + 1));
+
+    s->y = (uint8_t*)alloc_aligned((size_t)s->y_stride * height);
+    s->a = (uint8_t*)alloc_aligned((size_t)s->y_stride * height);
+    s->u = (uint8_t*)alloc_aligned((size_t)s->uv_stride * ((height + 1) / 2));
+    s->v = (uint8_t*)alloc_aligned((size_t)s->uv_stride * ((height + 1) / 2));
+    s->uyvy = (uint8_t*)alloc_aligned((size_t)s->uyvy_stride * height);
+
+    fill_random(s->y, (size_t)s->y_stride * height);
+    fill_random(s->a, (size_t)s->y_stride * height);
+    fill_random(s->u, (size_t)s->uv_stride * ((height + 1) / 2));
+    fill_random(s->v, (size_t)s->uv_stride * ((height + 1) / 2));
+    fill_random(s->uyvy, (size_t)s->uyvy_stride * height);
+}
+
+static void free_source(Source *s)
+{
+    free_aligned(s->y);
+    free_aligned(s->a);
+    free_aligned(s->u);
+    free_aligned(s->v);
+    free_aligned(s->uyvy);
+}
+
+/*
+ * Converts with the given kernel and with the scalar one and compares every
+ * pixel. The SSE2 kernel only converts even sizes.
+ */
+static int verify(ColorConvertKernel kernel, size_t c, int32_t width, int32_t height)
+{
+    Source s;
+    int32_t stride = ALIGN16(4 * width);
+    size_t size = (size_t)stride * height;
+    uint8_t *expected = (uint8_t*)alloc_aligned(size);
+    uint8_t *actual = (uint8_t*)alloc_aligned(size);
+    int32_t j, ok = 1;
+
+    init_source(&s, width, height);
+    memset(expected, 0, size);
+    memset(actual, 0, size);
+
+    ColorConvert_SetKernel(COLOR_CONVERT_KERNEL_SCALAR);
+    ok &= converters[c].convert(&s, expected, stride) == 0;
+    ColorConvert_SetKernel(kernel);
+    ok &= converters[c].convert(&s, actual, stride) == 0;
+
+    for (j = 0; ok && j < height; j++)
+        ok = memcmp(expected + (size_t)j * stride, actual + (size_t)j * stride, 4 * width) == 0;
+
+    free_source(&s);
+    free_aligned(expected);
+    free_aligned(actual);
+    return ok;
+}
+
+static double seconds(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static double run(ColorConvertKernel kernel, size_t c, const Source *s, uint8_t *dst, int32_t stride, int frames)
+{
+    double start;
+    int i;
+
+    ColorConvert_SetKernel(kernel);
+    start = seconds();
+    for (i = 0; i < frames; i++)
+        converters[c].convert(s, dst, stride);
+    return (double)s->width * s->height * frames / (seconds() - start) / 1e6;
+}
+
+static void usage(void)
+{
+    printf("Usage: ColorConverterSpeedTest [<width> <height> [<frames>]]\n");
+    exit(1);
+}
+
+int main(int argc, char **argv)
+{
+    static const int32_t sizes[][2] = {
+        { 2, 2 }, { 16, 2 }, { 30, 4 }, { 32, 32 }, { 34, 6 }, { 62, 10 }, { 100, 50 }, { 638, 360 },
+        { 1, 1 }, { 17, 3 }, { 33, 5 }, { 47, 9 },
+    };
+    int32_t width = 1920, height = 1080;
+    int frames = 200, failed = 0;
+    ColorConvertKernel best = ColorConvert_GetKernel();
+    int32_t stride;
+    uint8_t *dst;
+    Source s;
+    size_t c, i;
+    int k;
+
+    if (argc != 1 && argc != 3 && argc != 4)
+        usage();
+    if (argc >= 3) {
+        width = atoi(argv[1]);
+        height = atoi(argv[2]);
+    }
+    if (argc == 4)
+        frames = atoi(argv[3]);
+    if (width <= 0 || height <= 0 || frames <= 0)
+        usage();
+
+    stride = ALIGN16(4 * width);
+    dst = (uint8_t*)alloc_aligned((size_t)stride * height);
+    init_source(&s, width, height);
+
+    printf("%d frames of %dx%d, best kernel: %s\n", frames, width, height, ColorConvert_GetKernelName(best));
+
+    for (c = 0; c < CONVERTER_COUNT; c++) {
+        double scalar = 0;
+
+        printf("%s\n", converters[c].name);
+        for (k = 0; k < COLOR_CONVERT_KERNEL_COUNT; k++) {
+            int correct = 1;
+            double mpps;
+
+            if (!ColorConvert_IsKernelSupported((ColorConvertKernel)k))
+                continue;
+
+            for (i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+                int odd = (sizes[i][0] | sizes[i][1]) & 1;
+                if (odd && k == COLOR_CONVERT_KERNEL_SSE2)
+                    continue;
+                correct &= verify((ColorConvertKernel)k, c, sizes[i][0], sizes[i][1]);
+            }
+            failed |= !correct;
+
+            mpps = run((ColorConvertKernel)k, c, &s, dst, stride, frames);
+            if (k == COLOR_CONVERT_KERNEL_SCALAR)
+                scalar = mpps;
+            printf("    %-8s %8.1f Mpixels/s %5.2fx%s\n", ColorConvert_GetKernelName((ColorConvertKernel)k),
+                   mpps, mpps / scalar, correct ? "" : "  MISMATCH");
+        }
+    }
+
+    free_source(&s);
+    free_aligned(dst);
+    return failed ? 1 : 0;
+}
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2010, 2018, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2010, 2019, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -26,6 +26,7 @@
 #include "GstAVPlaybackPipeline.h"
 
 #include "GstVideoFrame.h"
+#include "GstVideoFramePool.h"
 #include <gst/gst.h>
 #include <gst/app/gstappsink.h>
 #include <PipelineManagement/VideoTrack.h>
@@ -60,6 +61,7 @@ CGstAVPlaybackPipeline::CGstAVPlaybackPipeline(const GstElementContainer& elemen
     m_FrameHeight = 0;
     m_videoCodecErrorCode = ERROR_NONE;
     m_bStaticPipeline = false; // For now all video pipelines are dynamic
+    m_pVideoFramePool = CGstVideoFramePool::Create();
 }
 
 /**
@@ -73,6 +75,9 @@ CGstAVPlaybackPipeline::~CGstAVPlaybackPipeline()
     g_print ("CGstAVPlaybackPipeline::~CGstAVPlaybackPipeline()\n");
 #endif
     LOGGER_LOGMSG(LOGGER_DEBUG, "CGstAVPlaybackPipeline::~CGstAVPlaybackPipeline()");
+
+    // Frames still held by Java keep the pool alive.
+    CGstVideoFramePool::ReleaseRef(m_pVideoFramePool);
 }
 
 /**
@@ -273,7 +278,7 @@ GstFlowReturn CGstAVPlaybackPipeline::OnAppSinkHaveFrame(GstElement* pElem, CGst
         OnAppSinkVideoFrameDiscont(pPipeline, pSample);
 
     //***** Create a VideoFrame object
-    CGstVideoFrame* pVideoFrame = new CGstVideoFrame();
+    CGstVideoFrame* pVideoFrame = new CGstVideoFrame(pPipeline->m_pVideoFramePool);
     if (!pVideoFrame->Init(pSample))
     {
         gst_sample_unref(pSample);
@@ -337,7 +342,7 @@ GstFlowReturn CGstAVPlaybackPipeline::OnAppSinkPreroll(GstElement* pElem, CGstAV
     // Send frome 0 up to use as poster frame.
     if(pPipeline->m_pEventDispatcher != NULL)
     {
-        CGstVideoFrame* pVideoFrame = new CGstVideoFrame();
+        CGstVideoFrame* pVideoFrame = new CGstVideoFrame(pPipeline->m_pVideoFramePool);
         if (!pVideoFrame->Init(pSample))
         {
             // INLINE - gst_sample_unref()
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2010, 2015, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2010, 2019, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -32,6 +32,7 @@
 #include "GstAudioPlaybackPipeline.h"
 #include "GstPipelineFactory.h"
 
+class CGstVideoFramePool;
 
 /**
  * class CGstAVPlaybackPipeline
@@ -81,6 +82,7 @@ private:
     gulong                  m_videoDecoderSrcProbeHID;
     gfloat                  m_EncodedVideoFrameRate;
     int                     m_videoCodecErrorCode;
+    CGstVideoFramePool*     m_pVideoFramePool;
 };
 
 #endif  //_GST_AV_PLAYBACK_PIPELINE_H_
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2010, 2018, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2010, 2019, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -1459,7 +1459,14 @@ gboolean CGstAudioPlaybackPipeline::BusCallback(GstBus* bus, GstMessage* msg, sB
                     }
                 }
           }
-
+#if ENABLE_LOGGING
+            else if (gst_structure_has_name(pStr, AV_VIDEO_DECODER_STATS_MESSAGE))
+            {
+                gchar *stats = gst_structure_to_string(pStr);
+                LOGGER_LOGMSG(LOGGER_DEBUG, stats);
+                g_free(stats);
+            }
+#endif // ENABLE_LOGGING
         }
             break;
 
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2010, 2016, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2010, 2019, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -67,6 +67,9 @@ enum CODEC_ID
 #define HLS_PB_MESSAGE_FULL         "hls_pb_full"
 #define HLS_PB_MESSAGE_NOT_FULL     "hls_pb_not_full"
 
+// Taken from videodecoder.h
+#define AV_VIDEO_DECODER_STATS_MESSAGE "avvideodecoder-stats"
+
 class CGstAudioPlaybackPipeline;
 struct sBusCallbackContent
 {
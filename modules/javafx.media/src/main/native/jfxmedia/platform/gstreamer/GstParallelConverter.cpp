@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#include "GstParallelConverter.h"
+#include <glib.h>
+#include <Utils/LowLevelPerf.h>
+
+// Beyond four bands the conversion is limited by memory bandwidth.
+#define MAX_BANDS           4
+#define MIN_PARALLEL_PIXELS (1280 * 720)
+
+struct sJob
+{
+    GMutex  lock;
+    GCond   done;
+    int     pending;
+    int     status;
+};
+
+struct sBand
+{
+    CGstParallelConverter::BandFunc func;
+    void*   pContext;
+    int     iFirstRow;
+    int     iRowCount;
+    sJob*   pJob;
+};
+
+static GThreadPool* g_pWorkers = NULL;
+static int          g_iMaxBands = 1;
+
+static void run_band(gpointer data, gpointer user_data)
+{
+    sBand* band = (sBand*)data;
+    sJob* job = band->pJob;
+    int status = band->func(band->pContext, band->iFirstRow, band->iRowCount);
+
+    g_mutex_lock(&job->lock);
+    if (status != 0)
+        job->status = status;
+    if (--job->pending == 0)
+        g_cond_signal(&job->done);
+    g_mutex_unlock(&job->lock);
+}
+
+static gpointer create_workers(gpointer data)
+{
+    int bands = MIN((int)g_get_num_processors(), MAX_BANDS);
+
+    if (bands > 1)
+    {
+        g_pWorkers = g_thread_pool_new(run_band, NULL, bands - 1, FALSE, NULL);
+        if (NULL != g_pWorkers)
+            g_iMaxBands = bands;
+    }
+    return NULL;
+}
+
+int CGstParallelConverter::Run(BandFunc func, void* pContext, int iWidth, int iRows, int iRowAlign)
+{
+    static GOnce once = G_ONCE_INIT;
+    sBand bands[MAX_BANDS];
+    sJob job;
+    int bandCount, bandRows, row, i;
+
+    g_once(&once, create_workers, NULL);
+
+    if (g_iMaxBands < 2 || iWidth * iRows < MIN_PARALLEL_PIXELS)
+        return func(pContext, 0, iRows);
+
+    bandRows = (iRows + g_iMaxBands - 1) / g_iMaxBands;
+    bandRows = (bandRows + iRowAlign - 1) / iRowAlign * iRowAlign;
+
+    bandCount = 0;
+    for (row = 0; row < iRows; row += bandRows)
+    {
+        bands[bandCount].func = func;
+        bands[bandCount].pContext = pContext;
+        bands[bandCount].iFirstRow = row;
+        bands[bandCount].iRowCount = MIN(bandRows, iRows - row);
+        bands[bandCount].pJob = &job;
+        bandCount++;
+    }
+
+    g_mutex_init(&job.lock);
+    g_cond_init(&job.done);
+    job.pending = bandCount;
+    job.status = 0;
+
+    for (i = 1; i < bandCount; i++)
+    {
+        // Convert the band here if no worker can be started.
+        if (!g_thread_pool_push(g_pWorkers, &bands[i], NULL))
+            run_band(&bands[i], NULL);
+    }
+    run_band(&bands[0], NULL);
+
+    g_mutex_lock(&job.lock);
+    while (job.pending > 0)
+        g_cond_wait(&job.done, &job.lock);
+    g_mutex_unlock(&job.lock);
+
+    g_cond_clear(&job.done);
+    g_mutex_clear(&job.lock);
+
+    LOWLEVELPERF_RESETCOUNTER("ParallelConvertedFrames");
+
+    return job.status;
+}
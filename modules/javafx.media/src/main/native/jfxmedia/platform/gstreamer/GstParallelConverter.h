@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#ifndef _GST_PARALLEL_CONVERTER_H_
+#define _GST_PARALLEL_CONVERTER_H_
+
+/**
+ * class CGstParallelConverter
+ *
+ * Runs a frame conversion in bands of rows on a small pool of worker threads
+ * shared by all players. The calling thread converts the first band itself and
+ * waits for the others. Frames smaller than 720p, and all frames on single
+ * core machines, are converted on the calling thread only.
+ */
+class CGstParallelConverter
+{
+public:
+    // Converts rows [iFirstRow, iFirstRow + iRowCount), returns 0 on success.
+    typedef int (*BandFunc)(void* pContext, int iFirstRow, int iRowCount);
+
+    /*
+     * Converts iRows rows of iWidth pixels. Every band but the last starts and
+     * ends on a multiple of iRowAlign. Returns 0 if all bands succeeded.
+     */
+    static int Run(BandFunc func, void* pContext, int iWidth, int iRows, int iRowAlign);
+};
+
+#endif  //_GST_PARALLEL_CONVERTER_H_
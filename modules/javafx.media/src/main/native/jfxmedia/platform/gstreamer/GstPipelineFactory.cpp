@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2010, 2017, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2010, 2019, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -35,6 +35,7 @@
 #include <jfxmedia_errors.h>
 #include <gst/gstelement.h>
 #include <Utils/LowLevelPerf.h>
+#include <jni/Logger.h>
 #include <algorithm>
 #if ENABLE_VIDEOCONVERT
 #include <gst/app/gstappsink.h>
@@ -43,6 +44,7 @@
 // From HLSConnectionHolder.java
 #define HLS_PROP_GET_HLS_MODE   2
 #define HLS_PROP_GET_MIMETYPE   3
+#define HLS_PROP_GET_LOOKAHEAD  4
 #define HLS_VALUE_MIMETYPE_MP2T 1
 #define HLS_VALUE_MIMETYPE_MP3  2
 
@@ -247,6 +249,15 @@ uint32_t CGstPipelineFactory::CreateSourceElement(CLocator* locator, GstElement*
                 if (NULL == buffer)
                     return ERROR_GSTREAMER_ELEMENT_CREATE;
 
+                if (hlsMode == 1)
+                {
+                    // Make room for the segments the holder downloads ahead, so that they
+                    // are handed over as soon as they arrive.
+                    int lookahead = callbacks->Property(HLS_PROP_GET_LOOKAHEAD, 0);
+                    if (lookahead > 0)
+                        g_object_set (buffer, "cached-segments", (guint)CLAMP(lookahead + 1, 3, 16), NULL);
+                }
+
                 gst_bin_add_many(GST_BIN(source), javaSource, buffer, NULL);
 
                 if (!gst_element_link(javaSource, buffer))
@@ -816,6 +827,15 @@ uint32_t CGstPipelineFactory::CreateVideoBin(const char* strDecoderName, GstElem
     if (NULL == videodec || NULL == videoqueue)
         return ERROR_GSTREAMER_ELEMENT_CREATE;
 
+#if ENABLE_LOGGING
+    // Have the decoder report its threading and throughput when debug
+    // messages are logged.
+    CLogger *pLogger = CLogger::getLogger();
+    if (pLogger && pLogger->canLog(LOGGER_DEBUG) &&
+        g_object_class_find_property(G_OBJECT_GET_CLASS(videodec), "stats-interval"))
+        g_object_set(videodec, "stats-interval", 5000, NULL);
+#endif // ENABLE_LOGGING
+
     if(NULL == pVideoSink)
     {
         pVideoSink = CreateElement ("autovideosink");
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2010, 2016, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2010, 2019, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -25,6 +25,8 @@
 
 #include "GstVideoFrame.h"
 #include "GstPipelineFactory.h"
+#include "GstVideoFramePool.h"
+#include "GstParallelConverter.h"
 #include <cstring>
 #include <Common/ProductFlags.h>
 #include <Common/VSMemory.h>
@@ -64,7 +66,7 @@ static GstBuffer *alloc_aligned_buffer(guint size)
 
     alignedData = (guint8*)(((intptr_t)newData + 15) & ~15);
 
-    return gst_buffer_new_wrapped_full((GstMemoryFlags)0, alignedData, alignedSize, 0, 0, newData, free_aligned_buffer);
+    return gst_buffer_new_wrapped_full((GstMemoryFlags)0, alignedData, alignedSize, 0, alignedSize, newData, free_aligned_buffer);
 }
 
 GstCaps *create_RGB_caps(CVideoFrame::FrameType type, gint width, gint height, gint encodedWidth, gint encodedHeight, gint stride)
@@ -102,12 +104,78 @@ GstCaps *create_RGB_caps(CVideoFrame::FrameType type, gint width, gint height, g
     return newCaps;
 }
 
-CGstVideoFrame::CGstVideoFrame()
+// The source planes and destination of a conversion from YCbCr. The chroma
+// pointers and strides are in the order ColorConvert takes them, Cr first.
+struct sYCbCrConversion
+{
+    CVideoFrame::FrameType destType;
+    bool            bHasAlpha;
+    uint8_t*        pDest;
+    int             iDestStride;
+    int             iWidth;
+    const uint8_t*  pY;
+    const uint8_t*  pCr;
+    const uint8_t*  pCb;
+    const uint8_t*  pA;
+    int             iYStride;
+    int             iCrStride;
+    int             iCbStride;
+    int             iAStride;
+};
+
+// Rows of 4:2:0 frames are converted in pairs, as they share a chroma row,
+// so firstRow is always even.
+static int convert_420p_rows(void* pContext, int firstRow, int rowCount)
+{
+    const sYCbCrConversion* c = (const sYCbCrConversion*)pContext;
+    uint8_t* dest = c->pDest + firstRow * c->iDestStride;
+    const uint8_t* y = c->pY + firstRow * c->iYStride;
+    const uint8_t* cr = c->pCr + (firstRow / 2) * c->iCrStride;
+    const uint8_t* cb = c->pCb + (firstRow / 2) * c->iCbStride;
+
+    if (c->destType == CVideoFrame::ARGB) {
+        if (c->bHasAlpha) {
+            return ColorConvert_YCbCr420p_to_ARGB32(dest, c->iDestStride, c->iWidth, rowCount,
+                                                    y, cr, cb, c->pA + firstRow * c->iAStride,
+                                                    c->iYStride, c->iCrStride, c->iCbStride, c->iAStride);
+        }
+        return ColorConvert_YCbCr420p_to_ARGB32_no_alpha(dest, c->iDestStride, c->iWidth, rowCount,
+                                                         y, cr, cb, c->iYStride, c->iCrStride, c->iCbStride);
+    }
+
+    if (c->bHasAlpha) {
+        return ColorConvert_YCbCr420p_to_BGRA32(dest, c->iDestStride, c->iWidth, rowCount,
+                                                y, cr, cb, c->pA + firstRow * c->iAStride,
+                                                c->iYStride, c->iCrStride, c->iCbStride, c->iAStride);
+    }
+    return ColorConvert_YCbCr420p_to_BGRA32_no_alpha(dest, c->iDestStride, c->iWidth, rowCount,
+                                                     y, cr, cb, c->iYStride, c->iCrStride, c->iCbStride);
+}
+
+// All three pointers point into the same packed plane.
+static int convert_422_rows(void* pContext, int firstRow, int rowCount)
+{
+    const sYCbCrConversion* c = (const sYCbCrConversion*)pContext;
+    uint8_t* dest = c->pDest + firstRow * c->iDestStride;
+    int offset = firstRow * c->iYStride;
+
+    if (c->destType == CVideoFrame::ARGB) {
+        return ColorConvert_YCbCr422p_to_ARGB32_no_alpha(dest, c->iDestStride, c->iWidth, rowCount,
+                                                         c->pY + offset, c->pCr + offset, c->pCb + offset,
+                                                         c->iYStride, c->iCbStride);
+    }
+    return ColorConvert_YCbCr422p_to_BGRA32_no_alpha(dest, c->iDestStride, c->iWidth, rowCount,
+                                                     c->pY + offset, c->pCr + offset, c->pCb + offset,
+                                                     c->iYStride, c->iCbStride);
+}
+
+CGstVideoFrame::CGstVideoFrame(CGstVideoFramePool* pFramePool)
 {
     m_bIsValid = false;
     m_pSample = NULL;
     m_pBuffer = NULL;
     m_bIsI420 = false;
+    m_pFramePool = CGstVideoFramePool::AddRef(pFramePool);
 }
 
 CGstVideoFrame::~CGstVideoFrame()
@@ -116,6 +184,8 @@ CGstVideoFrame::~CGstVideoFrame()
 
     if (NULL != m_pBuffer)
         Dispose();
+
+    CGstVideoFramePool::ReleaseRef(m_pFramePool);
 }
 
 bool CGstVideoFrame::Init(GstSample* sample)
@@ -340,6 +410,14 @@ void CGstVideoFrame::Dispose()
     }
 }
 
+GstBuffer *CGstVideoFrame::AllocBuffer(guint size)
+{
+    if (NULL != m_pFramePool) {
+        return m_pFramePool->AllocBuffer(size);
+    }
+    return alloc_aligned_buffer(size);
+}
+
 CVideoFrame *CGstVideoFrame::ConvertToFormat(FrameType type)
 {
     CGstVideoFrame *newFrame = NULL;
@@ -381,6 +459,7 @@ CGstVideoFrame *CGstVideoFrame::ConvertFromYCbCr420p(FrameType destType)
     GstBuffer *destBuffer = NULL;
     GstCaps *destCaps = NULL;
     GstMapInfo info;
+    sYCbCrConversion conversion;
     gint stride = m_iEncodedWidth * 4;
     int u_index, v_index;
     int status;
@@ -394,7 +473,7 @@ CGstVideoFrame *CGstVideoFrame::ConvertFromYCbCr420p(FrameType destType)
     }
 
     stride = ((stride + 15) & ~15); // round up to multiple of 16 bytes
-    destBuffer = alloc_aligned_buffer(stride * m_iEncodedHeight);
+    destBuffer = AllocBuffer(stride * m_iEncodedHeight);
     if (!destBuffer) {
         return NULL;
     }
@@ -411,49 +490,22 @@ CGstVideoFrame *CGstVideoFrame::ConvertFromYCbCr420p(FrameType destType)
     }
 
     // now do the conversion
-    if (destType == ARGB) {
-        if (m_bHasAlpha) {
-            status = ColorConvert_YCbCr420p_to_ARGB32(
-                        info.data, stride,
-                        m_iEncodedWidth, m_iEncodedHeight,
-                        (const uint8_t*)m_pvPlaneData[0],
-                        (const uint8_t*)m_pvPlaneData[v_index],
-                        (const uint8_t*)m_pvPlaneData[u_index],
-                        (const uint8_t*)m_pvPlaneData[3],
-                        m_piPlaneStrides[0], m_piPlaneStrides[v_index],
-                        m_piPlaneStrides[u_index], m_piPlaneStrides[3]);
-        } else {
-            status = ColorConvert_YCbCr420p_to_ARGB32_no_alpha(
-                        info.data, stride,
-                        m_iEncodedWidth, m_iEncodedHeight,
-                        (const uint8_t*)m_pvPlaneData[0],
-                        (const uint8_t*)m_pvPlaneData[v_index],
-                        (const uint8_t*)m_pvPlaneData[u_index],
-                        m_piPlaneStrides[0], m_piPlaneStrides[v_index],
-                        m_piPlaneStrides[u_index]);
-        }
-    } else {
-        if (m_bHasAlpha) {
-            status = ColorConvert_YCbCr420p_to_BGRA32(
-                        info.data, stride,
-                        m_iEncodedWidth, m_iEncodedHeight,
-                        (const uint8_t*)m_pvPlaneData[0],
-                        (const uint8_t*)m_pvPlaneData[v_index],
-                        (const uint8_t*)m_pvPlaneData[u_index],
-                        (const uint8_t*)m_pvPlaneData[3],
-                        m_piPlaneStrides[0], m_piPlaneStrides[v_index],
-                        m_piPlaneStrides[u_index], m_piPlaneStrides[3]);
-        } else {
-            status = ColorConvert_YCbCr420p_to_BGRA32_no_alpha(
-                        info.data, stride,
-                        m_iEncodedWidth, m_iEncodedHeight,
-                        (const uint8_t*)m_pvPlaneData[0],
-                        (const uint8_t*)m_pvPlaneData[v_index],
-                        (const uint8_t*)m_pvPlaneData[u_index],
-                        m_piPlaneStrides[0], m_piPlaneStrides[v_index],
-                        m_piPlaneStrides[u_index]);
-        }
-    }
+    conversion.destType = destType;
+    conversion.bHasAlpha = m_bHasAlpha;
+    conversion.pDest = info.data;
+    conversion.iDestStride = stride;
+    conversion.iWidth = m_iEncodedWidth;
+    conversion.pY = (const uint8_t*)m_pvPlaneData[0];
+    conversion.pCr = (const uint8_t*)m_pvPlaneData[v_index];
+    conversion.pCb = (const uint8_t*)m_pvPlaneData[u_index];
+    conversion.pA = m_bHasAlpha ? (const uint8_t*)m_pvPlaneData[3] : NULL;
+    conversion.iYStride = m_piPlaneStrides[0];
+    conversion.iCrStride = m_piPlaneStrides[v_index];
+    conversion.iCbStride = m_piPlaneStrides[u_index];
+    conversion.iAStride = m_bHasAlpha ? m_piPlaneStrides[3] : 0;
+
+    status = CGstParallelConverter::Run(convert_420p_rows, &conversion,
+                                        m_iEncodedWidth, m_iEncodedHeight, 2);
 
     gst_buffer_unmap(destBuffer, &info);
 
@@ -475,7 +527,7 @@ CGstVideoFrame *CGstVideoFrame::ConvertFromYCbCr420p(FrameType destType)
     gst_caps_unref(destCaps);
 
     if (0 == status && destSample) {
-        CGstVideoFrame *newFrame = new CGstVideoFrame();
+        CGstVideoFrame *newFrame = new CGstVideoFrame(m_pFramePool);
         bool result = newFrame->Init(destSample);
         // INLINE - gst_sample_unref()
         gst_buffer_unref(destBuffer); // else we'll have a massive memory leak!
@@ -493,6 +545,7 @@ CGstVideoFrame *CGstVideoFrame::ConvertFromYCbCr422(FrameType destType)
     GstBuffer *destBuffer;
     GstCaps *destCaps;
     GstMapInfo info;
+    sYCbCrConversion conversion;
     gint stride = m_iEncodedWidth * 4;
     int status = 1;
 
@@ -502,7 +555,7 @@ CGstVideoFrame *CGstVideoFrame::ConvertFromYCbCr422(FrameType destType)
     }
 
     stride = ((stride + 15) & ~15); // round up to multiple of 16 bytes
-    destBuffer = alloc_aligned_buffer(stride * m_iEncodedHeight);
+    destBuffer = AllocBuffer(stride * m_iEncodedHeight);
     if (!destBuffer) {
         return NULL;
     }
@@ -519,21 +572,22 @@ CGstVideoFrame *CGstVideoFrame::ConvertFromYCbCr422(FrameType destType)
     }
 
     // now do the conversion
-    if (destType == ARGB) {
-        status = ColorConvert_YCbCr422p_to_ARGB32_no_alpha(info.data, stride,
-                                                           m_iEncodedWidth, m_iEncodedHeight,
-                                                           (uint8_t*)m_pvPlaneData[0] + 1,
-                                                           (uint8_t*)m_pvPlaneData[0] + 2,
-                                                           (uint8_t*)m_pvPlaneData[0],
-                                                           m_piPlaneStrides[0], m_piPlaneStrides[0]);
-    } else {
-        status = ColorConvert_YCbCr422p_to_BGRA32_no_alpha(info.data, stride,
-                                                           m_iEncodedWidth, m_iEncodedHeight,
-                                                           (uint8_t*)m_pvPlaneData[0] + 1,
-                                                           (uint8_t*)m_pvPlaneData[0] + 2,
-                                                           (uint8_t*)m_pvPlaneData[0],
-                                                           m_piPlaneStrides[0], m_piPlaneStrides[0]);
-    }
+    conversion.destType = destType;
+    conversion.bHasAlpha = false;
+    conversion.pDest = info.data;
+    conversion.iDestStride = stride;
+    conversion.iWidth = m_iEncodedWidth;
+    conversion.pY = (const uint8_t*)m_pvPlaneData[0] + 1;
+    conversion.pCr = (const uint8_t*)m_pvPlaneData[0] + 2;
+    conversion.pCb = (const uint8_t*)m_pvPlaneData[0];
+    conversion.pA = NULL;
+    conversion.iYStride = m_piPlaneStrides[0];
+    conversion.iCrStride = m_piPlaneStrides[0];
+    conversion.iCbStride = m_piPlaneStrides[0];
+    conversion.iAStride = 0;
+
+    status = CGstParallelConverter::Run(convert_422_rows, &conversion,
+                                        m_iEncodedWidth, m_iEncodedHeight, 1);
 
     gst_buffer_unmap(destBuffer, &info);
 
@@ -555,7 +609,7 @@ CGstVideoFrame *CGstVideoFrame::ConvertFromYCbCr422(FrameType destType)
     gst_caps_unref(destCaps);
 
     if (0 == status && destBuffer) {
-        CGstVideoFrame *newFrame = new CGstVideoFrame();
+        CGstVideoFrame *newFrame = new CGstVideoFrame(m_pFramePool);
         bool result = newFrame->Init(destSample);
         // INLINE - gst_buffer_unref()
         gst_buffer_unref(destBuffer); // else we'll have a massive memory leak!
@@ -579,7 +633,7 @@ CGstVideoFrame *CGstVideoFrame::ConvertSwapRGB(FrameType destType)
 
     size = gst_buffer_get_size(m_pBuffer);
 
-    destBuffer = alloc_aligned_buffer(size);
+    destBuffer = AllocBuffer(size);
     if (!destBuffer) {
         return NULL;
     }
@@ -665,7 +719,7 @@ CGstVideoFrame *CGstVideoFrame::ConvertSwapRGB(FrameType destType)
     gst_buffer_unmap(destBuffer, &destInfo);
 
     if (destBuffer) {
-        CGstVideoFrame *newFrame = new CGstVideoFrame();
+        CGstVideoFrame *newFrame = new CGstVideoFrame(m_pFramePool);
         bool result = newFrame->Init(destSample);
         // INLINE - gst_buffer_unref()
         gst_buffer_unref(destBuffer); // else we'll have a massive memory leak!
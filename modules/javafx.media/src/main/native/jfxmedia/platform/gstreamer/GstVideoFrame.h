@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2010, 2015, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2010, 2019, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -29,6 +29,8 @@
 #include <gst/gst.h>
 #include <PipelineManagement/VideoFrame.h>
 
+class CGstVideoFramePool;
+
 #define FOURCC_I420 "I420"
 #define FOURCC_UYVY "UYVY"
 
@@ -40,7 +42,11 @@
 class CGstVideoFrame : public CVideoFrame
 {
 public:
-    CGstVideoFrame();
+    /*
+     * Frames converted from this one take their buffers from pFramePool,
+     * or allocate them if it is NULL.
+     */
+    CGstVideoFrame(CGstVideoFramePool* pFramePool = NULL);
 
     virtual ~CGstVideoFrame();
 
@@ -69,7 +75,9 @@ private:
     void*       m_pvBufferBaseAddress;
     unsigned long m_ulBufferSize;
     bool        m_bIsI420;
+    CGstVideoFramePool* m_pFramePool;
 
+    GstBuffer *AllocBuffer(guint size);
     CGstVideoFrame *ConvertSwapRGB(FrameType destType);
     CGstVideoFrame *ConvertFromYCbCr420p(FrameType destType);
     CGstVideoFrame *ConvertFromYCbCr422(FrameType destType);
@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#include "GstVideoFramePool.h"
+#include <Utils/JfxCriticalSection.h>
+#include <Utils/LowLevelPerf.h>
+
+// Idle buffers kept for reuse. The frame queue on the Java side holds a
+// couple of converted frames, more than that is never in flight for long.
+#define MAX_FREE_BLOCKS 4
+
+CGstVideoFramePool* CGstVideoFramePool::Create()
+{
+    CGstVideoFramePool* pool = new CGstVideoFramePool();
+    if (NULL == pool->m_pLock)
+    {
+        delete pool;
+        return NULL;
+    }
+    return pool;
+}
+
+CGstVideoFramePool* CGstVideoFramePool::AddRef(CGstVideoFramePool* pool)
+{
+    if (pool != NULL)
+        g_atomic_int_add(&pool->m_RefCounter, 1);
+    return pool;
+}
+
+void CGstVideoFramePool::ReleaseRef(CGstVideoFramePool* pool)
+{
+    if (pool != NULL && g_atomic_int_dec_and_test(&pool->m_RefCounter))
+        delete pool;
+}
+
+CGstVideoFramePool::CGstVideoFramePool()
+{
+    g_atomic_int_set(&m_RefCounter, 1);
+    m_pLock = CJfxCriticalSection::Create();
+    m_FreeSize = 0;
+}
+
+CGstVideoFramePool::~CGstVideoFramePool()
+{
+    for (size_t i = 0; i < m_FreeBlocks.size(); i++)
+        FreeBlock(m_FreeBlocks[i]);
+    m_FreeBlocks.clear();
+
+    delete m_pLock;
+}
+
+GstBuffer* CGstVideoFramePool::AllocBuffer(guint size)
+{
+    sBlock* block = NULL;
+
+    m_pLock->Enter();
+    if (size == m_FreeSize && !m_FreeBlocks.empty())
+    {
+        block = m_FreeBlocks.back();
+        m_FreeBlocks.pop_back();
+    }
+    m_pLock->Exit();
+
+    if (NULL != block)
+    {
+        LOWLEVELPERF_RESETCOUNTER("VideoFramePoolHit");
+    }
+    else
+    {
+        LOWLEVELPERF_RESETCOUNTER("VideoFramePoolMiss");
+
+        // allocate a buffer large enough to accommodate 16 byte alignment
+        guint8* data = (guint8*)g_try_malloc(size + 16);
+        if (NULL == data)
+            return NULL;
+
+        block = new sBlock;
+        block->pData = data;
+        block->size = size;
+        LOWLEVELPERF_COUNTERINC("VideoFramePoolBuffers", 1, 1);
+    }
+
+    // Every buffer handed out keeps the pool alive until it comes back.
+    block->pPool = AddRef(this);
+    return WrapBlock(block);
+}
+
+GstBuffer* CGstVideoFramePool::WrapBlock(sBlock* block)
+{
+    guint8* alignedData = (guint8*)(((intptr_t)block->pData + 15) & ~15);
+
+    return gst_buffer_new_wrapped_full((GstMemoryFlags)0, alignedData, block->size, 0, block->size,
+                                       block, ReturnBlock);
+}
+
+void CGstVideoFramePool::ReturnBlock(gpointer data)
+{
+    sBlock* block = (sBlock*)data;
+    CGstVideoFramePool* pool = block->pPool;
+
+    block->pPool = NULL;
+    pool->Recycle(block);
+    ReleaseRef(pool);
+}
+
+void CGstVideoFramePool::FreeBlock(sBlock* block)
+{
+    LOWLEVELPERF_COUNTERDEC("VideoFramePoolBuffers", 1, 1);
+    g_free(block->pData);
+    delete block;
+}
+
+void CGstVideoFramePool::Recycle(sBlock* block)
+{
+    std::vector<sBlock*> staleBlocks;
+
+    m_pLock->Enter();
+    if (block->size != m_FreeSize)
+    {
+        // The frame size changed, the idle buffers will not be asked for again.
+        staleBlocks.swap(m_FreeBlocks);
+        m_FreeSize = block->size;
+    }
+
+    if (m_FreeBlocks.size() < MAX_FREE_BLOCKS)
+    {
+        m_FreeBlocks.push_back(block);
+        block = NULL;
+    }
+    m_pLock->Exit();
+
+    for (size_t i = 0; i < staleBlocks.size(); i++)
+        FreeBlock(staleBlocks[i]);
+    if (NULL != block)
+        FreeBlock(block);
+}
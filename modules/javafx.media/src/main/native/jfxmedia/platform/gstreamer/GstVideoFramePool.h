@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#ifndef _GST_VIDEO_FRAME_POOL_H_
+#define _GST_VIDEO_FRAME_POOL_H_
+
+#include <gst/gst.h>
+#include <vector>
+
+class CJfxCriticalSection;
+
+/**
+ * class CGstVideoFramePool
+ *
+ * Recycles the 16 byte aligned buffers that CGstVideoFrame converts frames
+ * into. A buffer goes back to the pool when its last reference is dropped
+ * and is handed out again for a frame of the same size, which is the row
+ * stride times the encoded height. Only a few idle buffers of the current
+ * size are kept, so the pool never holds more than a handful of frames.
+ *
+ * The pool is shared by all the frames of a player and is reference counted,
+ * as converted frames and their buffers may outlive the pipeline.
+ */
+class CGstVideoFramePool
+{
+public:
+    static CGstVideoFramePool* Create();
+
+    static CGstVideoFramePool* AddRef(CGstVideoFramePool* pool);
+    static void                ReleaseRef(CGstVideoFramePool* pool);
+
+    // Returns a buffer of the given size, NULL if out of memory.
+    GstBuffer* AllocBuffer(guint size);
+
+private:
+    struct sBlock
+    {
+        CGstVideoFramePool* pPool;
+        guint8*             pData;   // as returned by g_try_malloc()
+        guint               size;
+    };
+
+    CGstVideoFramePool();
+    ~CGstVideoFramePool();
+
+    static GstBuffer* WrapBlock(sBlock* block);
+    static void       ReturnBlock(gpointer block);
+    static void       FreeBlock(sBlock* block);
+
+    void Recycle(sBlock* block);
+
+    volatile int          m_RefCounter;
+    CJfxCriticalSection*  m_pLock;
+    std::vector<sBlock*>  m_FreeBlocks;
+    guint                 m_FreeSize;   // size of the blocks in m_FreeBlocks
+};
+
+#endif  //_GST_VIDEO_FRAME_POOL_H_
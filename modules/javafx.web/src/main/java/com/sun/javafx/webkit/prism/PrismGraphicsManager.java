@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2011, 2017, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2011, 2019, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -132,10 +132,11 @@ public final class PrismGraphicsManager extends WCGraphicsManager {
 
     @Override
     protected WCImageFrame createFrame(int w, int h, ByteBuffer bytes) {
-        int[] data = new int[bytes.capacity() / 4];
-        bytes.order(ByteOrder.nativeOrder());
-        bytes.asIntBuffer().get(data);
-        final WCImageImpl wimg = new WCImageImpl(data, w, h);
+        // Keep the pixels off the Java heap, decoded photos can be large
+        ByteBuffer data = ByteBuffer.allocateDirect(bytes.capacity())
+                .order(ByteOrder.nativeOrder());
+        data.put(bytes).rewind();
+        final WCImageImpl wimg = new WCImageImpl(data.asIntBuffer(), w, h);
 
         return new WCImageFrame() {
             @Override public WCImage getFrame() { return wimg; }
@@ -111,14 +111,29 @@ final class WCFontImpl extends WCFont {
         return strike;
     }
 
-    @Override public double getGlyphWidth(int glyph) {
-        return getFontStrike().getFontResource().getAdvance(glyph, font.getSize());
+    @Override public float[] getGlyphWidths(int firstGlyph, int count) {
+        FontResource fr = getFontStrike().getFontResource();
+        float size = font.getSize();
+        float[] widths = new float[count];
+        for (int i = 0; i < count; i++) {
+            widths[i] = fr.getAdvance(firstGlyph + i, size);
+        }
+        return widths;
     }
 
-    @Override public float[] getGlyphBoundingBox(int glyph) {
+    @Override public float[] getGlyphBoundingBoxes(int firstGlyph, int count) {
+        FontResource fr = getFontStrike().getFontResource();
+        float size = font.getSize();
         float[] bb = new float[4];
-        bb = getFontStrike().getFontResource().getGlyphBoundingBox(glyph, font.getSize(), bb);
-        return new float[]{bb[0], -bb[3], bb[2], bb[3] - bb[1]};
+        float[] boxes = new float[4 * count];
+        for (int i = 0; i < count; i++) {
+            bb = fr.getGlyphBoundingBox(firstGlyph + i, size, bb);
+            boxes[4 * i] = bb[0];
+            boxes[4 * i + 1] = -bb[3];
+            boxes[4 * i + 2] = bb[2];
+            boxes[4 * i + 3] = bb[3] - bb[1];
+        }
+        return boxes;
     }
 
     @Override public float getXHeight() {
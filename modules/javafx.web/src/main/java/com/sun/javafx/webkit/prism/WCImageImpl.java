@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2011, 2018, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2011, 2019, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -38,6 +38,7 @@ import com.sun.prism.image.CompoundTexture;
 import com.sun.prism.image.Coords;
 import com.sun.prism.image.ViewPort;
 import java.nio.ByteBuffer;
+import java.nio.IntBuffer;
 import javafx.scene.image.PixelFormat;
 
 /**
@@ -60,7 +61,7 @@ final class WCImageImpl extends PrismImage {
         img = Image.fromIntArgbPreData(new int[w*h], w, h);
     }
 
-    WCImageImpl(int[] buffer, int w, int h) {
+    WCImageImpl(IntBuffer buffer, int w, int h) {
         if (log.isLoggable(Level.FINE)) {
             log.fine("Creating image({0},{1}) from buffer",
                     new Object[] {w, h});
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2011, 2018, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2011, 2019, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -27,15 +27,18 @@ package com.sun.webkit;
 
 import com.sun.javafx.logging.PlatformLogger;
 import java.io.File;
-import java.io.FileNotFoundException;
 import java.io.IOException;
 import java.io.RandomAccessFile;
 import static java.lang.String.format;
 import java.nio.ByteBuffer;
 import java.nio.channels.FileChannel;
+import java.nio.file.DirectoryStream;
 import java.nio.file.Files;
 import java.nio.file.InvalidPathException;
+import java.nio.file.Path;
 import java.nio.file.Paths;
+import java.util.ArrayList;
+import java.util.List;
 
 final class FileSystem {
 
@@ -56,10 +59,68 @@ final class FileSystem {
         return new File(path).exists();
     }
 
+    private static boolean fwkDeleteFile(String path) {
+        try {
+            Path file = Paths.get(path);
+            if (!Files.isDirectory(file)) {
+                return Files.deleteIfExists(file);
+            }
+        } catch (InvalidPathException | IOException | SecurityException ex) {
+            logger.fine(format("Error deleting file [%s]", path), ex);
+        }
+        return false;
+    }
+
+    private static boolean fwkDeleteEmptyDirectory(String path) {
+        try {
+            Path directory = Paths.get(path);
+            if (Files.isDirectory(directory)) {
+                Files.delete(directory);
+                return true;
+            }
+        } catch (InvalidPathException | IOException | SecurityException ex) {
+            logger.fine(format("Error deleting directory [%s]", path), ex);
+        }
+        return false;
+    }
+
+    /**
+     * Returns the paths of the entries in {@code path} whose names match
+     * the glob {@code filter}, or an empty array if the directory cannot
+     * be read.
+     */
+    private static String[] fwkListDirectory(String path, String filter) {
+        List<String> entries = new ArrayList<>();
+        try (DirectoryStream<Path> stream =
+                 Files.newDirectoryStream(Paths.get(path), filter)) {
+            for (Path entry : stream) {
+                entries.add(entry.toString());
+            }
+        } catch (InvalidPathException | IOException | SecurityException ex) {
+            logger.fine(format("Error listing directory [%s]", path), ex);
+        }
+        return entries.toArray(new String[0]);
+    }
+
+    /**
+     * Opens {@code path} with the given {@code RandomAccessFile} mode.
+     * The additional mode {@code "w"} opens the file for writing and
+     * truncates it, creating it if necessary.
+     */
     private static RandomAccessFile fwkOpenFile(String path, String mode) {
         try {
+            if ("w".equals(mode)) {
+                RandomAccessFile raf = new RandomAccessFile(path, "rw");
+                try {
+                    raf.setLength(0);
+                } catch (IOException ex) {
+                    raf.close();
+                    throw ex;
+                }
+                return raf;
+            }
             return new RandomAccessFile(path, mode);
-        } catch (FileNotFoundException | SecurityException ex) {
+        } catch (IOException | SecurityException ex) {
             logger.fine(format("Error while creating RandomAccessFile for file [%s]", path), ex);
         }
         return null;
@@ -83,6 +144,20 @@ final class FileSystem {
         return -1;
     }
 
+    private static int fwkWriteToFile(RandomAccessFile raf, ByteBuffer byteBuffer) {
+        try {
+            FileChannel fc = raf.getChannel();
+            int written = 0;
+            while (byteBuffer.hasRemaining()) {
+                written += fc.write(byteBuffer);
+            }
+            return written;
+        } catch (IOException ex) {
+            logger.fine(format("Error while writing RandomAccessFile for file [%s]", raf), ex);
+        }
+        return -1;
+    }
+
     private static void fwkSeekFile(RandomAccessFile raf, long pos) {
         try {
             raf.seek(pos);
@@ -25,6 +25,9 @@
 
 package com.sun.webkit;
 
+import java.util.Timer;
+import java.util.TimerTask;
+
 /**
  * The class reflects the native webkit module.
  */
@@ -36,9 +39,34 @@ final class MainThread {
         });
     }
 
+    private static Timer runLoopTimer;
+
+    private static void fwkScheduleRunLoopWakeUp(long delay) {
+        if (delay <= 0) {
+            Invoker.getInvoker().postOnEventThread(() -> {
+                twkRunMainLoop();
+            });
+            return;
+        }
+        synchronized (MainThread.class) {
+            if (runLoopTimer == null) {
+                runLoopTimer = new Timer("WebPane-RunLoop", true);
+            }
+            runLoopTimer.schedule(new TimerTask() {
+                @Override public void run() {
+                    Invoker.getInvoker().postOnEventThread(() -> {
+                        twkRunMainLoop();
+                    });
+                }
+            }, delay);
+        }
+    }
+
     private static boolean fwkIsMainThread() {
         return Invoker.getInvoker().isEventThread();
     }
 
     private static native void twkScheduleDispatchFunctions();
+
+    private static native void twkRunMainLoop();
 }
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2012, 2014, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2012, 2019, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -25,8 +25,13 @@
 
 package com.sun.webkit;
 
+import java.nio.ByteBuffer;
+
 public final class SharedBuffer {
 
+    private static final ByteBuffer EMPTY_BUFFER =
+            ByteBuffer.allocateDirect(0).asReadOnlyBuffer();
+
     private long nativePointer;
 
 
@@ -80,6 +85,34 @@ public final class SharedBuffer {
         return twkGetSomeData(nativePointer, position, buffer, offset, length);
     }
 
+    /**
+     * Returns a read-only view of the data starting at {@code position},
+     * up to the end of the native segment that contains it, or an empty
+     * buffer if {@code position} is equal to the size of this buffer.
+     * The view shares memory with the native segment and remains valid
+     * after this buffer is disposed.
+     */
+    ByteBuffer getSomeData(long position) {
+        if (nativePointer == 0) {
+            throw new IllegalStateException("nativePointer is 0");
+        }
+        if (position < 0) {
+            throw new IndexOutOfBoundsException("position is negative");
+        }
+        if (position > size()) {
+            throw new IndexOutOfBoundsException(
+                    "position is greater than size");
+        }
+        long nativeView = twkCreateSomeDataView(nativePointer, position);
+        if (nativeView == 0) {
+            return EMPTY_BUFFER;
+        }
+        ByteBuffer buffer = twkGetViewData(nativeView);
+        // Buffers derived from the returned one keep this one reachable.
+        Disposer.addRecord(buffer, new ViewDisposer(nativeView));
+        return buffer.asReadOnlyBuffer();
+    }
+
     void append(byte[] buffer, int offset, int length) {
         if (nativePointer == 0) {
             throw new IllegalStateException("nativePointer is 0");
@@ -118,10 +151,30 @@ public final class SharedBuffer {
                                              int offset,
                                              int length);
 
+    private static native long twkCreateSomeDataView(long nativePointer,
+                                                     long position);
+
+    private static native ByteBuffer twkGetViewData(long nativeView);
+
+    private static native void twkDisposeView(long nativeView);
+
     private static native void twkAppend(long nativePointer,
                                          byte[] buffer,
                                          int offset,
                                          int length);
 
     private static native void twkDispose(long nativePointer);
+
+    private static final class ViewDisposer implements DisposerRecord {
+        private final long nativeView;
+
+        private ViewDisposer(long nativeView) {
+            this.nativeView = nativeView;
+        }
+
+        @Override
+        public void dispose() {
+            twkDisposeView(nativeView);
+        }
+    }
 }
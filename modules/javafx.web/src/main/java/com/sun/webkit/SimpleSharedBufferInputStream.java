@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2012, 2014, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2012, 2019, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -26,11 +26,15 @@
 package com.sun.webkit;
 
 import java.io.InputStream;
+import java.nio.ByteBuffer;
 
 public final class SimpleSharedBufferInputStream extends InputStream {
 
     private final SharedBuffer sharedBuffer;
     private long position;
+    // View of the native segment containing position, so that reads
+    // within a segment do not cross into native code.
+    private ByteBuffer segment;
 
 
     public SimpleSharedBufferInputStream(SharedBuffer sharedBuffer) {
@@ -43,11 +47,10 @@ public final class SimpleSharedBufferInputStream extends InputStream {
 
     @Override
     public int read() {
-        byte[] buffer = new byte[1];
-        int length = sharedBuffer.getSomeData(position, buffer, 0, 1);
-        if (length != 0) {
+        ByteBuffer data = segment();
+        if (data.hasRemaining()) {
             position++;
-            return buffer[0] & 0xff;
+            return data.get() & 0xff;
         } else {
             return -1;
         }
@@ -71,8 +74,10 @@ public final class SimpleSharedBufferInputStream extends InputStream {
         if (len == 0) {
             return 0;
         }
-        int length = sharedBuffer.getSomeData(position, b, off, len);
+        ByteBuffer data = segment();
+        int length = Math.min(len, data.remaining());
         if (length != 0) {
+            data.get(b, off, length);
             position += length;
             return length;
         } else {
@@ -87,6 +92,11 @@ public final class SimpleSharedBufferInputStream extends InputStream {
             k = n < 0 ? 0 : n;
         }
         position += k;
+        if (segment != null && k <= segment.remaining()) {
+            segment.position(segment.position() + (int) k);
+        } else {
+            segment = null;
+        }
         return k;
     }
 
@@ -95,4 +105,11 @@ public final class SimpleSharedBufferInputStream extends InputStream {
         return (int) Math.min(sharedBuffer.size() - position,
                               Integer.MAX_VALUE);
     }
+
+    private ByteBuffer segment() {
+        if (segment == null || !segment.hasRemaining()) {
+            segment = sharedBuffer.getSomeData(position);
+        }
+        return segment;
+    }
 }
@@ -47,9 +47,11 @@ import java.security.AccessControlContext;
 import java.security.AccessController;
 import java.security.PrivilegedAction;
 import java.util.ArrayList;
+import java.util.Collection;
 import java.util.HashMap;
 import java.util.HashSet;
 import java.util.Iterator;
+import java.util.LinkedHashMap;
 import java.util.LinkedList;
 import java.util.List;
 import java.util.Map;
@@ -128,6 +130,14 @@ public final class WebPage {
     // An ID of the current updateContent cycle associated with an updateContent call.
     private int updateContentCycleID;
 
+    // The size of the tiles the dirty region is recorded in, each tile into
+    // its own render queue. Zero, the default, records every dirty rect as
+    // a whole. Tiles are painted by one traversal each and are not
+    // rasterized in parallel, so tiling is opt-in.
+    private static final int PAINT_TILE_SIZE = AccessController.doPrivileged(
+            (PrivilegedAction<Integer>) () -> Integer.getInteger(
+                    "com.sun.webkit.paintTileSize", 0));
+
     static {
         AccessController.doPrivileged((PrivilegedAction<Void>) () -> {
             NativeLibLoader.loadLibrary("jfxwebkit");
@@ -138,7 +148,13 @@ public final class WebPage {
                         "com.sun.webkit.setDefaultCookieHandler",
                         "true"));
                 if (setDefault) {
-                    CookieHandler.setDefault(new CookieManager());
+                    boolean useNativeStore = Boolean.valueOf(System.getProperty(
+                            "com.sun.webkit.useNativeCookieStore",
+                            "false"));
+                    CookieHandler.setDefault(useNativeStore
+                            ? CookieManager.createNativeBacked(System.getProperty(
+                                    "com.sun.webkit.cookieStoreFile"))
+                            : new CookieManager());
                 }
             }
 
@@ -301,17 +317,21 @@ public final class WebPage {
         List<WCRectangle> oldDirtyRects = dirtyRects;
         dirtyRects = new LinkedList<WCRectangle>();
         twkPrePaint(getPage());
-        while (!oldDirtyRects.isEmpty()) {
-            WCRectangle r = oldDirtyRects.remove(0).intersection(clip);
-            if (r.getWidth() <= 0 || r.getHeight() <= 0) {
-                continue;
+        if (PAINT_TILE_SIZE > 0) {
+            updateDirtyTiles(oldDirtyRects, clip);
+        } else {
+            while (!oldDirtyRects.isEmpty()) {
+                WCRectangle r = oldDirtyRects.remove(0).intersection(clip);
+                if (r.getWidth() <= 0 || r.getHeight() <= 0) {
+                    continue;
+                }
+                paintLog.finest("Updating: {0}", r);
+                WCRenderQueue rq = WCGraphicsManager.getGraphicsManager()
+                        .createRenderQueue(r, true);
+                twkUpdateContent(getPage(), rq, r.getIntX() - 1, r.getIntY() - 1,
+                                 r.getIntWidth() + 2, r.getIntHeight() + 2);
+                currentFrame.addRenderQueue(rq);
             }
-            paintLog.finest("Updating: {0}", r);
-            WCRenderQueue rq = WCGraphicsManager.getGraphicsManager()
-                    .createRenderQueue(r, true);
-            twkUpdateContent(getPage(), rq, r.getIntX() - 1, r.getIntY() - 1,
-                             r.getIntWidth() + 2, r.getIntHeight() + 2);
-            currentFrame.addRenderQueue(rq);
         }
         {
             WCRenderQueue rq = WCGraphicsManager.getGraphicsManager()
@@ -347,6 +367,10 @@ public final class WebPage {
                     }
                 }
 
+                if (PAINT_TILE_SIZE > 0) {
+                    RenderFrame.dropCoveredTiles(frameQueue, currentFrame);
+                }
+
                 frameQueue.add(currentFrame);
                 currentFrame = new RenderFrame();
 
@@ -367,6 +391,72 @@ public final class WebPage {
         }
     }
 
+    /**
+     * Records the dirty rects tile by tile. A tile touched by several dirty
+     * rects is recorded once, clipped to the bounds of its dirty parts, and
+     * all the tiles are painted by a single native call.
+     */
+    private void updateDirtyTiles(List<WCRectangle> rects, WCRectangle clip) {
+        Collection<WCRectangle> tiles = getDirtyTiles(rects, clip, PAINT_TILE_SIZE);
+        if (tiles.isEmpty()) {
+            return;
+        }
+
+        WCRenderQueue[] rqs = new WCRenderQueue[tiles.size()];
+        int[] bounds = new int[4 * tiles.size()];
+        int i = 0;
+        for (WCRectangle r : tiles) {
+            paintLog.finest("Updating tile: {0}", r);
+            rqs[i] = WCGraphicsManager.getGraphicsManager()
+                    .createRenderQueue(r, true);
+            bounds[4 * i] = r.getIntX() - 1;
+            bounds[4 * i + 1] = r.getIntY() - 1;
+            bounds[4 * i + 2] = r.getIntWidth() + 2;
+            bounds[4 * i + 3] = r.getIntHeight() + 2;
+            i++;
+        }
+        twkUpdateContentTiles(getPage(), rqs, bounds);
+        for (WCRenderQueue rq : rqs) {
+            currentFrame.addRenderQueue(rq);
+        }
+    }
+
+    /**
+     * Splits the dirty rects, clipped to {@code clip}, into tiles of
+     * {@code tileSize} pixels. A tile touched by several dirty rects is
+     * returned once, as the bounds of its dirty parts.
+     */
+    static Collection<WCRectangle> getDirtyTiles(List<WCRectangle> rects,
+            WCRectangle clip, int tileSize)
+    {
+        Map<Long, WCRectangle> tiles = new LinkedHashMap<Long, WCRectangle>();
+        for (WCRectangle rect : rects) {
+            // intersection() of disjoint rects is Float.MIN_VALUE sized,
+            // not empty
+            WCRectangle r = rect.intersection(clip);
+            if (r.getIntWidth() <= 0 || r.getIntHeight() <= 0) {
+                continue;
+            }
+            int tx1 = (int) Math.floor(r.getMinX() / tileSize);
+            int ty1 = (int) Math.floor(r.getMinY() / tileSize);
+            int tx2 = (int) Math.ceil(r.getMaxX() / tileSize);
+            int ty2 = (int) Math.ceil(r.getMaxY() / tileSize);
+            for (int ty = ty1; ty < ty2; ty++) {
+                for (int tx = tx1; tx < tx2; tx++) {
+                    WCRectangle part = r.intersection(new WCRectangle(
+                            tx * tileSize, ty * tileSize, tileSize, tileSize));
+                    if (part.getIntWidth() <= 0 || part.getIntHeight() <= 0) {
+                        continue;
+                    }
+                    long key = ((long) ty << 32) | (tx & 0xFFFFFFFFL);
+                    WCRectangle tile = tiles.get(key);
+                    tiles.put(key, tile == null ? part : tile.createUnion(part));
+                }
+            }
+        }
+        return tiles.values();
+    }
+
     private void scroll(int x, int y, int w, int h, int dx, int dy) {
         if (paintLog.isLoggable(Level.FINEST)) {
             paintLog.finest("rect=[" + x + ", " + y + " " + w + "x" + h +
@@ -421,14 +511,14 @@ public final class WebPage {
 
     // Instances of this class may not be accessed and modified concurrently
     // by multiple threads
-    private static final class RenderFrame {
+    static final class RenderFrame {
         private final List<WCRenderQueue> rqList =
                 new LinkedList<WCRenderQueue>();
-        private int scrollDx, scrollDy;
+        int scrollDx, scrollDy;
         private final WCRectangle enclosingRect = new WCRectangle();
 
         // Called on: Event thread only
-        private void addRenderQueue(WCRenderQueue rq) {
+        void addRenderQueue(WCRenderQueue rq) {
             if (rq.isEmpty()) {
                 return;
             }
@@ -445,7 +535,7 @@ public final class WebPage {
         }
 
         // Called on: Event thread and Main thread
-        private List<WCRenderQueue> getRQList() {
+        List<WCRenderQueue> getRQList() {
             return rqList;
         }
 
@@ -454,6 +544,58 @@ public final class WebPage {
             return enclosingRect;
         }
 
+        // Called on: Event thread only
+        private boolean isScrolled() {
+            return scrollDx != 0 || scrollDy != 0;
+        }
+
+        /**
+         * Drops the queued tiles the current frame paints over, so that the
+         * render thread does not rasterize content that is already stale
+         * when it falls behind. A scroll copies what the frames before it
+         * left in the back buffer, so frames queued before the last scroll
+         * are kept. Called on the event thread with the frameQueue monitor
+         * held.
+         */
+        static void dropCoveredTiles(Collection<RenderFrame> frameQueue,
+                RenderFrame currentFrame)
+        {
+            if (currentFrame.isScrolled()) {
+                return;
+            }
+            List<RenderFrame> frames = new ArrayList<RenderFrame>(frameQueue);
+            for (int i = frames.size() - 1; i >= 0; i--) {
+                RenderFrame frame = frames.get(i);
+                if (frame.isScrolled()) {
+                    break;
+                }
+                frame.dropCoveredBy(currentFrame);
+                if (frame.getRQList().isEmpty()) {
+                    paintLog.finest("Dropping: {0}", frame);
+                    frameQueue.remove(frame);
+                }
+            }
+        }
+
+        // Called on: Event thread only
+        void dropCoveredBy(RenderFrame newer) {
+            for (Iterator<WCRenderQueue> it = rqList.iterator(); it.hasNext();) {
+                WCRenderQueue rq = it.next();
+                if (!rq.isOpaque()) {
+                    continue;
+                }
+                for (WCRenderQueue newerRQ : newer.rqList) {
+                    if (newerRQ.isOpaque()
+                            && newerRQ.getClip().contains(rq.getClip()))
+                    {
+                        rq.dispose();
+                        it.remove();
+                        break;
+                    }
+                }
+            }
+        }
+
         // Called on: Event thread only
         private void drop() {
             for (WCRenderQueue rq : rqList) {
@@ -2597,6 +2739,7 @@ public final class WebPage {
     private native void twkSetBounds(long pPage, int x, int y, int w, int h);
     private native void twkPrePaint(long pPage);
     private native void twkUpdateContent(long pPage, WCRenderQueue rq, int x, int y, int w, int h);
+    private native void twkUpdateContentTiles(long pPage, WCRenderQueue[] rqs, int[] rects);
     private native void twkPostPaint(long pPage, WCRenderQueue rq,
                                      int x, int y, int w, int h);
 
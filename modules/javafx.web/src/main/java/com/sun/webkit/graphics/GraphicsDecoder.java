@@ -456,7 +456,8 @@ public final class GraphicsDecoder  {
     }
 
     private static WCPath getPath(WCGraphicsManager gm, ByteBuffer buf) {
-        WCPath path = (WCPath) gm.getRef(buf.getInt());
+        WCPath path = gm.createWCPath();
+        path.addPathData(buf);
         path.setWindingRule(buf.getInt());
         return path;
     }
@@ -37,9 +37,20 @@ public abstract class WCFont extends Ref {
 
     public abstract float getXHeight();
 
-    public abstract double getGlyphWidth(int glyph);
+    /**
+     * Returns the advances of {@code count} consecutive glyphs starting
+     * with {@code firstGlyph}.
+     * NB: This method is called from native code!
+     */
+    public abstract float[] getGlyphWidths(int firstGlyph, int count);
 
-    public abstract float[] getGlyphBoundingBox(int glyph);
+    /**
+     * Returns the bounding boxes of {@code count} consecutive glyphs
+     * starting with {@code firstGlyph}, as {x, y, width, height} quadruples
+     * relative to the baseline origin.
+     * NB: This method is called from native code!
+     */
+    public abstract float[] getGlyphBoundingBoxes(int firstGlyph, int count);
 
     /**
      * Returns a hash code value for the object.
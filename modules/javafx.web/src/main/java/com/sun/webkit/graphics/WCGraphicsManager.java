@@ -31,6 +31,7 @@ import com.sun.webkit.SimpleSharedBufferInputStream;
 import java.io.IOException;
 import java.io.InputStream;
 import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
 import java.util.HashMap;
 import java.util.MissingResourceException;
 import java.util.ResourceBundle;
@@ -90,6 +91,12 @@ public abstract class WCGraphicsManager {
 
     protected abstract WCPath createWCPath(WCPath path);
 
+    private WCPath fwkCreateWCPath(ByteBuffer data) {
+        WCPath path = createWCPath();
+        path.addPathData(data.order(ByteOrder.nativeOrder()));
+        return path;
+    }
+
     protected abstract WCImage createWCImage(int w, int h);
 
     protected abstract WCImage createRTImage(int w, int h);
@@ -26,6 +26,7 @@
 package com.sun.webkit.graphics;
 
 import java.lang.annotation.Native;
+import java.nio.ByteBuffer;
 
 public abstract class WCPath<P> extends Ref {
 
@@ -104,4 +105,38 @@ public abstract class WCPath<P> extends Ref {
                                            double thickness, double miterLimit,
                                            int cap, int join, double dashOffset,
                                            double[] dashArray);
+
+    /**
+     * Appends the segments of a path encoded by the native
+     * PlatformPathJava::encode() to this path: the number of segments,
+     * followed by each segment type (see {@link WCPathIterator}) and its
+     * float coordinates. The buffer position is advanced past the data.
+     */
+    public final void addPathData(ByteBuffer buf) {
+        int count = buf.getInt();
+        for (int i = 0; i < count; i++) {
+            switch (buf.getInt()) {
+                case WCPathIterator.SEG_MOVETO:
+                    moveTo(buf.getFloat(), buf.getFloat());
+                    break;
+                case WCPathIterator.SEG_LINETO:
+                    addLineTo(buf.getFloat(), buf.getFloat());
+                    break;
+                case WCPathIterator.SEG_QUADTO:
+                    addQuadCurveTo(buf.getFloat(), buf.getFloat(),
+                                   buf.getFloat(), buf.getFloat());
+                    break;
+                case WCPathIterator.SEG_CUBICTO:
+                    addBezierCurveTo(buf.getFloat(), buf.getFloat(),
+                                     buf.getFloat(), buf.getFloat(),
+                                     buf.getFloat(), buf.getFloat());
+                    break;
+                case WCPathIterator.SEG_CLOSE:
+                    closeSubpath();
+                    break;
+                default:
+                    throw new IllegalArgumentException("Invalid path data");
+            }
+        }
+    }
 }
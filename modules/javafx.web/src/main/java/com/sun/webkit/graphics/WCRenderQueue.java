@@ -46,6 +46,13 @@ public abstract class WCRenderQueue extends Ref {
     private int size = 0;
     private final boolean opaque;
 
+    // Statistics used to size the native buffer ring
+    // (see RenderingQueue::MAX_BUFFER_COUNT)
+    private int buffersInFlight = 0;
+    private int flushCount = 0;
+    private int frameBytes = 0;
+    private int lastFrameBytes = 0;
+
     // Associated graphics context (currently used to draw to a buffered image).
     protected final WCGraphicsContext gc;
 
@@ -73,7 +80,11 @@ public abstract class WCRenderQueue extends Ref {
         currentBuffer.setBuffer(buffer);
         buffers.addLast(currentBuffer);
         currentBuffer = new BufferData();
-        size += buffer.capacity();
+        size += buffer.remaining();
+        frameBytes += buffer.remaining();
+        if (buffer.isDirect()) {
+            buffersInFlight++;
+        }
         if (size > MAX_QUEUE_SIZE && gc!=null) {
             // It is isolated queue over the canvas image [image-gc!=null].
             // We need to flush the changes periodically
@@ -113,13 +124,53 @@ public abstract class WCRenderQueue extends Ref {
     protected abstract void flush();
 
     private void fwkFlush() {
+        synchronized (this) {
+            flushCount++;
+            lastFrameBytes = frameBytes;
+            frameBytes = 0;
+            if (log.isLoggable(Level.FINE)) {
+                log.fine("WCRenderQueue{0} flush #{1}: {2} bytes, {3} buffers in flight",
+                        new Object[]{hashCode(), flushCount, lastFrameBytes,
+                                     buffersInFlight});
+            }
+        }
         flush();
     }
 
-    private void fwkAddBuffer(ByteBuffer buffer) {
+    /*
+     * The native side recycles its buffers together with their
+     * DirectByteBuffer wrappers, so the wrapper is reset to cover
+     * the newly written data only.
+     */
+    private void fwkAddBuffer(ByteBuffer buffer, int length) {
+        buffer.clear();
+        buffer.limit(length);
         addBuffer(buffer);
     }
 
+    /**
+     * Returns the number of native buffers added to this queue
+     * that have not been released back to the native side yet.
+     */
+    public synchronized int getBuffersInFlight() {
+        return buffersInFlight;
+    }
+
+    /**
+     * Returns the number of times the native side flushed this queue.
+     */
+    public synchronized int getFlushCount() {
+        return flushCount;
+    }
+
+    /**
+     * Returns the number of bytes added to this queue between
+     * the last two flushes.
+     */
+    public synchronized int getLastFrameBytes() {
+        return lastFrameBytes;
+    }
+
     public WCRectangle getClip() {
         return clip;
     }
@@ -130,7 +181,11 @@ public abstract class WCRenderQueue extends Ref {
             int i = 0;
             final Object[] arr = new Object[n];
             for (BufferData bdata: buffers) {
-                arr[i++] = bdata.getBuffer();
+                ByteBuffer buffer = bdata.getBuffer();
+                if (buffer.isDirect()) {
+                    buffersInFlight--;
+                }
+                arr[i++] = buffer;
             }
             buffers.clear();
             Invoker.getInvoker().invokeOnEventThread(() -> {
@@ -175,7 +230,9 @@ public abstract class WCRenderQueue extends Ref {
         return "WCRenderQueue{"
                 + "clip=" + clip + ", "
                 + "size=" + size + ", "
-                + "opaque=" + opaque
+                + "opaque=" + opaque + ", "
+                + "buffersInFlight=" + buffersInFlight + ", "
+                + "flushCount=" + flushCount
                 + "}";
     }
 }
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2011, 2018, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2011, 2019, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -59,7 +59,7 @@ final class Cookie {
     /**
      * Creates a new {@code Cookie}.
      */
-    private Cookie(String name, String value, long expiryTime, String domain,
+    Cookie(String name, String value, long expiryTime, String domain,
             String path, ExtendedTime creationTime, long lastAccessTime,
             boolean persistent, boolean hostOnly, boolean secureOnly,
             boolean httpOnly)
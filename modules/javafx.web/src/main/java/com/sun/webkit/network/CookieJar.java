@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2011, 2014, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2011, 2019, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -40,6 +40,7 @@ final class CookieJar {
     }
 
     private static void fwkPut(String url, String cookie) {
+        NativeCookieStore.checkDefaultHandler();
         CookieHandler handler = CookieHandler.getDefault();
         if (handler != null) {
             URI uri = null;
@@ -62,6 +63,7 @@ final class CookieJar {
     }
 
     private static String fwkGet(String url, boolean includeHttpOnlyCookies) {
+        NativeCookieStore.checkDefaultHandler();
         CookieHandler handler = CookieHandler.getDefault();
         if (handler != null) {
             URI uri = null;
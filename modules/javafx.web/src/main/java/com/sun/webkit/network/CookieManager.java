@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2011, 2018, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2011, 2019, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -31,6 +31,7 @@ import com.sun.javafx.logging.PlatformLogger.Level;
 import java.net.CookieHandler;
 import java.net.URI;
 import java.util.Arrays;
+import java.util.Collection;
 import java.util.Collections;
 import java.util.HashMap;
 import java.util.List;
@@ -46,13 +47,78 @@ public final class CookieManager extends CookieHandler {
             PlatformLogger.getLogger(CookieManager.class.getName());
 
 
-    private final CookieStore store = new CookieStore();
+    /**
+     * The Java cookie store, {@code null} if the cookies are kept in the
+     * {@link NativeCookieStore}.
+     */
+    private final CookieStore store;
 
 
     /**
      * Creates a new {@code CookieManager}.
      */
     public CookieManager() {
+        store = new CookieStore();
+    }
+
+    private CookieManager(boolean useNativeStore) {
+        store = useNativeStore ? null : new CookieStore();
+    }
+
+    /**
+     * Creates a {@code CookieManager} that keeps its cookies in the
+     * native store of the web engine, which lets the engine look them up
+     * without calling back into Java. The jfxwebkit library must be
+     * loaded. If {@code backingFile} is not {@code null}, persistent
+     * cookies are loaded from it and saved to it when the engine flushes
+     * its cookie store, and on exit.
+     */
+    public static CookieManager createNativeBacked(String backingFile) {
+        if (backingFile != null) {
+            if (!NativeCookieStore.setBackingFile(backingFile)) {
+                logger.fine("Cannot read cookie file [{0}]", backingFile);
+            }
+            Runtime.getRuntime().addShutdownHook(
+                    new Thread(NativeCookieStore::flush, "Cookie Flusher"));
+        }
+        return new CookieManager(true);
+    }
+
+    /**
+     * Returns {@code true} if the cookies of this manager are kept in the
+     * native store of the web engine.
+     */
+    boolean usesNativeStore() {
+        return store == null;
+    }
+
+    /**
+     * Returns all the unexpired cookies of this manager.
+     */
+    List<Cookie> exportCookies() {
+        if (usesNativeStore()) {
+            return NativeCookieStore.exportCookies();
+        }
+        synchronized (store) {
+            return store.getAll();
+        }
+    }
+
+    /**
+     * Adds the given cookies to this manager, replacing cookies with the
+     * same name, domain, and path. The cookies are stored as they are,
+     * they are expected to come from {@link #exportCookies}.
+     */
+    void importCookies(Collection<Cookie> cookies) {
+        if (usesNativeStore()) {
+            NativeCookieStore.importCookies(cookies);
+            return;
+        }
+        synchronized (store) {
+            for (Cookie cookie : cookies) {
+                store.put(cookie);
+            }
+        }
     }
 
 
@@ -107,6 +173,11 @@ public final class CookieManager extends CookieHandler {
         boolean httpApi = "http".equalsIgnoreCase(scheme)
                 || "https".equalsIgnoreCase(scheme);
 
+        if (usesNativeStore()) {
+            return NativeCookieStore.get(host, uri.getPath(),
+                    secureProtocol, httpApi);
+        }
+
         List<Cookie> cookieList;
         synchronized (store) {
             cookieList = store.get(host, uri.getPath(),
@@ -214,6 +285,16 @@ public final class CookieManager extends CookieHandler {
             return;
         }
 
+        if (usesNativeStore()) {
+            if (!NativeCookieStore.put(cookie, httpApi)) {
+                logger.finest("Non-HTTP API attempts to "
+                        + "overwrite HttpOnly cookie, blocked");
+                return;
+            }
+            logger.finest("Stored: {0}", cookie);
+            return;
+        }
+
         synchronized (store) {
             Cookie oldCookie = store.get(cookie);
             if (oldCookie != null) {
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2011, 2018, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2011, 2019, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -137,6 +137,21 @@ final class CookieStore {
         return result;
     }
 
+    /**
+     * Returns all the currently stored cookies that have not expired.
+     */
+    List<Cookie> getAll() {
+        ArrayList<Cookie> result = new ArrayList<Cookie>(totalCount);
+        for (Map<Cookie,Cookie> bucket : buckets.values()) {
+            for (Cookie cookie : bucket.values()) {
+                if (!cookie.hasExpired()) {
+                    result.add(cookie);
+                }
+            }
+        }
+        return result;
+    }
+
     /**
      * Finds all the cookies that are stored in the given bucket and
      * match the given query.
@@ -0,0 +1,208 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package com.sun.webkit.network;
+
+import com.sun.javafx.logging.PlatformLogger;
+
+import java.net.CookieHandler;
+import java.util.ArrayList;
+import java.util.Collection;
+import java.util.List;
+
+/**
+ * The cookie store of the native web engine. It holds the cookies of
+ * {@code CookieManager}s created with {@code createNativeBacked()}, which
+ * {@code WebPage} installs as the default cookie handler if the
+ * {@code com.sun.webkit.useNativeCookieStore} property is {@code true}.
+ * The engine can then answer {@code document.cookie} and its own request
+ * header lookups without calling into Java. The
+ * matching and eviction rules are those of {@link CookieStore}.
+ */
+final class NativeCookieStore {
+
+    private static final PlatformLogger logger =
+            PlatformLogger.getLogger(NativeCookieStore.class.getName());
+
+    // Cookie flags, must match CookieStoreJava.cpp
+    private static final int PERSISTENT = 1 << 0;
+    private static final int HOST_ONLY = 1 << 1;
+    private static final int SECURE_ONLY = 1 << 2;
+    private static final int HTTP_ONLY = 1 << 3;
+
+    /**
+     * Whether the engine was last told that the default cookie handler
+     * uses this store. Accessed on the WebKit thread only.
+     */
+    private static boolean active;
+
+
+    private NativeCookieStore() {
+        throw new AssertionError();
+    }
+
+
+    /**
+     * Tells the engine whether it can look cookies up in this store or has
+     * to ask the default cookie handler, which the application may have
+     * replaced since the last call.
+     */
+    static void checkDefaultHandler() {
+        CookieHandler handler = CookieHandler.getDefault();
+        boolean usesNativeStore = handler instanceof CookieManager
+                && ((CookieManager) handler).usesNativeStore();
+        if (usesNativeStore != active) {
+            active = usesNativeStore;
+            logger.finest("Native cookie store active: {0}", active);
+            twkSetActive(active);
+        }
+    }
+
+    /**
+     * Returns the cookie string for the given query, or {@code null} if no
+     * cookie matches.
+     */
+    static String get(String hostname, String path, boolean secureProtocol,
+            boolean httpApi)
+    {
+        return twkGet(hostname, path, secureProtocol, httpApi);
+    }
+
+    /**
+     * Stores the given cookie. Returns {@code false} if a non-HTTP API
+     * attempted to overwrite an HttpOnly cookie.
+     */
+    static boolean put(Cookie cookie, boolean httpApi) {
+        return twkPut(cookie.getName(), cookie.getValue(), cookie.getDomain(),
+                cookie.getPath(), cookie.getExpiryTime(),
+                cookie.getCreationTime().baseTime(),
+                cookie.getCreationTime().subtime(),
+                cookie.getLastAccessTime(), flags(cookie), httpApi);
+    }
+
+    /**
+     * Returns all the unexpired cookies in the store.
+     */
+    static List<Cookie> exportCookies() {
+        String[] strings;
+        long[] times;
+        int[] flags;
+        int count = twkGetCount();
+        while (true) {
+            strings = new String[4 * count];
+            times = new long[4 * count];
+            flags = new int[count];
+            int exportedCount = twkExport(strings, times, flags);
+            if (exportedCount <= count) {
+                count = exportedCount;
+                break;
+            }
+            // The store grew since twkGetCount()
+            count = exportedCount;
+        }
+
+        List<Cookie> cookies = new ArrayList<Cookie>(count);
+        for (int i = 0; i < count; i++) {
+            cookies.add(new Cookie(strings[4 * i], strings[4 * i + 1],
+                    times[4 * i], strings[4 * i + 2], strings[4 * i + 3],
+                    new ExtendedTime(times[4 * i + 1], (int) times[4 * i + 2]),
+                    times[4 * i + 3], (flags[i] & PERSISTENT) != 0,
+                    (flags[i] & HOST_ONLY) != 0, (flags[i] & SECURE_ONLY) != 0,
+                    (flags[i] & HTTP_ONLY) != 0));
+        }
+        return cookies;
+    }
+
+    /**
+     * Adds the given cookies to the store in a single call, replacing
+     * stored cookies with the same name, domain, and path.
+     */
+    static void importCookies(Collection<Cookie> cookies) {
+        int count = cookies.size();
+        String[] strings = new String[4 * count];
+        long[] times = new long[4 * count];
+        int[] flags = new int[count];
+        int i = 0;
+        for (Cookie cookie : cookies) {
+            strings[4 * i] = cookie.getName();
+            strings[4 * i + 1] = cookie.getValue();
+            strings[4 * i + 2] = cookie.getDomain();
+            strings[4 * i + 3] = cookie.getPath();
+            times[4 * i] = cookie.getExpiryTime();
+            times[4 * i + 1] = cookie.getCreationTime().baseTime();
+            times[4 * i + 2] = cookie.getCreationTime().subtime();
+            times[4 * i + 3] = cookie.getLastAccessTime();
+            flags[i] = flags(cookie);
+            i++;
+        }
+        twkImport(strings, times, flags, count);
+    }
+
+    /**
+     * Removes all the cookies from the store.
+     */
+    static void clear() {
+        twkClear();
+    }
+
+    /**
+     * Loads the persistent cookies stored in {@code path} and keeps
+     * {@code path} as the file {@link #flush} writes them to. Returns
+     * {@code false} if the file exists but could not be read.
+     */
+    static boolean setBackingFile(String path) {
+        return twkSetBackingFile(path);
+    }
+
+    /**
+     * Writes the persistent cookies to the backing file if they changed.
+     */
+    static void flush() {
+        twkFlush();
+    }
+
+    private static int flags(Cookie cookie) {
+        return (cookie.getPersistent() ? PERSISTENT : 0)
+                | (cookie.getHostOnly() ? HOST_ONLY : 0)
+                | (cookie.getSecureOnly() ? SECURE_ONLY : 0)
+                | (cookie.getHttpOnly() ? HTTP_ONLY : 0);
+    }
+
+    private static native void twkSetActive(boolean active);
+    private static native String twkGet(String hostname, String path,
+            boolean secureProtocol, boolean httpApi);
+    private static native boolean twkPut(String name, String value,
+            String domain, String path, long expiryTime, long creationTime,
+            int creationSubtime, long lastAccessTime, int flags,
+            boolean httpApi);
+    private static native int twkGetCount();
+    private static native int twkExport(String[] strings, long[] times,
+            int[] flags);
+    private static native void twkImport(String[] strings, long[] times,
+            int[] flags, int count);
+    private static native void twkClear();
+    private static native boolean twkSetBackingFile(String path);
+    private static native void twkFlush();
+}
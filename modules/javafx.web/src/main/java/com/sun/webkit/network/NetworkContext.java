@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2011, 2018, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2011, 2019, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -143,6 +143,9 @@ final class NetworkContext {
                     data,
                     Util.formatHeaders(headers)));
         }
+        // The application may have replaced the default cookie handler
+        NativeCookieStore.checkDefaultHandler();
+
         URLLoader loader = new URLLoader(
                 webPage,
                 byteBufferPool,
@@ -85,17 +85,17 @@ public final class WCFontPerfLogger extends WCFont {
         return res;
     }
 
-    public double getGlyphWidth(int glyph) {
-        logger.resumeCount("GETGLYPHWIDTH");
-        double res = fnt.getGlyphWidth(glyph);
-        logger.suspendCount("GETGLYPHWIDTH");
+    public float[] getGlyphWidths(int firstGlyph, int count) {
+        logger.resumeCount("GETGLYPHWIDTHS");
+        float[] res = fnt.getGlyphWidths(firstGlyph, count);
+        logger.suspendCount("GETGLYPHWIDTHS");
         return res;
     }
 
-    public float[] getGlyphBoundingBox(int glyph) {
-        logger.resumeCount("GETGLYPHBOUNDINGBOX");
-        float[] res = fnt.getGlyphBoundingBox(glyph);
-        logger.suspendCount("GETGLYPHBOUNDINGBOX");
+    public float[] getGlyphBoundingBoxes(int firstGlyph, int count) {
+        logger.resumeCount("GETGLYPHBOUNDINGBOXES");
+        float[] res = fnt.getGlyphBoundingBoxes(firstGlyph, count);
+        logger.suspendCount("GETGLYPHBOUNDINGBOXES");
         return res;
     }
 
@@ -15,7 +15,6 @@ list(APPEND WTF_PUBLIC_HEADERS
 )
 
 list(APPEND WTF_SOURCES
-    java/FileSystemJava.cpp
     java/JavaEnv.cpp
     java/MainThreadJava.cpp
     java/StringJava.cpp
@@ -26,6 +25,22 @@ list(APPEND WTF_LIBRARIES
     "${JAVA_JVM_LIBRARY}"
 )
 
+if (USE_JAVA_FILE_SYSTEM)
+    list(APPEND WTF_SOURCES
+        java/FileSystemJava.cpp
+    )
+else ()
+    list(APPEND WTF_SOURCES
+        java/FileSystemPOSIXJava.cpp
+        posix/FileSystemPOSIX.cpp
+    )
+    if (APPLE)
+        list(APPEND WTF_SOURCES
+            cf/FileSystemCF.cpp
+        )
+    endif ()
+endif ()
+
 list(APPEND WTF_SYSTEM_INCLUDE_DIRECTORIES
 	  "${JDK_INCLUDE_DIRS}"
 )
@@ -83,6 +98,7 @@ elseif (UNIX)
     list(APPEND WTF_SOURCES
         generic/RunLoopGeneric.cpp
         generic/WorkQueueGeneric.cpp
+        java/RunLoopJava.cpp
         linux/CurrentProcessMemoryStatus.cpp
         linux/MemoryFootprintLinux.cpp
         linux/MemoryPressureHandlerLinux.cpp
@@ -54,6 +54,9 @@ void RunLoop::initializeMainRunLoop()
         return;
     initializeMainThread();
     s_mainRunLoop = &RunLoop::current();
+#if USE(GENERIC_EVENT_LOOP) && PLATFORM(JAVA)
+    s_mainRunLoop->m_isEventThreadLoop = true;
+#endif
 }
 
 RunLoop& RunLoop::current()
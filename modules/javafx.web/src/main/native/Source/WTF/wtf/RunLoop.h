@@ -73,6 +73,12 @@ public:
     WTF_EXPORT_PRIVATE static void iterate();
 #endif
 
+#if USE(GENERIC_EVENT_LOOP) && PLATFORM(JAVA)
+    // The main RunLoop has no thread of its own in the Java port. It is iterated
+    // on the JavaFX event thread whenever it has pending tasks or a timer is due.
+    static void iterateOnEventThread();
+#endif
+
 #if USE(GLIB_EVENT_LOOP) || USE(GENERIC_EVENT_LOOP)
     WTF_EXPORT_PRIVATE void dispatchAfter(Seconds, Function<void()>&&);
 #endif
@@ -205,6 +211,11 @@ private:
     Vector<Status*> m_mainLoops;
     bool m_shutdown { false };
     bool m_pendingTasks { false };
+#if PLATFORM(JAVA)
+    void scheduleEventThreadWakeUp(const AbstractLocker&, MonotonicTime);
+
+    bool m_isEventThreadLoop { false };
+#endif
 #endif
 };
 
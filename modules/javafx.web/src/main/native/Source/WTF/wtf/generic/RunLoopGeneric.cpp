@@ -206,10 +206,16 @@ void RunLoop::stop()
     }
 }
 
-void RunLoop::wakeUp(const AbstractLocker&)
+void RunLoop::wakeUp(const AbstractLocker& locker)
 {
     m_pendingTasks = true;
     m_readyToRun.notifyOne();
+#if PLATFORM(JAVA)
+    if (m_isEventThreadLoop)
+        scheduleEventThreadWakeUp(locker, MonotonicTime::now());
+#else
+    UNUSED_PARAM(locker);
+#endif
 }
 
 void RunLoop::wakeUp()
@@ -232,6 +238,15 @@ void RunLoop::schedule(Ref<TimerBase::ScheduledTask>&& task)
 
 void RunLoop::scheduleAndWakeUp(const AbstractLocker& locker, Ref<TimerBase::ScheduledTask>&& task)
 {
+#if PLATFORM(JAVA)
+    // The event thread only needs to come back when the timer is due.
+    if (m_isEventThreadLoop) {
+        MonotonicTime fireTime = task->scheduledTimePoint();
+        schedule(locker, WTFMove(task));
+        scheduleEventThreadWakeUp(locker, fireTime);
+        return;
+    }
+#endif
     schedule(locker, WTFMove(task));
     wakeUp(locker);
 }
@@ -240,8 +255,7 @@ void RunLoop::dispatchAfter(Seconds delay, Function<void()>&& function)
 {
     LockHolder locker(m_loopLock);
     bool repeating = false;
-    schedule(locker, TimerBase::ScheduledTask::create(WTFMove(function), delay, repeating));
-    wakeUp(locker);
+    scheduleAndWakeUp(locker, TimerBase::ScheduledTask::create(WTFMove(function), delay, repeating));
 }
 
 // Since RunLoop does not own the registered TimerBase,
@@ -60,14 +60,42 @@ bool fileExists(const String& path)
     return jbool_to_bool(result);
 }
 
-bool deleteFile(const String&)
+bool deleteFile(const String& path)
 {
-    return false;
+    JNIEnv* env = WTF::GetJavaEnv();
+
+    static jmethodID mid = env->GetStaticMethodID(
+            GetFileSystemClass(env),
+            "fwkDeleteFile",
+            "(Ljava/lang/String;)Z");
+    ASSERT(mid);
+
+    jboolean result = env->CallStaticBooleanMethod(
+            GetFileSystemClass(env),
+            mid,
+            (jstring)path.toJavaString(env));
+    WTF::CheckAndClearException(env);
+
+    return jbool_to_bool(result);
 }
 
-bool deleteEmptyDirectory(String const &)
+bool deleteEmptyDirectory(const String& path)
 {
-    return false;
+    JNIEnv* env = WTF::GetJavaEnv();
+
+    static jmethodID mid = env->GetStaticMethodID(
+            GetFileSystemClass(env),
+            "fwkDeleteEmptyDirectory",
+            "(Ljava/lang/String;)Z");
+    ASSERT(mid);
+
+    jboolean result = env->CallStaticBooleanMethod(
+            GetFileSystemClass(env),
+            mid,
+            (jstring)path.toJavaString(env));
+    WTF::CheckAndClearException(env);
+
+    return jbool_to_bool(result);
 }
 
 bool getFileSize(const String& path, long long& result)
@@ -205,10 +233,34 @@ Optional<FileMetadata> fileMetadataFollowingSymlinks(const String& path)
     return fileMetadata(path);
 }
 
-Vector<String> listDirectory(const String&, const String&)
+Vector<String> listDirectory(const String& path, const String& filter)
 {
-    Vector<String> entities;
-    return entities;
+    JNIEnv* env = WTF::GetJavaEnv();
+
+    static jmethodID mid = env->GetStaticMethodID(
+            GetFileSystemClass(env),
+            "fwkListDirectory",
+            "(Ljava/lang/String;Ljava/lang/String;)[Ljava/lang/String;");
+    ASSERT(mid);
+
+    JLObjectArray paths(static_cast<jobjectArray>(env->CallStaticObjectMethod(
+            GetFileSystemClass(env),
+            mid,
+            (jstring)path.toJavaString(env),
+            (jstring)filter.toJavaString(env))));
+
+    Vector<String> entries;
+    if (WTF::CheckAndClearException(env) || !paths) {
+        return entries;
+    }
+
+    jsize length = env->GetArrayLength(paths);
+    entries.reserveInitialCapacity(length);
+    for (jsize i = 0; i < length; i++) {
+        JLString entry(static_cast<jstring>(env->GetObjectArrayElement(paths, i)));
+        entries.uncheckedAppend(String(env, entry));
+    }
+    return entries;
 }
 
 CString fileSystemRepresentation(const String& s)
@@ -224,7 +276,17 @@ String openTemporaryFile(const String&, PlatformFileHandle& handle)
 
 PlatformFileHandle openFile(const String& path, FileOpenMode mode)
 {
-    if (mode != FileOpenMode::Read) {
+    // "w" is not a RandomAccessFile mode, fwkOpenFile maps it to a
+    // truncated "rw" file.
+    const char* javaMode;
+    switch (mode) {
+    case FileOpenMode::Read:
+        javaMode = "r";
+        break;
+    case FileOpenMode::Write:
+        javaMode = "w";
+        break;
+    default:
         return invalidPlatformFileHandle;
     }
     JNIEnv* env = WTF::GetJavaEnv();
@@ -237,7 +299,7 @@ PlatformFileHandle openFile(const String& path, FileOpenMode mode)
     PlatformFileHandle result = env->CallStaticObjectMethod(
             GetFileSystemClass(env),
             mid,
-            (jstring)path.toJavaString(env), (jstring)(env->NewStringUTF("r")));
+            (jstring)path.toJavaString(env), (jstring)JLString(env->NewStringUTF(javaMode)));
 
     WTF::CheckAndClearException(env);
     return result ? result : invalidPlatformFileHandle;
@@ -286,9 +348,31 @@ int readFromFile(PlatformFileHandle handle, char* data, int length)
     return result;
 }
 
-int writeToFile(PlatformFileHandle, const char*, int)
+int writeToFile(PlatformFileHandle handle, const char* data, int length)
 {
-    return -1;
+    if (length < 0 || !isHandleValid(handle) || data == nullptr) {
+        return -1;
+    }
+    JNIEnv* env = WTF::GetJavaEnv();
+    static jmethodID mid = env->GetStaticMethodID(
+            GetFileSystemClass(env),
+            "fwkWriteToFile",
+            "(Ljava/io/RandomAccessFile;Ljava/nio/ByteBuffer;)I");
+    ASSERT(mid);
+
+    // The buffer is only read from on the Java side.
+    JLObject byteBuffer(env->NewDirectByteBuffer(const_cast<char*>(data), length));
+    int result = env->CallStaticIntMethod(
+            GetFileSystemClass(env),
+            mid,
+            (jobject)handle,
+            (jobject)byteBuffer);
+    WTF::CheckAndClearException(env);
+
+    if (result < 0) {
+        return -1;
+    }
+    return result;
 }
 
 String pathGetFileName(const String& path)
@@ -0,0 +1,218 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+// Java port additions to posix/FileSystemPOSIX.cpp, used unless the build
+// routes file access through Java (USE_JAVA_FILE_SYSTEM).
+
+#include "config.h"
+#include <wtf/FileSystem.h>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <wtf/CheckedArithmetic.h>
+#include <wtf/HashMap.h>
+#include <wtf/Lock.h>
+#include <wtf/NeverDestroyed.h>
+#include <wtf/text/CString.h>
+
+namespace WTF {
+
+namespace FileSystemImpl {
+
+namespace {
+
+// Files at least this large that are opened for reading are memory mapped,
+// so readFromFile() copies straight out of the page cache without a system
+// call per chunk. Smaller files are cheaper to read(2) than to map.
+const long long mappedReadThreshold = 4 * 1024 * 1024;
+
+struct MappedFile {
+    void* data { nullptr };
+    size_t size { 0 };
+    size_t position { 0 };
+};
+
+// File descriptors of mapped files and their read positions. Blob streams
+// read on the file thread, so the map is shared between threads.
+typedef HashMap<int, MappedFile, IntHash<int>, SignedWithZeroKeyHashTraits<int>> MappedFileMap;
+
+Lock mappedFilesLock;
+
+MappedFileMap& mappedFiles()
+{
+    static NeverDestroyed<MappedFileMap> files;
+    return files;
+}
+
+void mapForReading(int fd)
+{
+    struct stat fileStat;
+    if (fstat(fd, &fileStat) || !S_ISREG(fileStat.st_mode) || fileStat.st_size < mappedReadThreshold)
+        return;
+
+    size_t size;
+    if (!WTF::convertSafely(fileStat.st_size, size))
+        return;
+
+    void* data = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    if (data == MAP_FAILED)
+        return;
+    madvise(data, size, MADV_SEQUENTIAL);
+
+    auto locker = holdLock(mappedFilesLock);
+    mappedFiles().set(fd, MappedFile { data, size, 0 });
+}
+
+} // namespace
+
+String homeDirectoryPath()
+{
+    return "";
+}
+
+PlatformFileHandle openFile(const String& path, FileOpenMode mode)
+{
+    CString fsRep = fileSystemRepresentation(path);
+
+    if (fsRep.isNull())
+        return invalidPlatformFileHandle;
+
+    int platformFlag = 0;
+    if (mode == FileOpenMode::Read)
+        platformFlag |= O_RDONLY;
+    else if (mode == FileOpenMode::Write)
+        platformFlag |= (O_WRONLY | O_CREAT | O_TRUNC);
+#if OS(DARWIN)
+    else if (mode == FileOpenMode::EventsOnly)
+        platformFlag |= O_EVTONLY;
+#endif
+
+    int fd = open(fsRep.data(), platformFlag, 0666);
+    if (fd >= 0 && mode == FileOpenMode::Read)
+        mapForReading(fd);
+    return fd;
+}
+
+void closeFile(PlatformFileHandle& handle)
+{
+    if (!isHandleValid(handle))
+        return;
+
+    {
+        auto locker = holdLock(mappedFilesLock);
+        auto mapped = mappedFiles().take(handle);
+        if (mapped.data)
+            munmap(mapped.data, mapped.size);
+    }
+    close(handle);
+    handle = invalidPlatformFileHandle;
+}
+
+long long seekFile(PlatformFileHandle handle, long long offset, FileSeekOrigin origin)
+{
+    {
+        auto locker = holdLock(mappedFilesLock);
+        auto it = mappedFiles().find(handle);
+        if (it != mappedFiles().end()) {
+            MappedFile& mapped = it->value;
+            long long base = 0;
+            switch (origin) {
+            case FileSeekOrigin::Beginning:
+                break;
+            case FileSeekOrigin::Current:
+                base = mapped.position;
+                break;
+            case FileSeekOrigin::End:
+                base = mapped.size;
+                break;
+            }
+            long long position = base + offset;
+            if (position < 0) {
+                errno = EINVAL;
+                return -1;
+            }
+            // Like lseek(), seeking past the end is allowed; reads then return 0.
+            mapped.position = static_cast<size_t>(position);
+            return position;
+        }
+    }
+
+    int whence = SEEK_SET;
+    switch (origin) {
+    case FileSeekOrigin::Beginning:
+        whence = SEEK_SET;
+        break;
+    case FileSeekOrigin::Current:
+        whence = SEEK_CUR;
+        break;
+    case FileSeekOrigin::End:
+        whence = SEEK_END;
+        break;
+    default:
+        ASSERT_NOT_REACHED();
+    }
+    return static_cast<long long>(lseek(handle, offset, whence));
+}
+
+int readFromFile(PlatformFileHandle handle, char* data, int length)
+{
+    if (length < 0 || !data)
+        return -1;
+
+    const char* source = nullptr;
+    size_t count = 0;
+    {
+        auto locker = holdLock(mappedFilesLock);
+        auto it = mappedFiles().find(handle);
+        if (it != mappedFiles().end()) {
+            MappedFile& mapped = it->value;
+            if (mapped.position >= mapped.size)
+                return 0;
+            source = static_cast<const char*>(mapped.data) + mapped.position;
+            count = std::min(static_cast<size_t>(length), mapped.size - mapped.position);
+            mapped.position += count;
+        }
+    }
+    if (source) {
+        // Copy outside the lock, faulting pages in may take a while.
+        memcpy(data, source, count);
+        return static_cast<int>(count);
+    }
+
+    do {
+        int bytesRead = read(handle, data, static_cast<size_t>(length));
+        if (bytesRead >= 0)
+            return bytesRead;
+    } while (errno == EINTR);
+    return -1;
+}
+
+} // namespace FileSystemImpl
+
+} // namespace WTF
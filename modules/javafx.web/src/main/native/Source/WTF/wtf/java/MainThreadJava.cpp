@@ -29,9 +29,45 @@
 #include <wtf/java/JavaRef.h>
 #include <wtf/MainThread.h>
 
+#include <atomic>
+
 namespace WTF {
+
+// Whether the current thread is the JavaFX event thread. The event thread
+// never changes, so each thread asks Java at most once and remembers the
+// answer; once initializeMainThreadPlatform() has run on the event thread no
+// other thread needs to ask at all.
+enum class MainThreadState : uint8_t { Unknown, Main, Other };
+static thread_local MainThreadState currentThreadState = MainThreadState::Unknown;
+static std::atomic<bool> mainThreadInitialized { false };
+
+// Set while a dispatch request is pending on the event thread, so that a burst
+// of callOnMainThread() calls from several threads posts a single runnable.
+static std::atomic<bool> dispatchScheduled { false };
+
+static bool isJavaEventThread()
+{
+    AttachThreadAsNonDaemonToJavaEnv autoAttach;
+    JNIEnv* env = autoAttach.env();
+    static JGClass jMainThreadCls(env->FindClass("com/sun/webkit/MainThread"));
+
+    static jmethodID mid = env->GetStaticMethodID(
+            jMainThreadCls,
+            "fwkIsMainThread",
+            "()Z");
+
+    ASSERT(mid);
+
+    jboolean isMainThread = env->CallStaticBooleanMethod(jMainThreadCls, mid);
+    WTF::CheckAndClearException(env);
+    return isMainThread == JNI_TRUE;
+}
+
 void scheduleDispatchFunctionsOnMainThread()
 {
+    if (dispatchScheduled.exchange(true))
+        return;
+
     AttachThreadAsNonDaemonToJavaEnv autoAttach;
     JNIEnv* env = autoAttach.env();
     static JGClass jMainThreadCls(env->FindClass("com/sun/webkit/MainThread"));
@@ -44,11 +80,16 @@ void scheduleDispatchFunctionsOnMainThread()
     ASSERT(mid);
 
     env->CallStaticVoidMethod(jMainThreadCls, mid);
-    WTF::CheckAndClearException(env);
+    if (WTF::CheckAndClearException(env))
+        dispatchScheduled.store(false);
 }
 
 void initializeMainThreadPlatform()
 {
+    // Called from WebPage.twkCreatePage, i.e. on the event thread.
+    ASSERT(isJavaEventThread());
+    currentThreadState = MainThreadState::Main;
+    mainThreadInitialized.store(true, std::memory_order_release);
 }
 
 bool isMainThreadIfInitialized()
@@ -58,20 +99,12 @@ bool isMainThreadIfInitialized()
 
 bool isMainThread()
 {
-    AttachThreadAsNonDaemonToJavaEnv autoAttach;
-    JNIEnv* env = autoAttach.env();
-    static JGClass jMainThreadCls(env->FindClass("com/sun/webkit/MainThread"));
-
-    static jmethodID mid = env->GetStaticMethodID(
-            jMainThreadCls,
-            "fwkIsMainThread",
-            "()Z");
+    if (LIKELY(currentThreadState != MainThreadState::Unknown))
+        return currentThreadState == MainThreadState::Main;
 
-    ASSERT(mid);
-
-    jboolean isMainThread = env->CallStaticBooleanMethod(jMainThreadCls, mid);
-    WTF::CheckAndClearException(env);
-    return isMainThread == JNI_TRUE;
+    bool isMain = mainThreadInitialized.load(std::memory_order_acquire) ? false : isJavaEventThread();
+    currentThreadState = isMain ? MainThreadState::Main : MainThreadState::Other;
+    return isMain;
 }
 
 extern "C" {
@@ -84,6 +117,9 @@ extern "C" {
 JNIEXPORT void JNICALL Java_com_sun_webkit_MainThread_twkScheduleDispatchFunctions
   (JNIEnv*, jobject)
 {
+    // Clear the flag before draining the queue so that anything posted while
+    // we run, or left behind when dispatching yields, gets a new wake-up.
+    dispatchScheduled.store(false);
     dispatchFunctionsFromMainThread();
 }
 }
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2015, 2016, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2015, 2019, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -24,43 +24,76 @@
  */
 
 #include "config.h"
-#include "RunLoop.h"
+#include <wtf/RunLoop.h>
+
+#include <wtf/java/JavaEnv.h>
+#include <wtf/java/JavaRef.h>
+
+#include <cmath>
 
 namespace WTF {
 
-// JDK-8146878
-//XXX: implement these stubs?
+// Earliest time the event thread has been asked to iterate the main RunLoop.
+// Requests for the same or a later time are folded into the pending one, so
+// a burst of dispatches and timer starts costs a single wake-up. Guarded by
+// the main RunLoop's m_loopLock.
+static MonotonicTime scheduledWakeUp = MonotonicTime::infinity();
 
-RunLoop::RunLoop() {}
-RunLoop::~RunLoop() {}
+void RunLoop::scheduleEventThreadWakeUp(const AbstractLocker&, MonotonicTime fireTime)
+{
+    ASSERT(m_isEventThreadLoop);
+    if (scheduledWakeUp <= fireTime)
+        return;
+    scheduledWakeUp = fireTime;
 
-void RunLoop::TimerBase::fired() {}
+    Seconds delay = std::max(fireTime - MonotonicTime::now(), 0_s);
 
-void RunLoop::run() {}
-void RunLoop::stop() {}
-void RunLoop::wakeUp() {}
+    AttachThreadAsNonDaemonToJavaEnv autoAttach;
+    JNIEnv* env = autoAttach.env();
+    static JGClass jMainThreadCls(env->FindClass("com/sun/webkit/MainThread"));
 
-RunLoop::TimerBase::TimerBase(RunLoop& runLoop)
-    : m_runLoop(runLoop)
-{
-}
+    static jmethodID mid = env->GetStaticMethodID(
+            jMainThreadCls,
+            "fwkScheduleRunLoopWakeUp",
+            "(J)V");
 
-RunLoop::TimerBase::~TimerBase()
-{
-    stop();
-}
+    ASSERT(mid);
 
-void RunLoop::TimerBase::start(double fireInterval, bool repeat)
-{
+    env->CallStaticVoidMethod(jMainThreadCls, mid, static_cast<jlong>(std::ceil(delay.milliseconds())));
+    if (WTF::CheckAndClearException(env))
+        scheduledWakeUp = MonotonicTime::infinity();
 }
 
-void RunLoop::TimerBase::stop()
+void RunLoop::iterateOnEventThread()
 {
+    RunLoop& runLoop = RunLoop::main();
+    ASSERT(&RunLoop::current() == &runLoop);
+    {
+        LockHolder locker(runLoop.m_loopLock);
+        scheduledWakeUp = MonotonicTime::infinity();
+    }
+
+    RunLoop::iterate();
+
+    // Repeating timers are put back on the heap without a wake-up, and
+    // timers that are not due yet were left there, so ask for the next one.
+    LockHolder locker(runLoop.m_loopLock);
+    if (!runLoop.m_schedules.isEmpty())
+        runLoop.scheduleEventThreadWakeUp(locker, runLoop.m_schedules.first()->scheduledTimePoint());
 }
 
-bool RunLoop::TimerBase::isActive() const
+extern "C" {
+
+/*
+ * Class:     com_sun_webkit_MainThread
+ * Method:    twkRunMainLoop
+ * Signature: ()V
+ */
+JNIEXPORT void JNICALL Java_com_sun_webkit_MainThread_twkRunMainLoop
+  (JNIEnv*, jclass)
 {
-  return true;
+    RunLoop::iterateOnEventThread();
+}
 }
 
 } // namespace WTF
@@ -73,6 +73,8 @@ bool deleteFile(const String& path)
     return !unlink(fsRep.data());
 }
 
+#if !PLATFORM(JAVA)
+// The Java port maps large files for reading, see FileSystemPOSIXJava.cpp.
 PlatformFileHandle openFile(const String& path, FileOpenMode mode)
 {
     CString fsRep = fileSystemRepresentation(path);
@@ -119,6 +121,7 @@ long long seekFile(PlatformFileHandle handle, long long offset, FileSeekOrigin o
     }
     return static_cast<long long>(lseek(handle, offset, whence));
 }
+#endif
 
 bool truncateFile(PlatformFileHandle handle, long long offset)
 {
@@ -136,6 +139,7 @@ int writeToFile(PlatformFileHandle handle, const char* data, int length)
     return -1;
 }
 
+#if !PLATFORM(JAVA)
 int readFromFile(PlatformFileHandle handle, char* data, int length)
 {
     do {
@@ -145,6 +149,7 @@ int readFromFile(PlatformFileHandle handle, char* data, int length)
     } while (errno == EINTR);
     return -1;
 }
+#endif
 
 #if USE(FILE_LOCK)
 bool lockFile(PlatformFileHandle handle, OptionSet<FileLockMode> lockMode)
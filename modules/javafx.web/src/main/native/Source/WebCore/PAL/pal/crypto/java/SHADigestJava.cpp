@@ -0,0 +1,545 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#include "config.h"
+#include "SHADigestJava.h"
+
+#include <algorithm>
+#include <string.h>
+
+#if (CPU(X86) || CPU(X86_64)) && (COMPILER(GCC_COMPATIBLE) || COMPILER(MSVC))
+#include <immintrin.h>
+#define HAVE_SHANI_KERNEL 1
+#if COMPILER(GCC_COMPATIBLE)
+#define SHANI_TARGET __attribute__((target("sha,sse4.1")))
+#else
+#define SHANI_TARGET
+#endif
+#endif
+
+namespace PAL {
+
+namespace {
+
+const uint32_t sha1InitialState[5] = {
+    0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476, 0xc3d2e1f0
+};
+
+const uint32_t sha224InitialState[8] = {
+    0xc1059ed8, 0x367cd507, 0x3070dd17, 0xf70e5939, 0xffc00b31, 0x68581511, 0x64f98fa7, 0xbefa4fa4
+};
+
+const uint32_t sha256InitialState[8] = {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+};
+
+const uint64_t sha384InitialState[8] = {
+    0xcbbb9d5dc1059ed8ULL, 0x629a292a367cd507ULL, 0x9159015a3070dd17ULL, 0x152fecd8f70e5939ULL,
+    0x67332667ffc00b31ULL, 0x8eb44a8768581511ULL, 0xdb0c2e0d64f98fa7ULL, 0x47b5481dbefa4fa4ULL
+};
+
+const uint64_t sha512InitialState[8] = {
+    0x6a09e667f3bcc908ULL, 0xbb67ae8584caa73bULL, 0x3c6ef372fe94f82bULL, 0xa54ff53a5f1d36f1ULL,
+    0x510e527fade682d1ULL, 0x9b05688c2b3e6c1fULL, 0x1f83d9abfb41bd6bULL, 0x5be0cd19137e2179ULL
+};
+
+alignas(16) const uint32_t sha256RoundConstants[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+const uint64_t sha512RoundConstants[80] = {
+    0x428a2f98d728ae22ULL, 0x7137449123ef65cdULL, 0xb5c0fbcfec4d3b2fULL, 0xe9b5dba58189dbbcULL,
+    0x3956c25bf348b538ULL, 0x59f111f1b605d019ULL, 0x923f82a4af194f9bULL, 0xab1c5ed5da6d8118ULL,
+    0xd807aa98a3030242ULL, 0x12835b0145706fbeULL, 0x243185be4ee4b28cULL, 0x550c7dc3d5ffb4e2ULL,
+    0x72be5d74f27b896fULL, 0x80deb1fe3b1696b1ULL, 0x9bdc06a725c71235ULL, 0xc19bf174cf692694ULL,
+    0xe49b69c19ef14ad2ULL, 0xefbe4786384f25e3ULL, 0x0fc19dc68b8cd5b5ULL, 0x240ca1cc77ac9c65ULL,
+    0x2de92c6f592b0275ULL, 0x4a7484aa6ea6e483ULL, 0x5cb0a9dcbd41fbd4ULL, 0x76f988da831153b5ULL,
+    0x983e5152ee66dfabULL, 0xa831c66d2db43210ULL, 0xb00327c898fb213fULL, 0xbf597fc7beef0ee4ULL,
+    0xc6e00bf33da88fc2ULL, 0xd5a79147930aa725ULL, 0x06ca6351e003826fULL, 0x142929670a0e6e70ULL,
+    0x27b70a8546d22ffcULL, 0x2e1b21385c26c926ULL, 0x4d2c6dfc5ac42aedULL, 0x53380d139d95b3dfULL,
+    0x650a73548baf63deULL, 0x766a0abb3c77b2a8ULL, 0x81c2c92e47edaee6ULL, 0x92722c851482353bULL,
+    0xa2bfe8a14cf10364ULL, 0xa81a664bbc423001ULL, 0xc24b8b70d0f89791ULL, 0xc76c51a30654be30ULL,
+    0xd192e819d6ef5218ULL, 0xd69906245565a910ULL, 0xf40e35855771202aULL, 0x106aa07032bbd1b8ULL,
+    0x19a4c116b8d2d0c8ULL, 0x1e376c085141ab53ULL, 0x2748774cdf8eeb99ULL, 0x34b0bcb5e19b48a8ULL,
+    0x391c0cb3c5c95a63ULL, 0x4ed8aa4ae3418acbULL, 0x5b9cca4f7763e373ULL, 0x682e6ff3d6b2b8a3ULL,
+    0x748f82ee5defb2fcULL, 0x78a5636f43172f60ULL, 0x84c87814a1f0ab72ULL, 0x8cc702081a6439ecULL,
+    0x90befffa23631e28ULL, 0xa4506cebde82bde9ULL, 0xbef9a3f7b2c67915ULL, 0xc67178f2e372532bULL,
+    0xca273eceea26619cULL, 0xd186b8c721c0c207ULL, 0xeada7dd6cde0eb1eULL, 0xf57d4f7fee6ed178ULL,
+    0x06f067aa72176fbaULL, 0x0a637dc5a2c898a6ULL, 0x113f9804bef90daeULL, 0x1b710b35131c471bULL,
+    0x28db77f523047d84ULL, 0x32caab7b40c72493ULL, 0x3c9ebe0a15c9bebcULL, 0x431d67c49c100d4cULL,
+    0x4cc5d4becb3e42b6ULL, 0x597f299cfc657e2aULL, 0x5fcb6fab3ad6faecULL, 0x6c44198c4a475817ULL
+};
+
+inline uint32_t rotateRight(uint32_t x, unsigned n) { return (x >> n) | (x << (32 - n)); }
+inline uint64_t rotateRight(uint64_t x, unsigned n) { return (x >> n) | (x << (64 - n)); }
+inline uint32_t rotateLeft(uint32_t x, unsigned n) { return (x << n) | (x >> (32 - n)); }
+
+inline uint32_t loadBigEndian32(const uint8_t* p)
+{
+    return (static_cast<uint32_t>(p[0]) << 24) | (static_cast<uint32_t>(p[1]) << 16)
+        | (static_cast<uint32_t>(p[2]) << 8) | p[3];
+}
+
+inline uint64_t loadBigEndian64(const uint8_t* p)
+{
+    return (static_cast<uint64_t>(loadBigEndian32(p)) << 32) | loadBigEndian32(p + 4);
+}
+
+inline void storeBigEndian32(uint8_t* p, uint32_t value)
+{
+    p[0] = static_cast<uint8_t>(value >> 24);
+    p[1] = static_cast<uint8_t>(value >> 16);
+    p[2] = static_cast<uint8_t>(value >> 8);
+    p[3] = static_cast<uint8_t>(value);
+}
+
+inline void storeBigEndian64(uint8_t* p, uint64_t value)
+{
+    storeBigEndian32(p, static_cast<uint32_t>(value >> 32));
+    storeBigEndian32(p + 4, static_cast<uint32_t>(value));
+}
+
+void sha1CompressPortable(uint32_t state[5], const uint8_t* blocks, size_t count)
+{
+    for (; count; --count, blocks += 64) {
+        uint32_t w[80];
+        for (unsigned t = 0; t < 16; ++t)
+            w[t] = loadBigEndian32(blocks + 4 * t);
+        for (unsigned t = 16; t < 80; ++t)
+            w[t] = rotateLeft(w[t - 3] ^ w[t - 8] ^ w[t - 14] ^ w[t - 16], 1);
+
+        uint32_t a = state[0], b = state[1], c = state[2], d = state[3], e = state[4];
+        auto round = [&](uint32_t f, uint32_t k, uint32_t w) {
+            uint32_t temp = rotateLeft(a, 5) + f + e + k + w;
+            e = d;
+            d = c;
+            c = rotateLeft(b, 30);
+            b = a;
+            a = temp;
+        };
+        unsigned t = 0;
+        for (; t < 20; ++t)
+            round((b & c) | (~b & d), 0x5a827999, w[t]);
+        for (; t < 40; ++t)
+            round(b ^ c ^ d, 0x6ed9eba1, w[t]);
+        for (; t < 60; ++t)
+            round((b & c) | (b & d) | (c & d), 0x8f1bbcdc, w[t]);
+        for (; t < 80; ++t)
+            round(b ^ c ^ d, 0xca62c1d6, w[t]);
+        state[0] += a;
+        state[1] += b;
+        state[2] += c;
+        state[3] += d;
+        state[4] += e;
+    }
+}
+
+void sha256CompressPortable(uint32_t state[8], const uint8_t* blocks, size_t count)
+{
+    for (; count; --count, blocks += 64) {
+        uint32_t w[64];
+        for (unsigned t = 0; t < 16; ++t)
+            w[t] = loadBigEndian32(blocks + 4 * t);
+        for (unsigned t = 16; t < 64; ++t) {
+            uint32_t s0 = rotateRight(w[t - 15], 7) ^ rotateRight(w[t - 15], 18) ^ (w[t - 15] >> 3);
+            uint32_t s1 = rotateRight(w[t - 2], 17) ^ rotateRight(w[t - 2], 19) ^ (w[t - 2] >> 10);
+            w[t] = w[t - 16] + s0 + w[t - 7] + s1;
+        }
+
+        uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+        uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+        for (unsigned t = 0; t < 64; ++t) {
+            uint32_t s1 = rotateRight(e, 6) ^ rotateRight(e, 11) ^ rotateRight(e, 25);
+            uint32_t choose = (e & f) ^ (~e & g);
+            uint32_t temp1 = h + s1 + choose + sha256RoundConstants[t] + w[t];
+            uint32_t s0 = rotateRight(a, 2) ^ rotateRight(a, 13) ^ rotateRight(a, 22);
+            uint32_t majority = (a & b) ^ (a & c) ^ (b & c);
+            uint32_t temp2 = s0 + majority;
+            h = g;
+            g = f;
+            f = e;
+            e = d + temp1;
+            d = c;
+            c = b;
+            b = a;
+            a = temp1 + temp2;
+        }
+        state[0] += a;
+        state[1] += b;
+        state[2] += c;
+        state[3] += d;
+        state[4] += e;
+        state[5] += f;
+        state[6] += g;
+        state[7] += h;
+    }
+}
+
+void sha512CompressPortable(uint64_t state[8], const uint8_t* blocks, size_t count)
+{
+    for (; count; --count, blocks += 128) {
+        uint64_t w[80];
+        for (unsigned t = 0; t < 16; ++t)
+            w[t] = loadBigEndian64(blocks + 8 * t);
+        for (unsigned t = 16; t < 80; ++t) {
+            uint64_t s0 = rotateRight(w[t - 15], 1) ^ rotateRight(w[t - 15], 8) ^ (w[t - 15] >> 7);
+            uint64_t s1 = rotateRight(w[t - 2], 19) ^ rotateRight(w[t - 2], 61) ^ (w[t - 2] >> 6);
+            w[t] = w[t - 16] + s0 + w[t - 7] + s1;
+        }
+
+        uint64_t a = state[0], b = state[1], c = state[2], d = state[3];
+        uint64_t e = state[4], f = state[5], g = state[6], h = state[7];
+        for (unsigned t = 0; t < 80; ++t) {
+            uint64_t s1 = rotateRight(e, 14) ^ rotateRight(e, 18) ^ rotateRight(e, 41);
+            uint64_t choose = (e & f) ^ (~e & g);
+            uint64_t temp1 = h + s1 + choose + sha512RoundConstants[t] + w[t];
+            uint64_t s0 = rotateRight(a, 28) ^ rotateRight(a, 34) ^ rotateRight(a, 39);
+            uint64_t majority = (a & b) ^ (a & c) ^ (b & c);
+            uint64_t temp2 = s0 + majority;
+            h = g;
+            g = f;
+            f = e;
+            e = d + temp1;
+            d = c;
+            c = b;
+            b = a;
+            a = temp1 + temp2;
+        }
+        state[0] += a;
+        state[1] += b;
+        state[2] += c;
+        state[3] += d;
+        state[4] += e;
+        state[5] += f;
+        state[6] += g;
+        state[7] += h;
+    }
+}
+
+#if HAVE(SHANI_KERNEL)
+
+// Four rounds with the boolean function and constant of the given group,
+// then the next four message words. w holds W[j - 4] .. W[j - 1] as
+// w[j % 4]; the message for rounds 4j .. 4j + 3 replaces W[j - 4].
+#define SHA1_ROUNDS(j, function) do { \
+    if (j >= 4) \
+        w[j % 4] = _mm_sha1msg2_epu32(_mm_xor_si128(_mm_sha1msg1_epu32(w[j % 4], w[(j + 1) % 4]), w[(j + 2) % 4]), w[(j + 3) % 4]); \
+    e = _mm_sha1nexte_epu32(previousABCD, w[j % 4]); \
+    previousABCD = abcd; \
+    abcd = _mm_sha1rnds4_epu32(abcd, e, function); \
+} while (0)
+
+SHANI_TARGET void sha1CompressSHANI(uint32_t state[5], const uint8_t* blocks, size_t count)
+{
+    const __m128i byteSwap = _mm_set_epi64x(0x0001020304050607ULL, 0x08090a0b0c0d0e0fULL);
+
+    // The SHA instructions keep A in the highest lane and E in its own register.
+    __m128i abcd = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(state)), 0x1b);
+    __m128i e0 = _mm_set_epi32(static_cast<int>(state[4]), 0, 0, 0);
+
+    for (; count; --count, blocks += 64) {
+        __m128i savedABCD = abcd;
+        __m128i savedE0 = e0;
+        __m128i w[4];
+        for (unsigned i = 0; i < 4; ++i)
+            w[i] = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(blocks + 16 * i)), byteSwap);
+
+        __m128i e = _mm_add_epi32(e0, w[0]);
+        __m128i previousABCD = abcd;
+        abcd = _mm_sha1rnds4_epu32(abcd, e, 0);
+        SHA1_ROUNDS(1, 0);
+        SHA1_ROUNDS(2, 0);
+        SHA1_ROUNDS(3, 0);
+        SHA1_ROUNDS(4, 0);
+        SHA1_ROUNDS(5, 1);
+        SHA1_ROUNDS(6, 1);
+        SHA1_ROUNDS(7, 1);
+        SHA1_ROUNDS(8, 1);
+        SHA1_ROUNDS(9, 1);
+        SHA1_ROUNDS(10, 2);
+        SHA1_ROUNDS(11, 2);
+        SHA1_ROUNDS(12, 2);
+        SHA1_ROUNDS(13, 2);
+        SHA1_ROUNDS(14, 2);
+        SHA1_ROUNDS(15, 3);
+        SHA1_ROUNDS(16, 3);
+        SHA1_ROUNDS(17, 3);
+        SHA1_ROUNDS(18, 3);
+        SHA1_ROUNDS(19, 3);
+
+        e0 = _mm_sha1nexte_epu32(previousABCD, savedE0);
+        abcd = _mm_add_epi32(abcd, savedABCD);
+    }
+
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(state), _mm_shuffle_epi32(abcd, 0x1b));
+    state[4] = static_cast<uint32_t>(_mm_extract_epi32(e0, 3));
+}
+
+#undef SHA1_ROUNDS
+
+SHANI_TARGET void sha256CompressSHANI(uint32_t state[8], const uint8_t* blocks, size_t count)
+{
+    const __m128i byteSwap = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+    // sha256rnds2 wants the state as ABEF and CDGH.
+    __m128i cdab = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(state)), 0xb1);
+    __m128i efgh = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(state + 4)), 0x1b);
+    __m128i abef = _mm_alignr_epi8(cdab, efgh, 8);
+    __m128i cdgh = _mm_blend_epi16(efgh, cdab, 0xf0);
+
+    for (; count; --count, blocks += 64) {
+        __m128i savedABEF = abef;
+        __m128i savedCDGH = cdgh;
+        __m128i w[4];
+        for (unsigned j = 0; j < 16; ++j) {
+            if (j < 4)
+                w[j] = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(blocks + 16 * j)), byteSwap);
+            else {
+                __m128i w7 = _mm_alignr_epi8(w[(j + 3) % 4], w[(j + 2) % 4], 4);
+                w[j % 4] = _mm_sha256msg2_epu32(_mm_add_epi32(_mm_sha256msg1_epu32(w[j % 4], w[(j + 1) % 4]), w7), w[(j + 3) % 4]);
+            }
+            __m128i message = _mm_add_epi32(w[j % 4], _mm_load_si128(reinterpret_cast<const __m128i*>(sha256RoundConstants + 4 * j)));
+            cdgh = _mm_sha256rnds2_epu32(cdgh, abef, message);
+            abef = _mm_sha256rnds2_epu32(abef, cdgh, _mm_shuffle_epi32(message, 0x0e));
+        }
+        abef = _mm_add_epi32(abef, savedABEF);
+        cdgh = _mm_add_epi32(cdgh, savedCDGH);
+    }
+
+    __m128i feba = _mm_shuffle_epi32(abef, 0x1b);
+    __m128i dchg = _mm_shuffle_epi32(cdgh, 0xb1);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(state), _mm_blend_epi16(feba, dchg, 0xf0));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(state + 4), _mm_alignr_epi8(dchg, feba, 8));
+}
+
+void readCPUID(unsigned level, unsigned count, unsigned result[4])
+{
+#if COMPILER(MSVC)
+    __cpuidex(reinterpret_cast<int*>(result), level, count);
+#else
+    __asm__ (
+        "cpuid\n"
+        : "=a"(result[0]), "=b"(result[1]), "=c"(result[2]), "=d"(result[3])
+        : "0"(level), "2"(count)
+    );
+#endif
+}
+
+bool cpuSupportsSHANI()
+{
+    unsigned result[4];
+    readCPUID(0, 0, result);
+    if (result[0] < 7)
+        return false;
+
+    // The kernels also use SSSE3 shuffles and SSE4.1 blends and extracts.
+    const unsigned ssse3AndSSE41 = (1 << 9) | (1 << 19);
+    readCPUID(1, 0, result);
+    if ((result[2] & ssse3AndSSE41) != ssse3AndSSE41)
+        return false;
+
+    readCPUID(7, 0, result);
+    return result[1] & (1 << 29);
+}
+
+#endif // HAVE(SHANI_KERNEL)
+
+} // namespace
+
+bool isSHAKernelSupported(SHAKernel kernel)
+{
+    switch (kernel) {
+    case SHAKernel::Portable:
+        return true;
+    case SHAKernel::SHANI:
+#if HAVE(SHANI_KERNEL)
+        {
+            static const bool supported = cpuSupportsSHANI();
+            return supported;
+        }
+#else
+        return false;
+#endif
+    }
+    return false;
+}
+
+SHAKernel bestSHAKernel()
+{
+    static const SHAKernel best = isSHAKernelSupported(SHAKernel::SHANI) ? SHAKernel::SHANI : SHAKernel::Portable;
+    return best;
+}
+
+const char* shaKernelName(SHAKernel kernel)
+{
+    switch (kernel) {
+    case SHAKernel::Portable:
+        return "portable";
+    case SHAKernel::SHANI:
+        return "sha-ni";
+    }
+    return "unknown";
+}
+
+SHADigest::SHADigest(Algorithm algorithm, SHAKernel kernel)
+    : m_algorithm(algorithm)
+    , m_kernel(kernel)
+    , m_is64Bit(algorithm == Algorithm::SHA384 || algorithm == Algorithm::SHA512)
+{
+    ASSERT(isSHAKernelSupported(kernel));
+    switch (algorithm) {
+    case Algorithm::SHA1:
+        memcpy(m_state.words32, sha1InitialState, sizeof(sha1InitialState));
+        break;
+    case Algorithm::SHA224:
+        memcpy(m_state.words32, sha224InitialState, sizeof(sha224InitialState));
+        break;
+    case Algorithm::SHA256:
+        memcpy(m_state.words32, sha256InitialState, sizeof(sha256InitialState));
+        break;
+    case Algorithm::SHA384:
+        memcpy(m_state.words64, sha384InitialState, sizeof(sha384InitialState));
+        break;
+    case Algorithm::SHA512:
+        memcpy(m_state.words64, sha512InitialState, sizeof(sha512InitialState));
+        break;
+    }
+}
+
+size_t SHADigest::digestLength(Algorithm algorithm)
+{
+    switch (algorithm) {
+    case Algorithm::SHA1:
+        return 20;
+    case Algorithm::SHA224:
+        return 28;
+    case Algorithm::SHA256:
+        return 32;
+    case Algorithm::SHA384:
+        return 48;
+    case Algorithm::SHA512:
+        return 64;
+    }
+    return 0;
+}
+
+void SHADigest::compress(const uint8_t* blocks, size_t count)
+{
+    switch (m_algorithm) {
+    case Algorithm::SHA1:
+#if HAVE(SHANI_KERNEL)
+        if (m_kernel == SHAKernel::SHANI) {
+            sha1CompressSHANI(m_state.words32, blocks, count);
+            return;
+        }
+#endif
+        sha1CompressPortable(m_state.words32, blocks, count);
+        return;
+    case Algorithm::SHA224:
+    case Algorithm::SHA256:
+#if HAVE(SHANI_KERNEL)
+        if (m_kernel == SHAKernel::SHANI) {
+            sha256CompressSHANI(m_state.words32, blocks, count);
+            return;
+        }
+#endif
+        sha256CompressPortable(m_state.words32, blocks, count);
+        return;
+    case Algorithm::SHA384:
+    case Algorithm::SHA512:
+        sha512CompressPortable(m_state.words64, blocks, count);
+        return;
+    }
+}
+
+void SHADigest::addBytes(const uint8_t* input, size_t length)
+{
+    size_t blockLength = this->blockLength();
+    m_totalLength += length;
+
+    if (m_bufferLength) {
+        size_t fill = std::min(length, blockLength - m_bufferLength);
+        memcpy(m_buffer + m_bufferLength, input, fill);
+        m_bufferLength += fill;
+        input += fill;
+        length -= fill;
+        if (m_bufferLength < blockLength)
+            return;
+        compress(m_buffer, 1);
+        m_bufferLength = 0;
+    }
+
+    // Hash whole blocks straight from the input.
+    size_t blocks = length / blockLength;
+    if (blocks) {
+        compress(input, blocks);
+        input += blocks * blockLength;
+        length -= blocks * blockLength;
+    }
+
+    memcpy(m_buffer, input, length);
+    m_bufferLength = length;
+}
+
+void SHADigest::computeHash(uint8_t* digest)
+{
+    size_t blockLength = this->blockLength();
+    // The message length in bits is stored big endian in the last 8 (SHA-1,
+    // SHA-256) or 16 (SHA-512) bytes of the final block.
+    size_t lengthFieldSize = m_is64Bit ? 16 : 8;
+    uint64_t bitLengthLow = m_totalLength << 3;
+    uint64_t bitLengthHigh = m_totalLength >> 61;
+
+    m_buffer[m_bufferLength++] = 0x80;
+    if (m_bufferLength > blockLength - lengthFieldSize) {
+        memset(m_buffer + m_bufferLength, 0, blockLength - m_bufferLength);
+        compress(m_buffer, 1);
+        m_bufferLength = 0;
+    }
+    memset(m_buffer + m_bufferLength, 0, blockLength - m_bufferLength);
+    if (m_is64Bit)
+        storeBigEndian64(m_buffer + blockLength - 16, bitLengthHigh);
+    storeBigEndian64(m_buffer + blockLength - 8, bitLengthLow);
+    compress(m_buffer, 1);
+    m_bufferLength = 0;
+
+    size_t length = digestLength();
+    if (m_is64Bit) {
+        for (size_t i = 0; i < length / 8; ++i)
+            storeBigEndian64(digest + 8 * i, m_state.words64[i]);
+    } else {
+        for (size_t i = 0; i < length / 4; ++i)
+            storeBigEndian32(digest + 4 * i, m_state.words32[i]);
+    }
+}
+
+} // namespace PAL
@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace PAL {
+
+/*
+ * Block functions used by the compress loops of SHADigest. SHA-1 and
+ * SHA-224/256 can use the x86 SHA extensions, SHA-384/512 are always
+ * computed by the portable code.
+ */
+enum class SHAKernel {
+    Portable,
+    SHANI
+};
+
+// The fastest kernel supported by the running CPU, detected once.
+SHAKernel bestSHAKernel();
+bool isSHAKernelSupported(SHAKernel);
+const char* shaKernelName(SHAKernel);
+
+/*
+ * Incremental SHA-1 and SHA-2 (FIPS 180-4) digest, the Java port's
+ * CryptoDigest implementation.
+ */
+class SHADigest {
+public:
+    enum class Algorithm {
+        SHA1,
+        SHA224,
+        SHA256,
+        SHA384,
+        SHA512
+    };
+
+    static const size_t maxDigestLength = 64;
+
+    explicit SHADigest(Algorithm algorithm)
+        : SHADigest(algorithm, bestSHAKernel())
+    {
+    }
+    SHADigest(Algorithm, SHAKernel);
+
+    static size_t digestLength(Algorithm);
+    size_t digestLength() const { return digestLength(m_algorithm); }
+
+    void addBytes(const uint8_t* input, size_t length);
+    // Writes digestLength() bytes to digest. The object cannot be reused.
+    void computeHash(uint8_t* digest);
+
+private:
+    size_t blockLength() const { return m_is64Bit ? 128 : 64; }
+    void compress(const uint8_t* blocks, size_t count);
+
+    Algorithm m_algorithm;
+    SHAKernel m_kernel;
+    bool m_is64Bit;
+    union {
+        uint32_t words32[8];
+        uint64_t words64[8];
+    } m_state;
+    uint8_t m_buffer[128];
+    size_t m_bufferLength { 0 };
+    uint64_t m_totalLength { 0 };
+};
+
+} // namespace PAL
@@ -0,0 +1,249 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+// Measures the throughput of the native CryptoDigest kernels and checks them
+// against the FIPS 180 test vectors and each other. From the native source
+// root it builds standalone like so:
+// g++ -o CryptoDigestSpeedTest -O3 -DNDEBUG -std=c++17 -ISource/WTF -ISource/WebCore/PAL/pal/crypto/java Source/WebCore/PAL/pal/crypto/java/benchmarks/CryptoDigestSpeedTest.cpp Source/WebCore/PAL/pal/crypto/java/SHADigestJava.cpp
+// Adding -DWITH_JAVA_DIGEST -I$JAVA_HOME/include -I$JAVA_HOME/include/<os>
+// -L$JAVA_HOME/lib/server -ljvm also times java.security.MessageDigest driven
+// through JNI the way CryptoDigestJava.cpp used to, one direct ByteBuffer per
+// chunk.
+//
+// Usage: CryptoDigestSpeedTest [<megabytes> [<chunk size>]]
+// The default hashes 64MB per algorithm in 16KB chunks.
+
+#include "config.h"
+
+#include "SHADigestJava.h"
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+#if defined(WITH_JAVA_DIGEST)
+#include <jni.h>
+#endif
+
+using namespace PAL;
+
+namespace {
+
+size_t totalBytes = 64 * 1024 * 1024;
+size_t chunkSize = 16 * 1024;
+
+struct Algorithm {
+    const char* name;
+    SHADigest::Algorithm algorithm;
+    const char* abcDigest;
+};
+
+const Algorithm algorithms[] = {
+    { "SHA-1", SHADigest::Algorithm::SHA1,
+        "a9993e364706816aba3e25717850c26c9cd0d89d" },
+    { "SHA-224", SHADigest::Algorithm::SHA224,
+        "23097d223405d8228642a477bda255b32aadbce4bda0b3f7e36c9da7" },
+    { "SHA-256", SHADigest::Algorithm::SHA256,
+        "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad" },
+    { "SHA-384", SHADigest::Algorithm::SHA384,
+        "cb00753f45a35e8bb5a03d699ac65007272c32ab0eded1631a8b605a43ff5bed"
+        "8086072ba1e7cc2358baeca134c825a7" },
+    { "SHA-512", SHADigest::Algorithm::SHA512,
+        "ddaf35a193617abacc417349ae20413112e6fa4e89a97ea20a9eeee64b55d39a"
+        "2192992a274fc1a836ba3c23a3feebbd454d4423643ce80e2a9ac94fa54ca49f" },
+};
+
+const SHAKernel kernels[] = { SHAKernel::Portable, SHAKernel::SHANI };
+
+std::vector<uint8_t> digest(SHADigest::Algorithm algorithm, SHAKernel kernel, const uint8_t* data, size_t length, size_t chunk)
+{
+    SHADigest digest(algorithm, kernel);
+    for (size_t offset = 0; offset < length; offset += chunk)
+        digest.addBytes(data + offset, std::min(chunk, length - offset));
+    std::vector<uint8_t> result(digest.digestLength());
+    digest.computeHash(result.data());
+    return result;
+}
+
+bool matchesHex(const std::vector<uint8_t>& bytes, const char* hex)
+{
+    if (strlen(hex) != 2 * bytes.size())
+        return false;
+    for (size_t i = 0; i < bytes.size(); ++i) {
+        char byte[3];
+        snprintf(byte, sizeof(byte), "%02x", bytes[i]);
+        if (strncmp(byte, hex + 2 * i, 2))
+            return false;
+    }
+    return true;
+}
+
+// Every kernel must agree with the test vector and with the portable code on
+// all message lengths around the padding boundaries, fed in odd chunks.
+bool verify(const Algorithm& algorithm, SHAKernel kernel, const std::vector<uint8_t>& data)
+{
+    if (!matchesHex(digest(algorithm.algorithm, kernel, reinterpret_cast<const uint8_t*>("abc"), 3, 3), algorithm.abcDigest))
+        return false;
+    for (size_t length = 0; length <= 520; ++length) {
+        for (size_t chunk : { static_cast<size_t>(1), static_cast<size_t>(7), static_cast<size_t>(64), length + 1 }) {
+            if (digest(algorithm.algorithm, kernel, data.data(), length, chunk)
+                != digest(algorithm.algorithm, SHAKernel::Portable, data.data(), length, length + 1))
+                return false;
+        }
+    }
+    return true;
+}
+
+double megabytesPerSecond(std::chrono::steady_clock::time_point start)
+{
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return totalBytes / elapsed.count() / (1024 * 1024);
+}
+
+double runNative(const Algorithm& algorithm, SHAKernel kernel, const std::vector<uint8_t>& data)
+{
+    auto start = std::chrono::steady_clock::now();
+    SHADigest digest(algorithm.algorithm, kernel);
+    for (size_t offset = 0; offset < totalBytes; offset += chunkSize)
+        digest.addBytes(data.data() + offset % data.size(), std::min(chunkSize, totalBytes - offset));
+    uint8_t result[SHADigest::maxDigestLength];
+    digest.computeHash(result);
+    return megabytesPerSecond(start);
+}
+
+#if defined(WITH_JAVA_DIGEST)
+
+JNIEnv* createJavaVM()
+{
+    JavaVMInitArgs args;
+    args.version = JNI_VERSION_1_8;
+    args.nOptions = 0;
+    args.options = nullptr;
+    args.ignoreUnrecognized = JNI_FALSE;
+
+    JavaVM* vm;
+    JNIEnv* env;
+    if (JNI_CreateJavaVM(&vm, reinterpret_cast<void**>(&env), &args) != JNI_OK)
+        return nullptr;
+    return env;
+}
+
+double runJava(JNIEnv* env, const Algorithm& algorithm, const std::vector<uint8_t>& data)
+{
+    jclass messageDigestClass = env->FindClass("java/security/MessageDigest");
+    jmethodID getInstance = env->GetStaticMethodID(messageDigestClass, "getInstance", "(Ljava/lang/String;)Ljava/security/MessageDigest;");
+    jmethodID update = env->GetMethodID(messageDigestClass, "update", "(Ljava/nio/ByteBuffer;)V");
+    jmethodID computeDigest = env->GetMethodID(messageDigestClass, "digest", "()[B");
+
+    jstring name = env->NewStringUTF(algorithm.name);
+    jobject digest = env->CallStaticObjectMethod(messageDigestClass, getInstance, name);
+    if (!digest || env->ExceptionCheck()) {
+        env->ExceptionClear();
+        return 0;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t offset = 0; offset < totalBytes; offset += chunkSize) {
+        jobject buffer = env->NewDirectByteBuffer(const_cast<uint8_t*>(data.data() + offset % data.size()), std::min(chunkSize, totalBytes - offset));
+        env->CallVoidMethod(digest, update, buffer);
+        env->DeleteLocalRef(buffer);
+    }
+    jobject result = env->CallObjectMethod(digest, computeDigest);
+    double throughput = megabytesPerSecond(start);
+
+    env->DeleteLocalRef(result);
+    env->DeleteLocalRef(digest);
+    env->DeleteLocalRef(name);
+    env->DeleteLocalRef(messageDigestClass);
+    return throughput;
+}
+
+#endif // defined(WITH_JAVA_DIGEST)
+
+NO_RETURN void usage()
+{
+    printf("Usage: CryptoDigestSpeedTest [<megabytes> [<chunk size>]]\n");
+    exit(1);
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv)
+{
+    if (argc > 3)
+        usage();
+    if (argc >= 2)
+        totalBytes = static_cast<size_t>(atoi(argv[1])) * 1024 * 1024;
+    if (argc == 3)
+        chunkSize = atoi(argv[2]);
+    if (!totalBytes || !chunkSize)
+        usage();
+
+    // Large enough to defeat the cache like a real script body would, every
+    // chunk is a slice of it.
+    std::vector<uint8_t> data((4 * 1024 * 1024 / chunkSize + 1) * chunkSize);
+    uint32_t seed = 1;
+    for (auto& byte : data) {
+        seed = seed * 1103515245 + 12345;
+        byte = static_cast<uint8_t>(seed >> 16);
+    }
+
+#if defined(WITH_JAVA_DIGEST)
+    JNIEnv* env = createJavaVM();
+    if (!env) {
+        printf("Could not create a Java VM\n");
+        return 1;
+    }
+#endif
+
+    printf("%zuMB in %zu byte chunks, best kernel: %s\n", totalBytes / (1024 * 1024), chunkSize, shaKernelName(bestSHAKernel()));
+
+    bool failed = false;
+    for (auto& algorithm : algorithms) {
+        printf("%s\n", algorithm.name);
+        double portableThroughput = 0;
+        for (SHAKernel kernel : kernels) {
+            if (!isSHAKernelSupported(kernel))
+                continue;
+            // There are no SHA-512 instructions, the other kernels fall back to portable code.
+            bool is64Bit = algorithm.algorithm == SHADigest::Algorithm::SHA384 || algorithm.algorithm == SHADigest::Algorithm::SHA512;
+            if (is64Bit && kernel != SHAKernel::Portable)
+                continue;
+            bool correct = verify(algorithm, kernel, data);
+            failed |= !correct;
+            double throughput = runNative(algorithm, kernel, data);
+            if (kernel == SHAKernel::Portable)
+                portableThroughput = throughput;
+            printf("    %-8s %8.1f MB/s %5.2fx%s\n", shaKernelName(kernel), throughput,
+                throughput / portableThroughput, correct ? "" : "  MISMATCH");
+        }
+#if defined(WITH_JAVA_DIGEST)
+        double throughput = runJava(env, algorithm, data);
+        printf("    %-8s %8.1f MB/s %5.2fx\n", "java", throughput, throughput / portableThroughput);
+#endif
+    }
+    return failed ? 1 : 0;
+}
@@ -63,8 +63,10 @@ set(WebCore_FORWARDING_HEADERS_FILES
     bridge/jni/jsc/BridgeUtils.h
     dom/DOMStringList.h
     html/forms/FileIconLoader.h
+    platform/graphics/java/GlyphMetricsCacheJava.h
     platform/graphics/java/ImageBufferDataJava.h
     platform/graphics/java/PlatformContextJava.h
+    platform/graphics/java/PlatformPathJava.h
     platform/graphics/java/RQRef.h
     platform/graphics/java/RenderingQueue.h
     platform/graphics/texmap/BitmapTextureJava.h
@@ -107,6 +109,14 @@ elseif (APPLE)
     )
 endif ()
 
+if (USE_NATIVE_IMAGE_DECODERS)
+    include(platform/ImageDecoders.cmake)
+
+    list(APPEND WebCore_SOURCES
+        platform/image-decoders/java/ImageBackingStoreJava.cpp
+    )
+endif ()
+
 #FIXME: Workaround
 list(APPEND WebCoreTestSupport_LIBRARIES ${SQLITE_LIBRARIES})
 
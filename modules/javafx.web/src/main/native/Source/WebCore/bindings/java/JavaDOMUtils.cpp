@@ -33,6 +33,7 @@
 #include "HTMLDocument.h"
 #include "HTMLElement.h"
 #include "DOMException.h"
+#include "NodeList.h"
 
 #include <wtf/java/JavaEnv.h>
 
@@ -125,6 +126,64 @@ JNIEXPORT jobject JNICALL Java_com_sun_webkit_WebPage_twkGetOwnerElement
 }
 
 
+jlongArray toJavaPeerArray(JNIEnv* env, const Vector<Ref<Node>>& nodes)
+{
+    jlongArray peers = env->NewLongArray(nodes.size());
+    if (WTF::CheckAndClearException(env)) // OOME
+        return nullptr;
+
+    jlong* data = env->GetLongArrayElements(peers, nullptr);
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        //paired deref() calls are in the NodeImpl disposer.
+        data[i] = ptr_to_jlong(nodes[i].copyRef().leakRef());
+    }
+    env->ReleaseLongArrayElements(peers, data, 0);
+    return peers;
+}
+
+jlongArray toJavaPeerArray(JNIEnv* env, NodeList& list)
+{
+    unsigned length = list.length();
+    Vector<Ref<Node>> nodes;
+    nodes.reserveInitialCapacity(length);
+    for (unsigned i = 0; i < length; ++i) {
+        if (Node* node = list.item(i))
+            nodes.uncheckedAppend(*node);
+    }
+    return toJavaPeerArray(env, nodes);
+}
+
+jobjectArray toJavaStringArray(JNIEnv* env, const Vector<String>& strings)
+{
+    static JGClass clsString(env->FindClass("java/lang/String"));
+
+    jobjectArray result = env->NewObjectArray(strings.size(), clsString, nullptr);
+    if (WTF::CheckAndClearException(env)) // OOME
+        return nullptr;
+
+    for (size_t i = 0; i < strings.size(); ++i) {
+        if (strings[i].isNull())
+            continue;
+        env->SetObjectArrayElement(result, i, (jstring)strings[i].toJavaString(env));
+    }
+    return result;
+}
+
+Vector<Node*> nodesFromJavaPeerArray(JNIEnv* env, jlongArray peers)
+{
+    Vector<Node*> nodes;
+    if (!peers)
+        return nodes;
+
+    jsize length = env->GetArrayLength(peers);
+    nodes.reserveInitialCapacity(length);
+    jlong* data = env->GetLongArrayElements(peers, nullptr);
+    for (jsize i = 0; i < length; ++i)
+        nodes.uncheckedAppend(jlong_to_Nodeptr(data[i]));
+    env->ReleaseLongArrayElements(peers, data, JNI_ABORT);
+    return nodes;
+}
+
 uint32_t getJavaHashCode(jobject o)
 {
     JNIEnv* env = WTF::GetJavaEnv();
@@ -28,6 +28,7 @@
 #include <jni.h>
 
 #include <wtf/RefPtr.h>
+#include <wtf/Vector.h>
 #include <wtf/text/WTFString.h>
 #include "ExceptionOr.h"
 
@@ -42,6 +43,9 @@
 
 namespace WebCore {
 
+class Node;
+class NodeList;
+
 enum JavaExceptionType {
     JavaDOMException = 0,
     JavaEventException,
@@ -73,6 +77,14 @@ template<typename T> inline T raiseOnDOMError(JNIEnv* env, ExceptionOr<T>&& exce
     return exceptionOrReturnValue.releaseReturnValue();
 }
 
+// Bulk transfers for walking many nodes in one JNI call. Every peer in a
+// returned long[] carries a reference, as with JavaReturn<Node>; the Java side
+// releases it when the wrapper is disposed.
+jlongArray toJavaPeerArray(JNIEnv*, const Vector<Ref<Node>>&);
+jlongArray toJavaPeerArray(JNIEnv*, NodeList&);
+jobjectArray toJavaStringArray(JNIEnv*, const Vector<String>&);
+Vector<Node*> nodesFromJavaPeerArray(JNIEnv*, jlongArray);
+
 template <typename T> class JavaReturn {
     JNIEnv* m_env;
     RefPtr<T> m_returnValue;
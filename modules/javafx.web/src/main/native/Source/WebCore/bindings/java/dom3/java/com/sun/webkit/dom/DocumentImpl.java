@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2013, 2017, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2013, 2019, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -1389,10 +1389,10 @@ public class DocumentImpl extends NodeImpl implements Document, XPathEvaluator,
 
     public NodeList querySelectorAll(String selectors) throws DOMException
     {
-        return NodeListImpl.getImpl(querySelectorAllImpl(getPeer()
+        return StaticNodeListImpl.create(querySelectorAllImpl(getPeer()
             , selectors));
     }
-    native static long querySelectorAllImpl(long peer
+    native static long[] querySelectorAllImpl(long peer
         , String selectors);
 
 
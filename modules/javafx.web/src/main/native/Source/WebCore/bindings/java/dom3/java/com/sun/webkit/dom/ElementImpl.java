@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2013, 2017, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2013, 2019, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -29,6 +29,7 @@ import org.w3c.dom.Attr;
 import org.w3c.dom.DOMException;
 import org.w3c.dom.Element;
 import org.w3c.dom.NamedNodeMap;
+import org.w3c.dom.Node;
 import org.w3c.dom.NodeList;
 import org.w3c.dom.TypeInfo;
 import org.w3c.dom.css.CSSStyleDeclaration;
@@ -45,6 +46,7 @@ public class ElementImpl extends NodeImpl implements Element {
     }
 
     native static boolean isHTMLElementImpl(long peer);
+    native static String[] getHTMLTagNamesImpl(long[] peers);
 
 
 // Constants
@@ -1239,14 +1241,27 @@ public class ElementImpl extends NodeImpl implements Element {
 
     public NodeList querySelectorAll(String selectors) throws DOMException
     {
-        return NodeListImpl.getImpl(querySelectorAllImpl(getPeer()
+        return StaticNodeListImpl.create(querySelectorAllImpl(getPeer()
             , selectors));
     }
-    native static long querySelectorAllImpl(long peer
+    native static long[] querySelectorAllImpl(long peer
         , String selectors);
 
 
 
+// Bulk access
+    /**
+     * Returns the value of the named attribute for each of the given nodes,
+     * or null where the node is not an element or has no such attribute.
+     */
+    public static String[] getAttributeValues(Node[] nodes, String name) {
+        return getAttributeValuesImpl(NodeImpl.getPeers(nodes), name);
+    }
+    native static String[] getAttributeValuesImpl(long[] peers
+        , String name);
+
+
+
 //stubs
     public void setIdAttribute(String name, boolean isId) throws DOMException {
         throw new UnsupportedOperationException("Not supported yet.");
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2013, 2017, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2013, 2019, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -54,18 +54,24 @@ public class NodeImpl extends JSObject implements Node, EventTarget {
     private static Node getCachedImpl(long peer) {
         if (peer == 0)
             return null;
+        NodeImpl node = lookupCachedImpl(peer);
+        if (node != null) {
+            // the peer need to be deref'ed!
+            NodeImpl.dispose(peer);
+            return node;
+        }
+        return addCachedImpl((NodeImpl)createInterface(peer));
+    }
+
+    private static NodeImpl lookupCachedImpl(long peer) {
         int hash = hashPeer(peer);
-        SelfDisposer head = hashTable[hash];
         SelfDisposer prev = null;
-        for (SelfDisposer disposer = head; disposer != null;) {
+        for (SelfDisposer disposer = hashTable[hash]; disposer != null;) {
             SelfDisposer next = disposer.next;
             if (disposer.peer == peer) {
                 NodeImpl node = (NodeImpl) disposer.get();
-                if (node != null) {
-                    // the peer need to be deref'ed!
-                    NodeImpl.dispose(peer);
+                if (node != null)
                     return node;
-                }
                 if (prev != null)
                     prev.next = next;
                 else
@@ -75,10 +81,15 @@ public class NodeImpl extends JSObject implements Node, EventTarget {
             prev = disposer;
             disposer = next;
         }
-        NodeImpl node = (NodeImpl)createInterface(peer);
+        return null;
+    }
+
+    private static NodeImpl addCachedImpl(NodeImpl node) {
+        long peer = node.getPeer();
+        int hash = hashPeer(peer);
         SelfDisposer disposer = new SelfDisposer(node, peer);
         Disposer.addRecord(disposer);
-        disposer.next = head;
+        disposer.next = hashTable[hash];
         hashTable[hash] = disposer;
         if (3 * hashCount >= 2 * hashTable.length)
             rehash();
@@ -86,6 +97,50 @@ public class NodeImpl extends JSObject implements Node, EventTarget {
         return node;
     }
 
+    /**
+     * Wraps peers handed out by a bulk native call. The node types and tag
+     * names needed to pick the wrapper class are fetched for all of them at
+     * once, and the extra references on peers that already have a wrapper
+     * are released in a single call as well.
+     */
+    static Node[] getImpls(long[] peers) {
+        if (peers == null)
+            return null;
+        Node[] nodes = new Node[peers.length];
+        short[] types = null;
+        String[] tagNames = null;
+        long[] cachedPeers = null;
+        int cachedCount = 0;
+        for (int i = 0; i < peers.length; i++) {
+            long peer = peers[i];
+            if (peer == 0)
+                continue;
+            NodeImpl node = lookupCachedImpl(peer);
+            if (node != null) {
+                if (cachedPeers == null)
+                    cachedPeers = new long[peers.length - i];
+                cachedPeers[cachedCount++] = peer;
+                nodes[i] = node;
+                continue;
+            }
+            if (types == null) {
+                types = getNodeTypesImpl(peers);
+                tagNames = ElementImpl.getHTMLTagNamesImpl(peers);
+            }
+            nodes[i] = addCachedImpl((NodeImpl)createInterface(peer, types[i], tagNames[i]));
+        }
+        if (cachedCount > 0)
+            disposeAllImpl(cachedPeers, cachedCount);
+        return nodes;
+    }
+
+    static long[] getPeers(Node[] nodes) {
+        long[] peers = new long[nodes.length];
+        for (int i = 0; i < nodes.length; i++)
+            peers[i] = getPeer(nodes[i]);
+        return peers;
+    }
+
     static int test_getHashCount() {
         return hashCount;
     }
@@ -143,12 +198,21 @@ public class NodeImpl extends JSObject implements Node, EventTarget {
 
     static Node createInterface(long peer) {
         if (peer == 0L) return null;
-        switch (NodeImpl.getNodeTypeImpl(peer)) {
+        short type = NodeImpl.getNodeTypeImpl(peer);
+        String htmlTagName = null;
+        if (type == ELEMENT_NODE && ElementImpl.isHTMLElementImpl(peer))
+            htmlTagName = ElementImpl.getTagNameImpl(peer);
+        return createInterface(peer, type, htmlTagName);
+    }
+
+    // htmlTagName is the tag name of an HTML element, null for anything else.
+    private static Node createInterface(long peer, short type, String htmlTagName) {
+        switch (type) {
         case ELEMENT_NODE :
-               if( !ElementImpl.isHTMLElementImpl(peer))
+               if (htmlTagName == null)
                    return new ElementImpl(peer);
                else {
-                   String tagName = ElementImpl.getTagNameImpl(peer).toUpperCase();
+                   String tagName = htmlTagName.toUpperCase();
                    if ("A".equals(tagName)) return new HTMLAnchorElementImpl(peer);
                    if ("APPLET".equals(tagName)) return new HTMLAppletElementImpl(peer);
                    if ("AREA".equals(tagName)) return new HTMLAreaElementImpl(peer);
@@ -227,6 +291,7 @@ public class NodeImpl extends JSObject implements Node, EventTarget {
     }
 
     native private static void dispose(long peer);
+    native private static void disposeAllImpl(long[] peers, int count);
 
     static Node getImpl(long peer) {
         return (Node)create(peer);
@@ -542,6 +607,28 @@ public class NodeImpl extends JSObject implements Node, EventTarget {
         , long event);
 
 
+// Bulk access
+    public Node[] getSubtree() {
+        return getImpls(getSubtreeImpl(getPeer()));
+    }
+    native static long[] getSubtreeImpl(long peer);
+
+    public static short[] getNodeTypes(Node[] nodes) {
+        return getNodeTypesImpl(getPeers(nodes));
+    }
+    native static short[] getNodeTypesImpl(long[] peers);
+
+    public static String[] getNodeNames(Node[] nodes) {
+        return getNodeNamesImpl(getPeers(nodes));
+    }
+    native static String[] getNodeNamesImpl(long[] peers);
+
+    public static String[] getTextContents(Node[] nodes) {
+        return getTextContentsImpl(getPeers(nodes));
+    }
+    native static String[] getTextContentsImpl(long[] peers);
+
+
 
 //stubs
     public Object getUserData(String key) {
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2013, 2017, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2013, 2019, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -93,6 +93,14 @@ public class NodeListImpl implements NodeList {
     native static long itemImpl(long peer
         , int index);
 
+    /**
+     * Returns all the items of the list, fetched in a single native call.
+     */
+    public Node[] items() {
+        return NodeImpl.getImpls(itemsImpl(getPeer()));
+    }
+    native static long[] itemsImpl(long peer);
+
 
 }
 
@@ -23,33 +23,36 @@
  * questions.
  */
 
-package com.sun.webkit.security;
+package com.sun.webkit.dom;
 
-import com.sun.javafx.webkit.WCMessageDigestImpl;
-import com.sun.webkit.perf.WCMessageDigestPerfLogger;
-import java.nio.ByteBuffer;
+import org.w3c.dom.Node;
+import org.w3c.dom.NodeList;
 
-public abstract class WCMessageDigest {
-    /**
-     * Creates the instance of WCMessageDigest for the given algorithm.
-     * @param algorithm the name of the algorithm like SHA-1, SHA-256.
-     */
-    protected static WCMessageDigest getInstance(String algorithm) {
-        try {
-            WCMessageDigest digest = new WCMessageDigestImpl(algorithm);
-            return WCMessageDigestPerfLogger.isEnabled() ? new WCMessageDigestPerfLogger(digest) : digest;
-        } catch (Exception ex) {
+/**
+ * A NodeList over a fixed set of nodes, such as the result of
+ * querySelectorAll(). All the wrappers are created up front from a
+ * single native call instead of one call per item().
+ */
+final class StaticNodeListImpl implements NodeList {
+    private final Node[] nodes;
+
+    private StaticNodeListImpl(Node[] nodes) {
+        this.nodes = nodes;
+    }
+
+    static NodeList create(long[] peers) {
+        if (peers == null)
             return null;
-        }
+        return new StaticNodeListImpl(NodeImpl.getImpls(peers));
     }
 
-    /**
-     * Update the digest using the specified ByteBuffer.
-     */
-    public abstract void addBytes(ByteBuffer input);
+    public int getLength() {
+        return nodes.length;
+    }
 
-    /**
-     * Returns the computed hash value.
-     */
-    public abstract byte[] computeHash();
+    public Node item(int index) {
+        if (index < 0 || index >= nodes.length)
+            return null;
+        return nodes[index];
+    }
 }
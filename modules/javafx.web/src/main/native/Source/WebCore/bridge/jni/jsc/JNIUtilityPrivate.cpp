@@ -255,50 +255,49 @@ jvalue convertValueToJValue(ExecState* exec, RootObject* rootObject, JSValue val
 
 jobject jvalueToJObject(jvalue value, JavaType jtype) {
     JNIEnv* env = getJNIEnv();
-    jmethodID meth;
     switch (jtype) {
     case JavaTypeObject:
     case JavaTypeArray:
         return value.l;
     case JavaTypeBoolean: {
       static JGClass clsZ(env->FindClass("java/lang/Boolean"));
-      meth = env->GetStaticMethodID(clsZ, "valueOf", "(Z)Ljava/lang/Boolean;");
+      static jmethodID meth = env->GetStaticMethodID(clsZ, "valueOf", "(Z)Ljava/lang/Boolean;");
       return env->CallStaticObjectMethod(clsZ, meth, value.z);
     }
     case JavaTypeChar: {
       static JGClass clsC(env->FindClass("java/lang/Character"));
-      meth = env->GetStaticMethodID(clsC, "valueOf",
-                                    "(C)Ljava/lang/Character;");
+      static jmethodID meth = env->GetStaticMethodID(clsC, "valueOf",
+                                                     "(C)Ljava/lang/Character;");
       return env->CallStaticObjectMethod(clsC, meth, value.c);
     }
     case JavaTypeByte: {
       static JGClass clsB(env->FindClass("java/lang/Byte"));
-      meth = env->GetStaticMethodID(clsB, "valueOf", "(B)Ljava/lang/Byte;");
+      static jmethodID meth = env->GetStaticMethodID(clsB, "valueOf", "(B)Ljava/lang/Byte;");
       return env->CallStaticObjectMethod(clsB, meth, value.b);
     }
     case JavaTypeShort: {
       static JGClass clsS(env->FindClass("java/lang/Short"));
-      meth = env->GetStaticMethodID(clsS, "valueOf", "(S)Ljava/lang/Short;");
+      static jmethodID meth = env->GetStaticMethodID(clsS, "valueOf", "(S)Ljava/lang/Short;");
       return env->CallStaticObjectMethod(clsS, meth, value.s);
     }
     case JavaTypeInt: {
       static JGClass clsI(env->FindClass("java/lang/Integer"));
-      meth = env->GetStaticMethodID(clsI, "valueOf", "(I)Ljava/lang/Integer;");
+      static jmethodID meth = env->GetStaticMethodID(clsI, "valueOf", "(I)Ljava/lang/Integer;");
       return env->CallStaticObjectMethod(clsI, meth, value.i);
     }
     case JavaTypeLong: {
       static JGClass clsJ(env->FindClass("java/lang/Long"));
-      meth = env->GetStaticMethodID(clsJ, "valueOf", "(J)Ljava/lang/Long;");
+      static jmethodID meth = env->GetStaticMethodID(clsJ, "valueOf", "(J)Ljava/lang/Long;");
       return env->CallStaticObjectMethod(clsJ, meth, value.j);
     }
     case JavaTypeFloat: {
       static JGClass clsF(env->FindClass("java/lang/Float"));
-      meth = env->GetStaticMethodID(clsF, "valueOf", "(F)Ljava/lang/Float;");
+      static jmethodID meth = env->GetStaticMethodID(clsF, "valueOf", "(F)Ljava/lang/Float;");
       return env->CallStaticObjectMethod(clsF, meth, value.f);
     }
     case JavaTypeDouble: {
       static JGClass clsD(env->FindClass("java/lang/Double"));
-      meth = env->GetStaticMethodID(clsD, "valueOf", "(D)Ljava/lang/Double;");
+      static jmethodID meth = env->GetStaticMethodID(clsD, "valueOf", "(D)Ljava/lang/Double;");
       return env->CallStaticObjectMethod(clsD, meth, value.d);
     }
     default:
@@ -306,6 +305,53 @@ jobject jvalueToJObject(jvalue value, JavaType jtype) {
     }
 }
 
+// Unboxes the value returned by Method.invoke. Boolean and Character come back
+// as themselves, every other primitive as a java.lang.Number.
+static void jobjectToJValue(JNIEnv* env, jobject r, JavaType returnType, jvalue& result)
+{
+    static JGClass clsZ(env->FindClass("java/lang/Boolean"));
+    static jmethodID booleanValue = env->GetMethodID(clsZ, "booleanValue", "()Z");
+    static JGClass clsN(env->FindClass("java/lang/Number"));
+    static jmethodID byteValue = env->GetMethodID(clsN, "byteValue", "()B");
+    static jmethodID shortValue = env->GetMethodID(clsN, "shortValue", "()S");
+    static jmethodID intValue = env->GetMethodID(clsN, "intValue", "()I");
+    static jmethodID longValue = env->GetMethodID(clsN, "longValue", "()J");
+    static jmethodID floatValue = env->GetMethodID(clsN, "floatValue", "()F");
+    static jmethodID doubleValue = env->GetMethodID(clsN, "doubleValue", "()D");
+
+    if (!r) {
+        memset(&result, 0, sizeof(jvalue));
+        return;
+    }
+
+    switch (returnType) {
+    case JavaTypeBoolean:
+        result.z = env->CallBooleanMethod(r, booleanValue);
+        break;
+    case JavaTypeByte:
+        result.b = env->CallByteMethod(r, byteValue);
+        break;
+    case JavaTypeShort:
+        result.s = env->CallShortMethod(r, shortValue);
+        break;
+    case JavaTypeInt:
+        result.i = env->CallIntMethod(r, intValue);
+        break;
+    case JavaTypeLong:
+        result.j = env->CallLongMethod(r, longValue);
+        break;
+    case JavaTypeFloat:
+        result.f = env->CallFloatMethod(r, floatValue);
+        break;
+    case JavaTypeDouble:
+        result.d = env->CallDoubleMethod(r, doubleValue);
+        break;
+    default:
+        ASSERT_NOT_REACHED();
+        break;
+    }
+}
+
 jthrowable dispatchJNICall(int count, RootObject*, jobject obj, bool isStatic, JavaType returnType, jmethodID methodId, jobject* args, jvalue& result, jobject accessControlContext) {
 
     // Since obj is WeakGlobalRef, creating a localref to safeguard instance() from GC
@@ -317,18 +363,21 @@ jthrowable dispatchJNICall(int count, RootObject*, jobject obj, bool isStatic, J
     }
 
     JNIEnv* env = getJNIEnv();
-    jclass objClass = env->GetObjectClass(obj);
-    jobject rmethod = env->ToReflectedMethod(objClass, methodId, isStatic);
-    jclass utilityCls = env->FindClass("com/sun/webkit/Utilities");
-    jclass objectCls = env->FindClass("java/lang/Object");
-    jobjectArray argsArray = env->NewObjectArray(count, objectCls, NULL);
-    for (int i = 0;  i < count; i++)
-      env->SetObjectArrayElement(argsArray, i, args[i]);
-    jmethodID invokeMethod =
+    static JGClass utilityCls(env->FindClass("com/sun/webkit/Utilities"));
+    static JGClass objectCls(env->FindClass("java/lang/Object"));
+    static jmethodID invokeMethod =
         env->GetStaticMethodID(utilityCls, "fwkInvokeWithContext",
                                "(Ljava/lang/reflect/Method;Ljava/lang/Object;[Ljava/lang/Object;Ljava/security/AccessControlContext;)Ljava/lang/Object;");
+
+    // The call still goes through Method.invoke under the caller's access
+    // control context, so the arguments have to be boxed.
+    JLClass objClass(env->GetObjectClass(obj));
+    JLObject rmethod(env->ToReflectedMethod(objClass, methodId, isStatic));
+    JLObjectArray argsArray(env->NewObjectArray(count, objectCls, NULL));
+    for (int i = 0;  i < count; i++)
+      env->SetObjectArrayElement(argsArray, i, args[i]);
     jobject r = env->CallStaticObjectMethod(utilityCls, invokeMethod,
-                                            rmethod, obj, argsArray,
+                                            (jobject)rmethod, obj, (jobjectArray)argsArray,
                                             accessControlContext);
 
     jthrowable ex = env->ExceptionOccurred();
@@ -348,31 +397,14 @@ jthrowable dispatchJNICall(int count, RootObject*, jobject obj, bool isStatic, J
         break;
 
     case JavaTypeBoolean:
-        result.z = callJNIMethod<jboolean>(r, "booleanValue", "()Z");
-        break;
-
     case JavaTypeByte:
-        result.b = callJNIMethod<jbyte>(r, "byteValue", "()B");
-        break;
-
     case JavaTypeShort:
-        result.s = callJNIMethod<jshort>(r, "shortValue", "()S");
-        break;
-
     case JavaTypeInt:
-        result.i = callJNIMethod<jint>(r, "intValue", "()I");
-        break;
-
     case JavaTypeLong:
-        result.j = callJNIMethod<jlong>(r, "longValue", "()J");
-        break;
-
     case JavaTypeFloat:
-        result.f = callJNIMethod<jfloat>(r, "floatValue", "()F");
-        break;
-
     case JavaTypeDouble:
-        result.d = callJNIMethod<jdouble>(r, "doubleValue", "()D");
+        jobjectToJValue(env, r, returnType, result);
+        env->DeleteLocalRef(r);
         break;
 
     case JavaTypeInvalid:
@@ -34,10 +34,65 @@
 #include "JNIUtilityPrivate.h"
 #include <JavaScriptCore/Identifier.h>
 #include <JavaScriptCore/JSLock.h>
+#include <wtf/Lock.h>
+#include <wtf/NeverDestroyed.h>
 
 using namespace JSC;
 using namespace JSC::Bindings;
 
+// Class descriptions keyed by the identity hash of the Java class. Entries
+// hold the class weakly and are dropped once it has been unloaded.
+typedef HashMap<unsigned, Vector<RefPtr<JavaClass>>, WTF::IntHash<unsigned>, WTF::UnsignedWithZeroKeyHashTraits<unsigned>> JavaClassCache;
+
+static Lock javaClassCacheLock;
+
+static JavaClassCache& javaClassCache()
+{
+    static NeverDestroyed<JavaClassCache> cache;
+    return cache;
+}
+
+Ref<JavaClass> JavaClass::classForInstance(jobject anInstance, RootObject* rootObject, jobject accessControlContext)
+{
+    // Since anInstance is WeakGlobalRef, creating a localref to safeguard instance() from GC
+    JLObject jlinstance(anInstance, true);
+    if (!jlinstance)
+        return adoptRef(*new JavaClass(anInstance, rootObject, accessControlContext));
+
+    JNIEnv* env = getJNIEnv();
+    JLClass aClass(env->GetObjectClass(jlinstance));
+    static jmethodID hashCodeID = env->GetMethodID(env->FindClass("java/lang/Object"), "hashCode", "()I");
+    unsigned hash = static_cast<unsigned>(env->CallIntMethod(aClass, hashCodeID));
+
+    {
+        auto locker = holdLock(javaClassCacheLock);
+        auto it = javaClassCache().find(hash);
+        if (it != javaClassCache().end()) {
+            auto& classes = it->value;
+            for (size_t i = 0; i < classes.size(); ) {
+                jobject cached = classes[i]->m_class->instance();
+                if (env->IsSameObject(cached, nullptr)) {
+                    classes.remove(i);
+                    continue;
+                }
+                if (env->IsSameObject(cached, aClass))
+                    return *classes[i];
+                ++i;
+            }
+        }
+    }
+
+    Ref<JavaClass> javaClass = adoptRef(*new JavaClass(anInstance, rootObject, accessControlContext));
+
+    // Reflection can be refused by the access control context; don't let
+    // a partial description stand in for callers that would see more.
+    if (javaClass->m_isComplete) {
+        auto locker = holdLock(javaClassCacheLock);
+        javaClassCache().add(hash, Vector<RefPtr<JavaClass>>()).iterator->value.append(javaClass.ptr());
+    }
+    return javaClass;
+}
+
 JavaClass::JavaClass(jobject anInstance, RootObject* rootObject, jobject accessControlContext)
 {
     // Since anInstance is WeakGlobalRef, creating a localref to safeguard instance() from GC
@@ -68,8 +123,12 @@ JavaClass::JavaClass(jobject anInstance, RootObject* rootObject, jobject accessC
     } else
         m_name = fastStrDup("<Unknown>");
 
+    m_class = JobjectWrapper::create(aClass);
+
     int i;
     JNIEnv* env = getJNIEnv();
+    bool hasFields = false;
+    bool hasMethods = false;
 
     // Get the fields
     jvalue result;
@@ -89,6 +148,7 @@ JavaClass::JavaClass(jobject anInstance, RootObject* rootObject, jobject accessC
             env->DeleteLocalRef(aJField);
         }
         env->DeleteLocalRef(fields);
+        hasFields = true;
     }
 
     // Get the methods
@@ -114,8 +174,10 @@ JavaClass::JavaClass(jobject anInstance, RootObject* rootObject, jobject accessC
             env->DeleteLocalRef(aJMethod);
         }
         env->DeleteLocalRef(methods);
+        hasMethods = true;
     }
 
+    m_isComplete = hasFields && hasMethods;
     env->DeleteLocalRef(aClass);
 }
 
@@ -166,103 +228,108 @@ Method* JavaClass::methodNamed(PropertyName propertyName, Instance*) const
     if (name.isNull())
         return nullptr;
     unsigned nameLength = name.length();
-    MethodList* methodList;
-    size_t i;
-    if (nameLength >= 3 && name[nameLength-1] == ')'
-        && (i = name.find('(', 1)) != WTF::notFound) {
-        Vector<String> pnames;
-        size_t pstart = i + 1;
-        if (pstart < nameLength-1) {
-            do {
-                size_t pnext = name.find(',', pstart);
-                if (pnext == WTF::notFound)
-                    pnext = nameLength-1;
-                String pname = name.substringSharingImpl(pstart, pnext-pstart);
-                pnames.append(pname);
-                pstart = pnext+1;
-            } while (pstart < nameLength);
-        }
-        size_t plen = pnames.size();
-        MethodList* allMethods
-            = m_methods.get(name.substringSharingImpl(0, i).impl());
-        methodList = nullptr;
-        size_t numMethods = allMethods == nullptr ? 0 : allMethods->size();
-        for (size_t methodIndex = 0; methodIndex < numMethods; methodIndex++) {
-            JavaMethod* jMethod = static_cast<JavaMethod*>(allMethods->at(methodIndex));
-            if (size_t(jMethod->numParameters()) == plen) {
-                // Iterate over parameters.
-                for (size_t i = 0;  ;  i++) {
-                    if (i == plen) {
-                        if (methodList == nullptr)
-                            methodList = new MethodList();
-                        methodList->append(jMethod);
+    if (nameLength >= 3 && name[nameLength-1] == ')' && name.find('(', 1) != WTF::notFound) {
+        auto it = m_overloads.find(name);
+        if (it != m_overloads.end())
+            return it->value;
+        Method* method = resolveOverload(name);
+        m_overloads.add(name, method);
+        return method;
+    }
+    MethodList* methodList = m_methods.get(name.impl());
+    if (methodList)
+        return methodList->at(0);
+    return nullptr;
+}
+
+// Picks the first method matching an explicit "name(type,...)" signature.
+Method* JavaClass::resolveOverload(const String& name) const
+{
+    unsigned nameLength = name.length();
+    size_t i = name.find('(', 1);
+    Vector<String> pnames;
+    size_t pstart = i + 1;
+    if (pstart < nameLength-1) {
+        do {
+            size_t pnext = name.find(',', pstart);
+            if (pnext == WTF::notFound)
+                pnext = nameLength-1;
+            String pname = name.substringSharingImpl(pstart, pnext-pstart);
+            pnames.append(pname);
+            pstart = pnext+1;
+        } while (pstart < nameLength);
+    }
+    size_t plen = pnames.size();
+    MethodList* allMethods
+        = m_methods.get(name.substringSharingImpl(0, i).impl());
+    size_t numMethods = allMethods == nullptr ? 0 : allMethods->size();
+    for (size_t methodIndex = 0; methodIndex < numMethods; methodIndex++) {
+        JavaMethod* jMethod = static_cast<JavaMethod*>(allMethods->at(methodIndex));
+        if (size_t(jMethod->numParameters()) == plen) {
+            // Iterate over parameters.
+            for (size_t i = 0;  ;  i++) {
+                if (i == plen)
+                    return jMethod;
+                String methodParam = jMethod->parameterAt(i);
+                size_t methodParamLength = methodParam.length();
+                String pname = pnames[i];
+                size_t pnameLength = pname.length();
+                // Handle array type names.
+                while (methodParamLength >= 2 && methodParam[0] == '['
+                       && pnameLength >= 3 && pname[pnameLength-2] == '['
+                       && pname[pnameLength-1] == ']') {
+                    // Primitive array type names.
+                    if (methodParamLength == 2) {
+                      const char *prim;
+                      switch (methodParam[1]) {
+                      case 'I': prim = "int[]"; break;
+                      case 'J': prim = "long[]"; break;
+                      case 'B': prim = "byte[]"; break;
+                      case 'S': prim = "short[]"; break;
+                      case 'F': prim = "float[]"; break;
+                      case 'D': prim = "double[]"; break;
+                      case 'C': prim = "char[]"; break;
+                      case 'Z': prim = "boolean[]"; break;
+                      default: prim = nullptr;
+                      }
+                      if (pname == prim) {
+                          methodParamLength = 0;
+                          pnameLength = 0;
+                      } else
                         break;
                     }
-                    String methodParam = jMethod->parameterAt(i);
-                    size_t methodParamLength = methodParam.length();
-                    String pname = pnames[i];
-                    size_t pnameLength = pname.length();
-                    // Handle array type names.
-                    while (methodParamLength >= 2 && methodParam[0] == '['
-                           && pnameLength >= 3 && pname[pnameLength-2] == '['
-                           && pname[pnameLength-1] == ']') {
-                        // Primitive array type names.
-                        if (methodParamLength == 2) {
-                          const char *prim;
-                          switch (methodParam[1]) {
-                          case 'I': prim = "int[]"; break;
-                          case 'J': prim = "long[]"; break;
-                          case 'B': prim = "byte[]"; break;
-                          case 'S': prim = "short[]"; break;
-                          case 'F': prim = "float[]"; break;
-                          case 'D': prim = "double[]"; break;
-                          case 'C': prim = "char[]"; break;
-                          case 'Z': prim = "boolean[]"; break;
-                          default: prim = nullptr;
-                          }
-                          if (pname == prim) {
-                              methodParamLength = 0;
-                              pnameLength = 0;
-                          } else
+                    // Object array type names.
+                    else if (methodParamLength > 3
+                            && methodParam[1] == 'L'
+                            && methodParam[methodParamLength-1] == ';') {
+                        pnameLength -= 2;
+                        pname = pname.substringSharingImpl(0, pnameLength);
+                        methodParamLength -= 3;
+                        methodParam = methodParam
+                            .substringSharingImpl(2, methodParamLength);
+                    } else {
+                      break;
+                    }
+                }
+                if (methodParamLength == pnameLength + 10
+                    && methodParam.find("java.lang.", 0) == 0) {
+                    methodParam = methodParam.substringSharingImpl(10, pnameLength);
+                    methodParamLength = pnameLength;
+                }
+                if (methodParamLength == pnameLength) {
+                    size_t k = 0;
+                    for (; k < methodParamLength;  k++) {
+                        if (methodParam[k] != pname[k]) {
                             break;
                         }
-                        // Object array type names.
-                        else if (methodParamLength > 3
-                                && methodParam[1] == 'L'
-                                && methodParam[methodParamLength-1] == ';') {
-                            pnameLength -= 2;
-                            pname = pname.substringSharingImpl(0, pnameLength);
-                            methodParamLength -= 3;
-                            methodParam = methodParam
-                                .substringSharingImpl(2, methodParamLength);
-                        } else {
-                          break;
-                        }
-                    }
-                    if (methodParamLength == pnameLength + 10
-                        && methodParam.find("java.lang.", 0) == 0) {
-                        methodParam = methodParam.substringSharingImpl(10, pnameLength);
-                        methodParamLength = pnameLength;
                     }
-                    if (methodParamLength == pnameLength) {
-                        size_t k = 0;
-                        for (; k < methodParamLength;  k++) {
-                            if (methodParam[k] != pname[k]) {
-                                break;
-                            }
-                        }
-                        if (k < methodParamLength)
-                            break;
-                    } else
+                    if (k < methodParamLength)
                         break;
-                }
+                } else
+                    break;
             }
         }
-    } else {
-        methodList = m_methods.get(name.impl());
     }
-    if (methodList)
-        return methodList->at(0);
     return nullptr;
 }
 
@@ -29,15 +29,19 @@
 
 #include "BridgeJSC.h"
 #include "JNIUtility.h"
+#include "JobjectWrapper.h"
 #include <wtf/HashMap.h>
+#include <wtf/RefCounted.h>
 
 namespace JSC {
 
 namespace Bindings {
 
-class JavaClass : public Class {
+class JavaClass : public Class, public RefCounted<JavaClass> {
 public:
-    JavaClass(jobject, RootObject*, jobject accessControlContext);
+    // Returns the description of the instance's class. Descriptions are
+    // shared by all instances of a class for as long as it stays loaded.
+    static Ref<JavaClass> classForInstance(jobject, RootObject*, jobject accessControlContext);
     ~JavaClass();
 
     virtual Method* methodNamed(PropertyName, Instance*) const;
@@ -49,10 +53,18 @@ public:
     bool isStringClass() const;
 
 private:
+    JavaClass(jobject, RootObject*, jobject accessControlContext);
+
     jobject createDummyObject();
+    Method* resolveOverload(const String&) const;
+
     const char* m_name;
+    RefPtr<JobjectWrapper> m_class;
+    bool m_isComplete { false };
     mutable FieldMap m_fields;
     mutable MethodListMap m_methods;
+    // Results of "name(type,...)" lookups, including misses.
+    mutable HashMap<String, Method*> m_overloads;
 };
 
 } // namespace Bindings
@@ -56,13 +56,11 @@ JavaInstance::JavaInstance(jobject instance, RefPtr<RootObject>&& rootObject, jo
     : Instance(WTFMove(rootObject))
 {
     m_instance = JobjectWrapper::create(instance);
-    m_class = 0;
     m_accessControlContext = JobjectWrapper::create(accessControlContext, true);
 }
 
 JavaInstance::~JavaInstance()
 {
-    delete m_class;
 }
 
 RuntimeObject* JavaInstance::newRuntimeObject(ExecState* exec)
@@ -86,9 +84,9 @@ Class* JavaInstance::getClass() const
 {
     if (!m_class) {
         jobject acc = accessControlContext();
-        m_class = new JavaClass(m_instance->instance(), rootObject(), acc);
+        m_class = JavaClass::classForInstance(m_instance->instance(), rootObject(), acc);
     }
-    return m_class;
+    return m_class.get();
 }
 
 JSValue JavaInstance::stringValue(ExecState* exec) const
@@ -304,10 +302,9 @@ JSValue JavaInstance::invokeMethod(ExecState* exec, RuntimeMethod* runtimeMethod
     Vector<jobject> jArgs(count);
 
     for (int i = 0; i < count; i++) {
-        CString javaClassName = jMethod->parameterAt(i).utf8();
-        JavaType jtype = javaTypeFromClassName(javaClassName.data());
+        JavaType jtype = jMethod->parameterTypeAt(i);
         jvalue jarg = convertValueToJValue(exec, m_rootObject.get(),
-            exec->argument(i), jtype, javaClassName.data());
+            exec->argument(i), jtype, jMethod->parameterClassNameAt(i));
         jArgs[i] = jvalueToJObject(jarg, jtype);
         LOG(LiveConnect, "JavaInstance::invokeMethod arg[%d] = %s", i, exec->argument(i).toString(exec)->value(exec).ascii().data());
     }
@@ -335,11 +332,9 @@ JSValue JavaInstance::invokeMethod(ExecState* exec, RuntimeMethod* runtimeMethod
         }
 
         // const char *callingURL = 0; // FIXME, need to propagate calling URL to Java
-        jmethodID methodId = getMethodID(obj, jMethod->name().utf8().data(), jMethod->signature());
-
         jthrowable ex = dispatchJNICall(exec->argumentCount(), rootObject,
                                         obj, jMethod->isStatic(),
-                                        jMethod->returnType(), methodId,
+                                        jMethod->returnType(), jMethod->methodID(),
                                         jArgs.data(), result,
                                         accessControlContext());
         if (ex != NULL) {
@@ -29,6 +29,7 @@
 
 #include "BridgeJSC.h"
 #include "JNIUtility.h"
+#include "JavaClassJSC.h"
 #include "JobjectWrapper.h"
 #include "runtime_root.h"
 
@@ -36,8 +37,6 @@ namespace JSC {
 
 namespace Bindings {
 
-class JavaClass;
-
 class JavaInstance : public Instance {
 public:
     static RefPtr<JavaInstance> create(jobject instance, RefPtr<RootObject>&& rootObject, jobject accessControlContext)
@@ -71,7 +70,7 @@ protected:
     virtual void virtualEnd();
 
     RefPtr<JobjectWrapper> m_instance;
-    mutable JavaClass* m_class;
+    mutable RefPtr<JavaClass> m_class;
     RefPtr<JobjectWrapper> m_accessControlContext;
 };
 
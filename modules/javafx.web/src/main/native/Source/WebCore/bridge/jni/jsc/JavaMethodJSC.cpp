@@ -66,6 +66,8 @@ JavaMethod::JavaMethod(JNIEnv* env, jobject aMethod)
             if (!parameterName)
                 parameterName = env->NewStringUTF("<Unknown>");
             m_parameters.append(JavaString(env, parameterName).impl());
+            m_parameterClassNames.append(m_parameters.last().utf8());
+            m_parameterTypes.append(javaTypeFromClassName(m_parameterClassNames.last().data()));
             env->DeleteLocalRef(aParameter);
             env->DeleteLocalRef(parameterName);
         }
@@ -75,6 +77,10 @@ JavaMethod::JavaMethod(JNIEnv* env, jobject aMethod)
     // Created lazily.
     m_signature = 0;
 
+    // Stays valid for as long as the declaring class is loaded, which the
+    // class cache in JavaClassJSC.cpp already depends on.
+    m_methodID = env->FromReflectedMethod(aMethod);
+
     jint modifiers = callJNIMethod<jint>(aMethod, "getModifiers", "()I");
     m_isStatic = (modifiers & 0x8) != 0;
 }
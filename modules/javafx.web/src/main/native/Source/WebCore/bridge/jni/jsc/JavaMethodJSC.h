@@ -32,6 +32,7 @@
 #include "JavaType.h"
 
 #include "JavaStringJSC.h"
+#include <wtf/text/CString.h>
 
 namespace JSC {
 
@@ -47,6 +48,9 @@ public:
     const String name() const { return m_name.impl(); }
     RuntimeType returnTypeClassName() const { return m_returnTypeClassName.utf8(); }
     const String parameterAt(int i) const { return m_parameters[i]; }
+    const char* parameterClassNameAt(int i) const { return m_parameterClassNames[i].data(); }
+    JavaType parameterTypeAt(int i) const { return m_parameterTypes[i]; }
+    jmethodID methodID() const { return m_methodID; }
     const char* signature() const;
     JavaType returnType() const { return m_returnType; }
     bool isStatic() const { return m_isStatic; }
@@ -56,6 +60,9 @@ public:
 
 private:
     Vector<WTF::String> m_parameters;
+    Vector<CString> m_parameterClassNames;
+    Vector<JavaType> m_parameterTypes;
+    jmethodID m_methodID;
     JavaString m_name;
     mutable char* m_signature;
     JavaString m_returnTypeClassName;
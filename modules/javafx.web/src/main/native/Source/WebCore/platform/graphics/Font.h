@@ -42,6 +42,10 @@
 #include <wtf/RetainPtr.h>
 #endif
 
+#if PLATFORM(JAVA)
+#include "GlyphMetricsCacheJava.h"
+#endif
+
 #if PLATFORM(WIN)
 #include <usp10.h>
 #endif
@@ -290,6 +294,10 @@ private:
     mutable Optional<BitVector> m_glyphsSupportedByAllPetiteCaps;
 #endif
 
+#if PLATFORM(JAVA)
+    mutable GlyphMetricsCacheJava m_glyphMetricsCache;
+#endif
+
 #if PLATFORM(WIN)
     mutable SCRIPT_CACHE m_scriptCache;
     mutable SCRIPT_FONTPROPERTIES* m_scriptFontProperties;
@@ -30,7 +30,7 @@
 #include "ImageDecoderCG.h"
 #elif USE(DIRECT2D)
 #include "ImageDecoderDirect2D.h"
-#elif PLATFORM(JAVA)
+#elif PLATFORM(JAVA) && USE(IMAGEIO)
 #include "ImageDecoderJava.h"
 #else
 #include "ScalableImageDecoder.h"
@@ -55,7 +55,7 @@ RefPtr<ImageDecoder> ImageDecoder::create(SharedBuffer& data, const String& mime
     return ImageDecoderCG::create(data, alphaOption, gammaAndColorProfileOption);
 #elif USE(DIRECT2D)
     return ImageDecoderDirect2D::create(data, alphaOption, gammaAndColorProfileOption);
-#elif PLATFORM(JAVA)
+#elif PLATFORM(JAVA) && USE(IMAGEIO)
     return ImageDecoderJava::create(data, alphaOption, gammaAndColorProfileOption);
 #else
     return ScalableImageDecoder::create(data, alphaOption, gammaAndColorProfileOption);
@@ -70,7 +70,7 @@ bool ImageDecoder::supportsMediaType(MediaType type)
 #elif USE(DIRECT2D)
     if (ImageDecoderDirect2D::supportsMediaType(type))
         return true;
-#elif PLATFORM(JAVA)
+#elif PLATFORM(JAVA) && USE(IMAGEIO)
     if (ImageDecoderJava::supportsMediaType(type))
         return true;
 #else
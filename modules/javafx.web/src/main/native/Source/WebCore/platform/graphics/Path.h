@@ -66,8 +66,8 @@ typedef WebCore::PlatformPath PlatformPath;
 
 #elif PLATFORM(JAVA)
 #include <wtf/RefPtr.h>
-#include "RQRef.h"
-typedef RefPtr<WebCore::RQRef> PlatformPath;
+#include "PlatformPathJava.h"
+typedef WebCore::PlatformPathJava PlatformPath;
 
 #else
 
@@ -76,7 +76,7 @@ typedef void PlatformPath;
 #endif
 
 #if PLATFORM(JAVA)
-typedef RefPtr<WebCore::RQRef> PlatformPathPtr;
+typedef RefPtr<PlatformPath> PlatformPathPtr;
 #else
 typedef PlatformPath* PlatformPathPtr;
 #endif
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#include "config.h"
+#include "GlyphMetricsCacheJava.h"
+
+#include "GraphicsContextJava.h"
+#include "RQRef.h"
+
+namespace WebCore {
+
+namespace {
+
+// Copies count * valuesPerGlyph floats returned by the WCFont method into
+// values. Leaves values untouched and returns false if the call failed.
+bool fetchGlyphMetrics(RQRef& font, jmethodID mid, Glyph firstGlyph, unsigned count, unsigned valuesPerGlyph, float* values)
+{
+    JNIEnv* env = WTF::GetJavaEnv();
+
+    JLocalRef<jfloatArray> metrics(static_cast<jfloatArray>(
+        env->CallObjectMethod(font, mid, jint(firstGlyph), jint(count))));
+    if (WTF::CheckAndClearException(env) || !metrics)
+        return false;
+
+    jsize length = count * valuesPerGlyph;
+    ASSERT(env->GetArrayLength(metrics) == length);
+    env->GetFloatArrayRegion(metrics, 0, length, values);
+    return !WTF::CheckAndClearException(env);
+}
+
+} // namespace
+
+float GlyphMetricsCacheJava::widthForGlyph(RQRef& font, Glyph glyph)
+{
+    unsigned pageNumber = glyph / widthPageSize;
+    auto result = m_widthPages.add(pageNumber, nullptr);
+    if (result.isNewEntry) {
+        JNIEnv* env = WTF::GetJavaEnv();
+        static jmethodID mid = env->GetMethodID(PG_GetFontClass(env), "getGlyphWidths", "(II)[F");
+        ASSERT(mid);
+
+        auto page = std::make_unique<WidthPage>();
+        if (!fetchGlyphMetrics(font, mid, pageNumber * widthPageSize, widthPageSize, 1, page->data())) {
+            m_widthPages.remove(pageNumber);
+            return 0;
+        }
+        result.iterator->value = WTFMove(page);
+    }
+    return (*result.iterator->value)[glyph % widthPageSize];
+}
+
+FloatRect GlyphMetricsCacheJava::boundsForGlyph(RQRef& font, Glyph glyph)
+{
+    unsigned pageNumber = glyph / boundsPageSize;
+    auto result = m_boundsPages.add(pageNumber, nullptr);
+    if (result.isNewEntry) {
+        JNIEnv* env = WTF::GetJavaEnv();
+        static jmethodID mid = env->GetMethodID(PG_GetFontClass(env), "getGlyphBoundingBoxes", "(II)[F");
+        ASSERT(mid);
+
+        std::array<float, 4 * boundsPageSize> boxes;
+        if (!fetchGlyphMetrics(font, mid, pageNumber * boundsPageSize, boundsPageSize, 4, boxes.data())) {
+            m_boundsPages.remove(pageNumber);
+            return { };
+        }
+        auto page = std::make_unique<BoundsPage>();
+        for (unsigned i = 0; i < boundsPageSize; ++i)
+            (*page)[i] = FloatRect(boxes[4 * i], boxes[4 * i + 1], boxes[4 * i + 2], boxes[4 * i + 3]);
+        result.iterator->value = WTFMove(page);
+    }
+    return (*result.iterator->value)[glyph % boundsPageSize];
+}
+
+} // namespace WebCore
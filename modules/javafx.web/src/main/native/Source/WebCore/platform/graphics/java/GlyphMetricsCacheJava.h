@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#pragma once
+
+#include "FloatRect.h"
+#include "Glyph.h"
+
+#include <array>
+#include <memory>
+#include <wtf/HashMap.h>
+
+namespace WebCore {
+
+class RQRef;
+
+/*
+ * Per-font cache of glyph advances and bounding boxes.
+ *
+ * Metrics are fetched from the Java font (WCFont) for a whole range of
+ * consecutive glyph IDs at a time, so laying out text costs one JNI round
+ * trip per range instead of one per glyph. Bounds need the glyph outlines
+ * and are only requested for overflow computations, hence the smaller page.
+ */
+class GlyphMetricsCacheJava {
+    WTF_MAKE_NONCOPYABLE(GlyphMetricsCacheJava);
+    WTF_MAKE_FAST_ALLOCATED;
+public:
+    static const unsigned widthPageSize = 256;
+    static const unsigned boundsPageSize = 32;
+
+    GlyphMetricsCacheJava() = default;
+
+    float widthForGlyph(RQRef& font, Glyph);
+    FloatRect boundsForGlyph(RQRef& font, Glyph);
+
+private:
+    typedef std::array<float, widthPageSize> WidthPage;
+    typedef std::array<FloatRect, boundsPageSize> BoundsPage;
+
+    // Keyed by page number; page 0 is valid, hence the zero key traits.
+    template<typename Page> using PageMap = HashMap<unsigned, std::unique_ptr<Page>,
+        IntHash<unsigned>, WTF::UnsignedWithZeroKeyHashTraits<unsigned>>;
+
+    PageMap<WidthPage> m_widthPages;
+    PageMap<BoundsPage> m_boundsPages;
+};
+
+} // namespace WebCore
@@ -722,9 +722,9 @@ void GraphicsContext::strokePath(const Path& path)
             com_sun_webkit_graphics_GraphicsDecoder_SET_STROKE_GRADIENT);
     }
 
-    platformContext()->rq().freeSpace(12)
+    platformContext()->rq().freeSpace(8 + path.platformPath()->encodedSize())
     << (jint)com_sun_webkit_graphics_GraphicsDecoder_STROKE_PATH
-    << copyPath(path.platformPath())
+    << *path.platformPath()
     << (jint)fillRule();
 }
 
@@ -739,9 +739,9 @@ static void setClipPath(
         return;
 
     state.clipBounds.intersect(state.transform.mapRect(path.fastBoundingRect()));
-    gc.platformContext()->rq().freeSpace(16)
+    gc.platformContext()->rq().freeSpace(12 + path.platformPath()->encodedSize())
     << jint(com_sun_webkit_graphics_GraphicsDecoder_CLIP_PATH)
-    << copyPath(path.platformPath())
+    << *path.platformPath()
     << jint(wrule == WindRule::EvenOdd
        ? com_sun_webkit_graphics_WCPath_RULE_EVENODD
        : com_sun_webkit_graphics_WCPath_RULE_NONZERO)
@@ -844,9 +844,9 @@ void GraphicsContext::fillPath(const Path& path)
                 com_sun_webkit_graphics_GraphicsDecoder_SET_FILL_GRADIENT);
         }
 
-        platformContext()->rq().freeSpace(12)
+        platformContext()->rq().freeSpace(8 + path.platformPath()->encodedSize())
         << (jint)com_sun_webkit_graphics_GraphicsDecoder_FILL_PATH
-        << copyPath(path.platformPath())
+        << *path.platformPath()
         << (jint)fillRule();
     }
 }
@@ -41,6 +41,7 @@
 #include "GraphicsContext.h"
 #include "IntRect.h"
 #include "ImageBufferData.h"
+#include "PixelConversionJava.h"
 
 
 
@@ -270,27 +271,11 @@ RefPtr<Uint8ClampedArray> getImageData(
     unsigned char* srcRows =
             idata.data() + originy * srcBytesPerRow + originx * 4;
 
+    // Convert BGRA to RGBA, unmultiplying if requested
+    PixelConversionKernel kernel = bestPixelConversionKernel();
+    bool unpremultiply = multiplied == AlphaPremultiplication::Unpremultiplied;
     for (int y = 0; y < height; ++y) {
-        unsigned char *pd = dstRows;
-        unsigned char *ps = srcRows;
-        for (int x = 0; x < width; x++) {
-            unsigned char alpha = ps[3];
-            if (multiplied == AlphaPremultiplication::Unpremultiplied && alpha && alpha!=255) {
-                // Unmultiply and convert BGRA to RGBA
-                pd[0] = (ps[2] * 255) / alpha;
-                pd[1] = (ps[1] * 255) / alpha;
-                pd[2] = (ps[0] * 255) / alpha;
-                pd[3] = alpha;
-            } else {
-                // Convert BGRA to RGBA
-                pd[0] = ps[2];
-                pd[1] = ps[1];
-                pd[2] = ps[0];
-                pd[3] = alpha;
-            }
-            pd += 4;
-            ps += 4;
-        }
+        convertBGRAToRGBA(kernel, srcRows, dstRows, width, unpremultiply);
         srcRows += srcBytesPerRow;
         dstRows += dstBytesPerRow;
     }
@@ -375,27 +360,11 @@ void ImageBuffer::putByteArray(
     unsigned char* dstRows =
             m_data.data() + desty * dstBytesPerRow + destx * 4;
 
+    // Convert RGBA to BGRA, premultiplying if the source is unmultiplied
+    PixelConversionKernel kernel = bestPixelConversionKernel();
+    bool premultiply = multiplied == AlphaPremultiplication::Unpremultiplied;
     for (int y = 0; y < height; ++y) {
-        unsigned char *pd = dstRows;
-        unsigned char *ps = srcRows;
-        for (int x = 0; x < width; x++) {
-            int alpha = ps[3]; //have to be [int] for right multiply casting
-            if (multiplied == AlphaPremultiplication::Unpremultiplied && alpha != 255) {
-                // Premultiply and convert RGBA to BGRA
-                pd[0] = static_cast<unsigned char>((ps[2] * alpha + 254) / 255);
-                pd[1] = static_cast<unsigned char>((ps[1] * alpha + 254) / 255);
-                pd[2] = static_cast<unsigned char>((ps[0] * alpha + 254) / 255);
-                pd[3] = static_cast<unsigned char>(alpha);
-            } else {
-                // Convert RGBA to BGRA
-                pd[0] = ps[2];
-                pd[1] = ps[1];
-                pd[2] = ps[0];
-                pd[3] = alpha;
-            }
-            pd += 4;
-            ps += 4;
-        }
+        convertRGBAToBGRA(kernel, srcRows, dstRows, width, premultiply);
         dstRows += dstBytesPerRow;
         srcRows += srcBytesPerRow;
     }
@@ -73,30 +73,4 @@ Ref<Image> Image::loadPlatformResource(const char *name)
     return BitmapImage::createFromName(name);
 }
 
-#if !USE(IMAGEIO)
-NativeImagePtr ImageFrame::asNewNativeImage() const
-{
-    JNIEnv* env = WTF::GetJavaEnv();
-    static jmethodID s_createWCImage_mID = env->GetMethodID(
-            PG_GetGraphicsManagerClass(env), "createFrame",
-            "(IILjava/nio/ByteBuffer;)Lcom/sun/webkit/graphics/WCImageFrame;");
-    ASSERT(s_createWCImage_mID);
-
-    JLObject data(env->NewDirectByteBuffer(
-            m_bytes,
-            width() * height() * sizeof(PixelData)));
-    ASSERT(data);
-
-    JLObject frame(env->CallObjectMethod(
-        PL_GetGraphicsManager(env),
-        s_createWCImage_mID,
-        width(),
-        height(),
-        (jobject)data));
-    ASSERT(frame);
-    WTF::CheckAndClearException(env);
-
-    return RQRef::create(frame);
-}
-#endif
 } // namespace WebCore
@@ -83,7 +83,7 @@ float subsamplingScale(GraphicsContext&, const FloatRect&, const FloatRect&)
     return 1;
 }
 
-void drawNativeImage(const NativeImagePtr& image, GraphicsContext& context, const FloatRect& destRect, const FloatRect& srcRect, const IntSize&, CompositeOperator op, BlendMode mode, const ImageOrientation& orientation)
+void drawNativeImage(const NativeImagePtr& image, GraphicsContext& context, const FloatRect& destRect, const FloatRect& srcRect, const IntSize& imageSize, CompositeOperator op, BlendMode mode, const ImageOrientation& orientation)
 {
     if (!image) {
         return;
@@ -103,6 +103,17 @@ void drawNativeImage(const NativeImagePtr& image, GraphicsContext& context, cons
     FloatRect adjustedSrcRect(srcRect);
 #endif
 
+#if !USE(IMAGEIO)
+    // srcRect is in image coordinates, a subsampled frame is smaller.
+    IntSize frameSize = nativeImageSize(image);
+    if (!imageSize.isEmpty() && frameSize != imageSize) {
+        adjustedSrcRect.scale(static_cast<float>(frameSize.width()) / imageSize.width(),
+            static_cast<float>(frameSize.height()) / imageSize.height());
+    }
+#else
+    UNUSED_PARAM(imageSize);
+#endif
+
     FloatRect adjustedDestRect = destRect;
 
     if (orientation != DefaultImageOrientation) {
@@ -29,17 +29,14 @@
 #include "FloatRect.h"
 #include "StrokeStyleApplier.h"
 #include "PlatformJavaClasses.h"
-#include "NotImplemented.h"
 #include "GraphicsContextJava.h"
-#include "RQRef.h"
 #include "GraphicsContext.h"
 #include "ImageBuffer.h"
 
+#include <wtf/MathExtras.h>
 #include <wtf/text/WTFString.h>
 #include <wtf/java/JavaRef.h>
 
-#include "com_sun_webkit_graphics_WCPathIterator.h"
-
 
 namespace WebCore {
 
@@ -50,46 +47,57 @@ static GraphicsContext& scratchContext()
     return context;
 }
 
-RefPtr<RQRef> createEmptyPath()
-{
-    JNIEnv* env = WTF::GetJavaEnv();
-    static jmethodID mid = env->GetMethodID(PG_GetGraphicsManagerClass(env),
-        "createWCPath", "()Lcom/sun/webkit/graphics/WCPath;");
-    ASSERT(mid);
+// Vector-backed sink for PlatformPathJava::encode(), used when the encoded
+// path has to be handed to Java outside of a RenderingQueue.
+class PathDataEncoder {
+public:
+    explicit PathDataEncoder(size_t capacity)
+    {
+        m_data.reserveInitialCapacity(capacity);
+    }
 
-    JLObject ref(env->CallObjectMethod(PL_GetGraphicsManager(env), mid));
-    ASSERT(ref);
-    WTF::CheckAndClearException(env);
-    return RQRef::create(ref);
-}
+    PathDataEncoder& operator << (jint i)
+    {
+        m_data.append(reinterpret_cast<const char*>(&i), sizeof(jint));
+        return *this;
+    }
 
-RefPtr<RQRef> copyPath(RefPtr<RQRef> p)
-{
-    if (!p) {
-        return createEmptyPath();
+    PathDataEncoder& operator << (jfloat f)
+    {
+        m_data.append(reinterpret_cast<const char*>(&f), sizeof(jfloat));
+        return *this;
     }
-    JNIEnv* env = WTF::GetJavaEnv();
 
+    char* data() { return m_data.data(); }
+    size_t size() const { return m_data.size(); }
+
+private:
+    Vector<char> m_data;
+};
+
+// Materializes a Java WCPath for the operations that still need the
+// Java geometry (e.g. stroking), in a single JNI round trip.
+static JLObject createJavaPath(JNIEnv* env, const PlatformPathJava& path)
+{
     static jmethodID mid = env->GetMethodID(PG_GetGraphicsManagerClass(env),
-        "createWCPath",
-        "(Lcom/sun/webkit/graphics/WCPath;)Lcom/sun/webkit/graphics/WCPath;");
+        "fwkCreateWCPath", "(Ljava/nio/ByteBuffer;)Lcom/sun/webkit/graphics/WCPath;");
     ASSERT(mid);
 
-    JLObject ref(env->CallObjectMethod(PL_GetGraphicsManager(env), mid, (jobject)*p));
-    ASSERT(ref);
-    WTF::CheckAndClearException(env);
+    PathDataEncoder encoder(path.encodedSize());
+    path.encode(encoder);
 
-    return RQRef::create(ref);
+    JLObject data(env->NewDirectByteBuffer(encoder.data(), encoder.size()));
+    JLObject ref(env->CallObjectMethod(PL_GetGraphicsManager(env), mid, (jobject)data));
+    WTF::CheckAndClearException(env);
+    return ref;
 }
 
-
-
 Path::Path()
-    : m_path(createEmptyPath())
+    : m_path(PlatformPathJava::create())
 {}
 
 Path::Path(const Path& p)
-    : m_path(copyPath(p.platformPath()))
+    : m_path(p.m_path ? PlatformPathJava::create(*p.m_path) : PlatformPathJava::create())
 {}
 
 Path::~Path()
@@ -97,14 +105,13 @@ Path::~Path()
 
 Path::Path(Path&& other)
 {
-    m_path = other.m_path;
-    other.m_path = nullptr;
+    m_path = WTFMove(other.m_path);
 }
 
 Path& Path::operator=(const Path &p)
 {
     if (this != &p) {
-        m_path = copyPath(p.platformPath());
+        m_path = p.m_path ? PlatformPathJava::create(*p.m_path) : PlatformPathJava::create();
     }
     return *this;
 }
@@ -114,26 +121,14 @@ Path& Path::operator=(Path&& other)
     if (this == &other)
         return *this;
 
-    m_path = other.m_path;
-    other.m_path = nullptr;
+    m_path = WTFMove(other.m_path);
     return *this;
 }
 
 bool Path::contains(const FloatPoint& p, WindRule rule) const
 {
     ASSERT(m_path);
-
-    JNIEnv* env = WTF::GetJavaEnv();
-
-    static jmethodID mid = env->GetMethodID(PG_GetPathClass(env), "contains",
-        "(IDD)Z");
-    ASSERT(mid);
-
-    jboolean res = env->CallBooleanMethod(*m_path, mid, (jint)rule,
-        (jdouble)p.x(), (jdouble)p.y());
-    WTF::CheckAndClearException(env);
-
-    return jbool_to_bool(res);
+    return m_path->contains(p, rule);
 }
 
 FloatRect Path::boundingRect() const
@@ -145,139 +140,65 @@ FloatRect Path::strokeBoundingRect(StrokeStyleApplier *applier) const
 {
     ASSERT(m_path);
 
-    JNIEnv* env = WTF::GetJavaEnv();
-
-    static jmethodID mid = env->GetMethodID(PG_GetPathClass(env), "getBounds",
-            "()Lcom/sun/webkit/graphics/WCRectangle;");
-    ASSERT(mid);
-
-    JLObject rect(env->CallObjectMethod(*m_path, mid));
-    WTF::CheckAndClearException(env);
-    if (rect) {
-        static jfieldID rectxFID = env->GetFieldID(PG_GetRectangleClass(env), "x", "F");
-        ASSERT(rectxFID);
-        static jfieldID rectyFID = env->GetFieldID(PG_GetRectangleClass(env), "y", "F");
-        ASSERT(rectyFID);
-        static jfieldID rectwFID = env->GetFieldID(PG_GetRectangleClass(env), "w", "F");
-        ASSERT(rectwFID);
-        static jfieldID recthFID = env->GetFieldID(PG_GetRectangleClass(env), "h", "F");
-        ASSERT(recthFID);
-
-        FloatRect bounds(
-            float(env->GetFloatField(rect, rectxFID)),
-            float(env->GetFloatField(rect, rectyFID)),
-            float(env->GetFloatField(rect, rectwFID)),
-            float(env->GetFloatField(rect, recthFID)));
-        WTF::CheckAndClearException(env);
-
-        float thickness;
-        if (applier) {
-            GraphicsContext& gc = scratchContext();
-            gc.save();
-            applier->strokeStyle(&gc);
-            thickness = gc.strokeThickness();
-            gc.restore();
-            bounds.inflate(thickness / 2);
-        }
-        return bounds;
-    } else {
+    if (m_path->points().isEmpty())
         return FloatRect();
+
+    FloatRect bounds = m_path->boundingRect();
+    if (applier) {
+        GraphicsContext& gc = scratchContext();
+        gc.save();
+        applier->strokeStyle(&gc);
+        float thickness = gc.strokeThickness();
+        gc.restore();
+        bounds.inflate(thickness / 2);
     }
+    return bounds;
 }
 
 void Path::clear()
 {
     ASSERT(m_path);
-
-    JNIEnv* env = WTF::GetJavaEnv();
-
-    static jmethodID mid = env->GetMethodID(PG_GetPathClass(env),
-        "clear", "()V");
-    ASSERT(mid);
-
-    env->CallVoidMethod(*m_path, mid);
-    WTF::CheckAndClearException(env);
+    m_path->clear();
 }
 
 bool Path::isEmpty() const
 {
     ASSERT(m_path);
-
-    JNIEnv* env = WTF::GetJavaEnv();
-
-    static jmethodID mid = env->GetMethodID(PG_GetPathClass(env),
-                                            "isEmpty", "()Z");
-    ASSERT(mid);
-
-    jboolean res = env->CallBooleanMethod(*m_path, mid);
-    WTF::CheckAndClearException(env);
-
-    return jbool_to_bool(res);
+    return m_path->isEmpty();
 }
 
 bool Path::hasCurrentPoint() const
 {
     ASSERT(m_path);
-
-    JNIEnv* env = WTF::GetJavaEnv();
-
-    static jmethodID mid = env->GetMethodID(PG_GetPathClass(env),
-                                            "hasCurrentPoint", "()Z");
-    ASSERT(mid);
-
-    jboolean res = env->CallBooleanMethod(*m_path, mid);
-    WTF::CheckAndClearException(env);
-
-    return jbool_to_bool(res);
+    return m_path->hasCurrentPoint();
 }
 
 FloatPoint Path::currentPoint() const
 {
-    //utatodo: return current point of subpath.
-    float quietNaN = std::numeric_limits<float>::quiet_NaN();
-    return FloatPoint(quietNaN, quietNaN);
+    ASSERT(m_path);
+    if (!m_path->hasCurrentPoint()) {
+        float quietNaN = std::numeric_limits<float>::quiet_NaN();
+        return FloatPoint(quietNaN, quietNaN);
+    }
+    return m_path->currentPoint();
 }
 
 void Path::moveTo(const FloatPoint &p)
 {
     ASSERT(m_path);
-
-    JNIEnv* env = WTF::GetJavaEnv();
-
-    static jmethodID mid = env->GetMethodID(PG_GetPathClass(env), "moveTo",
-        "(DD)V");
-    ASSERT(mid);
-
-    env->CallVoidMethod(*m_path, mid, (jdouble)p.x(), (jdouble)p.y());
-    WTF::CheckAndClearException(env);
+    m_path->moveTo(p);
 }
 
 void Path::addLineTo(const FloatPoint &p)
 {
     ASSERT(m_path);
-
-    JNIEnv* env = WTF::GetJavaEnv();
-
-    static jmethodID mid = env->GetMethodID(PG_GetPathClass(env), "addLineTo",
-        "(DD)V");
-    ASSERT(mid);
-
-    env->CallVoidMethod(*m_path, mid, (jdouble)p.x(), (jdouble)p.y());
-    WTF::CheckAndClearException(env);
+    m_path->lineTo(p);
 }
 
 void Path::addQuadCurveTo(const FloatPoint &cp, const FloatPoint &p)
 {
     ASSERT(m_path);
-
-    JNIEnv* env = WTF::GetJavaEnv();
-
-    static jmethodID mid = env->GetMethodID(PG_GetPathClass(env), "addQuadCurveTo",
-                                            "(DDDD)V");
-    ASSERT(mid);
-
-    env->CallVoidMethod(*m_path, mid, (jdouble)cp.x(), (jdouble)cp.y(), (jdouble)p.x(), (jdouble)p.y());
-    WTF::CheckAndClearException(env);
+    m_path->quadTo(cp, p);
 }
 
 void Path::addBezierCurveTo(const FloatPoint & controlPoint1,
@@ -285,209 +206,111 @@ void Path::addBezierCurveTo(const FloatPoint & controlPoint1,
                             const FloatPoint & controlPoint3)
 {
     ASSERT(m_path);
-
-    JNIEnv* env = WTF::GetJavaEnv();
-
-    static jmethodID mid = env->GetMethodID(PG_GetPathClass(env),
-        "addBezierCurveTo", "(DDDDDD)V");
-    ASSERT(mid);
-
-    env->CallVoidMethod(*m_path, mid,
-                        (jdouble)controlPoint1.x(), (jdouble)controlPoint1.y(),
-                        (jdouble)controlPoint2.x(), (jdouble)controlPoint2.y(),
-                        (jdouble)controlPoint3.x(), (jdouble)controlPoint3.y());
-    WTF::CheckAndClearException(env);
+    m_path->cubicTo(controlPoint1, controlPoint2, controlPoint3);
 }
 
 void Path::addArcTo(const FloatPoint & p1, const FloatPoint & p2, float radius)
 {
     ASSERT(m_path);
-
-    JNIEnv* env = WTF::GetJavaEnv();
-
-    static jmethodID mid = env->GetMethodID(PG_GetPathClass(env), "addArcTo",
-        "(DDDDD)V");
-    ASSERT(mid);
-
-    env->CallVoidMethod(*m_path, mid,
-                        (jdouble)p1.x(), (jdouble)p1.y(),
-                        (jdouble)p2.x(), (jdouble)p2.y(), (jdouble)radius);
-    WTF::CheckAndClearException(env);
+    m_path->arcTo(p1, p2, radius);
 }
 
 void Path::closeSubpath()
 {
     ASSERT(m_path);
+    m_path->close();
+}
 
-    JNIEnv* env = WTF::GetJavaEnv();
-
-    static jmethodID mid = env->GetMethodID(PG_GetPathClass(env),
-        "closeSubpath", "()V");
-    ASSERT(mid);
-
-    env->CallVoidMethod(*m_path, mid);
-    WTF::CheckAndClearException(env);
+// Returns the signed sweep of an arc from startAngle to endAngle.
+// CanvasPath has already normalized full turns (see normalizeAngles()),
+// what remains is to go the other way around when the angles are in
+// the opposite order of the requested direction.
+//
+// NOTE: When startAngle = 0, endAngle = 2Pi and anticlockwise = true, the
+// spec does not indicate clearly. We draw the entire circle, because some
+// web sites use arc(x, y, r, 0, 2*Math.PI, true) to draw circle.
+static float arcSweep(float startAngle, float endAngle, bool anticlockwise)
+{
+    const float twoPi = 2 * piFloat;
+    if (!anticlockwise && startAngle > endAngle)
+        return twoPi - fmodf(startAngle - endAngle, twoPi);
+    if (anticlockwise && startAngle < endAngle)
+        return -(twoPi - fmodf(endAngle - startAngle, twoPi));
+    return endAngle - startAngle;
 }
 
 void Path::addArc(const FloatPoint & p, float radius, float startAngle,
-                  float endAngle, bool clockwise)
+                  float endAngle, bool anticlockwise)
 {
     ASSERT(m_path);
-
-    JNIEnv* env = WTF::GetJavaEnv();
-
-    static jmethodID mid = env->GetMethodID(PG_GetPathClass(env), "addArc",
-        "(DDDDDZ)V");
-    ASSERT(mid);
-
-    env->CallVoidMethod(*m_path, mid, (jdouble)p.x(), (jdouble)p.y(),
-        (jdouble)radius, (jdouble)startAngle, (jdouble)endAngle,
-        bool_to_jbool(clockwise));
-    WTF::CheckAndClearException(env);
+    m_path->arc(p, radius, radius, 0, startAngle,
+        arcSweep(startAngle, endAngle, anticlockwise), true);
 }
 
 void Path::addRect(const FloatRect& r)
 {
     ASSERT(m_path);
-
-    JNIEnv* env = WTF::GetJavaEnv();
-
-    static jmethodID mid = env->GetMethodID(PG_GetPathClass(env), "addRect",
-        "(DDDD)V");
-    ASSERT(mid);
-
-    env->CallVoidMethod(*m_path, mid, (jdouble)r.x(), (jdouble)r.y(),
-                              (jdouble)r.width(), (jdouble)r.height());
-    WTF::CheckAndClearException(env);
+    m_path->addRect(r);
 }
 
-void Path::addEllipse(FloatPoint, float, float, float, float, float, bool)
+void Path::addEllipse(FloatPoint p, float radiusX, float radiusY, float rotation,
+                      float startAngle, float endAngle, bool anticlockwise)
 {
-    notImplemented();
+    ASSERT(m_path);
+    m_path->arc(p, radiusX, radiusY, rotation, startAngle,
+        arcSweep(startAngle, endAngle, anticlockwise), true);
 }
 
-void Path::addPath(const Path&, const AffineTransform&)
+void Path::addPath(const Path& path, const AffineTransform& transform)
 {
-    notImplemented();
+    ASSERT(m_path);
+    if (path.m_path)
+        m_path->addPath(*path.m_path, transform);
 }
 
 void Path::addEllipse(const FloatRect& r)
 {
     ASSERT(m_path);
-
-    JNIEnv* env = WTF::GetJavaEnv();
-    static jmethodID mid = env->GetMethodID(PG_GetPathClass(env), "addEllipse",
-        "(DDDD)V");
-    ASSERT(mid);
-
-    env->CallVoidMethod(*m_path, mid,
-                        (jdouble)r.x(), (jdouble)r.y(),
-                        (jdouble)r.width(), (jdouble)r.height());
-    WTF::CheckAndClearException(env);
+    m_path->addEllipse(r);
 }
 
 void Path::translate(const FloatSize &sz)
 {
     ASSERT(m_path);
-
-    JNIEnv* env = WTF::GetJavaEnv();
-    static jmethodID mid = env->GetMethodID(PG_GetPathClass(env), "translate",
-        "(DD)V");
-    ASSERT(mid);
-
-    env->CallVoidMethod(*m_path, mid,
-                        (jdouble)sz.width(), (jdouble)sz.height());
-    WTF::CheckAndClearException(env);
+    m_path->translate(sz.width(), sz.height());
 }
 
 void Path::transform(const AffineTransform &at)
 {
     ASSERT(m_path);
-
-    JNIEnv* env = WTF::GetJavaEnv();
-
-    static jmethodID mid = env->GetMethodID(PG_GetPathClass(env),
-        "transform", "(DDDDDD)V");
-    ASSERT(mid);
-
-    env->CallVoidMethod(*m_path, mid,
-                        (jdouble)at.a(), (jdouble)at.b(),
-                        (jdouble)at.c(), (jdouble)at.d(),
-                        (jdouble)at.e(), (jdouble)at.f());
-    WTF::CheckAndClearException(env);
+    m_path->transform(at);
 }
 
 void Path::apply(const PathApplierFunction& function) const
 {
     ASSERT(m_path);
 
-    JNIEnv* env = WTF::GetJavaEnv();
-
-    static jmethodID mid = env->GetMethodID(PG_GetPathClass(env),
-        "getPathIterator", "()Lcom/sun/webkit/graphics/WCPathIterator;");
-    ASSERT(mid);
-
-    JLObject iter(env->CallObjectMethod(*m_path, mid));
-    WTF::CheckAndClearException(env);
-
-    if (iter) {
-        static jmethodID midIsDone = env->GetMethodID(PG_GetPathIteratorClass(env),
-            "isDone", "()Z");
-        ASSERT(midIsDone);
-
-        static jmethodID midNext = env->GetMethodID(PG_GetPathIteratorClass(env),
-            "next", "()V");
-        ASSERT(midNext);
-
-        static jmethodID midCurrentSegment = env->GetMethodID(PG_GetPathIteratorClass(env),
-            "currentSegment", "([D)I");
-        ASSERT(midCurrentSegment);
-
-        PathElement pelement;
-        FloatPoint points[3];
-        pelement.points = points;
-
-        JLocalRef<jdoubleArray> coords(env->NewDoubleArray(6));
-        while(JNI_FALSE == env->CallBooleanMethod(iter, midIsDone)) {
-            jint type = env->CallBooleanMethod(
-                iter,
-                midCurrentSegment,
-                (jdoubleArray)coords);
-            jboolean isCopy = JNI_FALSE;
-            jdouble *data = env->GetDoubleArrayElements(coords, &isCopy);
-            switch (type) {
-            case com_sun_webkit_graphics_WCPathIterator_SEG_MOVETO:
-                pelement.type = PathElementMoveToPoint;
-                pelement.points[0] = FloatPoint(data[0],data[1]);
-                function(pelement);
-                break;
-            case com_sun_webkit_graphics_WCPathIterator_SEG_LINETO:
-                pelement.type = PathElementAddLineToPoint;
-                pelement.points[0] = FloatPoint(data[0],data[1]);
-                function(pelement);
-                break;
-            case com_sun_webkit_graphics_WCPathIterator_SEG_QUADTO:
-                pelement.type = PathElementAddQuadCurveToPoint;
-                pelement.points[0] = FloatPoint(data[0],data[1]);
-                pelement.points[1] = FloatPoint(data[2],data[3]);
-                function(pelement);
-                break;
-            case com_sun_webkit_graphics_WCPathIterator_SEG_CUBICTO:
-                pelement.type = PathElementAddCurveToPoint;
-                pelement.points[0] = FloatPoint(data[0],data[1]);
-                pelement.points[1] = FloatPoint(data[2],data[3]);
-                pelement.points[2] = FloatPoint(data[4],data[5]);
-                function(pelement);
-                break;
-            case com_sun_webkit_graphics_WCPathIterator_SEG_CLOSE:
-                pelement.type = PathElementCloseSubpath;
-                function(pelement);
-                break;
-            }
-            env->ReleaseDoubleArrayElements(coords, data, JNI_ABORT);
-            env->CallVoidMethod(iter, midNext);
+    static const PathElementType elementTypes[] = {
+        PathElementMoveToPoint,
+        PathElementAddLineToPoint,
+        PathElementAddQuadCurveToPoint,
+        PathElementAddCurveToPoint,
+        PathElementCloseSubpath
+    };
+
+    PathElement pelement;
+    FloatPoint points[3];
+    pelement.points = points;
+
+    const Vector<FloatPoint>& pathPoints = m_path->points();
+    size_t p = 0;
+    for (uint8_t verb : m_path->verbs()) {
+        const unsigned count = PlatformPathJava::pointCount(PlatformPathJava::Verb(verb));
+        for (unsigned i = 0; i < count; ++i) {
+            points[i] = pathPoints[p++];
         }
-        WTF::CheckAndClearException(env);
+        pelement.type = elementTypes[verb];
+        function(pelement);
     }
 }
 
@@ -516,8 +339,18 @@ bool Path::strokeContains(StrokeStyleApplier *applier, const FloatPoint& p) cons
 
     gc.restore();
 
+    // Cheap rejection before going to Java for the stroker.
+    FloatRect bounds = m_path->boundingRect();
+    bounds.inflate(thickness * std::max(miterLimit, sqrtOfTwoFloat) / 2);
+    if (!bounds.contains(p))
+        return false;
+
     JNIEnv* env = WTF::GetJavaEnv();
 
+    JLObject path(createJavaPath(env, *m_path));
+    if (!path)
+        return false;
+
     static jmethodID mid = env->GetMethodID(PG_GetPathClass(env), "strokeContains",
         "(DDDDIID[D)Z");
 
@@ -527,7 +360,7 @@ bool Path::strokeContains(StrokeStyleApplier *applier, const FloatPoint& p) cons
     JLocalRef<jdoubleArray> dashArray(env->NewDoubleArray(size));
     env->SetDoubleArrayRegion(dashArray, 0, size, dashes.data());
 
-    jboolean res = env->CallBooleanMethod(*m_path, mid, (jdouble)p.x(),
+    jboolean res = env->CallBooleanMethod(path, mid, (jdouble)p.x(),
         (jdouble)p.y(), (jdouble) thickness, (jdouble) miterLimit,
         (jint) cap, (jint) join, (jdouble) dashOffset, (jdoubleArray) dashArray);
 
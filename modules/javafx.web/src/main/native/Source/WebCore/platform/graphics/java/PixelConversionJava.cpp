@@ -0,0 +1,536 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#include "config.h"
+#include "PixelConversionJava.h"
+
+#if CPU(X86_SSE2)
+#include <emmintrin.h>
+#if COMPILER(GCC_COMPATIBLE) || COMPILER(MSVC)
+#include <immintrin.h>
+#define HAVE_AVX2_KERNEL 1
+#if COMPILER(GCC_COMPATIBLE)
+#define AVX2_TARGET __attribute__((target("avx2")))
+#else
+#define AVX2_TARGET
+#endif
+#endif
+#endif
+
+#if CPU(ARM_NEON) || CPU(ARM64)
+#include <arm_neon.h>
+#define HAVE_NEON_KERNEL 1
+#endif
+
+namespace WebCore {
+
+namespace {
+
+// For every alpha value a > 0 holds floor(65535 / a) in both 16-bit halves,
+// so a SIMD kernel can build a vector of per-pixel reciprocals from 32-bit
+// loads. Entry 0 is never used as a divisor.
+struct ReciprocalTable {
+    constexpr ReciprocalTable()
+    {
+        for (unsigned a = 1; a < 256; ++a) {
+            uint32_t r = 65535 / a;
+            value[a] = r | (r << 16);
+        }
+    }
+
+    uint32_t value[256] { };
+};
+
+constexpr ReciprocalTable reciprocals;
+
+// (c * 255) / a for a > 0. The estimate (n * floor(65535 / a)) >> 16 never
+// exceeds the exact quotient and is at most two below it, so two remainder
+// corrections make it exact. The result is truncated to 8 bits like the
+// original division loop did for (invalid) colors brighter than alpha.
+inline uint8_t unpremultiplyChannel(unsigned c, unsigned a)
+{
+    unsigned n = c * 255;
+    unsigned q = (n * (reciprocals.value[a] & 0xFFFF)) >> 16;
+    unsigned r = n - q * a;
+    // Branch-free, the corrections are data dependent and mispredict badly.
+    unsigned carry = r >= a;
+    q += carry;
+    r -= carry * a;
+    q += r >= a;
+    return static_cast<uint8_t>(q);
+}
+
+// (c * a + 254) / 255 without a division; exact for n < 65535.
+inline uint8_t premultiplyChannel(unsigned c, unsigned a)
+{
+    unsigned n = c * a + 254;
+    return static_cast<uint8_t>((n + 1 + (n >> 8)) >> 8);
+}
+
+void convertBGRAToRGBAScalar(const uint8_t* source, uint8_t* destination, unsigned pixelCount, bool unpremultiply)
+{
+    for (unsigned i = 0; i < pixelCount; ++i, source += 4, destination += 4) {
+        uint8_t alpha = source[3];
+        if (unpremultiply && alpha && alpha != 255) {
+            destination[0] = unpremultiplyChannel(source[2], alpha);
+            destination[1] = unpremultiplyChannel(source[1], alpha);
+            destination[2] = unpremultiplyChannel(source[0], alpha);
+        } else {
+            destination[0] = source[2];
+            destination[1] = source[1];
+            destination[2] = source[0];
+        }
+        destination[3] = alpha;
+    }
+}
+
+void convertRGBAToBGRAScalar(const uint8_t* source, uint8_t* destination, unsigned pixelCount, bool premultiply)
+{
+    for (unsigned i = 0; i < pixelCount; ++i, source += 4, destination += 4) {
+        uint8_t alpha = source[3];
+        if (premultiply && alpha != 255) {
+            destination[0] = premultiplyChannel(source[2], alpha);
+            destination[1] = premultiplyChannel(source[1], alpha);
+            destination[2] = premultiplyChannel(source[0], alpha);
+        } else {
+            destination[0] = source[2];
+            destination[1] = source[1];
+            destination[2] = source[0];
+        }
+        destination[3] = alpha;
+    }
+}
+
+#if CPU(X86_SSE2)
+
+// Swaps bytes 0 and 2 of every 32-bit pixel. The conversion is symmetric,
+// so this serves both directions.
+inline __m128i swapRedBlueSSE2(__m128i pixels)
+{
+    const __m128i alphaGreen = _mm_set1_epi32(static_cast<int>(0xFF00FF00));
+    __m128i redBlue = _mm_andnot_si128(alphaGreen, pixels);
+    redBlue = _mm_or_si128(_mm_srli_epi32(redBlue, 16), _mm_slli_epi32(redBlue, 16));
+    return _mm_or_si128(_mm_and_si128(pixels, alphaGreen), redBlue);
+}
+
+// Broadcasts the alpha lane of two 16-bit expanded pixels to all channels.
+inline __m128i broadcastAlphaSSE2(__m128i channels)
+{
+    return _mm_shufflehi_epi16(_mm_shufflelo_epi16(channels, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+}
+
+// Un-premultiplies two pixels held as 16-bit channels. The alpha channel
+// and transparent pixels keep their values.
+inline __m128i unpremultiplySSE2(__m128i channels, __m128i reciprocal)
+{
+    const __m128i zero = _mm_setzero_si128();
+    __m128i alpha = broadcastAlphaSSE2(channels);
+    __m128i n = _mm_mullo_epi16(channels, _mm_set1_epi16(255));
+    __m128i q = _mm_mulhi_epu16(n, reciprocal);
+    __m128i r = _mm_sub_epi16(n, _mm_mullo_epi16(q, alpha));
+    // r >= a exactly when the saturated a - r is zero; the all-ones
+    // compare result is subtracted to increment the quotient.
+    __m128i carry = _mm_cmpeq_epi16(_mm_subs_epu16(alpha, r), zero);
+    q = _mm_sub_epi16(q, carry);
+    r = _mm_sub_epi16(r, _mm_and_si128(carry, alpha));
+    carry = _mm_cmpeq_epi16(_mm_subs_epu16(alpha, r), zero);
+    q = _mm_and_si128(_mm_sub_epi16(q, carry), _mm_set1_epi16(0xFF));
+    __m128i keep = _mm_or_si128(_mm_cmpeq_epi16(alpha, zero), _mm_set_epi16(-1, 0, 0, 0, -1, 0, 0, 0));
+    return _mm_or_si128(_mm_and_si128(keep, channels), _mm_andnot_si128(keep, q));
+}
+
+// Premultiplies two pixels held as 16-bit channels; the alpha channel is
+// multiplied by 255 and therefore stays unchanged.
+inline __m128i premultiplySSE2(__m128i channels)
+{
+    __m128i factor = _mm_or_si128(broadcastAlphaSSE2(channels), _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0));
+    __m128i n = _mm_add_epi16(_mm_mullo_epi16(channels, factor), _mm_set1_epi16(254));
+    n = _mm_add_epi16(_mm_add_epi16(n, _mm_set1_epi16(1)), _mm_srli_epi16(n, 8));
+    return _mm_srli_epi16(n, 8);
+}
+
+inline int alphaMaskSSE2(__m128i pixels, uint8_t value)
+{
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(pixels, _mm_set1_epi8(static_cast<char>(value)))) & 0x8888;
+}
+
+void convertBGRAToRGBASSE2(const uint8_t* source, uint8_t* destination, unsigned pixelCount, bool unpremultiply)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const uint32_t* table = reciprocals.value;
+    unsigned i = 0;
+    for (; i + 4 <= pixelCount; i += 4, source += 16, destination += 16) {
+        __m128i pixels = swapRedBlueSSE2(_mm_loadu_si128(reinterpret_cast<const __m128i*>(source)));
+        if (unpremultiply && (alphaMaskSSE2(pixels, 0) | alphaMaskSSE2(pixels, 255)) != 0x8888) {
+            __m128i low = unpremultiplySSE2(_mm_unpacklo_epi8(pixels, zero),
+                _mm_set_epi32(table[source[7]], table[source[7]], table[source[3]], table[source[3]]));
+            __m128i high = unpremultiplySSE2(_mm_unpackhi_epi8(pixels, zero),
+                _mm_set_epi32(table[source[15]], table[source[15]], table[source[11]], table[source[11]]));
+            pixels = _mm_packus_epi16(low, high);
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(destination), pixels);
+    }
+    convertBGRAToRGBAScalar(source, destination, pixelCount - i, unpremultiply);
+}
+
+void convertRGBAToBGRASSE2(const uint8_t* source, uint8_t* destination, unsigned pixelCount, bool premultiply)
+{
+    const __m128i zero = _mm_setzero_si128();
+    unsigned i = 0;
+    for (; i + 4 <= pixelCount; i += 4, source += 16, destination += 16) {
+        __m128i pixels = swapRedBlueSSE2(_mm_loadu_si128(reinterpret_cast<const __m128i*>(source)));
+        if (premultiply && alphaMaskSSE2(pixels, 255) != 0x8888) {
+            pixels = _mm_packus_epi16(
+                premultiplySSE2(_mm_unpacklo_epi8(pixels, zero)),
+                premultiplySSE2(_mm_unpackhi_epi8(pixels, zero)));
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(destination), pixels);
+    }
+    convertRGBAToBGRAScalar(source, destination, pixelCount - i, premultiply);
+}
+
+#endif // CPU(X86_SSE2)
+
+#if HAVE(AVX2_KERNEL)
+
+// The AVX2 kernels mirror the SSE2 ones. Unpacking and packing work within
+// each 128-bit lane, so the low half holds pixels 0, 1, 4, 5 and the high
+// half pixels 2, 3, 6, 7.
+
+AVX2_TARGET inline __m256i swapRedBlueAVX2(__m256i pixels)
+{
+    const __m256i alphaGreen = _mm256_set1_epi32(static_cast<int>(0xFF00FF00));
+    __m256i redBlue = _mm256_andnot_si256(alphaGreen, pixels);
+    redBlue = _mm256_or_si256(_mm256_srli_epi32(redBlue, 16), _mm256_slli_epi32(redBlue, 16));
+    return _mm256_or_si256(_mm256_and_si256(pixels, alphaGreen), redBlue);
+}
+
+AVX2_TARGET inline __m256i broadcastAlphaAVX2(__m256i channels)
+{
+    return _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(channels, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+}
+
+AVX2_TARGET inline __m256i unpremultiplyAVX2(__m256i channels, __m256i reciprocal)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i alpha = broadcastAlphaAVX2(channels);
+    __m256i n = _mm256_mullo_epi16(channels, _mm256_set1_epi16(255));
+    __m256i q = _mm256_mulhi_epu16(n, reciprocal);
+    __m256i r = _mm256_sub_epi16(n, _mm256_mullo_epi16(q, alpha));
+    __m256i carry = _mm256_cmpeq_epi16(_mm256_subs_epu16(alpha, r), zero);
+    q = _mm256_sub_epi16(q, carry);
+    r = _mm256_sub_epi16(r, _mm256_and_si256(carry, alpha));
+    carry = _mm256_cmpeq_epi16(_mm256_subs_epu16(alpha, r), zero);
+    q = _mm256_and_si256(_mm256_sub_epi16(q, carry), _mm256_set1_epi16(0xFF));
+    __m256i keep = _mm256_or_si256(_mm256_cmpeq_epi16(alpha, zero),
+        _mm256_set_epi16(-1, 0, 0, 0, -1, 0, 0, 0, -1, 0, 0, 0, -1, 0, 0, 0));
+    return _mm256_blendv_epi8(q, channels, keep);
+}
+
+AVX2_TARGET inline __m256i premultiplyAVX2(__m256i channels)
+{
+    __m256i factor = _mm256_or_si256(broadcastAlphaAVX2(channels),
+        _mm256_set_epi16(255, 0, 0, 0, 255, 0, 0, 0, 255, 0, 0, 0, 255, 0, 0, 0));
+    __m256i n = _mm256_add_epi16(_mm256_mullo_epi16(channels, factor), _mm256_set1_epi16(254));
+    n = _mm256_add_epi16(_mm256_add_epi16(n, _mm256_set1_epi16(1)), _mm256_srli_epi16(n, 8));
+    return _mm256_srli_epi16(n, 8);
+}
+
+AVX2_TARGET inline uint32_t alphaMaskAVX2(__m256i pixels, uint8_t value)
+{
+    return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(pixels, _mm256_set1_epi8(static_cast<char>(value))))) & 0x88888888;
+}
+
+AVX2_TARGET void convertBGRAToRGBAAVX2(const uint8_t* source, uint8_t* destination, unsigned pixelCount, bool unpremultiply)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const uint32_t* table = reciprocals.value;
+    unsigned i = 0;
+    for (; i + 8 <= pixelCount; i += 8, source += 32, destination += 32) {
+        __m256i pixels = swapRedBlueAVX2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(source)));
+        if (unpremultiply && (alphaMaskAVX2(pixels, 0) | alphaMaskAVX2(pixels, 255)) != 0x88888888) {
+            __m256i low = unpremultiplyAVX2(_mm256_unpacklo_epi8(pixels, zero), _mm256_set_epi32(
+                table[source[23]], table[source[23]], table[source[19]], table[source[19]],
+                table[source[7]], table[source[7]], table[source[3]], table[source[3]]));
+            __m256i high = unpremultiplyAVX2(_mm256_unpackhi_epi8(pixels, zero), _mm256_set_epi32(
+                table[source[31]], table[source[31]], table[source[27]], table[source[27]],
+                table[source[15]], table[source[15]], table[source[11]], table[source[11]]));
+            pixels = _mm256_packus_epi16(low, high);
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination), pixels);
+    }
+    convertBGRAToRGBASSE2(source, destination, pixelCount - i, unpremultiply);
+}
+
+AVX2_TARGET void convertRGBAToBGRAAVX2(const uint8_t* source, uint8_t* destination, unsigned pixelCount, bool premultiply)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    unsigned i = 0;
+    for (; i + 8 <= pixelCount; i += 8, source += 32, destination += 32) {
+        __m256i pixels = swapRedBlueAVX2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(source)));
+        if (premultiply && alphaMaskAVX2(pixels, 255) != 0x88888888) {
+            pixels = _mm256_packus_epi16(
+                premultiplyAVX2(_mm256_unpacklo_epi8(pixels, zero)),
+                premultiplyAVX2(_mm256_unpackhi_epi8(pixels, zero)));
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination), pixels);
+    }
+    convertRGBAToBGRASSE2(source, destination, pixelCount - i, premultiply);
+}
+
+void readCPUID(unsigned level, unsigned count, unsigned result[4])
+{
+#if COMPILER(MSVC)
+    __cpuidex(reinterpret_cast<int*>(result), level, count);
+#else
+    __asm__ (
+        "cpuid\n"
+        : "=a"(result[0]), "=b"(result[1]), "=c"(result[2]), "=d"(result[3])
+        : "0"(level), "2"(count)
+    );
+#endif
+}
+
+bool cpuSupportsAVX2()
+{
+    unsigned result[4];
+    readCPUID(0, 0, result);
+    if (result[0] < 7)
+        return false;
+
+    // AVX2 also needs the OS to preserve the YMM registers (OSXSAVE + AVX,
+    // then XCR0 bits 1 and 2).
+    const unsigned osxsaveAndAVX = (1 << 27) | (1 << 28);
+    readCPUID(1, 0, result);
+    if ((result[2] & osxsaveAndAVX) != osxsaveAndAVX)
+        return false;
+#if COMPILER(MSVC)
+    uint64_t xcr0 = _xgetbv(0);
+#else
+    uint32_t xcr0Low, xcr0High;
+    __asm__ ("xgetbv" : "=a"(xcr0Low), "=d"(xcr0High) : "c"(0));
+    uint64_t xcr0 = xcr0Low | (static_cast<uint64_t>(xcr0High) << 32);
+#endif
+    if ((xcr0 & 0x6) != 0x6)
+        return false;
+
+    readCPUID(7, 0, result);
+    return result[1] & (1 << 5);
+}
+
+#endif // HAVE(AVX2_KERNEL)
+
+#if HAVE(NEON_KERNEL)
+
+// The NEON kernels deinterleave eight pixels into channel vectors, so the
+// red/blue swap is free and only the color channels need arithmetic.
+
+inline bool allEqualNEON(uint8x8_t mask)
+{
+    return vget_lane_u64(vreinterpret_u64_u8(mask), 0) == UINT64_MAX;
+}
+
+inline uint8x8_t unpremultiplyNEON(uint8x8_t channel, uint16x8_t alpha, uint16x8_t reciprocal)
+{
+    uint16x8_t n = vmull_u8(channel, vdup_n_u8(255));
+    uint16x8_t q = vcombine_u16(
+        vshrn_n_u32(vmull_u16(vget_low_u16(n), vget_low_u16(reciprocal)), 16),
+        vshrn_n_u32(vmull_u16(vget_high_u16(n), vget_high_u16(reciprocal)), 16));
+    uint16x8_t r = vmlsq_u16(n, q, alpha);
+    uint16x8_t carry = vcgeq_u16(r, alpha);
+    q = vsubq_u16(q, carry);
+    r = vsubq_u16(r, vandq_u16(carry, alpha));
+    q = vsubq_u16(q, vcgeq_u16(r, alpha));
+    return vmovn_u16(q);
+}
+
+inline uint8x8_t premultiplyNEON(uint8x8_t channel, uint8x8_t alpha)
+{
+    uint16x8_t n = vmlal_u8(vdupq_n_u16(254), channel, alpha);
+    n = vaddq_u16(vaddq_u16(n, vdupq_n_u16(1)), vshrq_n_u16(n, 8));
+    return vshrn_n_u16(n, 8);
+}
+
+void convertBGRAToRGBANEON(const uint8_t* source, uint8_t* destination, unsigned pixelCount, bool unpremultiply)
+{
+    unsigned i = 0;
+    for (; i + 8 <= pixelCount; i += 8, source += 32, destination += 32) {
+        uint8x8x4_t bgra = vld4_u8(source);
+        uint8x8_t alpha = bgra.val[3];
+        uint8x8_t transparent = vceq_u8(alpha, vdup_n_u8(0));
+        uint8x8x4_t rgba;
+        if (unpremultiply && !allEqualNEON(vorr_u8(transparent, vceq_u8(alpha, vdup_n_u8(255))))) {
+            uint16_t reciprocal[8];
+            for (unsigned k = 0; k < 8; ++k)
+                reciprocal[k] = static_cast<uint16_t>(reciprocals.value[source[4 * k + 3]]);
+            uint16x8_t reciprocal16 = vld1q_u16(reciprocal);
+            uint16x8_t alpha16 = vmovl_u8(alpha);
+            rgba.val[0] = vbsl_u8(transparent, bgra.val[2], unpremultiplyNEON(bgra.val[2], alpha16, reciprocal16));
+            rgba.val[1] = vbsl_u8(transparent, bgra.val[1], unpremultiplyNEON(bgra.val[1], alpha16, reciprocal16));
+            rgba.val[2] = vbsl_u8(transparent, bgra.val[0], unpremultiplyNEON(bgra.val[0], alpha16, reciprocal16));
+        } else {
+            rgba.val[0] = bgra.val[2];
+            rgba.val[1] = bgra.val[1];
+            rgba.val[2] = bgra.val[0];
+        }
+        rgba.val[3] = alpha;
+        vst4_u8(destination, rgba);
+    }
+    convertBGRAToRGBAScalar(source, destination, pixelCount - i, unpremultiply);
+}
+
+void convertRGBAToBGRANEON(const uint8_t* source, uint8_t* destination, unsigned pixelCount, bool premultiply)
+{
+    unsigned i = 0;
+    for (; i + 8 <= pixelCount; i += 8, source += 32, destination += 32) {
+        uint8x8x4_t rgba = vld4_u8(source);
+        uint8x8_t alpha = rgba.val[3];
+        uint8x8x4_t bgra;
+        if (premultiply && !allEqualNEON(vceq_u8(alpha, vdup_n_u8(255)))) {
+            bgra.val[0] = premultiplyNEON(rgba.val[2], alpha);
+            bgra.val[1] = premultiplyNEON(rgba.val[1], alpha);
+            bgra.val[2] = premultiplyNEON(rgba.val[0], alpha);
+        } else {
+            bgra.val[0] = rgba.val[2];
+            bgra.val[1] = rgba.val[1];
+            bgra.val[2] = rgba.val[0];
+        }
+        bgra.val[3] = alpha;
+        vst4_u8(destination, bgra);
+    }
+    convertRGBAToBGRAScalar(source, destination, pixelCount - i, premultiply);
+}
+
+#endif // HAVE(NEON_KERNEL)
+
+} // namespace
+
+bool isPixelConversionKernelSupported(PixelConversionKernel kernel)
+{
+    switch (kernel) {
+    case PixelConversionKernel::Scalar:
+        return true;
+    case PixelConversionKernel::SSE2:
+#if CPU(X86_SSE2)
+        return true;
+#else
+        return false;
+#endif
+    case PixelConversionKernel::AVX2:
+#if HAVE(AVX2_KERNEL)
+        {
+            static const bool supported = cpuSupportsAVX2();
+            return supported;
+        }
+#else
+        return false;
+#endif
+    case PixelConversionKernel::NEON:
+#if HAVE(NEON_KERNEL)
+        return true;
+#else
+        return false;
+#endif
+    }
+    return false;
+}
+
+PixelConversionKernel bestPixelConversionKernel()
+{
+    static const PixelConversionKernel best = [] {
+        const PixelConversionKernel preferred[] = { PixelConversionKernel::AVX2, PixelConversionKernel::SSE2, PixelConversionKernel::NEON };
+        for (auto kernel : preferred) {
+            if (isPixelConversionKernelSupported(kernel))
+                return kernel;
+        }
+        return PixelConversionKernel::Scalar;
+    }();
+    return best;
+}
+
+const char* pixelConversionKernelName(PixelConversionKernel kernel)
+{
+    switch (kernel) {
+    case PixelConversionKernel::Scalar:
+        return "scalar";
+    case PixelConversionKernel::SSE2:
+        return "sse2";
+    case PixelConversionKernel::AVX2:
+        return "avx2";
+    case PixelConversionKernel::NEON:
+        return "neon";
+    }
+    return "unknown";
+}
+
+void convertBGRAToRGBA(PixelConversionKernel kernel, const uint8_t* source, uint8_t* destination, unsigned pixelCount, bool unpremultiply)
+{
+    ASSERT(isPixelConversionKernelSupported(kernel));
+    switch (kernel) {
+#if HAVE(AVX2_KERNEL)
+    case PixelConversionKernel::AVX2:
+        convertBGRAToRGBAAVX2(source, destination, pixelCount, unpremultiply);
+        return;
+#endif
+#if CPU(X86_SSE2)
+    case PixelConversionKernel::SSE2:
+        convertBGRAToRGBASSE2(source, destination, pixelCount, unpremultiply);
+        return;
+#endif
+#if HAVE(NEON_KERNEL)
+    case PixelConversionKernel::NEON:
+        convertBGRAToRGBANEON(source, destination, pixelCount, unpremultiply);
+        return;
+#endif
+    default:
+        convertBGRAToRGBAScalar(source, destination, pixelCount, unpremultiply);
+    }
+}
+
+void convertRGBAToBGRA(PixelConversionKernel kernel, const uint8_t* source, uint8_t* destination, unsigned pixelCount, bool premultiply)
+{
+    ASSERT(isPixelConversionKernelSupported(kernel));
+    switch (kernel) {
+#if HAVE(AVX2_KERNEL)
+    case PixelConversionKernel::AVX2:
+        convertRGBAToBGRAAVX2(source, destination, pixelCount, premultiply);
+        return;
+#endif
+#if CPU(X86_SSE2)
+    case PixelConversionKernel::SSE2:
+        convertRGBAToBGRASSE2(source, destination, pixelCount, premultiply);
+        return;
+#endif
+#if HAVE(NEON_KERNEL)
+    case PixelConversionKernel::NEON:
+        convertRGBAToBGRANEON(source, destination, pixelCount, premultiply);
+        return;
+#endif
+    default:
+        convertRGBAToBGRAScalar(source, destination, pixelCount, premultiply);
+    }
+}
+
+} // namespace WebCore
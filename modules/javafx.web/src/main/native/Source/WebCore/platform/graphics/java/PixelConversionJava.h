@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+namespace WebCore {
+
+/*
+ * Row converters between the premultiplied BGRA layout of ImageBufferData
+ * and the RGBA layout of canvas ImageData.
+ *
+ * Every kernel produces bit-identical output:
+ *  - un-premultiplying computes (c * 255) / a truncated to 8 bits, pixels
+ *    with alpha 0 are copied unchanged;
+ *  - premultiplying computes (c * a + 254) / 255.
+ * The division is done with a table of 16-bit reciprocals and an exact
+ * remainder correction, which is what lets the SIMD kernels match the
+ * scalar one.
+ */
+enum class PixelConversionKernel {
+    Scalar,
+    SSE2,
+    AVX2,
+    NEON
+};
+
+// The fastest kernel supported by the running CPU, detected once.
+PixelConversionKernel bestPixelConversionKernel();
+bool isPixelConversionKernelSupported(PixelConversionKernel);
+const char* pixelConversionKernelName(PixelConversionKernel);
+
+void convertBGRAToRGBA(PixelConversionKernel, const uint8_t* source, uint8_t* destination, unsigned pixelCount, bool unpremultiply);
+void convertRGBAToBGRA(PixelConversionKernel, const uint8_t* source, uint8_t* destination, unsigned pixelCount, bool premultiply);
+
+inline void convertBGRAToRGBA(const uint8_t* source, uint8_t* destination, unsigned pixelCount, bool unpremultiply)
+{
+    convertBGRAToRGBA(bestPixelConversionKernel(), source, destination, pixelCount, unpremultiply);
+}
+
+inline void convertRGBAToBGRA(const uint8_t* source, uint8_t* destination, unsigned pixelCount, bool premultiply)
+{
+    convertRGBAToBGRA(bestPixelConversionKernel(), source, destination, pixelCount, premultiply);
+}
+
+} // namespace WebCore
@@ -25,6 +25,7 @@
 
 #pragma once
 
+#include "AffineTransform.h"
 #include "GraphicsContext.h"
 #include "Path.h"
 #include "RenderingQueue.h"
@@ -34,8 +35,6 @@
 
 namespace WebCore {
 
-    RefPtr<RQRef> copyPath(RefPtr<RQRef> p);
-
     class PlatformContextJava {
         WTF_MAKE_NONCOPYABLE(PlatformContextJava);
     public:
@@ -69,14 +68,7 @@ namespace WebCore {
         }
 
         void addPath(PlatformPathPtr pPath) {
-            JNIEnv* env = WTF::GetJavaEnv();
-
-            static jmethodID mid = env->GetMethodID(PG_GetPathClass(env),
-                "addPath", "(Lcom/sun/webkit/graphics/WCPath;)V");
-            ASSERT(mid);
-
-            env->CallVoidMethod((jobject)*m_path.platformPath(), mid, (jobject)*pPath);
-            WTF::CheckAndClearException(env);
+            m_path.platformPath()->addPath(*pPath, AffineTransform());
         }
 
         PlatformPathPtr platformPath() {
@@ -0,0 +1,475 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#include "config.h"
+
+#include "PlatformPathJava.h"
+#include "AffineTransform.h"
+
+#include <wtf/MathExtras.h>
+
+#include "com_sun_webkit_graphics_WCPathIterator.h"
+
+namespace WebCore {
+
+static_assert(PlatformPathJava::MoveTo == com_sun_webkit_graphics_WCPathIterator_SEG_MOVETO, "verb mismatch");
+static_assert(PlatformPathJava::LineTo == com_sun_webkit_graphics_WCPathIterator_SEG_LINETO, "verb mismatch");
+static_assert(PlatformPathJava::QuadTo == com_sun_webkit_graphics_WCPathIterator_SEG_QUADTO, "verb mismatch");
+static_assert(PlatformPathJava::CubicTo == com_sun_webkit_graphics_WCPathIterator_SEG_CUBICTO, "verb mismatch");
+static_assert(PlatformPathJava::Close == com_sun_webkit_graphics_WCPathIterator_SEG_CLOSE, "verb mismatch");
+
+void PlatformPathJava::ensureSubpath(const FloatPoint& p)
+{
+    if (!m_hasCurrentPoint)
+        moveTo(p);
+}
+
+void PlatformPathJava::moveTo(const FloatPoint& p)
+{
+    // Consecutive moveTo's collapse into the last one.
+    if (!m_verbs.isEmpty() && m_verbs.last() == MoveTo)
+        m_points.last() = p;
+    else {
+        m_verbs.append(MoveTo);
+        m_points.append(p);
+    }
+    m_currentPoint = m_subpathStart = p;
+    m_hasCurrentPoint = true;
+}
+
+void PlatformPathJava::lineTo(const FloatPoint& p)
+{
+    ensureSubpath(p);
+    m_verbs.append(LineTo);
+    m_points.append(p);
+    m_currentPoint = p;
+}
+
+void PlatformPathJava::quadTo(const FloatPoint& cp, const FloatPoint& p)
+{
+    ensureSubpath(cp);
+    m_verbs.append(QuadTo);
+    m_points.append(cp);
+    m_points.append(p);
+    m_currentPoint = p;
+}
+
+void PlatformPathJava::cubicTo(const FloatPoint& cp1, const FloatPoint& cp2, const FloatPoint& p)
+{
+    ensureSubpath(cp1);
+    m_verbs.append(CubicTo);
+    m_points.append(cp1);
+    m_points.append(cp2);
+    m_points.append(p);
+    m_currentPoint = p;
+}
+
+void PlatformPathJava::close()
+{
+    if (m_verbs.isEmpty() || m_verbs.last() == Close)
+        return;
+    m_verbs.append(Close);
+    m_currentPoint = m_subpathStart;
+}
+
+void PlatformPathJava::arc(const FloatPoint& center, float radiusX, float radiusY, float rotation,
+    float startAngle, float sweepAngle, bool connect)
+{
+    if (!std::isfinite(startAngle) || !std::isfinite(sweepAngle)
+        || !std::isfinite(radiusX) || !std::isfinite(radiusY))
+        return;
+
+    const double cosR = cos(rotation);
+    const double sinR = sin(rotation);
+    auto map = [&] (double x, double y) {
+        x *= radiusX;
+        y *= radiusY;
+        return FloatPoint(center.x() + x * cosR - y * sinR, center.y() + x * sinR + y * cosR);
+    };
+
+    double sweep = clampTo<double>(sweepAngle, -2 * piDouble, 2 * piDouble);
+    double angle = startAngle;
+    FloatPoint start = map(cos(angle), sin(angle));
+
+    if (connect && m_hasCurrentPoint) {
+        if (m_verbs.last() == Close || m_currentPoint != start)
+            lineTo(start);
+    } else
+        moveTo(start);
+
+    // Split the arc into segments of at most 90 degrees, each approximated
+    // by a cubic bezier with control distance 4/3 * tan(segment / 4).
+    int segments = static_cast<int>(ceil(fabs(sweep) / piOverTwoDouble));
+    if (!segments)
+        return;
+    const double increment = sweep / segments;
+    const double k = 4.0 / 3.0 * tan(increment / 4);
+    if (!k)
+        return;
+
+    double x0 = cos(angle);
+    double y0 = sin(angle);
+    for (int i = 0; i < segments; ++i) {
+        angle += increment;
+        double x1 = cos(angle);
+        double y1 = sin(angle);
+        cubicTo(map(x0 - k * y0, y0 + k * x0),
+            map(x1 + k * y1, y1 - k * x1),
+            map(x1, y1));
+        x0 = x1;
+        y0 = y1;
+    }
+}
+
+void PlatformPathJava::arcTo(const FloatPoint& p1, const FloatPoint& p2, float radius)
+{
+    if (!m_hasCurrentPoint) {
+        moveTo(p1);
+        return;
+    }
+
+    const FloatPoint p0 = m_currentPoint;
+    const double v1x = p0.x() - p1.x();
+    const double v1y = p0.y() - p1.y();
+    const double v2x = p2.x() - p1.x();
+    const double v2y = p2.y() - p1.y();
+    const double l1 = sqrt(v1x * v1x + v1y * v1y);
+    const double l2 = sqrt(v2x * v2x + v2y * v2y);
+    const double cross = v1x * v2y - v1y * v2x;
+
+    // Degenerate cases (coincident or collinear points, zero radius)
+    // reduce to a straight line to p1.
+    if (radius <= 0 || !l1 || !l2 || fabs(cross) <= std::numeric_limits<float>::epsilon() * l1 * l2) {
+        lineTo(p1);
+        return;
+    }
+
+    const double cosTheta = clampTo<double>((v1x * v2x + v1y * v2y) / (l1 * l2), -1, 1);
+    const double halfTheta = acos(cosTheta) / 2;
+    const double tangentDistance = radius / tan(halfTheta);
+    const double centerDistance = radius / sin(halfTheta);
+
+    double bx = v1x / l1 + v2x / l2;
+    double by = v1y / l1 + v2y / l2;
+    const double bl = sqrt(bx * bx + by * by);
+    bx /= bl;
+    by /= bl;
+
+    const FloatPoint center(p1.x() + bx * centerDistance, p1.y() + by * centerDistance);
+    const double t1x = p1.x() + v1x / l1 * tangentDistance;
+    const double t1y = p1.y() + v1y / l1 * tangentDistance;
+    const double t2x = p1.x() + v2x / l2 * tangentDistance;
+    const double t2y = p1.y() + v2y / l2 * tangentDistance;
+
+    const double startAngle = atan2(t1y - center.y(), t1x - center.x());
+    double sweep = atan2(t2y - center.y(), t2x - center.x()) - startAngle;
+    if (sweep > piDouble)
+        sweep -= 2 * piDouble;
+    else if (sweep < -piDouble)
+        sweep += 2 * piDouble;
+
+    arc(center, radius, radius, 0, startAngle, sweep, true);
+}
+
+void PlatformPathJava::addRect(const FloatRect& r)
+{
+    moveTo(r.location());
+    lineTo(FloatPoint(r.maxX(), r.y()));
+    lineTo(FloatPoint(r.maxX(), r.maxY()));
+    lineTo(FloatPoint(r.x(), r.maxY()));
+    close();
+}
+
+void PlatformPathJava::addEllipse(const FloatRect& r)
+{
+    // Starts at 3 o'clock and goes clockwise, like Ellipse2D does.
+    arc(r.center(), r.width() / 2, r.height() / 2, 0, 0, 2 * piFloat, false);
+    close();
+}
+
+void PlatformPathJava::addPath(const PlatformPathJava& other, const AffineTransform& at)
+{
+    if (&other == this) {
+        addPath(PlatformPathJava(other), at);
+        return;
+    }
+
+    size_t p = 0;
+    for (uint8_t verb : other.m_verbs) {
+        const FloatPoint* pts = other.m_points.data() + p;
+        switch (verb) {
+        case MoveTo:
+            moveTo(at.mapPoint(pts[0]));
+            break;
+        case LineTo:
+            lineTo(at.mapPoint(pts[0]));
+            break;
+        case QuadTo:
+            quadTo(at.mapPoint(pts[0]), at.mapPoint(pts[1]));
+            break;
+        case CubicTo:
+            cubicTo(at.mapPoint(pts[0]), at.mapPoint(pts[1]), at.mapPoint(pts[2]));
+            break;
+        case Close:
+            close();
+            break;
+        }
+        p += pointCount(Verb(verb));
+    }
+}
+
+void PlatformPathJava::clear()
+{
+    m_verbs.clear();
+    m_points.clear();
+    m_currentPoint = m_subpathStart = FloatPoint();
+    m_hasCurrentPoint = false;
+}
+
+void PlatformPathJava::transform(const AffineTransform& at)
+{
+    for (auto& p : m_points)
+        p = at.mapPoint(p);
+    m_currentPoint = at.mapPoint(m_currentPoint);
+    m_subpathStart = at.mapPoint(m_subpathStart);
+}
+
+void PlatformPathJava::translate(float dx, float dy)
+{
+    const FloatSize delta(dx, dy);
+    for (auto& p : m_points)
+        p.move(delta);
+    m_currentPoint.move(delta);
+    m_subpathStart.move(delta);
+}
+
+bool PlatformPathJava::isEmpty() const
+{
+    for (uint8_t verb : m_verbs) {
+        if (verb == LineTo || verb == QuadTo || verb == CubicTo)
+            return false;
+    }
+    return true;
+}
+
+// Crossing counting follows com.sun.javafx.geom.Curve: the number of times
+// a ray cast from (px, py) towards +x crosses the segment, signed by the
+// direction of the segment in y.
+static int pointCrossingsForLine(double px, double py, double x0, double y0, double x1, double y1)
+{
+    if (py < y0 && py < y1)
+        return 0;
+    if (py >= y0 && py >= y1)
+        return 0;
+    if (px >= x0 && px >= x1)
+        return 0;
+    if (px < x0 && px < x1)
+        return y0 < y1 ? 1 : -1;
+    const double xIntercept = x0 + (py - y0) * (x1 - x0) / (y1 - y0);
+    if (px >= xIntercept)
+        return 0;
+    return y0 < y1 ? 1 : -1;
+}
+
+static int pointCrossingsForCubic(double px, double py,
+    double x0, double y0, double xc0, double yc0,
+    double xc1, double yc1, double x1, double y1, int level)
+{
+    if (py < y0 && py < yc0 && py < yc1 && py < y1)
+        return 0;
+    if (py >= y0 && py >= yc0 && py >= yc1 && py >= y1)
+        return 0;
+    if (px >= x0 && px >= xc0 && px >= xc1 && px >= x1)
+        return 0;
+    if (px < x0 && px < xc0 && px < xc1 && px < x1) {
+        if (py >= y0) {
+            if (py < y1)
+                return 1;
+        } else if (py >= y1)
+            return -1;
+        return 0;
+    }
+    // A double has 52 bits of mantissa, further subdivision is pointless.
+    if (level > 52)
+        return pointCrossingsForLine(px, py, x0, y0, x1, y1);
+
+    double xmid = (xc0 + xc1) / 2;
+    double ymid = (yc0 + yc1) / 2;
+    xc0 = (x0 + xc0) / 2;
+    yc0 = (y0 + yc0) / 2;
+    xc1 = (xc1 + x1) / 2;
+    yc1 = (yc1 + y1) / 2;
+    const double xc0m = (xc0 + xmid) / 2;
+    const double yc0m = (yc0 + ymid) / 2;
+    const double xmc1 = (xmid + xc1) / 2;
+    const double ymc1 = (ymid + yc1) / 2;
+    xmid = (xc0m + xmc1) / 2;
+    ymid = (yc0m + ymc1) / 2;
+    if (std::isnan(xmid) || std::isnan(ymid))
+        return 0;
+    return pointCrossingsForCubic(px, py, x0, y0, xc0, yc0, xc0m, yc0m, xmid, ymid, level + 1)
+        + pointCrossingsForCubic(px, py, xmid, ymid, xmc1, ymc1, xc1, yc1, x1, y1, level + 1);
+}
+
+bool PlatformPathJava::contains(const FloatPoint& point, WindRule rule) const
+{
+    const double px = point.x();
+    const double py = point.y();
+    if (m_verbs.isEmpty() || !std::isfinite(px) || !std::isfinite(py))
+        return false;
+
+    int crossings = 0;
+    double movx = 0, movy = 0, curx = 0, cury = 0;
+    size_t p = 0;
+    for (uint8_t verb : m_verbs) {
+        const FloatPoint* pts = m_points.data() + p;
+        switch (verb) {
+        case MoveTo:
+            if (cury != movy)
+                crossings += pointCrossingsForLine(px, py, curx, cury, movx, movy);
+            movx = curx = pts[0].x();
+            movy = cury = pts[0].y();
+            break;
+        case LineTo:
+            crossings += pointCrossingsForLine(px, py, curx, cury, pts[0].x(), pts[0].y());
+            curx = pts[0].x();
+            cury = pts[0].y();
+            break;
+        case QuadTo:
+            // Degree elevation: a quadratic is an exact cubic.
+            crossings += pointCrossingsForCubic(px, py, curx, cury,
+                curx + 2 * (pts[0].x() - curx) / 3, cury + 2 * (pts[0].y() - cury) / 3,
+                pts[1].x() + 2 * (pts[0].x() - pts[1].x()) / 3, pts[1].y() + 2 * (pts[0].y() - pts[1].y()) / 3,
+                pts[1].x(), pts[1].y(), 0);
+            curx = pts[1].x();
+            cury = pts[1].y();
+            break;
+        case CubicTo:
+            crossings += pointCrossingsForCubic(px, py, curx, cury,
+                pts[0].x(), pts[0].y(), pts[1].x(), pts[1].y(), pts[2].x(), pts[2].y(), 0);
+            curx = pts[2].x();
+            cury = pts[2].y();
+            break;
+        case Close:
+            if (cury != movy)
+                crossings += pointCrossingsForLine(px, py, curx, cury, movx, movy);
+            curx = movx;
+            cury = movy;
+            break;
+        }
+        p += pointCount(Verb(verb));
+    }
+    if (cury != movy)
+        crossings += pointCrossingsForLine(px, py, curx, cury, movx, movy);
+
+    return rule == WindRule::EvenOdd ? (crossings & 1) : crossings != 0;
+}
+
+// Adds to the bounds the extrema of a cubic bezier along one axis, found at
+// the roots of its derivative in (0, 1).
+template<typename Extend>
+static void cubicExtrema(double p0, double p1, double p2, double p3, const Extend& extend)
+{
+    const double a = p3 - 3 * p2 + 3 * p1 - p0;
+    const double b = 2 * (p2 - 2 * p1 + p0);
+    const double c = p1 - p0;
+
+    auto evaluate = [&] (double t) {
+        if (t > 0 && t < 1) {
+            const double mt = 1 - t;
+            extend(mt * mt * mt * p0 + 3 * mt * mt * t * p1 + 3 * mt * t * t * p2 + t * t * t * p3);
+        }
+    };
+
+    if (fabs(a) < 1e-12) {
+        if (fabs(b) > 1e-12)
+            evaluate(-c / b);
+        return;
+    }
+    const double discriminant = b * b - 4 * a * c;
+    if (discriminant < 0)
+        return;
+    const double root = sqrt(discriminant);
+    evaluate((-b + root) / (2 * a));
+    evaluate((-b - root) / (2 * a));
+}
+
+FloatRect PlatformPathJava::boundingRect() const
+{
+    if (m_points.isEmpty())
+        return FloatRect();
+
+    double minX = m_points[0].x(), maxX = minX;
+    double minY = m_points[0].y(), maxY = minY;
+    auto extendX = [&] (double x) {
+        minX = std::min(minX, x);
+        maxX = std::max(maxX, x);
+    };
+    auto extendY = [&] (double y) {
+        minY = std::min(minY, y);
+        maxY = std::max(maxY, y);
+    };
+
+    FloatPoint current;
+    FloatPoint subpathStart;
+    size_t p = 0;
+    for (uint8_t verb : m_verbs) {
+        const FloatPoint* pts = m_points.data() + p;
+        switch (verb) {
+        case MoveTo:
+            current = subpathStart = pts[0];
+            break;
+        case LineTo:
+            current = pts[0];
+            break;
+        case QuadTo:
+            // Elevated to a cubic, the same extrema search applies.
+            cubicExtrema(current.x(), current.x() + 2 * (pts[0].x() - current.x()) / 3,
+                pts[1].x() + 2 * (pts[0].x() - pts[1].x()) / 3, pts[1].x(), extendX);
+            cubicExtrema(current.y(), current.y() + 2 * (pts[0].y() - current.y()) / 3,
+                pts[1].y() + 2 * (pts[0].y() - pts[1].y()) / 3, pts[1].y(), extendY);
+            current = pts[1];
+            break;
+        case CubicTo:
+            cubicExtrema(current.x(), pts[0].x(), pts[1].x(), pts[2].x(), extendX);
+            cubicExtrema(current.y(), pts[0].y(), pts[1].y(), pts[2].y(), extendY);
+            current = pts[2];
+            break;
+        case Close:
+            current = subpathStart;
+            break;
+        }
+        if (verb != Close) {
+            // End points always lie on the path.
+            extendX(current.x());
+            extendY(current.y());
+        }
+        p += pointCount(Verb(verb));
+    }
+
+    return FloatRect(minX, minY, maxX - minX, maxY - minY);
+}
+
+} // namespace WebCore
@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#pragma once
+
+#include "FloatPoint.h"
+#include "FloatRect.h"
+#include "WindRule.h"
+
+#include <jni.h>
+#include <wtf/RefCounted.h>
+#include <wtf/Ref.h>
+#include <wtf/Vector.h>
+
+namespace WebCore {
+
+class AffineTransform;
+
+/*
+ * Native storage for WebCore::Path in the Java port.
+ *
+ * A path is kept as a compact array of verbs and a parallel array of points,
+ * so building, hit-testing and measuring a path never leaves the native side.
+ * The Java peer (WCPath) is only materialized when the path is actually
+ * rendered: the path is then encoded into the RenderingQueue next to the
+ * FILL_PATH / STROKE_PATH / CLIP_PATH operation and rebuilt on the Java side
+ * by WCPath.addPathData().
+ *
+ * The encoded form is
+ *     jint verbCount
+ *     verbCount x { jint verb, jfloat coords[2 * pointCount(verb)] }
+ * where verb values are the WCPathIterator.SEG_* constants.
+ */
+class PlatformPathJava : public RefCounted<PlatformPathJava> {
+public:
+    enum Verb : uint8_t {
+        MoveTo,
+        LineTo,
+        QuadTo,
+        CubicTo,
+        Close
+    };
+
+    static Ref<PlatformPathJava> create()
+    {
+        return adoptRef(*new PlatformPathJava());
+    }
+
+    static Ref<PlatformPathJava> create(const PlatformPathJava& other)
+    {
+        return adoptRef(*new PlatformPathJava(other));
+    }
+
+    static unsigned pointCount(Verb verb)
+    {
+        static const unsigned counts[] = { 1, 1, 2, 3, 0 };
+        return counts[verb];
+    }
+
+    const Vector<uint8_t>& verbs() const { return m_verbs; }
+    const Vector<FloatPoint>& points() const { return m_points; }
+
+    void moveTo(const FloatPoint&);
+    void lineTo(const FloatPoint&);
+    void quadTo(const FloatPoint& controlPoint, const FloatPoint& endPoint);
+    void cubicTo(const FloatPoint& controlPoint1, const FloatPoint& controlPoint2, const FloatPoint& endPoint);
+    void close();
+
+    // Appends a circular or elliptical arc. The angles are in radians and
+    // sweep clockwise in the (y-down) user space when sweepAngle > 0.
+    // If connect is true and the path has a current point, the arc is
+    // joined to it with a line, otherwise it starts a new subpath.
+    void arc(const FloatPoint& center, float radiusX, float radiusY, float rotation,
+        float startAngle, float sweepAngle, bool connect);
+    void arcTo(const FloatPoint& p1, const FloatPoint& p2, float radius);
+    void addRect(const FloatRect&);
+    void addEllipse(const FloatRect&);
+    void addPath(const PlatformPathJava&, const AffineTransform&);
+
+    void clear();
+    void transform(const AffineTransform&);
+    void translate(float dx, float dy);
+
+    bool isEmpty() const;
+    bool hasCurrentPoint() const { return m_hasCurrentPoint; }
+    FloatPoint currentPoint() const { return m_currentPoint; }
+
+    bool contains(const FloatPoint&, WindRule) const;
+    FloatRect boundingRect() const;
+
+    // Size in bytes of the encoded form written by encode().
+    int encodedSize() const
+    {
+        return int(sizeof(jint) * (1 + m_verbs.size() + 2 * m_points.size()));
+    }
+
+    // Writes the encoded form to any sink accepting jint and jfloat values
+    // through operator<< (e.g. a RenderingQueue).
+    template<typename Encoder> void encode(Encoder& encoder) const
+    {
+        encoder << jint(m_verbs.size());
+        size_t p = 0;
+        for (uint8_t verb : m_verbs) {
+            encoder << jint(verb);
+            for (unsigned i = 0; i < pointCount(Verb(verb)); ++i, ++p) {
+                encoder << jfloat(m_points[p].x()) << jfloat(m_points[p].y());
+            }
+        }
+    }
+
+private:
+    PlatformPathJava() = default;
+    PlatformPathJava(const PlatformPathJava&) = default;
+
+    void ensureSubpath(const FloatPoint&);
+
+    Vector<uint8_t> m_verbs;
+    Vector<FloatPoint> m_points;
+    FloatPoint m_currentPoint;
+    // Start of the current subpath, where closeSubpath() returns to.
+    FloatPoint m_subpathStart;
+    bool m_hasCurrentPoint { false };
+};
+
+} // namespace WebCore
@@ -45,6 +45,44 @@ static Addr2ByteBuffer& getAddr2ByteBuffer()
     return container.get();
 }
 
+void ByteBuffer::release()
+{
+    m_refList.clear();
+    m_position = 0;
+    if (m_pool) {
+        RefPtr<ByteBufferPool> pool = WTFMove(m_pool);
+        pool->recycle(this);
+    }
+}
+
+RefPtr<ByteBuffer> ByteBufferPool::acquire(int size)
+{
+    if (size > m_bufferCapacity) {
+        // Oversized buffers are rare (e.g. huge paths), don't keep them.
+        return ByteBuffer::create(size);
+    }
+    if (!m_freeBuffers.isEmpty()) {
+        return m_freeBuffers.takeLast();
+    }
+    return ByteBuffer::create(m_bufferCapacity, this);
+}
+
+void ByteBufferPool::recycle(RefPtr<ByteBuffer> buffer)
+{
+    if (!m_valid || m_freeBuffers.size() >= m_maxBufferCount) {
+        return;
+    }
+    // Buffers in the ring keep the pool alive, invalidate() breaks the cycle.
+    buffer->m_pool = this;
+    m_freeBuffers.append(WTFMove(buffer));
+}
+
+void ByteBufferPool::invalidate()
+{
+    m_valid = false;
+    m_freeBuffers.clear();
+}
+
 /*static*/
 RefPtr<RenderingQueue> RenderingQueue::create(
     const JLObject &jRQ,
@@ -65,7 +103,7 @@ RenderingQueue& RenderingQueue::freeSpace(int size) {
         }
     }
     if (!m_buffer) {
-        m_buffer = RefPtr<ByteBuffer>(ByteBuffer::create(std::max(m_capacity, size)));
+        m_buffer = m_pool->acquire(std::max(m_capacity, size));
     }
     return *this;
 }
@@ -106,7 +144,7 @@ RenderingQueue& RenderingQueue::flushBuffer() {
     JNIEnv* env = WTF::GetJavaEnv();
 
     static jmethodID midFwkAddBuffer = env->GetMethodID(PG_GetRenderQueueClass(env),
-        "fwkAddBuffer", "(Ljava/nio/ByteBuffer;)V");
+        "fwkAddBuffer", "(Ljava/nio/ByteBuffer;I)V");
     ASSERT(midFwkAddBuffer);
 
     Addr2ByteBuffer &a2bb = getAddr2ByteBuffer();
@@ -114,7 +152,8 @@ RenderingQueue& RenderingQueue::flushBuffer() {
     env->CallVoidMethod(
         getWCRenderingQueue(),
         midFwkAddBuffer,
-        (jobject)(m_buffer->createDirectByteBuffer(env)));
+        (jobject)(m_buffer->getDirectByteBuffer(env)),
+        (jint)m_buffer->position());
     WTF::CheckAndClearException(env);
 
     m_buffer = nullptr;
@@ -131,7 +170,7 @@ JNIEXPORT void JNICALL Java_com_sun_webkit_graphics_WCRenderQueue_twkRelease
     /*
      * This method should be called on the Event thread to synchronize with JavaScript
      * by thread. JavaScript may access resources kept in ByteBuffer::m_refList,
-     * so when a resource is dereferenced (as a result of ByteBuffer destruction)
+     * so when a resource is dereferenced (as a result of ByteBuffer release)
      * it should be thread safe.
      */
     Addr2ByteBuffer& a2bb = getAddr2ByteBuffer();
@@ -139,7 +178,10 @@ JNIEXPORT void JNICALL Java_com_sun_webkit_graphics_WCRenderQueue_twkRelease
         char *key = (char *)env->GetDirectBufferAddress(
             JLObject(env->GetObjectArrayElement(bufs, i)));
         if (key != 0) {
-            a2bb.remove(key);
+            RefPtr<ByteBuffer> buffer = a2bb.take(key);
+            if (buffer) {
+                buffer->release();
+            }
         }
     }
 }
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2011, 2017, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2011, 2019, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -31,24 +31,30 @@
 #include <wtf/HashSet.h>
 #include <wtf/java/DbgUtils.h>
 
+#include "PlatformPathJava.h"
 #include "RQRef.h"
 
 namespace WebCore {
 
 class RQRef;
+class ByteBufferPool;
 
 class ByteBuffer : public RefCounted<ByteBuffer> {
     RQ_LOG_INSTANCE_COUNT(ByteBuffer)
+    friend class ByteBufferPool;
 public:
-    static RefPtr<ByteBuffer> create(int capacity) {
-        return adoptRef(new ByteBuffer(capacity));
+    static RefPtr<ByteBuffer> create(int capacity, RefPtr<ByteBufferPool> pool = nullptr) {
+        return adoptRef(new ByteBuffer(capacity, WTFMove(pool)));
     }
 
-    JLObject createDirectByteBuffer(JNIEnv* env) {
+    // The NIO wrapper spans the whole capacity and is created once for
+    // the lifetime of the buffer, the used length is passed along with it.
+    JLObject getDirectByteBuffer(JNIEnv* env) {
         ASSERT(!isEmpty());
-        JLObject ret(env->NewDirectByteBuffer(m_buffer, m_position));
-        m_nio_holder = ret;
-        return ret;
+        if (!m_nio_holder) {
+            m_nio_holder = JLObject(env->NewDirectByteBuffer(m_buffer, m_capacity));
+        }
+        return m_nio_holder;
     }
 
     char* bufferAddress() { return m_buffer; }
@@ -76,15 +82,25 @@ public:
 
     bool isEmpty() { return m_position == 0; }
 
+    int capacity() { return m_capacity; }
+
+    int position() { return m_position; }
+
+    // Called once the Java side is done with the buffer (see twkRelease).
+    // Drops the resources referenced by the decoded content and returns
+    // the buffer to the pool it was taken from, if any.
+    void release();
+
     ~ByteBuffer() {
         delete[] m_buffer;
     }
 
 private:
-    ByteBuffer(int capacity) :
+    ByteBuffer(int capacity, RefPtr<ByteBufferPool> pool) :
         m_buffer(new char[capacity]),
         m_capacity(capacity),
-        m_position(0)
+        m_position(0),
+        m_pool(WTFMove(pool))
     {}
 
     char* m_buffer;
@@ -92,6 +108,38 @@ private:
     int m_position;
     JGObject m_nio_holder;
     Vector< RefPtr<RQRef> > m_refList;
+    RefPtr<ByteBufferPool> m_pool;
+};
+
+/*
+ * A ring of reusable ByteBuffers of the RenderingQueue capacity, so that
+ * a flush does not allocate a new native array and a new DirectByteBuffer.
+ * Buffers return to the ring when Java releases them after decoding.
+ * The pool outlives its RenderingQueue as long as buffers are in flight;
+ * once invalidated, returning buffers are simply destroyed.
+ *
+ * All methods are called on the Event thread.
+ */
+class ByteBufferPool : public RefCounted<ByteBufferPool> {
+public:
+    static RefPtr<ByteBufferPool> create(int bufferCapacity, size_t maxBufferCount) {
+        return adoptRef(new ByteBufferPool(bufferCapacity, maxBufferCount));
+    }
+
+    RefPtr<ByteBuffer> acquire(int size);
+    void recycle(RefPtr<ByteBuffer>);
+    void invalidate();
+
+private:
+    ByteBufferPool(int bufferCapacity, size_t maxBufferCount) :
+        m_bufferCapacity(bufferCapacity),
+        m_maxBufferCount(maxBufferCount)
+    {}
+
+    int m_bufferCapacity;
+    size_t m_maxBufferCount;
+    bool m_valid { true };
+    Vector< RefPtr<ByteBuffer> > m_freeBuffers;
 };
 
 /*
@@ -131,6 +179,12 @@ public:
         return *this;
     }
 
+    // The caller reserves PlatformPathJava::encodedSize() bytes with freeSpace().
+    RenderingQueue& operator << (const PlatformPathJava& path) {
+        path.encode(*this);
+        return *this;
+    }
+
     RenderingQueue& freeSpace(int size);
     RenderingQueue& flushBuffer();
 
@@ -149,6 +203,7 @@ public:
     }
 
     ~RenderingQueue() {
+        m_pool->invalidate();
         disposeGraphics();
     }
 
@@ -157,7 +212,8 @@ private:
         m_rqoRenderingQueue(RQRef::create(jRQ)),
         m_capacity(capacity),
         m_autoFlush(autoFlush),
-        m_buffer(nullptr)
+        m_buffer(nullptr),
+        m_pool(ByteBufferPool::create(capacity, MAX_BUFFER_COUNT))
     {}
 
     void flush();
@@ -170,6 +226,6 @@ private:
     int m_capacity;
     bool m_autoFlush;
     RefPtr<ByteBuffer> m_buffer; // ref to the current ByteBuffer
-
+    RefPtr<ByteBufferPool> m_pool; // recycled ByteBuffers
 };
 } // namespace WebCore
@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+// Compares the canvas getImageData/putImageData pixel converters against the
+// per-pixel division loop they replaced, and checks that every kernel gives
+// the same bytes. From the native source root it builds standalone like so:
+// g++ -o PixelConversionSpeedTest -O3 -DNDEBUG -std=c++17 -ISource/WTF -ISource/WebCore/platform/graphics/java Source/WebCore/platform/graphics/java/benchmarks/PixelConversionSpeedTest.cpp Source/WebCore/platform/graphics/java/PixelConversionJava.cpp
+// (use cl /O2 /DNDEBUG /std:c++17 with the same include paths on Windows).
+//
+// Usage: PixelConversionSpeedTest [<width> <height> [<iterations>]]
+// The default is one 3840x2160 canvas converted 50 times per kernel.
+
+#include "config.h"
+
+#include "PixelConversionJava.h"
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+using namespace WebCore;
+
+namespace {
+
+unsigned width = 3840;
+unsigned height = 2160;
+unsigned iterations = 50;
+
+// The loops ImageBufferJava.cpp used before the kernels were introduced.
+void legacyGetImageData(const uint8_t* source, uint8_t* destination, unsigned pixelCount, bool unpremultiply)
+{
+    const unsigned char* ps = source;
+    unsigned char* pd = destination;
+    for (unsigned x = 0; x < pixelCount; x++) {
+        unsigned char alpha = ps[3];
+        if (unpremultiply && alpha && alpha != 255) {
+            pd[0] = (ps[2] * 255) / alpha;
+            pd[1] = (ps[1] * 255) / alpha;
+            pd[2] = (ps[0] * 255) / alpha;
+            pd[3] = alpha;
+        } else {
+            pd[0] = ps[2];
+            pd[1] = ps[1];
+            pd[2] = ps[0];
+            pd[3] = alpha;
+        }
+        pd += 4;
+        ps += 4;
+    }
+}
+
+void legacyPutImageData(const uint8_t* source, uint8_t* destination, unsigned pixelCount, bool premultiply)
+{
+    const unsigned char* ps = source;
+    unsigned char* pd = destination;
+    for (unsigned x = 0; x < pixelCount; x++) {
+        int alpha = ps[3];
+        if (premultiply && alpha != 255) {
+            pd[0] = static_cast<unsigned char>((ps[2] * alpha + 254) / 255);
+            pd[1] = static_cast<unsigned char>((ps[1] * alpha + 254) / 255);
+            pd[2] = static_cast<unsigned char>((ps[0] * alpha + 254) / 255);
+            pd[3] = static_cast<unsigned char>(alpha);
+        } else {
+            pd[0] = ps[2];
+            pd[1] = ps[1];
+            pd[2] = ps[0];
+            pd[3] = alpha;
+        }
+        pd += 4;
+        ps += 4;
+    }
+}
+
+struct Candidate {
+    const char* name;
+    PixelConversionKernel kernel;
+    bool legacy;
+};
+
+// Premultiplied pixels: a third opaque, a sixth transparent and the rest
+// translucent, roughly what an antialiased chart looks like.
+void fillPremultiplied(std::vector<uint8_t>& pixels)
+{
+    uint32_t seed = 1;
+    for (size_t i = 0; i < pixels.size(); i += 4) {
+        seed = seed * 1103515245 + 12345;
+        unsigned choice = (seed >> 16) % 6;
+        unsigned alpha = choice < 2 ? 255 : (choice == 2 ? 0 : (seed >> 8) & 0xFF);
+        for (unsigned c = 0; c < 3; ++c) {
+            seed = seed * 1103515245 + 12345;
+            pixels[i + c] = static_cast<uint8_t>(alpha ? ((seed >> 16) % (alpha + 1)) : 0);
+        }
+        pixels[i + 3] = static_cast<uint8_t>(alpha);
+    }
+}
+
+double run(const Candidate& candidate, bool toImageData, const std::vector<uint8_t>& source, std::vector<uint8_t>& destination)
+{
+    unsigned rowBytes = 4 * width;
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned i = 0; i < iterations; ++i) {
+        for (unsigned y = 0; y < height; ++y) {
+            const uint8_t* src = source.data() + y * rowBytes;
+            uint8_t* dst = destination.data() + y * rowBytes;
+            if (candidate.legacy)
+                (toImageData ? legacyGetImageData : legacyPutImageData)(src, dst, width, true);
+            else if (toImageData)
+                convertBGRAToRGBA(candidate.kernel, src, dst, width, true);
+            else
+                convertRGBAToBGRA(candidate.kernel, src, dst, width, true);
+        }
+    }
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / iterations;
+}
+
+NO_RETURN void usage()
+{
+    printf("Usage: PixelConversionSpeedTest [<width> <height> [<iterations>]]\n");
+    exit(1);
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv)
+{
+    if (argc != 1 && argc != 3 && argc != 4)
+        usage();
+    if (argc >= 3) {
+        width = atoi(argv[1]);
+        height = atoi(argv[2]);
+    }
+    if (argc == 4)
+        iterations = atoi(argv[3]);
+    if (!width || !height || !iterations)
+        usage();
+
+    std::vector<uint8_t> source(4 * width * height);
+    fillPremultiplied(source);
+    std::vector<uint8_t> expected(source.size());
+    std::vector<uint8_t> actual(source.size());
+
+    const Candidate candidates[] = {
+        { "legacy", PixelConversionKernel::Scalar, true },
+        { "scalar", PixelConversionKernel::Scalar, false },
+        { "sse2", PixelConversionKernel::SSE2, false },
+        { "avx2", PixelConversionKernel::AVX2, false },
+        { "neon", PixelConversionKernel::NEON, false },
+    };
+
+    printf("%ux%u, %u iterations, best kernel: %s\n", width, height, iterations,
+        pixelConversionKernelName(bestPixelConversionKernel()));
+
+    bool failed = false;
+    for (bool toImageData : { true, false }) {
+        printf("%s\n", toImageData ? "getImageData (BGRA -> RGBA, unpremultiply)" : "putImageData (RGBA -> BGRA, premultiply)");
+        double legacyTime = 0;
+        for (auto& candidate : candidates) {
+            if (!candidate.legacy && !isPixelConversionKernelSupported(candidate.kernel))
+                continue;
+            std::vector<uint8_t>& destination = candidate.legacy ? expected : actual;
+            double time = run(candidate, toImageData, source, destination);
+            if (candidate.legacy)
+                legacyTime = time;
+            bool matches = candidate.legacy || !memcmp(expected.data(), actual.data(), actual.size());
+            failed |= !matches;
+            printf("    %-8s %8.3f ms/frame %8.1f Mpixel/s %5.2fx%s\n", candidate.name, time,
+                width * height / time / 1000, legacyTime / time, matches ? "" : "  MISMATCH");
+        }
+    }
+    return failed ? 1 : 0;
+}
@@ -215,13 +215,63 @@ bool ScalableImageDecoder::frameHasAlphaAtIndex(size_t index) const
     return frame.hasAlpha();
 }
 
-unsigned ScalableImageDecoder::frameBytesAtIndex(size_t index, SubsamplingLevel) const
+#if PLATFORM(JAVA)
+static IntSize subsampledSize(const IntSize& size, SubsamplingLevel subsamplingLevel)
+{
+    int shift = static_cast<int>(subsamplingLevel);
+    int mask = (1 << shift) - 1;
+    return IntSize((size.width() + mask) >> shift, (size.height() + mask) >> shift);
+}
+
+IntSize ScalableImageDecoder::frameSizeAtIndex(size_t, SubsamplingLevel subsamplingLevel) const
+{
+    return subsampledSize(size(), subsamplingLevel);
+}
+
+// Averages every 2^subsamplingLevel square of the premultiplied frame into
+// one pixel, so that a large photo drawn at a fraction of its size is handed
+// to Java at roughly the size it is drawn rather than in full.
+static NativeImagePtr subsampledImage(const ImageBackingStore& backingStore, SubsamplingLevel subsamplingLevel)
+{
+    int shift = static_cast<int>(subsamplingLevel);
+    const IntSize& size = backingStore.size();
+    IntSize scaledSize = subsampledSize(size, subsamplingLevel);
+    auto scaledBackingStore = ImageBackingStore::create(scaledSize);
+    if (scaledBackingStore->size().isEmpty())
+        return backingStore.image();
+
+    for (int y = 0; y < scaledSize.height(); ++y) {
+        int top = y << shift;
+        int bottom = std::min(top + (1 << shift), size.height());
+        RGBA32* destination = scaledBackingStore->pixelAt(0, y);
+        for (int x = 0; x < scaledSize.width(); ++x) {
+            int left = x << shift;
+            int width = std::min(left + (1 << shift), size.width()) - left;
+            unsigned r = 0, g = 0, b = 0, a = 0;
+            for (int sourceY = top; sourceY < bottom; ++sourceY) {
+                const RGBA32* source = backingStore.pixelAt(left, sourceY);
+                for (int i = 0; i < width; ++i) {
+                    r += redChannel(source[i]);
+                    g += greenChannel(source[i]);
+                    b += blueChannel(source[i]);
+                    a += alphaChannel(source[i]);
+                }
+            }
+            unsigned count = width * (bottom - top);
+            unsigned half = count / 2;
+            destination[x] = makeRGBA((r + half) / count, (g + half) / count, (b + half) / count, (a + half) / count);
+        }
+    }
+    return scaledBackingStore->image();
+}
+#endif
+
+unsigned ScalableImageDecoder::frameBytesAtIndex(size_t index, SubsamplingLevel subsamplingLevel) const
 {
     LockHolder lockHolder(m_mutex);
     if (m_frameBufferCache.size() <= index)
         return 0;
-    // FIXME: Use the dimension of the requested frame.
-    return (m_size.area() * sizeof(uint32_t)).unsafeGet();
+    return (frameSizeAtIndex(index, subsamplingLevel).area() * sizeof(uint32_t)).unsafeGet();
 }
 
 Seconds ScalableImageDecoder::frameDurationAtIndex(size_t index) const
@@ -247,7 +297,7 @@ Seconds ScalableImageDecoder::frameDurationAtIndex(size_t index) const
     return duration;
 }
 
-NativeImagePtr ScalableImageDecoder::createFrameImageAtIndex(size_t index, SubsamplingLevel, const DecodingOptions&)
+NativeImagePtr ScalableImageDecoder::createFrameImageAtIndex(size_t index, SubsamplingLevel subsamplingLevel, const DecodingOptions&)
 {
     LockHolder lockHolder(m_mutex);
     // Zero-height images can cause problems for some ports. If we have an empty image dimension, just bail.
@@ -258,6 +308,13 @@ NativeImagePtr ScalableImageDecoder::createFrameImageAtIndex(size_t index, Subsa
     if (!buffer || buffer->isInvalid() || !buffer->hasBackingStore())
         return nullptr;
 
+#if PLATFORM(JAVA)
+    if (subsamplingLevel != SubsamplingLevel::Default)
+        return subsampledImage(*buffer->backingStore(), subsamplingLevel);
+#else
+    UNUSED_PARAM(subsamplingLevel);
+#endif
+
     // Return the buffer contents as a native image. For some ports, the data
     // is already in a native container, and this just increments its refcount.
     return buffer->backingStore()->image();
@@ -108,10 +108,16 @@ public:
     // sizes. This does NOT differ from size() for GIF, since decoding GIFs
     // composites any smaller frames against previous frames to create full-
     // size frames.
+#if PLATFORM(JAVA)
+    // The Java port downsamples frames by 2^SubsamplingLevel before handing
+    // them out, see createFrameImageAtIndex().
+    IntSize frameSizeAtIndex(size_t, SubsamplingLevel) const override;
+#else
     IntSize frameSizeAtIndex(size_t, SubsamplingLevel) const override
     {
         return size();
     }
+#endif
 
     // Returns whether the size is legal (i.e. not going to result in
     // overflow elsewhere). If not, marks decoding as failed.
@@ -153,7 +159,11 @@ public:
 
     ImageOrientation frameOrientationAtIndex(size_t) const override { return m_orientation; }
 
+#if PLATFORM(JAVA)
+    bool frameAllowSubsamplingAtIndex(size_t) const override { return true; }
+#else
     bool frameAllowSubsamplingAtIndex(size_t) const override { return false; }
+#endif
 
     enum { ICCColorProfileHeaderLength = 128 };
 
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2012, 2017, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2012, 2019, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -26,16 +26,46 @@
 #include "config.h"
 
 #include "SharedBuffer.h"
-#include "NotImplemented.h"
 #include "com_sun_webkit_SharedBuffer.h"
 
+#include <wtf/FileSystem.h>
+
 namespace WebCore {
 
-// JDK-8146959
-RefPtr<SharedBuffer> SharedBuffer::createFromReadingFile(const String&)
+// Fallback for createWithContentsOfFile() when the file cannot be mapped,
+// e.g. on Windows where MappedFileData is not implemented. Goes through the
+// FileSystem layer so it works with both the POSIX and the Java backend.
+RefPtr<SharedBuffer> SharedBuffer::createFromReadingFile(const String& filePath)
 {
-  notImplemented();
-  return {};
+    if (filePath.isEmpty())
+        return nullptr;
+
+    FileSystem::PlatformFileHandle handle = FileSystem::openFile(filePath, FileSystem::FileOpenMode::Read);
+    if (!FileSystem::isHandleValid(handle))
+        return nullptr;
+
+    long long fileSize;
+    size_t bytesToRead;
+    if (!FileSystem::getFileSize(handle, fileSize) || !WTF::convertSafely(fileSize, bytesToRead)) {
+        FileSystem::closeFile(handle);
+        return nullptr;
+    }
+
+    Vector<char> buffer(bytesToRead);
+    size_t totalBytesRead = 0;
+    while (totalBytesRead < bytesToRead) {
+        int chunkSize = static_cast<int>(std::min<size_t>(bytesToRead - totalBytesRead, std::numeric_limits<int>::max()));
+        int bytesRead = FileSystem::readFromFile(handle, buffer.data() + totalBytesRead, chunkSize);
+        if (bytesRead <= 0)
+            break;
+        totalBytesRead += bytesRead;
+    }
+    FileSystem::closeFile(handle);
+
+    if (totalBytesRead != bytesToRead)
+        return nullptr;
+
+    return SharedBuffer::create(WTFMove(buffer));
 }
 
 extern "C" {
@@ -85,6 +115,41 @@ JNIEXPORT jint JNICALL Java_com_sun_webkit_SharedBuffer_twkGetSomeData
     return len;
 }
 
+JNIEXPORT jlong JNICALL Java_com_sun_webkit_SharedBuffer_twkCreateSomeDataView
+  (JNIEnv*, jclass, jlong nativePointer, jlong position)
+{
+    SharedBuffer* p = static_cast<SharedBuffer*>(jlong_to_ptr(nativePointer));
+    ASSERT(p);
+    ASSERT(position >= 0);
+
+    if ((size_t)position >= p->size()) {
+        return 0;
+    }
+
+    // The view holds a reference to its segment, so the data stays valid
+    // after the buffer is appended to, cleared or disposed.
+    return ptr_to_jlong(new SharedBufferDataView(p->getSomeData(position)));
+}
+
+JNIEXPORT jobject JNICALL Java_com_sun_webkit_SharedBuffer_twkGetViewData
+  (JNIEnv* env, jclass, jlong nativeView)
+{
+    SharedBufferDataView* view = static_cast<SharedBufferDataView*>(jlong_to_ptr(nativeView));
+    ASSERT(view);
+
+    // Segments are immutable and may be mapped read-only, the Java side
+    // only hands out read-only wrappers of this buffer.
+    return env->NewDirectByteBuffer(const_cast<char*>(view->data()), view->size());
+}
+
+JNIEXPORT void JNICALL Java_com_sun_webkit_SharedBuffer_twkDisposeView
+  (JNIEnv*, jclass, jlong nativeView)
+{
+    SharedBufferDataView* view = static_cast<SharedBufferDataView*>(jlong_to_ptr(nativeView));
+    ASSERT(view);
+    delete view;
+}
+
 JNIEXPORT void JNICALL Java_com_sun_webkit_SharedBuffer_twkAppend
   (JNIEnv* env, jclass, jlong nativePointer, jbyteArray buffer,
    jint offset, jint length)
@@ -0,0 +1,652 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#include "config.h"
+#include "CookieStoreJava.h"
+
+#include "PlatformJavaClasses.h"
+#include "com_sun_webkit_network_NativeCookieStore.h"
+#include <algorithm>
+#include <wtf/FileSystem.h>
+#include <wtf/NeverDestroyed.h>
+#include <wtf/WallTime.h>
+#include <wtf/text/StringBuilder.h>
+
+namespace WebCore {
+
+namespace CookieStoreJavaInternal {
+
+// Same limits as com.sun.webkit.network.CookieStore.
+static const size_t maxBucketSize = 50;
+static const size_t totalCountLowerThreshold = 3000;
+static const size_t totalCountUpperThreshold = 4000;
+
+// Backing file layout: the magic, the cookie count, then for every cookie
+// the four times, the flags and the name, value, domain and path as length
+// prefixed UTF-8. All numbers are in native byte order, the file is not
+// meant to move between machines.
+static const char backingFileMagic[8] = { 'J', 'F', 'X', 'C', 'K', 'S', '0', '1' };
+
+enum CookieFlags {
+    Persistent = 1 << 0,
+    HostOnly = 1 << 1,
+    SecureOnly = 1 << 2,
+    HttpOnly = 1 << 3
+};
+
+static int64_t currentTimeMillis()
+{
+    return static_cast<int64_t>(WallTime::now().secondsSinceEpoch().milliseconds());
+}
+
+static bool hasExpired(const CookieStoreJava::Cookie& cookie, int64_t currentTime)
+{
+    return currentTime > cookie.expiryTime;
+}
+
+static bool isSameCookie(const CookieStoreJava::Cookie& a, const CookieStoreJava::Cookie& b)
+{
+    return a.name == b.name && a.domain == b.domain && a.path == b.path;
+}
+
+static bool isIPAddress(const String& hostname)
+{
+    unsigned parts = 0;
+    unsigned i = 0;
+    while (i < hostname.length()) {
+        unsigned value = 0;
+        unsigned digits = 0;
+        for (; i < hostname.length() && isASCIIDigit(hostname[i]) && digits < 3; ++i, ++digits)
+            value = value * 10 + hostname[i] - '0';
+        if (!digits || value > 255 || ++parts > 4)
+            return false;
+        if (i == hostname.length())
+            break;
+        if (hostname[i++] != '.' || i == hostname.length())
+            return false;
+    }
+    return parts == 4;
+}
+
+static bool domainMatches(const String& domain, const String& cookieDomain)
+{
+    if (!domain.endsWith(cookieDomain))
+        return false;
+    if (domain.length() == cookieDomain.length())
+        return true;
+    return domain[domain.length() - cookieDomain.length() - 1] == '.' && !isIPAddress(domain);
+}
+
+static bool pathMatches(const String& path, const String& cookiePath)
+{
+    if (!path.startsWith(cookiePath))
+        return false;
+    return path.length() == cookiePath.length()
+        || cookiePath.endsWith('/')
+        || path[cookiePath.length()] == '/';
+}
+
+static unsigned flags(const CookieStoreJava::Cookie& cookie)
+{
+    return (cookie.persistent ? Persistent : 0)
+        | (cookie.hostOnly ? HostOnly : 0)
+        | (cookie.secureOnly ? SecureOnly : 0)
+        | (cookie.httpOnly ? HttpOnly : 0);
+}
+
+static void setFlags(CookieStoreJava::Cookie& cookie, unsigned flags)
+{
+    cookie.persistent = flags & Persistent;
+    cookie.hostOnly = flags & HostOnly;
+    cookie.secureOnly = flags & SecureOnly;
+    cookie.httpOnly = flags & HttpOnly;
+}
+
+template<typename T> static void appendNumber(Vector<uint8_t>& data, T number)
+{
+    data.append(reinterpret_cast<const uint8_t*>(&number), sizeof(number));
+}
+
+static void appendString(Vector<uint8_t>& data, const String& string)
+{
+    CString utf8 = string.utf8();
+    appendNumber(data, static_cast<uint32_t>(utf8.length()));
+    data.append(reinterpret_cast<const uint8_t*>(utf8.data()), utf8.length());
+}
+
+class BackingFileReader {
+public:
+    BackingFileReader(const uint8_t* data, size_t size)
+        : m_position(data)
+        , m_end(data + size)
+    {
+    }
+
+    template<typename T> bool read(T& number)
+    {
+        if (static_cast<size_t>(m_end - m_position) < sizeof(number))
+            return false;
+        memcpy(&number, m_position, sizeof(number));
+        m_position += sizeof(number);
+        return true;
+    }
+
+    bool read(String& string)
+    {
+        uint32_t length;
+        if (!read(length) || static_cast<size_t>(m_end - m_position) < length)
+            return false;
+        string = String::fromUTF8(m_position, length);
+        m_position += length;
+        return !string.isNull();
+    }
+
+    bool readMagic()
+    {
+        if (static_cast<size_t>(m_end - m_position) < sizeof(backingFileMagic)
+            || memcmp(m_position, backingFileMagic, sizeof(backingFileMagic)))
+            return false;
+        m_position += sizeof(backingFileMagic);
+        return true;
+    }
+
+private:
+    const uint8_t* m_position;
+    const uint8_t* m_end;
+};
+
+static bool readCookies(const uint8_t* data, size_t size, Vector<CookieStoreJava::Cookie>& cookies)
+{
+    BackingFileReader reader(data, size);
+    uint32_t count;
+    if (!reader.readMagic() || !reader.read(count))
+        return false;
+    for (uint32_t i = 0; i < count; ++i) {
+        CookieStoreJava::Cookie cookie;
+        uint32_t cookieFlags;
+        if (!reader.read(cookie.expiryTime)
+            || !reader.read(cookie.creationTime)
+            || !reader.read(cookie.creationSubtime)
+            || !reader.read(cookie.lastAccessTime)
+            || !reader.read(cookieFlags)
+            || !reader.read(cookie.name)
+            || !reader.read(cookie.value)
+            || !reader.read(cookie.domain)
+            || !reader.read(cookie.path))
+            return false;
+        setFlags(cookie, cookieFlags);
+        cookies.append(WTFMove(cookie));
+    }
+    return true;
+}
+
+// Reads the whole file where it cannot be mapped, as on Windows.
+static bool readFile(const String& path, Vector<uint8_t>& data)
+{
+    long long size;
+    if (!FileSystem::getFileSize(path, size) || size <= 0 || size > std::numeric_limits<int>::max())
+        return false;
+    FileSystem::PlatformFileHandle handle = FileSystem::openFile(path, FileSystem::FileOpenMode::Read);
+    if (!FileSystem::isHandleValid(handle))
+        return false;
+    data.resize(static_cast<size_t>(size));
+    int bytesRead = FileSystem::readFromFile(handle, reinterpret_cast<char*>(data.data()), static_cast<int>(size));
+    FileSystem::closeFile(handle);
+    return bytesRead == size;
+}
+
+} // namespace CookieStoreJavaInternal
+
+using namespace CookieStoreJavaInternal;
+
+CookieStoreJava::Cookie CookieStoreJava::Cookie::isolatedCopy() const
+{
+    Cookie copy(*this);
+    copy.name = name.isolatedCopy();
+    copy.value = value.isolatedCopy();
+    copy.domain = domain.isolatedCopy();
+    copy.path = path.isolatedCopy();
+    return copy;
+}
+
+CookieStoreJava& CookieStoreJava::shared()
+{
+    static NeverDestroyed<CookieStoreJava> store;
+    return store;
+}
+
+String CookieStoreJava::cookieHeader(const String& hostname, const String& path, bool secureProtocol, bool httpApi)
+{
+    auto locker = holdLock(m_lock);
+    int64_t currentTime = currentTimeMillis();
+
+    // Walk up the domain hierarchy, only the buckets of hostname and its
+    // parent domains can hold matching cookies.
+    Vector<Cookie*, 16> result;
+    Vector<String, 4> emptyBuckets;
+    for (size_t start = 0; start < hostname.length(); ) {
+        auto it = m_buckets.find(hostname.substring(start));
+        if (it != m_buckets.end()) {
+            Bucket& bucket = it->value;
+            m_totalCount -= bucket.removeAllMatching([currentTime] (const Cookie& cookie) {
+                return hasExpired(cookie, currentTime);
+            });
+            if (bucket.isEmpty())
+                emptyBuckets.append(it->key);
+            for (auto& cookie : bucket) {
+                if (cookie.hostOnly ? !equalIgnoringASCIICase(hostname, cookie.domain) : !domainMatches(hostname, cookie.domain))
+                    continue;
+                if (!pathMatches(path, cookie.path))
+                    continue;
+                if ((cookie.secureOnly && !secureProtocol) || (cookie.httpOnly && !httpApi))
+                    continue;
+                result.append(&cookie);
+            }
+        }
+        size_t nextPoint = hostname.find('.', start);
+        if (nextPoint == notFound)
+            break;
+        start = nextPoint + 1;
+    }
+
+    // Drop buckets emptied by expiry so that the map only holds live domains.
+    for (auto& domain : emptyBuckets)
+        m_buckets.remove(domain);
+
+    if (result.isEmpty())
+        return String();
+
+    std::stable_sort(result.begin(), result.end(), [] (const Cookie* a, const Cookie* b) {
+        if (a->path.length() != b->path.length())
+            return a->path.length() > b->path.length();
+        if (a->creationTime != b->creationTime)
+            return a->creationTime < b->creationTime;
+        return a->creationSubtime < b->creationSubtime;
+    });
+
+    StringBuilder builder;
+    for (auto* cookie : result) {
+        if (!builder.isEmpty())
+            builder.appendLiteral("; ");
+        // Appending through StringView copies the characters, the stored
+        // strings must not be shared with the caller.
+        builder.append(StringView(cookie->name));
+        builder.append('=');
+        builder.append(StringView(cookie->value));
+        cookie->lastAccessTime = currentTime;
+    }
+    return builder.toString();
+}
+
+bool CookieStoreJava::put(Cookie&& cookie, bool httpApi)
+{
+    auto locker = holdLock(m_lock);
+    int64_t currentTime = currentTimeMillis();
+
+    auto it = m_buckets.find(cookie.domain);
+    if (it != m_buckets.end()) {
+        for (auto& oldCookie : it->value) {
+            if (!isSameCookie(oldCookie, cookie) || hasExpired(oldCookie, currentTime))
+                continue;
+            if (oldCookie.httpOnly && !httpApi)
+                return false;
+            cookie.creationTime = oldCookie.creationTime;
+            cookie.creationSubtime = oldCookie.creationSubtime;
+            break;
+        }
+    }
+
+    putLocked(cookie.isolatedCopy());
+    return true;
+}
+
+void CookieStoreJava::putLocked(Cookie&& cookie)
+{
+    int64_t currentTime = currentTimeMillis();
+    if (cookie.persistent)
+        m_backingFileDirty = true;
+
+    auto addResult = m_buckets.add(cookie.domain, Bucket());
+    Bucket& bucket = addResult.iterator->value;
+    size_t index = bucket.findMatching([&cookie] (const Cookie& storedCookie) {
+        return isSameCookie(storedCookie, cookie);
+    });
+
+    if (hasExpired(cookie, currentTime)) {
+        if (index != notFound) {
+            m_backingFileDirty |= bucket[index].persistent;
+            bucket.remove(index);
+            --m_totalCount;
+        }
+        if (bucket.isEmpty())
+            m_buckets.remove(addResult.iterator);
+        return;
+    }
+
+    if (index != notFound) {
+        m_backingFileDirty |= bucket[index].persistent;
+        bucket[index] = WTFMove(cookie);
+        return;
+    }
+
+    bucket.append(WTFMove(cookie));
+    ++m_totalCount;
+    if (bucket.size() > maxBucketSize) {
+        purge(bucket);
+        if (bucket.isEmpty())
+            m_buckets.remove(addResult.iterator);
+    }
+    if (m_totalCount > totalCountUpperThreshold)
+        purge();
+}
+
+void CookieStoreJava::purge(Bucket& bucket)
+{
+    int64_t currentTime = currentTimeMillis();
+    m_totalCount -= bucket.removeAllMatching([currentTime] (const Cookie& cookie) {
+        return hasExpired(cookie, currentTime);
+    });
+    if (bucket.size() <= maxBucketSize)
+        return;
+
+    auto earliest = std::min_element(bucket.begin(), bucket.end(), [] (const Cookie& a, const Cookie& b) {
+        return a.lastAccessTime < b.lastAccessTime;
+    });
+    m_backingFileDirty |= earliest->persistent;
+    bucket.remove(earliest - bucket.begin());
+    --m_totalCount;
+}
+
+void CookieStoreJava::purge()
+{
+    int64_t currentTime = currentTimeMillis();
+    Vector<std::pair<int64_t, String>> removalQueue;
+    for (auto& bucket : m_buckets.values()) {
+        m_totalCount -= bucket.removeAllMatching([currentTime] (const Cookie& cookie) {
+            return hasExpired(cookie, currentTime);
+        });
+        for (auto& cookie : bucket)
+            removalQueue.append({ cookie.lastAccessTime, cookie.domain });
+    }
+    if (m_totalCount > totalCountLowerThreshold) {
+        // Evict the least recently accessed cookies. Entries with the same
+        // access time in the same bucket are interchangeable.
+        std::sort(removalQueue.begin(), removalQueue.end(), [] (const auto& a, const auto& b) {
+            return a.first < b.first;
+        });
+        size_t excessCount = m_totalCount - totalCountLowerThreshold;
+        for (size_t i = 0; i < excessCount; ++i) {
+            auto& entry = removalQueue[i];
+            Bucket& bucket = m_buckets.find(entry.second)->value;
+            size_t index = bucket.findMatching([&entry] (const Cookie& cookie) {
+                return cookie.lastAccessTime == entry.first;
+            });
+            m_backingFileDirty |= bucket[index].persistent;
+            bucket.remove(index);
+            --m_totalCount;
+        }
+    }
+    // Both expiry and eviction can leave buckets empty.
+    m_buckets.removeIf([] (auto& entry) {
+        return entry.value.isEmpty();
+    });
+}
+
+Vector<CookieStoreJava::Cookie> CookieStoreJava::exportCookies()
+{
+    auto locker = holdLock(m_lock);
+    int64_t currentTime = currentTimeMillis();
+
+    Vector<Cookie> cookies;
+    cookies.reserveInitialCapacity(m_totalCount);
+    for (auto& bucket : m_buckets.values()) {
+        for (auto& cookie : bucket) {
+            if (!hasExpired(cookie, currentTime))
+                cookies.uncheckedAppend(cookie.isolatedCopy());
+        }
+    }
+    return cookies;
+}
+
+void CookieStoreJava::importCookies(Vector<Cookie>&& cookies)
+{
+    auto locker = holdLock(m_lock);
+    for (auto& cookie : cookies)
+        putLocked(cookie.isolatedCopy());
+}
+
+size_t CookieStoreJava::cookieCount()
+{
+    auto locker = holdLock(m_lock);
+    return m_totalCount;
+}
+
+void CookieStoreJava::clear()
+{
+    auto locker = holdLock(m_lock);
+    m_buckets.clear();
+    m_totalCount = 0;
+    m_backingFileDirty = !m_backingFilePath.isNull();
+}
+
+bool CookieStoreJava::setBackingFile(const String& path)
+{
+    auto locker = holdLock(m_lock);
+    m_backingFilePath = path.isolatedCopy();
+    m_backingFileDirty = false;
+    if (path.isNull())
+        return true;
+
+    Vector<Cookie> cookies;
+    bool success;
+    FileSystem::MappedFileData mappedFile(path, success);
+    if (success)
+        success = readCookies(static_cast<const uint8_t*>(mappedFile.data()), mappedFile.size(), cookies);
+    else {
+        Vector<uint8_t> data;
+        success = readFile(path, data) && readCookies(data.data(), data.size(), cookies);
+    }
+
+    // A missing or damaged file leaves the store as it is, the next flush
+    // replaces it.
+    if (!success)
+        return !FileSystem::fileExists(path);
+
+    for (auto& cookie : cookies)
+        putLocked(WTFMove(cookie));
+    m_backingFileDirty = false;
+    return true;
+}
+
+void CookieStoreJava::flush()
+{
+    auto locker = holdLock(m_lock);
+    if (m_backingFilePath.isNull() || !m_backingFileDirty)
+        return;
+
+    int64_t currentTime = currentTimeMillis();
+    Vector<uint8_t> data;
+    uint32_t count = 0;
+    for (auto& bucket : m_buckets.values()) {
+        for (auto& cookie : bucket) {
+            if (!cookie.persistent || hasExpired(cookie, currentTime))
+                continue;
+            appendNumber(data, cookie.expiryTime);
+            appendNumber(data, cookie.creationTime);
+            appendNumber(data, cookie.creationSubtime);
+            appendNumber(data, cookie.lastAccessTime);
+            appendNumber(data, static_cast<uint32_t>(flags(cookie)));
+            appendString(data, cookie.name);
+            appendString(data, cookie.value);
+            appendString(data, cookie.domain);
+            appendString(data, cookie.path);
+            ++count;
+        }
+    }
+
+    Vector<uint8_t> header;
+    header.append(reinterpret_cast<const uint8_t*>(backingFileMagic), sizeof(backingFileMagic));
+    appendNumber(header, count);
+
+    FileSystem::PlatformFileHandle handle = FileSystem::openFile(m_backingFilePath, FileSystem::FileOpenMode::Write);
+    if (!FileSystem::isHandleValid(handle))
+        return;
+    bool written = FileSystem::writeToFile(handle, reinterpret_cast<const char*>(header.data()), header.size()) == static_cast<int>(header.size())
+        && FileSystem::writeToFile(handle, reinterpret_cast<const char*>(data.data()), data.size()) == static_cast<int>(data.size());
+    FileSystem::closeFile(handle);
+    m_backingFileDirty = !written;
+}
+
+} // namespace WebCore
+
+using namespace WebCore;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+JNIEXPORT void JNICALL Java_com_sun_webkit_network_NativeCookieStore_twkSetActive
+  (JNIEnv*, jclass, jboolean active)
+{
+    CookieStoreJava::shared().setActive(jbool_to_bool(active));
+}
+
+JNIEXPORT jstring JNICALL Java_com_sun_webkit_network_NativeCookieStore_twkGet
+  (JNIEnv* env, jclass, jstring hostname, jstring path,
+   jboolean secureProtocol, jboolean httpApi)
+{
+    return CookieStoreJava::shared().cookieHeader(
+            String(env, hostname),
+            String(env, path),
+            jbool_to_bool(secureProtocol),
+            jbool_to_bool(httpApi)).toJavaString(env).releaseLocal();
+}
+
+JNIEXPORT jboolean JNICALL Java_com_sun_webkit_network_NativeCookieStore_twkPut
+  (JNIEnv* env, jclass, jstring name, jstring value, jstring domain,
+   jstring path, jlong expiryTime, jlong creationTime, jint creationSubtime,
+   jlong lastAccessTime, jint flags, jboolean httpApi)
+{
+    CookieStoreJava::Cookie cookie;
+    cookie.name = String(env, name);
+    cookie.value = String(env, value);
+    cookie.domain = String(env, domain);
+    cookie.path = String(env, path);
+    cookie.expiryTime = expiryTime;
+    cookie.creationTime = creationTime;
+    cookie.creationSubtime = creationSubtime;
+    cookie.lastAccessTime = lastAccessTime;
+    CookieStoreJavaInternal::setFlags(cookie, flags);
+    return bool_to_jbool(CookieStoreJava::shared().put(WTFMove(cookie), jbool_to_bool(httpApi)));
+}
+
+JNIEXPORT jint JNICALL Java_com_sun_webkit_network_NativeCookieStore_twkGetCount
+  (JNIEnv*, jclass)
+{
+    return static_cast<jint>(CookieStoreJava::shared().cookieCount());
+}
+
+// Fills the arrays with four strings, four times and the flags of every
+// cookie as long as they have room, and returns the number of cookies.
+JNIEXPORT jint JNICALL Java_com_sun_webkit_network_NativeCookieStore_twkExport
+  (JNIEnv* env, jclass, jobjectArray strings, jlongArray times,
+   jintArray flags)
+{
+    Vector<CookieStoreJava::Cookie> cookies = CookieStoreJava::shared().exportCookies();
+    jsize capacity = env->GetArrayLength(flags);
+    if (cookies.size() > static_cast<size_t>(capacity))
+        return static_cast<jint>(cookies.size());
+
+    Vector<jlong> timeValues;
+    Vector<jint> flagValues;
+    for (size_t i = 0; i < cookies.size(); ++i) {
+        const auto& cookie = cookies[i];
+        env->SetObjectArrayElement(strings, 4 * i, (jstring) cookie.name.toJavaString(env));
+        env->SetObjectArrayElement(strings, 4 * i + 1, (jstring) cookie.value.toJavaString(env));
+        env->SetObjectArrayElement(strings, 4 * i + 2, (jstring) cookie.domain.toJavaString(env));
+        env->SetObjectArrayElement(strings, 4 * i + 3, (jstring) cookie.path.toJavaString(env));
+        timeValues.append(cookie.expiryTime);
+        timeValues.append(cookie.creationTime);
+        timeValues.append(cookie.creationSubtime);
+        timeValues.append(cookie.lastAccessTime);
+        flagValues.append(CookieStoreJavaInternal::flags(cookie));
+    }
+    env->SetLongArrayRegion(times, 0, timeValues.size(), timeValues.data());
+    env->SetIntArrayRegion(flags, 0, flagValues.size(), flagValues.data());
+    WTF::CheckAndClearException(env);
+    return static_cast<jint>(cookies.size());
+}
+
+JNIEXPORT void JNICALL Java_com_sun_webkit_network_NativeCookieStore_twkImport
+  (JNIEnv* env, jclass, jobjectArray strings, jlongArray times,
+   jintArray flags, jint count)
+{
+    Vector<jlong> timeValues(4 * count);
+    Vector<jint> flagValues(count);
+    env->GetLongArrayRegion(times, 0, timeValues.size(), timeValues.data());
+    env->GetIntArrayRegion(flags, 0, flagValues.size(), flagValues.data());
+    if (WTF::CheckAndClearException(env))
+        return;
+
+    Vector<CookieStoreJava::Cookie> cookies;
+    cookies.reserveInitialCapacity(count);
+    for (jint i = 0; i < count; ++i) {
+        CookieStoreJava::Cookie cookie;
+        cookie.name = String(env, JLString(static_cast<jstring>(env->GetObjectArrayElement(strings, 4 * i))));
+        cookie.value = String(env, JLString(static_cast<jstring>(env->GetObjectArrayElement(strings, 4 * i + 1))));
+        cookie.domain = String(env, JLString(static_cast<jstring>(env->GetObjectArrayElement(strings, 4 * i + 2))));
+        cookie.path = String(env, JLString(static_cast<jstring>(env->GetObjectArrayElement(strings, 4 * i + 3))));
+        cookie.expiryTime = timeValues[4 * i];
+        cookie.creationTime = timeValues[4 * i + 1];
+        cookie.creationSubtime = static_cast<int32_t>(timeValues[4 * i + 2]);
+        cookie.lastAccessTime = timeValues[4 * i + 3];
+        CookieStoreJavaInternal::setFlags(cookie, flagValues[i]);
+        cookies.uncheckedAppend(WTFMove(cookie));
+    }
+    CookieStoreJava::shared().importCookies(WTFMove(cookies));
+}
+
+JNIEXPORT void JNICALL Java_com_sun_webkit_network_NativeCookieStore_twkClear
+  (JNIEnv*, jclass)
+{
+    CookieStoreJava::shared().clear();
+}
+
+JNIEXPORT jboolean JNICALL Java_com_sun_webkit_network_NativeCookieStore_twkSetBackingFile
+  (JNIEnv* env, jclass, jstring path)
+{
+    return bool_to_jbool(CookieStoreJava::shared().setBackingFile(
+            path ? String(env, path) : String()));
+}
+
+JNIEXPORT void JNICALL Java_com_sun_webkit_network_NativeCookieStore_twkFlush
+  (JNIEnv*, jclass)
+{
+    CookieStoreJava::shared().flush();
+}
+
+#ifdef __cplusplus
+}
+#endif
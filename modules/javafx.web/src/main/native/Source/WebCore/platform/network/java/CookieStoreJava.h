@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <limits>
+#include <wtf/HashMap.h>
+#include <wtf/Lock.h>
+#include <wtf/NeverDestroyed.h>
+#include <wtf/Vector.h>
+#include <wtf/text/StringHash.h>
+#include <wtf/text/WTFString.h>
+
+namespace WebCore {
+
+/*
+ * Native counterpart of com.sun.webkit.network.CookieStore, filled by
+ * CookieManager.createNativeBacked() instances. WebPage installs one as the
+ * default CookieHandler if com.sun.webkit.useNativeCookieStore is set. It lets
+ * document.cookie and the request header lookups be answered without
+ * calling into Java. Parsing Set-Cookie and the public suffix checks stay in
+ * CookieManager, which hands the resulting cookies to put().
+ *
+ * Cookies are stored in buckets indexed by domain and follow the matching,
+ * ordering and eviction rules of the Java store. The store is used from the
+ * WebKit thread and the Java network threads, every method takes m_lock and
+ * no stored String is ever handed out.
+ */
+class CookieStoreJava {
+public:
+    struct Cookie {
+        String name;
+        String value;
+        String domain;
+        String path;
+        int64_t expiryTime { std::numeric_limits<int64_t>::max() };
+        int64_t creationTime { 0 };
+        int32_t creationSubtime { 0 };
+        int64_t lastAccessTime { 0 };
+        bool persistent { false };
+        bool hostOnly { false };
+        bool secureOnly { false };
+        bool httpOnly { false };
+
+        Cookie isolatedCopy() const;
+    };
+
+    static CookieStoreJava& shared();
+
+    // Whether the default CookieHandler is backed by this store. If it is
+    // not, cookie lookups have to go to the Java CookieHandler instead.
+    bool isActive() const { return m_active; }
+    void setActive(bool active) { m_active = active; }
+
+    // The Cookie header value for a request, null if no cookie matches.
+    String cookieHeader(const String& hostname, const String& path, bool secureProtocol, bool httpApi);
+
+    // Stores a cookie, replacing the one with the same name, domain and
+    // path. Returns false if a non-HTTP API tried to replace an HttpOnly
+    // cookie.
+    bool put(Cookie&&, bool httpApi);
+
+    Vector<Cookie> exportCookies();
+    void importCookies(Vector<Cookie>&&);
+    size_t cookieCount();
+    void clear();
+
+    // Persistent cookies are loaded from path right away and written back
+    // to it by flush(). A null path detaches the store from its file.
+    bool setBackingFile(const String& path);
+    void flush();
+
+private:
+    friend class NeverDestroyed<CookieStoreJava>;
+    CookieStoreJava() = default;
+
+    using Bucket = Vector<Cookie>;
+
+    void putLocked(Cookie&&);
+    void purge(Bucket&);
+    void purge();
+    void loadBackingFile();
+
+    Lock m_lock;
+    HashMap<String, Bucket> m_buckets;
+    size_t m_totalCount { 0 };
+    std::atomic<bool> m_active { false };
+    String m_backingFilePath;
+    bool m_backingFileDirty { false };
+};
+
+} // namespace WebCore
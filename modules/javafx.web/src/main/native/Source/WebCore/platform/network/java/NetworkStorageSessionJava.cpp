@@ -28,9 +28,11 @@
 
 #include "Cookie.h"
 #include "CookieRequestHeaderFieldProxy.h"
+#include "CookieStoreJava.h"
 #include "NetworkingContext.h"
 #include "NotImplemented.h"
 #include "ResourceHandle.h"
+#include "TextEncoding.h"
 
 #include <wtf/MainThread.h>
 #include <wtf/NeverDestroyed.h>
@@ -66,9 +68,25 @@ static void initRefs(JNIEnv* env)
     }
 }
 
+// Mirrors what CookieJar.fwkGet and CookieManager.get do with the URL.
+static String getCookiesFromNativeStore(const URL& url, bool includeHttpOnlyCookies)
+{
+    String host = url.host().convertToASCIILowercase();
+    if (host.isEmpty())
+        return emptyString();
+
+    bool isHTTPS = url.protocolIs("https");
+    bool secureProtocol = isHTTPS;
+    bool httpApi = includeHttpOnlyCookies && (isHTTPS || url.protocolIs("http"));
+    String result = CookieStoreJava::shared().cookieHeader(host, decodeURLEscapeSequences(url.path()), secureProtocol, httpApi);
+    return result.isNull() ? emptyString() : result;
+}
+
 static String getCookies(const URL& url, bool includeHttpOnlyCookies)
 {
-    using namespace CookieInternalJava;
+    if (CookieStoreJava::shared().isActive())
+        return getCookiesFromNativeStore(url, includeHttpOnlyCookies);
+
     JNIEnv* env = WTF::GetJavaEnv();
     initRefs(env);
 
@@ -167,7 +185,7 @@ Vector<Cookie> NetworkStorageSession::getCookies(const URL&)
 
 void NetworkStorageSession::flushCookieStore()
 {
-    // FIXME: Implement for WebKit to use.
+    CookieStoreJava::shared().flush();
 }
 
 } // namespace WebCore
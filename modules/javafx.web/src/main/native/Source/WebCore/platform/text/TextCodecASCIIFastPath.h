@@ -29,6 +29,10 @@
 
 #include <wtf/text/ASCIIFastPath.h>
 
+#if CPU(ARM64) && COMPILER(GCC_COMPATIBLE)
+#include <arm_neon.h>
+#endif
+
 namespace WebCore {
 
 template<size_t size> struct UCharByteFiller;
@@ -75,6 +79,27 @@ inline void copyASCIIMachineWord(UChar* destination, const uint8_t* source)
     UCharByteFiller<sizeof(WTF::MachineWord)>::copy(destination, source);
 }
 
+// Returns the number of leading bytes of source that are ASCII, 16 at a time
+// where the CPU allows it.
+inline size_t asciiPrefixLength(const uint8_t* source, size_t length)
+{
+    size_t i = 0;
+#if CPU(X86_SSE2)
+    for (; i + 16 <= length; i += 16) {
+        if (_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i))))
+            break;
+    }
+#elif CPU(ARM64) && COMPILER(GCC_COMPATIBLE)
+    for (; i + 16 <= length; i += 16) {
+        if (vmaxvq_u8(vld1q_u8(source + i)) & 0x80)
+            break;
+    }
+#endif
+    while (i < length && isASCII(source[i]))
+        ++i;
+    return i;
+}
+
 } // namespace WebCore
 
 #endif // TextCodecASCIIFastPath_h
@@ -27,6 +27,7 @@
 #include "config.h"
 #include "TextCodecICU.h"
 
+#include "TextCodecASCIIFastPath.h"
 #include "TextEncoding.h"
 #include "TextEncodingRegistry.h"
 #include "ThreadGlobalData.h"
@@ -41,6 +42,10 @@ namespace WebCore {
 
 const size_t ConversionBufferSize = 16384;
 
+// Shorter runs of ASCII are left to ICU, splitting the input that finely
+// costs more than it saves.
+const size_t MinimumASCIIRunLength = 16;
+
 #define DECLARE_ALIASES(encoding, ...) \
     static const char* const encoding##_aliases[] { __VA_ARGS__ }
 
@@ -220,6 +225,35 @@ TextCodecICU::~TextCodecICU()
     }
 }
 
+// True if the converter decodes every byte below 0x80 to the same code point
+// whenever no multi-byte sequence is pending, which lets decode() copy runs
+// of ASCII without going through ICU. Only the EUC, GBK, Big5 and Shift_JIS
+// style converters gain from it: ICU already decodes single byte charsets
+// through a flat table, and in stateful ones like ISO-2022-JP ASCII escape
+// sequences switch character sets.
+static bool isASCIITransparent(UConverter& converter)
+{
+    if (ucnv_getType(&converter) != UCNV_MBCS || ucnv_getMaxCharSize(&converter) < 2)
+        return false;
+
+    char ascii[128];
+    for (size_t i = 0; i < sizeof(ascii); ++i)
+        ascii[i] = static_cast<char>(i);
+    UChar decoded[128];
+    UChar* target = decoded;
+    const char* source = ascii;
+    UErrorCode error = U_ZERO_ERROR;
+    ucnv_toUnicode(&converter, &target, decoded + WTF_ARRAY_LENGTH(decoded), &source, ascii + sizeof(ascii), nullptr, true, &error);
+    ucnv_resetToUnicode(&converter);
+    if (U_FAILURE(error) || target != decoded + WTF_ARRAY_LENGTH(decoded))
+        return false;
+    for (size_t i = 0; i < WTF_ARRAY_LENGTH(decoded); ++i) {
+        if (decoded[i] != i)
+            return false;
+    }
+    return true;
+}
+
 void TextCodecICU::createICUConverter() const
 {
     ASSERT(!m_converter);
@@ -230,16 +264,25 @@ void TextCodecICU::createICUConverter() const
     if (cachedConverter) {
         UErrorCode error = U_ZERO_ERROR;
         const char* cachedConverterName = ucnv_getName(cachedConverter.get(), &error);
-        if (U_SUCCESS(error) && !strcmp(m_canonicalConverterName, cachedConverterName)) {
+        if (U_SUCCESS(error) && !strcmp(m_canonicalConverterName, cachedConverterName))
             m_converter = WTFMove(cachedConverter);
-            return;
-        }
     }
 
+    if (!m_converter) {
+        UErrorCode error = U_ZERO_ERROR;
+        m_converter = ICUConverterPtr { ucnv_open(m_canonicalConverterName, &error), ucnv_close };
+        if (m_converter)
+            ucnv_setFallback(m_converter.get(), TRUE);
+    }
+
+    m_hasASCIIFastPath = m_converter && isASCIITransparent(*m_converter);
+}
+
+bool TextCodecICU::hasPendingBytes() const
+{
     UErrorCode error = U_ZERO_ERROR;
-    m_converter = ICUConverterPtr { ucnv_open(m_canonicalConverterName, &error), ucnv_close };
-    if (m_converter)
-        ucnv_setFallback(m_converter.get(), TRUE);
+    int32_t pending = ucnv_toUCountPending(m_converter.get(), &error);
+    return U_FAILURE(error) || pending;
 }
 
 int TextCodecICU::decodeToBuffer(UChar* target, UChar* targetLimit, const char*& source, const char* sourceLimit, int32_t* offsets, bool flush, UErrorCode& error)
@@ -250,6 +293,19 @@ int TextCodecICU::decodeToBuffer(UChar* target, UChar* targetLimit, const char*&
     return target - targetStart;
 }
 
+// The start of a run of at least MinimumASCIIRunLength ASCII bytes, or
+// sourceLimit. The input is checked in blocks of that size, so a run is only
+// guaranteed to be found if it is about twice as long.
+static const char* findASCIIRun(const char* source, const char* sourceLimit)
+{
+    while (static_cast<size_t>(sourceLimit - source) >= MinimumASCIIRunLength) {
+        if (asciiPrefixLength(reinterpret_cast<const uint8_t*>(source), MinimumASCIIRunLength) == MinimumASCIIRunLength)
+            return source;
+        source += MinimumASCIIRunLength;
+    }
+    return sourceLimit;
+}
+
 class ErrorCallbackSetter {
 public:
     ErrorCallbackSetter(UConverter& converter, bool stopOnError)
@@ -306,9 +362,29 @@ String TextCodecICU::decode(const char* bytes, size_t length, bool flush, bool s
     UErrorCode err = U_ZERO_ERROR;
 
     do {
-        int ucharsDecoded = decodeToBuffer(buffer, bufferLimit, source, sourceLimit, offsets, flush, err);
-        result.append(buffer, ucharsDecoded);
-    } while (err == U_BUFFER_OVERFLOW_ERROR);
+        // Append runs of ASCII directly and hand ICU only the bytes between
+        // them. A run right after a lead byte is left to ICU, as its first
+        // byte may be the trail byte of a double byte character.
+        const char* segmentLimit = sourceLimit;
+        if (m_hasASCIIFastPath && source < sourceLimit) {
+            if (!hasPendingBytes()) {
+                size_t asciiLength = asciiPrefixLength(reinterpret_cast<const uint8_t*>(source), sourceLimit - source);
+                if (asciiLength >= MinimumASCIIRunLength || source + asciiLength == sourceLimit) {
+                    result.append(reinterpret_cast<const LChar*>(source), asciiLength);
+                    source += asciiLength;
+                    if (source < sourceLimit || !flush)
+                        continue;
+                }
+            }
+            if (source < sourceLimit)
+                segmentLimit = findASCIIRun(source + 1, sourceLimit);
+        }
+
+        do {
+            int ucharsDecoded = decodeToBuffer(buffer, bufferLimit, source, segmentLimit, offsets, flush && segmentLimit == sourceLimit, err);
+            result.append(buffer, ucharsDecoded);
+        } while (err == U_BUFFER_OVERFLOW_ERROR);
+    } while (U_SUCCESS(err) && source < sourceLimit);
 
     if (U_FAILURE(err)) {
         // flush the converter so it can be reused, and not be bothered by this error.
@@ -47,6 +47,7 @@ private:
 
     void createICUConverter() const;
     void releaseICUConverter() const;
+    bool hasPendingBytes() const;
     bool needsGBKFallbacks() const { return m_needsGBKFallbacks; }
     void setNeedsGBKFallbacks(bool needsFallbacks) { m_needsGBKFallbacks = needsFallbacks; }
 
@@ -56,6 +57,7 @@ private:
     const char* const m_canonicalConverterName;
     mutable ICUConverterPtr m_converter { nullptr, ucnv_close };
     mutable bool m_needsGBKFallbacks { false };
+    mutable bool m_hasASCIIFastPath { false };
 };
 
 struct ICUConverterWrapper {
@@ -89,11 +89,16 @@ JNIEXPORT jlong JNICALL Java_com_sun_webkit_dom_DocumentFragmentImpl_querySelect
 }
 
 
-JNIEXPORT jlong JNICALL Java_com_sun_webkit_dom_DocumentFragmentImpl_querySelectorAllImpl(JNIEnv* env, jclass, jlong peer
+JNIEXPORT jlongArray JNICALL Java_com_sun_webkit_dom_DocumentFragmentImpl_querySelectorAllImpl(JNIEnv* env, jclass, jlong peer
     , jstring selectors)
 {
     WebCore::JSMainThreadNullState state;
-    return JavaReturn<NodeList>(env, WTF::getPtr(raiseOnDOMError(env, IMPL->querySelectorAll(String(env, selectors)))));
+    auto result = IMPL->querySelectorAll(String(env, selectors));
+    if (result.hasException()) {
+        raiseDOMErrorException(env, result.releaseException());
+        return nullptr;
+    }
+    return toJavaPeerArray(env, result.releaseReturnValue());
 }
 
 
@@ -56,6 +56,34 @@ JNIEXPORT jboolean JNICALL Java_com_sun_webkit_dom_ElementImpl_isHTMLElementImpl
     return IMPL->isHTMLElement();
 }
 
+JNIEXPORT jobjectArray JNICALL Java_com_sun_webkit_dom_ElementImpl_getHTMLTagNamesImpl(JNIEnv* env, jclass, jlongArray peers)
+{
+    WebCore::JSMainThreadNullState state;
+    Vector<String> tagNames;
+    for (Node* node : nodesFromJavaPeerArray(env, peers)) {
+        if (node && node->isHTMLElement())
+            tagNames.append(downcast<Element>(*node).tagName());
+        else
+            tagNames.append(String());
+    }
+    return toJavaStringArray(env, tagNames);
+}
+
+JNIEXPORT jobjectArray JNICALL Java_com_sun_webkit_dom_ElementImpl_getAttributeValuesImpl(JNIEnv* env, jclass, jlongArray peers
+    , jstring name)
+{
+    WebCore::JSMainThreadNullState state;
+    AtomicString attributeName { String(env, name) };
+    Vector<String> values;
+    for (Node* node : nodesFromJavaPeerArray(env, peers)) {
+        if (is<Element>(node))
+            values.append(downcast<Element>(*node).getAttribute(attributeName));
+        else
+            values.append(String());
+    }
+    return toJavaStringArray(env, values);
+}
+
 
 // Attributes
 JNIEXPORT jstring JNICALL Java_com_sun_webkit_dom_ElementImpl_getTagNameImpl(JNIEnv* env, jclass, jlong peer)
@@ -1410,11 +1438,16 @@ JNIEXPORT jlong JNICALL Java_com_sun_webkit_dom_ElementImpl_querySelectorImpl(JN
 }
 
 
-JNIEXPORT jlong JNICALL Java_com_sun_webkit_dom_ElementImpl_querySelectorAllImpl(JNIEnv* env, jclass, jlong peer
+JNIEXPORT jlongArray JNICALL Java_com_sun_webkit_dom_ElementImpl_querySelectorAllImpl(JNIEnv* env, jclass, jlong peer
     , jstring selectors)
 {
     WebCore::JSMainThreadNullState state;
-    return JavaReturn<NodeList>(env, WTF::getPtr(raiseOnDOMError(env, IMPL->querySelectorAll(String(env, selectors)))));
+    auto result = IMPL->querySelectorAll(String(env, selectors));
+    if (result.hasException()) {
+        raiseDOMErrorException(env, result.releaseException());
+        return nullptr;
+    }
+    return toJavaPeerArray(env, result.releaseReturnValue());
 }
 
 
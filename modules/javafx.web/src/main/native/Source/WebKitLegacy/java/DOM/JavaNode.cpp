@@ -35,6 +35,7 @@
 #include <WebCore/NamedNodeMap.h>
 #include <WebCore/Node.h>
 #include <WebCore/NodeList.h>
+#include <WebCore/NodeTraversal.h>
 #include <WebCore/JSExecState.h>
 #include <WebCore/SVGTests.h>
 #include <JavaScriptCore/APICast.h>
@@ -352,4 +353,55 @@ JNIEXPORT jboolean JNICALL Java_com_sun_webkit_dom_NodeImpl_dispatchEventImpl(JN
 }
 
 
+// Bulk access
+JNIEXPORT jlongArray JNICALL Java_com_sun_webkit_dom_NodeImpl_getSubtreeImpl(JNIEnv* env, jclass, jlong peer)
+{
+    WebCore::JSMainThreadNullState state;
+    Vector<Ref<Node>> nodes;
+    for (Node* node = NodeTraversal::next(*IMPL, IMPL); node; node = NodeTraversal::next(*node, IMPL))
+        nodes.append(*node);
+    return toJavaPeerArray(env, nodes);
+}
+
+JNIEXPORT jshortArray JNICALL Java_com_sun_webkit_dom_NodeImpl_getNodeTypesImpl(JNIEnv* env, jclass, jlongArray peers)
+{
+    WebCore::JSMainThreadNullState state;
+    Vector<Node*> nodes = nodesFromJavaPeerArray(env, peers);
+    jshortArray types = env->NewShortArray(nodes.size());
+    if (WTF::CheckAndClearException(env)) // OOME
+        return nullptr;
+
+    jshort* data = env->GetShortArrayElements(types, nullptr);
+    for (size_t i = 0; i < nodes.size(); ++i)
+        data[i] = nodes[i] ? nodes[i]->nodeType() : 0;
+    env->ReleaseShortArrayElements(types, data, 0);
+    return types;
+}
+
+JNIEXPORT jobjectArray JNICALL Java_com_sun_webkit_dom_NodeImpl_getNodeNamesImpl(JNIEnv* env, jclass, jlongArray peers)
+{
+    WebCore::JSMainThreadNullState state;
+    Vector<String> names;
+    for (Node* node : nodesFromJavaPeerArray(env, peers))
+        names.append(node ? node->nodeName() : String());
+    return toJavaStringArray(env, names);
+}
+
+JNIEXPORT jobjectArray JNICALL Java_com_sun_webkit_dom_NodeImpl_getTextContentsImpl(JNIEnv* env, jclass, jlongArray peers)
+{
+    WebCore::JSMainThreadNullState state;
+    Vector<String> contents;
+    for (Node* node : nodesFromJavaPeerArray(env, peers))
+        contents.append(node ? node->textContent() : String());
+    return toJavaStringArray(env, contents);
+}
+
+JNIEXPORT void JNICALL Java_com_sun_webkit_dom_NodeImpl_disposeAllImpl(JNIEnv* env, jclass, jlongArray peers, jint count)
+{
+    Vector<Node*> nodes = nodesFromJavaPeerArray(env, peers);
+    for (jint i = 0; i < count && static_cast<size_t>(i) < nodes.size(); ++i)
+        nodes[i]->deref();
+}
+
+
 }
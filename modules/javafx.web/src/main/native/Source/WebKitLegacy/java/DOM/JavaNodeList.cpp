@@ -64,5 +64,11 @@ JNIEXPORT jlong JNICALL Java_com_sun_webkit_dom_NodeListImpl_itemImpl(JNIEnv* en
     return JavaReturn<Node>(env, WTF::getPtr(IMPL->item(index)));
 }
 
+JNIEXPORT jlongArray JNICALL Java_com_sun_webkit_dom_NodeListImpl_itemsImpl(JNIEnv* env, jclass, jlong peer)
+{
+    WebCore::JSMainThreadNullState state;
+    return toJavaPeerArray(env, *IMPL);
+}
+
 
 }
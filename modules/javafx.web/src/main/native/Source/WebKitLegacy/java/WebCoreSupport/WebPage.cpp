@@ -257,17 +257,57 @@ void WebPage::paint(jobject rq, jint x, jint y, jint w, jint h)
         return;
     }
 
-    // Will be deleted by GraphicsContext destructor
-    PlatformContextJava* ppgc = new PlatformContextJava(rq, jRenderTheme());
-    GraphicsContext gc(ppgc);
-
     // TODO: Following JS synchronization is not necessary for single thread model
     JSGlobalContextRef globalContext = toGlobalRef(mainFrame->script().globalObject(mainThreadNormalWorld())->globalExec());
     JSC::JSLockHolder sw(toJS(globalContext)); // TODO-java: was JSC::APIEntryShim sw( toJS(globalContext) );
 
-    frameView->paint(gc, IntRect(x, y, w, h));
+    paintRect(*frameView, rq, IntRect(x, y, w, h));
+}
+
+// Paints each of rects (x, y, w, h quadruples) into the render queue at the
+// same index, so that the dirty region of a large view is recorded as tiles
+// in a single call.
+void WebPage::paintTiles(jobjectArray rqs, jintArray rects)
+{
+    if (m_rootLayer) {
+        return;
+    }
+
+    DBG_CHECKPOINTEX("twkUpdateContentTiles", 15, 100);
+
+    RefPtr<Frame> mainFrame((Frame*)&m_page->mainFrame());
+    RefPtr<FrameView> frameView(mainFrame->view());
+    if (!frameView) {
+        return;
+    }
+
+    JNIEnv* env = WTF::GetJavaEnv();
+    jsize count = env->GetArrayLength(rqs);
+    ASSERT(env->GetArrayLength(rects) == 4 * count);
+    Vector<jint> bounds(4 * count);
+    env->GetIntArrayRegion(rects, 0, 4 * count, bounds.data());
+    if (WTF::CheckAndClearException(env)) {
+        return;
+    }
+
+    JSGlobalContextRef globalContext = toGlobalRef(mainFrame->script().globalObject(mainThreadNormalWorld())->globalExec());
+    JSC::JSLockHolder sw(toJS(globalContext));
+
+    for (jsize i = 0; i < count; ++i) {
+        JLObject rq(env->GetObjectArrayElement(rqs, i));
+        paintRect(*frameView, rq, IntRect(bounds[4 * i], bounds[4 * i + 1], bounds[4 * i + 2], bounds[4 * i + 3]));
+    }
+}
+
+void WebPage::paintRect(FrameView& frameView, jobject rq, const IntRect& rect)
+{
+    // Will be deleted by GraphicsContext destructor
+    PlatformContextJava* ppgc = new PlatformContextJava(rq, jRenderTheme());
+    GraphicsContext gc(ppgc);
+
+    frameView.paint(gc, rect);
     if (m_page->settings().showDebugBorders()) {
-        drawDebugLed(gc, IntRect(x, y, w, h), Color(0, 0, 255, 128));
+        drawDebugLed(gc, rect, Color(0, 0, 255, 128));
     }
 
     gc.platformContext()->rq().flushBuffer();
@@ -924,6 +964,10 @@ JNIEXPORT void JNICALL Java_com_sun_webkit_WebPage_twkInit
     settings.setMaximumHTMLParserDOMTreeDepth(180);
     settings.setXSSAuditorEnabled(true);
     settings.setInteractiveFormValidationEnabled(true);
+#if !USE(IMAGEIO)
+    // The WebCore decoders can hand out large images downsampled.
+    settings.setImageSubsamplingEnabled(true);
+#endif
 
     /* Using java logical fonts as defaults */
     settings.setSerifFontFamily("Serif");
@@ -1639,6 +1683,12 @@ JNIEXPORT void JNICALL Java_com_sun_webkit_WebPage_twkUpdateContent
     WebPage::webPageFromJLong(pPage)->paint(rq, x, y, w, h);
 }
 
+JNIEXPORT void JNICALL Java_com_sun_webkit_WebPage_twkUpdateContentTiles
+    (JNIEnv*, jobject, jlong pPage, jobjectArray rqs, jintArray rects)
+{
+    WebPage::webPageFromJLong(pPage)->paintTiles(rqs, rects);
+}
+
 JNIEXPORT void JNICALL Java_com_sun_webkit_WebPage_twkPostPaint
   (JNIEnv*, jobject, jlong pPage, jobject rq, jint x, jint y, jint w, jint h)
 {
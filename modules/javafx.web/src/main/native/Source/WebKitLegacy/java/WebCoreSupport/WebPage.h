@@ -38,6 +38,7 @@
 namespace WebCore {
 
 class Frame;
+class FrameView;
 class GraphicsContext;
 class GraphicsLayer;
 class IntRect;
@@ -83,6 +84,7 @@ public:
     void setSize(const IntSize&);
     void prePaint();
     void paint(jobject, jint, jint, jint, jint);
+    void paintTiles(jobjectArray, jintArray);
     void postPaint(jobject, jint, jint, jint, jint);
     bool processKeyEvent(const PlatformKeyboardEvent& event);
 
@@ -104,6 +106,7 @@ public:
 
 private:
     void requestJavaRepaint(const IntRect&);
+    void paintRect(FrameView&, jobject, const IntRect&);
     void markForSync();
     void syncLayers();
     IntRect pageRect();
@@ -3,7 +3,6 @@ include(GNUInstallDirs)
 set(WEBKITJAVA_API_VERSION 4.0)
 
 set(ICU_UNICODE TRUE)
-SET_AND_EXPOSE_TO_BUILD(USE_IMAGEIO TRUE)
 SET_AND_EXPOSE_TO_BUILD(USE_TEXTURE_MAPPER TRUE)
 SET_AND_EXPOSE_TO_BUILD(USE_NPOBJECT OFF)
 SET_AND_EXPOSE_TO_BUILD(ENABLE_JAVA_BRIDGE ON)
@@ -115,6 +114,21 @@ WEBKIT_OPTION_DEFAULT_PORT_VALUE(ENABLE_PUBLIC_SUFFIX_LIST PRIVATE OFF)
 WEBKIT_OPTION_DEFAULT_PORT_VALUE(ENABLE_FTL_JIT PUBLIC OFF)
 WEBKIT_OPTION_DEFAULT_PORT_VALUE(ENABLE_WEBASSEMBLY PRIVATE OFF)
 
+# WTF::FileSystem goes straight to POSIX on Linux and Mac. Turning on
+# USE_JAVA_FILE_SYSTEM routes it through com.sun.webkit.FileSystem instead,
+# so that file access stays under the Java security manager in sandboxed
+# deployments. Windows has no native backend and always uses Java.
+if (WIN32)
+    set(USE_JAVA_FILE_SYSTEM_DEFAULT ON)
+else ()
+    set(USE_JAVA_FILE_SYSTEM_DEFAULT OFF)
+endif ()
+WEBKIT_OPTION_DEFINE(USE_JAVA_FILE_SYSTEM "Route WTF::FileSystem through Java instead of POSIX" PRIVATE ${USE_JAVA_FILE_SYSTEM_DEFAULT})
+
+# Images are decoded by javafx.iio unless USE_NATIVE_IMAGE_DECODERS builds the
+# WebCore decoders against the system libjpeg, libpng and (if found) libwebp.
+WEBKIT_OPTION_DEFINE(USE_NATIVE_IMAGE_DECODERS "Decode images with the WebCore decoders instead of javafx.iio" PRIVATE OFF)
+
 if (WIN32)
     # FIXME: Port bmalloc to Windows. https://bugs.webkit.org/show_bug.cgi?id=143310
     WEBKIT_OPTION_DEFAULT_PORT_VALUE(USE_SYSTEM_MALLOC PRIVATE ON)
@@ -130,6 +144,21 @@ endif ()
 WEBKIT_OPTION_END()
 
 
+if (WIN32 AND NOT USE_JAVA_FILE_SYSTEM)
+    message(FATAL_ERROR "USE_JAVA_FILE_SYSTEM is required on Windows")
+endif ()
+
+if (USE_NATIVE_IMAGE_DECODERS)
+    find_package(JPEG REQUIRED)
+    find_package(PNG REQUIRED)
+    find_package(WebP)
+    if (WEBP_FOUND)
+        SET_AND_EXPOSE_TO_BUILD(USE_WEBP TRUE)
+    endif ()
+else ()
+    SET_AND_EXPOSE_TO_BUILD(USE_IMAGEIO TRUE)
+endif ()
+
 set(ENABLE_WEBKIT_LEGACY ON)
 set(ENABLE_WEBKIT OFF)
 add_definitions(-DBUILDING_JAVA__=1)
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package com.sun.webkit;
+
+import com.sun.webkit.graphics.WCRectangle;
+import com.sun.webkit.graphics.WCRenderQueue;
+import java.util.ArrayList;
+import java.util.Collection;
+import java.util.LinkedList;
+import java.util.List;
+
+public class RenderFrameShim {
+
+    private final WebPage.RenderFrame frame = new WebPage.RenderFrame();
+
+    public void addRenderQueue(WCRenderQueue rq) {
+        frame.addRenderQueue(rq);
+    }
+
+    public List<WCRenderQueue> getRQList() {
+        return frame.getRQList();
+    }
+
+    public void setScroll(int dx, int dy) {
+        frame.scrollDx = dx;
+        frame.scrollDy = dy;
+    }
+
+    public void dropCoveredBy(RenderFrameShim newer) {
+        frame.dropCoveredBy(newer.frame);
+    }
+
+    /**
+     * Runs WebPage's tile dropping over the given queue, removing the
+     * frames it drops from {@code frameQueue}.
+     */
+    public static void dropCoveredTiles(List<RenderFrameShim> frameQueue,
+            RenderFrameShim currentFrame)
+    {
+        LinkedList<WebPage.RenderFrame> frames =
+                new LinkedList<WebPage.RenderFrame>();
+        for (RenderFrameShim shim : frameQueue) {
+            frames.add(shim.frame);
+        }
+        WebPage.RenderFrame.dropCoveredTiles(frames, currentFrame.frame);
+        frameQueue.removeIf(shim -> !frames.contains(shim.frame));
+    }
+
+    public static List<WCRectangle> getDirtyTiles(List<WCRectangle> rects,
+            WCRectangle clip, int tileSize)
+    {
+        Collection<WCRectangle> tiles =
+                WebPage.getDirtyTiles(rects, clip, tileSize);
+        return new ArrayList<WCRectangle>(tiles);
+    }
+}
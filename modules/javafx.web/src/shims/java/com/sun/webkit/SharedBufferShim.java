@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2015, 2019, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -24,6 +24,8 @@
  */
 package com.sun.webkit;
 
+import java.nio.ByteBuffer;
+
 public class SharedBufferShim {
 
     public static SharedBuffer createSharedBuffer() {
@@ -46,4 +48,8 @@ public class SharedBufferShim {
         return sb.getSomeData(position, buffer, offset, length);
     }
 
+    public static ByteBuffer getSomeData(SharedBuffer sb, long position) {
+        return sb.getSomeData(position);
+    }
+
 }
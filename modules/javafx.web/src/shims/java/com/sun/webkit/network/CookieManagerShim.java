@@ -23,27 +23,19 @@
  * questions.
  */
 
-package com.sun.javafx.webkit;
+package com.sun.webkit.network;
 
-import com.sun.webkit.security.WCMessageDigest;
-import java.nio.ByteBuffer;
-import java.security.MessageDigest;
-import java.security.NoSuchAlgorithmException;
+public class CookieManagerShim {
 
-public class WCMessageDigestImpl extends WCMessageDigest {
-    private final MessageDigest digest;
-
-    public WCMessageDigestImpl(String algorithm) throws NoSuchAlgorithmException {
-        digest = MessageDigest.getInstance(algorithm);
+    public static boolean usesNativeStore(CookieManager cookieManager) {
+        return cookieManager.usesNativeStore();
     }
 
-    @Override
-    public void addBytes(ByteBuffer input) {
-        digest.update(input);
+    public static int getCookieCount(CookieManager cookieManager) {
+        return cookieManager.exportCookies().size();
     }
 
-    @Override
-    public byte[] computeHash() {
-        return digest.digest();
+    public static void copyCookies(CookieManager from, CookieManager to) {
+        to.importCookies(from.exportCookies());
     }
 }
@@ -23,40 +23,19 @@
  * questions.
  */
 
-package com.sun.webkit.perf;
+package com.sun.webkit.network;
 
-import com.sun.javafx.logging.PlatformLogger;
-import com.sun.webkit.security.WCMessageDigest;
-import java.nio.ByteBuffer;
+public class NativeCookieStoreShim {
 
-public class WCMessageDigestPerfLogger extends WCMessageDigest {
-    private static final PlatformLogger log =
-            PlatformLogger.getLogger(WCMessageDigestPerfLogger.class.getName());
-
-    private static final PerfLogger logger = PerfLogger.getLogger(log);
-
-    final private WCMessageDigest digest;
-
-    public WCMessageDigestPerfLogger(WCMessageDigest digest) {
-        this.digest = digest;
-    }
-
-    public synchronized static boolean isEnabled() {
-        return logger.isEnabled();
+    public static void clear() {
+        NativeCookieStore.clear();
     }
 
-    @Override
-    public void addBytes(ByteBuffer input) {
-        logger.resumeCount("ADDBYTES");
-        digest.addBytes(input);
-        logger.suspendCount("ADDBYTES");
+    public static boolean setBackingFile(String path) {
+        return NativeCookieStore.setBackingFile(path);
     }
 
-    @Override
-    public byte[] computeHash() {
-        logger.resumeCount("COMPUTEHASH");
-        byte[] result = digest.computeHash();
-        logger.suspendCount("COMPUTEHASH");
-        return result;
+    public static void flush() {
+        NativeCookieStore.flush();
     }
 }
@@ -0,0 +1,189 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package test.com.sun.webkit;
+
+import com.sun.webkit.RenderFrameShim;
+import com.sun.webkit.graphics.WCRectangle;
+import com.sun.webkit.graphics.WCRenderQueue;
+import java.nio.ByteBuffer;
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.List;
+import org.junit.Test;
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertFalse;
+import static org.junit.Assert.assertTrue;
+import test.javafx.scene.web.TestBase;
+
+/**
+ * Tests the splitting of the dirty region into tiles and the dropping of
+ * queued tiles that a newer frame paints over.
+ */
+public class RenderFrameTest extends TestBase {
+
+    private static final class TestRenderQueue extends WCRenderQueue {
+        private boolean disposed;
+
+        private TestRenderQueue(WCRectangle clip, boolean opaque) {
+            super(clip, opaque);
+            addBuffer(ByteBuffer.allocate(4));
+        }
+
+        @Override protected void flush() {}
+
+        @Override protected void disposeGraphics() {}
+
+        @Override public synchronized void dispose() {
+            disposed = true;
+        }
+    }
+
+
+    @Test public void testDirtyTilesSplitOnTileBoundaries() {
+        List<WCRectangle> tiles = RenderFrameShim.getDirtyTiles(
+                Arrays.asList(new WCRectangle(100, 100, 200, 100)),
+                new WCRectangle(0, 0, 1000, 1000), 256);
+        assertEquals(Arrays.asList(
+                new WCRectangle(100, 100, 156, 100),
+                new WCRectangle(256, 100, 44, 100)), tiles);
+    }
+
+    @Test public void testDirtyTilesMergeRectsInSameTile() {
+        List<WCRectangle> tiles = RenderFrameShim.getDirtyTiles(
+                Arrays.asList(new WCRectangle(10, 10, 10, 10),
+                              new WCRectangle(50, 50, 10, 10)),
+                new WCRectangle(0, 0, 1000, 1000), 256);
+        assertEquals(Arrays.asList(new WCRectangle(10, 10, 50, 50)), tiles);
+    }
+
+    @Test public void testDirtyTilesClipped() {
+        List<WCRectangle> tiles = RenderFrameShim.getDirtyTiles(
+                Arrays.asList(new WCRectangle(-50, 200, 100, 100),
+                              new WCRectangle(600, 600, 10, 10)),
+                new WCRectangle(0, 0, 500, 260), 256);
+        assertEquals(Arrays.asList(
+                new WCRectangle(0, 200, 50, 56),
+                new WCRectangle(0, 256, 50, 4)), tiles);
+    }
+
+    @Test public void testDropCoveredByFullOverlap() {
+        TestRenderQueue older = opaque(0, 0, 256, 256);
+        RenderFrameShim frame = frame(older);
+        frame.dropCoveredBy(frame(opaque(0, 0, 256, 256)));
+        assertTrue(older.disposed);
+        assertTrue(frame.getRQList().isEmpty());
+    }
+
+    @Test public void testDropCoveredByPartialOverlap() {
+        TestRenderQueue older = opaque(0, 0, 256, 256);
+        RenderFrameShim frame = frame(older);
+        frame.dropCoveredBy(frame(opaque(128, 0, 256, 256),
+                                  opaque(0, 128, 128, 128)));
+        assertFalse(older.disposed);
+        assertEquals(Arrays.asList(older), frame.getRQList());
+    }
+
+    @Test public void testDropCoveredByKeepsNonOpaqueQueues() {
+        TestRenderQueue postPaint = translucent(0, 0, 100, 100);
+        TestRenderQueue tile = opaque(0, 0, 100, 100);
+        RenderFrameShim frame = frame(postPaint, tile);
+        frame.dropCoveredBy(frame(translucent(0, 0, 500, 500),
+                                  opaque(0, 0, 50, 50)));
+        assertFalse(postPaint.disposed);
+        assertFalse(tile.disposed);
+
+        frame.dropCoveredBy(frame(opaque(0, 0, 500, 500)));
+        assertFalse(postPaint.disposed);
+        assertTrue(tile.disposed);
+        assertEquals(Arrays.asList(postPaint), frame.getRQList());
+    }
+
+    @Test public void testDropCoveredTilesRemovesEmptyFrames() {
+        TestRenderQueue covered = opaque(0, 0, 256, 256);
+        TestRenderQueue partial = opaque(256, 0, 256, 256);
+        RenderFrameShim first = frame(covered);
+        RenderFrameShim second = frame(partial);
+        List<RenderFrameShim> queue = queue(first, second);
+
+        RenderFrameShim current = frame(opaque(0, 0, 300, 256));
+        RenderFrameShim.dropCoveredTiles(queue, current);
+
+        assertTrue(covered.disposed);
+        assertFalse(partial.disposed);
+        assertEquals(Arrays.asList(second), queue);
+    }
+
+    @Test public void testDropCoveredTilesKeepsFramesBeforeScroll() {
+        TestRenderQueue beforeScroll = opaque(0, 0, 256, 256);
+        TestRenderQueue scrollCopy = translucent(0, 0, 1000, 1000);
+        TestRenderQueue afterScroll = opaque(0, 0, 256, 256);
+        RenderFrameShim first = frame(beforeScroll);
+        RenderFrameShim scrolled = frame(scrollCopy);
+        scrolled.setScroll(0, -20);
+        RenderFrameShim last = frame(afterScroll);
+        List<RenderFrameShim> queue = queue(first, scrolled, last);
+
+        RenderFrameShim.dropCoveredTiles(queue, frame(opaque(0, 0, 256, 256)));
+
+        assertFalse(beforeScroll.disposed);
+        assertFalse(scrollCopy.disposed);
+        assertTrue(afterScroll.disposed);
+        assertEquals(Arrays.asList(first, scrolled), queue);
+    }
+
+    @Test public void testDropCoveredTilesScrolledCurrentFrame() {
+        TestRenderQueue older = opaque(0, 0, 256, 256);
+        List<RenderFrameShim> queue = queue(frame(older));
+
+        RenderFrameShim current = frame(opaque(0, 0, 1000, 1000));
+        current.setScroll(10, 0);
+        RenderFrameShim.dropCoveredTiles(queue, current);
+
+        assertFalse(older.disposed);
+        assertEquals(1, queue.size());
+    }
+
+
+    private static TestRenderQueue opaque(int x, int y, int w, int h) {
+        return new TestRenderQueue(new WCRectangle(x, y, w, h), true);
+    }
+
+    private static TestRenderQueue translucent(int x, int y, int w, int h) {
+        return new TestRenderQueue(new WCRectangle(x, y, w, h), false);
+    }
+
+    private static RenderFrameShim frame(WCRenderQueue... rqs) {
+        RenderFrameShim frame = new RenderFrameShim();
+        for (WCRenderQueue rq : rqs) {
+            frame.addRenderQueue(rq);
+        }
+        return frame;
+    }
+
+    private static List<RenderFrameShim> queue(RenderFrameShim... frames) {
+        return new ArrayList<RenderFrameShim>(Arrays.asList(frames));
+    }
+}
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2012, 2018, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2012, 2019, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -28,6 +28,7 @@ package test.com.sun.webkit;
 import com.sun.webkit.SharedBuffer;
 import com.sun.webkit.SharedBufferShim;
 import com.sun.webkit.WebPage;
+import java.nio.ByteBuffer;
 import java.util.ArrayList;
 import java.util.Arrays;
 import java.util.Random;
@@ -210,6 +211,67 @@ public class SharedBufferTest {
                 getSomeData(SEGMENT_SIZE * 2, SEGMENT_SIZE));
     }
 
+    @Test
+    public void testGetSomeDataViewFirstSegment() {
+        append(SEGMENT_SIZE * 2.5);
+        assertViewContains(0);
+    }
+
+    @Test
+    public void testGetSomeDataViewInteriorSegmentInteriorByte() {
+        append(SEGMENT_SIZE * 2.5);
+        assertViewContains(SEGMENT_SIZE + 9);
+    }
+
+    @Test
+    public void testGetSomeDataViewLastByte() {
+        append(SEGMENT_SIZE * 2.5);
+        assertViewContains(SEGMENT_SIZE * 2.5 - 1);
+    }
+
+    @Test
+    public void testGetSomeDataViewAfterLastByte() {
+        append(SEGMENT_SIZE * 2.5);
+        assertEquals(0, SharedBufferShim.getSomeData(
+                sb, (long) (SEGMENT_SIZE * 2.5)).remaining());
+    }
+
+    @Test
+    public void testGetSomeDataViewIsReadOnly() {
+        append(SEGMENT_SIZE);
+        ByteBuffer view = SharedBufferShim.getSomeData(sb, 0);
+        assertTrue(view.isReadOnly());
+        assertTrue(view.isDirect());
+    }
+
+    @Test
+    public void testGetSomeDataViewAfterDispose() {
+        append(SEGMENT_SIZE);
+        ByteBuffer view = SharedBufferShim.getSomeData(sb, 0);
+        SharedBufferShim.dispose(sb);
+        sb = null;
+        byte[] actual = new byte[view.remaining()];
+        view.get(actual);
+        assertArrayEquals(g(0, actual.length), actual);
+    }
+
+    @Test
+    public void testGetSomeDataViewNegativePosition() {
+        try {
+            SharedBufferShim.getSomeData(sb, -1);
+            fail("IndexOutOfBoundsException expected but not thrown");
+        } catch (IndexOutOfBoundsException expected) {}
+    }
+
+    @Test
+    public void testGetSomeDataViewPositionGreaterThanSize() {
+        append(SEGMENT_SIZE);
+        try {
+            SharedBufferShim.getSomeData(sb, SEGMENT_SIZE + 1);
+            fail("IndexOutOfBoundsException expected but not thrown");
+        } catch (IndexOutOfBoundsException expected) {}
+    }
+
     @Test
     public void testGetSomeDataFirstSegmentFirstZeroBytes() {
         append(SEGMENT_SIZE * 2.5);
@@ -488,6 +550,16 @@ public class SharedBufferTest {
         return result;
     }
 
+    private void assertViewContains(double position) {
+        ByteBuffer view = SharedBufferShim.getSomeData(sb, (long) position);
+        int remaining = view.remaining();
+        assertTrue("Unexpected remaining: " + remaining, remaining > 0
+                && remaining <= SharedBufferShim.size(sb) - (long) position);
+        byte[] actual = new byte[remaining];
+        view.get(actual);
+        assertArrayEquals(g(position, remaining), actual);
+    }
+
     private void append(byte[] data) {
         int offset = random.nextBoolean() ? random.nextInt(100) : 0;
         int extraLength = random.nextBoolean() ? random.nextInt(200) : 0;
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2011, 2015, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2011, 2019, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -25,7 +25,9 @@
 
 package test.com.sun.webkit.network;
 
+import com.sun.webkit.WebPage;
 import com.sun.webkit.network.CookieManager;
+import com.sun.webkit.network.NativeCookieStoreShim;
 import java.util.TreeSet;
 import java.util.Set;
 import java.util.LinkedHashSet;
@@ -34,20 +36,67 @@ import java.util.Map;
 import java.net.URI;
 import java.net.URISyntaxException;
 import java.util.Arrays;
+import java.util.Collection;
 import java.util.Collections;
 import java.util.HashMap;
 import java.util.List;
+import org.junit.After;
+import org.junit.Before;
+import org.junit.BeforeClass;
 import org.junit.Ignore;
 import org.junit.Test;
+import org.junit.runner.RunWith;
+import org.junit.runners.Parameterized;
+import org.junit.runners.Parameterized.Parameters;
 import static org.junit.Assert.assertEquals;
 import static org.junit.Assert.fail;
 
 /**
- * A test for the {@link CookieManager} class.
+ * A test for the {@link CookieManager} class. Runs against both the Java
+ * cookie store and the native one.
  */
+@RunWith(Parameterized.class)
 public class CookieManagerTest {
 
-    private final CookieManager cookieManager = new CookieManager();
+    private final boolean nativeStore;
+    private final CookieManager cookieManager;
+
+
+    @Parameters
+    public static Collection<Object[]> data() {
+        return Arrays.asList(new Object[][] {
+            {false},
+            {true},
+        });
+    }
+
+    public CookieManagerTest(boolean nativeStore) {
+        this.nativeStore = nativeStore;
+        cookieManager = nativeStore
+                ? CookieManager.createNativeBacked(null)
+                : new CookieManager();
+    }
+
+    @BeforeClass
+    public static void beforeClass() throws ClassNotFoundException {
+        // Loads the native library the native cookie store lives in
+        Class.forName(WebPage.class.getName());
+    }
+
+    @Before
+    public void before() {
+        // The native store is shared by all native backed managers
+        if (nativeStore) {
+            NativeCookieStoreShim.clear();
+        }
+    }
+
+    @After
+    public void after() {
+        if (nativeStore) {
+            NativeCookieStoreShim.clear();
+        }
+    }
 
 
     /**
@@ -0,0 +1,212 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package test.com.sun.webkit.network;
+
+import com.sun.webkit.WebPage;
+import com.sun.webkit.network.CookieManager;
+import com.sun.webkit.network.CookieManagerShim;
+import com.sun.webkit.network.NativeCookieStoreShim;
+import java.io.File;
+import java.io.IOException;
+import java.net.URI;
+import java.net.URISyntaxException;
+import java.nio.file.Files;
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.Collections;
+import java.util.HashMap;
+import java.util.List;
+import java.util.Map;
+import org.junit.After;
+import org.junit.Before;
+import org.junit.BeforeClass;
+import org.junit.Test;
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertFalse;
+import static org.junit.Assert.assertTrue;
+
+/**
+ * A test for the native cookie store behind
+ * {@link CookieManager#createNativeBacked}: its backing file and the bulk
+ * exchange of cookies with the Java store.
+ */
+public class NativeCookieStoreTest {
+
+    private final CookieManager cookieManager =
+            CookieManager.createNativeBacked(null);
+    private File backingFile;
+
+
+    @BeforeClass
+    public static void beforeClass() throws ClassNotFoundException {
+        Class.forName(WebPage.class.getName());
+    }
+
+    @Before
+    public void before() throws IOException {
+        NativeCookieStoreShim.clear();
+        backingFile = File.createTempFile("cookies", ".dat");
+        assertTrue(backingFile.delete());
+    }
+
+    @After
+    public void after() {
+        NativeCookieStoreShim.setBackingFile(null);
+        NativeCookieStoreShim.clear();
+        backingFile.delete();
+    }
+
+
+    /**
+     * Tests that the manager is backed by the native store.
+     */
+    @Test
+    public void testUsesNativeStore() {
+        assertTrue(CookieManagerShim.usesNativeStore(cookieManager));
+        assertFalse(CookieManagerShim.usesNativeStore(new CookieManager()));
+    }
+
+    /**
+     * Tests that persistent cookies survive a flush, a restart of the
+     * store, and a reload of the backing file, and that session cookies
+     * do not.
+     */
+    @Test
+    public void testBackingFileRoundTrip() {
+        assertTrue(NativeCookieStoreShim.setBackingFile(backingFile.getPath()));
+        put("http://example.org/",
+                "foo=bar; Max-Age=3600",
+                "baz=qux",
+                "quux=corge; Max-Age=3600; Path=/grault; HttpOnly");
+        NativeCookieStoreShim.flush();
+        assertTrue(backingFile.length() > 0);
+
+        // Restart
+        NativeCookieStoreShim.setBackingFile(null);
+        NativeCookieStoreShim.clear();
+        assertEquals("", get("http://example.org/grault"));
+
+        assertTrue(NativeCookieStoreShim.setBackingFile(backingFile.getPath()));
+        assertEquals(2, CookieManagerShim.getCookieCount(cookieManager));
+        assertEquals("quux=corge; foo=bar", get("http://example.org/grault"));
+
+        // HttpOnly is kept across the round trip
+        put("javascript://example.org/", "quux=garply; Path=/grault");
+        assertEquals("quux=corge; foo=bar", get("http://example.org/grault"));
+    }
+
+    /**
+     * Tests that an expired cookie is not written to the backing file.
+     */
+    @Test
+    public void testBackingFileSkipsExpiredCookies() {
+        assertTrue(NativeCookieStoreShim.setBackingFile(backingFile.getPath()));
+        put("http://example.org/", "foo=bar; Max-Age=3600", "baz=qux; Max-Age=1");
+        sleep(1200);
+        NativeCookieStoreShim.flush();
+
+        NativeCookieStoreShim.setBackingFile(null);
+        NativeCookieStoreShim.clear();
+        assertTrue(NativeCookieStoreShim.setBackingFile(backingFile.getPath()));
+        assertEquals(1, CookieManagerShim.getCookieCount(cookieManager));
+        assertEquals("foo=bar", get("http://example.org/"));
+    }
+
+    /**
+     * Tests that a damaged backing file is reported and leaves the store
+     * as it is.
+     */
+    @Test
+    public void testDamagedBackingFile() throws IOException {
+        put("http://example.org/", "foo=bar");
+        Files.write(backingFile.toPath(), new byte[] {'J', 'F', 'X', 0, 1, 2});
+        assertFalse(NativeCookieStoreShim.setBackingFile(backingFile.getPath()));
+        assertEquals("foo=bar", get("http://example.org/"));
+    }
+
+    /**
+     * Tests exporting cookies from a Java backed manager and importing
+     * them into the native store, and back.
+     */
+    @Test
+    public void testExportImport() {
+        CookieManager javaManager = new CookieManager();
+        put(javaManager, "http://example.org/",
+                "foo=bar",
+                "baz=qux; Domain=example.org",
+                "quux=corge; Path=/grault");
+        CookieManagerShim.copyCookies(javaManager, cookieManager);
+        assertEquals(3, CookieManagerShim.getCookieCount(cookieManager));
+        assertEquals(get(javaManager, "http://example.org/grault"),
+                get("http://example.org/grault"));
+
+        CookieManager otherJavaManager = new CookieManager();
+        CookieManagerShim.copyCookies(cookieManager, otherJavaManager);
+        assertEquals(get(javaManager, "http://example.org/grault"),
+                get(otherJavaManager, "http://example.org/grault"));
+    }
+
+
+    private void put(String uri, String... values) {
+        put(cookieManager, uri, values);
+    }
+
+    private String get(String uri) {
+        return get(cookieManager, uri);
+    }
+
+    private static void put(CookieManager manager, String uri,
+            String... values)
+    {
+        Map<String,List<String>> map = new HashMap<String,List<String>>(1);
+        List<String> list = new ArrayList<String>(Arrays.asList(values));
+        Collections.reverse(list);
+        map.put("Set-Cookie", list);
+        manager.put(uri(uri), map);
+    }
+
+    private static String get(CookieManager manager, String uri) {
+        List<String> list = manager.get(uri(uri),
+                Collections.<String,List<String>>emptyMap()).get("Cookie");
+        return list != null ? list.get(0) : "";
+    }
+
+    private static URI uri(String s) {
+        try {
+            return new URI(s);
+        } catch (URISyntaxException ex) {
+            throw new AssertionError(ex);
+        }
+    }
+
+    private static void sleep(long millis) {
+        try {
+            Thread.sleep(millis);
+        } catch (InterruptedException ex) {
+            throw new AssertionError(ex);
+        }
+    }
+}
@@ -125,6 +125,54 @@ public class CanvasTest extends TestBase {
         });
     }
 
+    @Test public void testCanvasPathHitTesting() {
+        final String htmlCanvasPath =
+                "<canvas id='canvas' width='200' height='200'></canvas> <script>" +
+                        "var context = document.getElementById('canvas').getContext('2d');" +
+                        "context.beginPath();" +
+                        "context.arc(100, 100, 80, 0, 2 * Math.PI, false);" +
+                        "context.arc(100, 100, 40, 0, 2 * Math.PI, true);" +
+                        "context.moveTo(10, 10);" +
+                        "context.quadraticCurveTo(50, 0, 40, 40);" +
+                        "</script>";
+
+        loadContent(htmlCanvasPath);
+        submit(() -> {
+            final String ctx = "document.getElementById('canvas').getContext('2d')";
+            assertTrue("Point in ring",
+                    (Boolean) getEngine().executeScript(ctx + ".isPointInPath(100, 30)"));
+            assertFalse("Point in the hole (nonzero)",
+                    (Boolean) getEngine().executeScript(ctx + ".isPointInPath(100, 100)"));
+            assertFalse("Point in the hole (evenodd)",
+                    (Boolean) getEngine().executeScript(ctx + ".isPointInPath(100, 100, 'evenodd')"));
+            assertFalse("Point outside",
+                    (Boolean) getEngine().executeScript(ctx + ".isPointInPath(195, 195)"));
+            assertTrue("Point inside quadratic curve",
+                    (Boolean) getEngine().executeScript(ctx + ".isPointInPath(35, 15)"));
+        });
+    }
+
+    @Test public void testCanvasEllipse() {
+        final String htmlCanvasEllipse =
+                "<canvas id='canvas' width='200' height='100'></canvas> <script>" +
+                        "var context = document.getElementById('canvas').getContext('2d');" +
+                        "context.beginPath();" +
+                        "context.ellipse(100, 50, 80, 20, 0, 0, 2 * Math.PI);" +
+                        "context.fillStyle = 'red';" +
+                        "context.fill();  </script>";
+
+        loadContent(htmlCanvasEllipse);
+        submit(() -> {
+            final String ctx = "document.getElementById('canvas').getContext('2d')";
+            assertEquals("Ellipse center", 255,
+                    (int) getEngine().executeScript(ctx + ".getImageData(100, 50, 1, 1).data[0]"));
+            assertEquals("Ellipse major axis", 255,
+                    (int) getEngine().executeScript(ctx + ".getImageData(170, 50, 1, 1).data[0]"));
+            assertEquals("Outside of ellipse", 0,
+                    (int) getEngine().executeScript(ctx + ".getImageData(100, 10, 1, 1).data[0]"));
+        });
+    }
+
     private BufferedImage htmlCanvasToBufferedImage(final String mime) throws Exception {
         ByteArrayOutputStream errStream = new ByteArrayOutputStream();
         System.setErr(new PrintStream(errStream));
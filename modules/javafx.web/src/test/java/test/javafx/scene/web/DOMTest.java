@@ -291,6 +291,45 @@ public class DOMTest extends TestBase {
         });
     }
 
+    @Test public void testQuerySelectorAll() {
+        final Document doc = getDocumentFor("src/test/resources/test/html/dom.html");
+        submit(() -> {
+            Element p = doc.getElementById("showcase-paragraph");
+            NodeList spans = ((ElementImpl) p).querySelectorAll("span");
+            assertEquals("SPAN count", 1, spans.getLength());
+            assertSame("SPAN wrapper is shared",
+                    p.getChildNodes().item(2), spans.item(0));
+            assertTrue("SPAN element is an HTML element",
+                    spans.item(0) instanceof HTMLElement);
+            assertNull("Out of range item", spans.item(1));
+        });
+    }
+
+    @Test public void testBulkAccess() {
+        final Document doc = getDocumentFor("src/test/resources/test/html/dom.html");
+        submit(() -> {
+            Element p = doc.getElementById("showcase-paragraph");
+            Node[] nodes = ((NodeImpl) p).getSubtree();
+            assertEquals("Subtree size", 4, nodes.length);
+            assertSame("First descendant", p.getFirstChild(), nodes[0]);
+
+            short[] types = NodeImpl.getNodeTypes(nodes);
+            String[] names = NodeImpl.getNodeNames(nodes);
+            String[] texts = NodeImpl.getTextContents(nodes);
+            String[] classes = ElementImpl.getAttributeValues(nodes, "class");
+            for (int i = 0; i < nodes.length; i++) {
+                assertEquals("Node type", nodes[i].getNodeType(), types[i]);
+                assertEquals("Node name", nodes[i].getNodeName(), names[i]);
+                assertEquals("Text content", nodes[i].getTextContent(), texts[i]);
+                assertEquals("Class attribute",
+                        nodes[i] instanceof Element
+                                ? ((Element) nodes[i]).getAttribute("class")
+                                : null,
+                        classes[i]);
+            }
+        });
+    }
+
     @Ignore("Incorrect test, refer JDK-8210955")
     @Test public void testEventListenerCascade() {
         final Document doc = getDocumentFor("src/test/resources/test/html/dom.html");
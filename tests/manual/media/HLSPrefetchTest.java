@@ -0,0 +1,184 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+import com.sun.net.httpserver.HttpExchange;
+import com.sun.net.httpserver.HttpServer;
+import javafx.application.Application;
+import javafx.application.Platform;
+import javafx.scene.Scene;
+import javafx.scene.control.Label;
+import javafx.scene.layout.VBox;
+import javafx.scene.media.Media;
+import javafx.scene.media.MediaPlayer;
+import javafx.scene.media.MediaView;
+import javafx.stage.Stage;
+
+import java.io.IOException;
+import java.io.OutputStream;
+import java.net.InetAddress;
+import java.net.InetSocketAddress;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.nio.file.Paths;
+import java.util.concurrent.Executors;
+import java.util.concurrent.atomic.AtomicInteger;
+
+/**
+ * Replays a local HLS stream through an HTTP server that delays every
+ * response, and reports how often playback stalls.
+ *
+ * Usage: java HLSPrefetchTest <playlist.m3u8> [<latency in ms>]
+ *
+ * The playlist and its segments are served from the directory of the
+ * playlist, the default latency is 500 ms. Run once with
+ * -Djfxmedia.hls.lookahead=0 and once with the default lookahead: with
+ * prefetching the stall count should drop to zero once playback has started,
+ * and more than one segment request should be in flight at a time.
+ */
+public class HLSPrefetchTest extends Application {
+
+    private static Path playlist;
+    private static int latency = 500;
+
+    private final AtomicInteger requests = new AtomicInteger();
+    private final AtomicInteger inFlight = new AtomicInteger();
+    private final AtomicInteger maxInFlight = new AtomicInteger();
+    private HttpServer server;
+    private MediaPlayer player;
+    private Label stats;
+    private long startTime;
+    private long startupTime = -1;
+    private int stalls = 0;
+    private long stallStart;
+    private long stallTime = 0;
+
+    @Override
+    public void start(Stage stage) throws IOException {
+        server = HttpServer.create(new InetSocketAddress(InetAddress.getLoopbackAddress(), 0), 0);
+        server.createContext("/", this::serve);
+        server.setExecutor(Executors.newCachedThreadPool());
+        server.start();
+
+        String uri = "http://localhost:" + server.getAddress().getPort() + "/" + playlist.getFileName();
+        player = new MediaPlayer(new Media(uri));
+        player.statusProperty().addListener((observable, oldStatus, status) -> {
+            long now = System.currentTimeMillis();
+            if (status == MediaPlayer.Status.PLAYING) {
+                if (startupTime < 0) {
+                    startupTime = now - startTime;
+                }
+                if (oldStatus == MediaPlayer.Status.STALLED) {
+                    stallTime += now - stallStart;
+                }
+            } else if (status == MediaPlayer.Status.STALLED) {
+                stalls++;
+                stallStart = now;
+            }
+            updateStats();
+        });
+        player.setOnEndOfMedia(() -> {
+            updateStats();
+            System.out.println(statsText());
+        });
+        player.setOnError(() -> System.err.println("Error: " + player.getError()));
+
+        MediaView view = new MediaView(player);
+        view.setFitWidth(640);
+        view.setPreserveRatio(true);
+        stats = new Label();
+
+        stage.setTitle("HLS Prefetch Test");
+        stage.setScene(new Scene(new VBox(5, view, stats)));
+        stage.show();
+
+        startTime = System.currentTimeMillis();
+        player.play();
+    }
+
+    @Override
+    public void stop() {
+        if (player != null) {
+            player.dispose();
+        }
+        if (server != null) {
+            server.stop(0);
+        }
+    }
+
+    private void updateStats() {
+        String text = statsText();
+        Platform.runLater(() -> stats.setText(text));
+    }
+
+    private String statsText() {
+        return "Lookahead: " + System.getProperty("jfxmedia.hls.lookahead", "default")
+                + ", latency: " + latency + " ms"
+                + "\nStartup: " + startupTime + " ms"
+                + "\nStalls: " + stalls + ", stalled for " + stallTime + " ms"
+                + "\nRequests: " + requests.get() + ", at most " + maxInFlight.get() + " in flight";
+    }
+
+    private void serve(HttpExchange exchange) throws IOException {
+        requests.incrementAndGet();
+        maxInFlight.accumulateAndGet(inFlight.incrementAndGet(), Math::max);
+        try {
+            Thread.sleep(latency);
+
+            Path file = playlist.resolveSibling(exchange.getRequestURI().getPath().substring(1)).normalize();
+            if (!file.startsWith(playlist.getParent()) || !Files.isRegularFile(file)) {
+                exchange.sendResponseHeaders(404, -1);
+                return;
+            }
+
+            byte[] data = Files.readAllBytes(file);
+            String name = file.getFileName().toString();
+            exchange.getResponseHeaders().set("Content-Type",
+                    name.endsWith(".m3u8") ? "application/vnd.apple.mpegurl"
+                    : name.endsWith(".mp3") ? "audio/mpeg" : "video/MP2T");
+            exchange.sendResponseHeaders(200, data.length);
+            try (OutputStream body = exchange.getResponseBody()) {
+                body.write(data);
+            }
+        } catch (InterruptedException e) {
+            exchange.sendResponseHeaders(503, -1);
+        } finally {
+            inFlight.decrementAndGet();
+            exchange.close();
+        }
+        updateStats();
+    }
+
+    public static void main(String[] args) {
+        if (args.length < 1 || args.length > 2) {
+            System.err.println("Usage: java HLSPrefetchTest <playlist.m3u8> [<latency in ms>]");
+            System.exit(1);
+        }
+        playlist = Paths.get(args[0]).toAbsolutePath().normalize();
+        if (args.length == 2) {
+            latency = Integer.parseInt(args[1]);
+        }
+        Application.launch(args);
+    }
+}
@@ -0,0 +1,183 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package test.com.sun.pisces;
+
+import com.sun.glass.utils.NativeLibLoader;
+import com.sun.pisces.GradientColorMap;
+import com.sun.pisces.JavaSurface;
+import com.sun.pisces.PiscesRenderer;
+import com.sun.pisces.RendererBase;
+import com.sun.pisces.Transform6;
+import java.util.function.Consumer;
+import org.junit.BeforeClass;
+import org.junit.Test;
+
+import static org.junit.Assert.assertEquals;
+
+/**
+ * Checks that rendering in bands on several threads produces the same
+ * pixels as rendering on the calling thread only.
+ */
+public class BandRenderingTest {
+
+    private static final int WIDTH = 1500;
+    private static final int HEIGHT = 1100;
+    private static final int THREADS = 4;
+
+    // 16.16 fixed point
+    private static final int ONE = 1 << 16;
+
+    @BeforeClass
+    public static void setupOnce() {
+        NativeLibLoader.loadLibrary("prism_sw");
+    }
+
+    private static int[] render(int threads, Consumer<PiscesRenderer> op) {
+        final int[] data = new int[WIDTH * HEIGHT];
+        final JavaSurface surface = new JavaSurface(data, RendererBase.TYPE_INT_ARGB_PRE, WIDTH, HEIGHT);
+        final PiscesRenderer pr = new PiscesRenderer(surface);
+        pr.setBandThreads(threads);
+        assertEquals(threads, pr.getBandThreads());
+
+        // translucent background so that SrcOver has something to blend with
+        pr.setColor(40, 90, 160, 200);
+        pr.fillRect(0, 0, WIDTH * ONE, HEIGHT * ONE);
+        op.accept(pr);
+        return data;
+    }
+
+    private static void checkBands(String name, Consumer<PiscesRenderer> op) {
+        final int[] expected = render(1, op);
+        final int[] actual = render(THREADS, op);
+        for (int i = 0; i < expected.length; i++) {
+            if (expected[i] != actual[i]) {
+                assertEquals(name + ": pixel (" + (i % WIDTH) + ", " + (i / WIDTH) + ")",
+                        Integer.toHexString(expected[i]), Integer.toHexString(actual[i]));
+            }
+        }
+    }
+
+    private static void setGradient(PiscesRenderer pr) {
+        final int[] fractions = { 0, ONE / 3, ONE };
+        final int[] argb = { 0xff0000ff, 0x8000ff00, 0xffff0000 };
+        final Transform6 tx = new Transform6(ONE, ONE / 4, -ONE / 5, ONE, 7 * ONE, -3 * ONE);
+        pr.setLinearGradient(100 * ONE, 50 * ONE, 700 * ONE, 400 * ONE,
+                fractions, argb, GradientColorMap.CYCLE_REFLECT, tx);
+    }
+
+    private static void setTexture(PiscesRenderer pr) {
+        final int tw = 37, th = 23;
+        final int[] tex = new int[tw * th];
+        for (int i = 0; i < tex.length; i++) {
+            final int a = 0x80 + (i % 0x80);
+            final int c = (i * 7) % a;
+            tex[i] = (a << 24) | (c << 16) | (((i * 13) % a) << 8) | (a - c);
+        }
+        // rotation by about 30 degrees with a scale and an offset
+        final Transform6 tx = new Transform6(56756, -32768, 32768, 56756, 11 * ONE, 5 * ONE);
+        pr.setTexture(RendererBase.TYPE_INT_ARGB_PRE, tex, tw, th, tw, tx, true, true, true);
+    }
+
+    private static byte[] createMask(int w, int h) {
+        final byte[] mask = new byte[w * h];
+        for (int y = 0; y < h; y++) {
+            for (int x = 0; x < w; x++) {
+                mask[y * w + x] = (byte) ((x * 3 + y * 5) & 0xff);
+            }
+        }
+        return mask;
+    }
+
+    @Test
+    public void testSolidFill() {
+        checkBands("solid", pr -> {
+            pr.setColor(250, 120, 10, 130);
+            pr.fillRect(ONE / 3, ONE / 2, (WIDTH - 3) * ONE, (HEIGHT - 2) * ONE + ONE / 4);
+            pr.setCompositeRule(RendererBase.COMPOSITE_SRC);
+            pr.setColor(10, 220, 30, 255);
+            pr.fillRect(200 * ONE, 100 * ONE, 900 * ONE, 800 * ONE);
+        });
+    }
+
+    @Test
+    public void testLinearGradientFill() {
+        checkBands("linear gradient", pr -> {
+            setGradient(pr);
+            pr.fillRect(5 * ONE + ONE / 3, 3 * ONE, (WIDTH - 10) * ONE, (HEIGHT - 6) * ONE + ONE / 2);
+        });
+    }
+
+    @Test
+    public void testTransformedTextureFill() {
+        checkBands("texture", pr -> {
+            setTexture(pr);
+            pr.fillRect(ONE, 2 * ONE + ONE / 4, (WIDTH - 2) * ONE, (HEIGHT - 3) * ONE);
+        });
+    }
+
+    @Test
+    public void testMaskFill() {
+        final int mw = WIDTH - 40, mh = HEIGHT - 30;
+        final byte[] mask = createMask(mw, mh);
+        checkBands("mask", pr -> {
+            setGradient(pr);
+            pr.fillAlphaMask(mask, 20, 15, mw, mh, 0, mw);
+        });
+    }
+
+    @Test
+    public void testClearRect() {
+        checkBands("clearRect", pr -> {
+            pr.setClip(10, 10, WIDTH - 20, HEIGHT - 20);
+            pr.clearRect(-5, 3, WIDTH - 100, HEIGHT);
+        });
+    }
+
+    @Test
+    public void testAlphaRows() {
+        final int x = 30, y = 20;
+        final int w = WIDTH - 60, h = HEIGHT - 40;
+        final byte[] mask = createMask(w, h);
+        // rows of varying extent, as a rasterized shape would produce
+        final int[] rowBounds = new int[2 * h];
+        for (int i = 0; i < h; i++) {
+            final int inset = (i * 17) % (w / 3);
+            rowBounds[2 * i] = x + inset;
+            rowBounds[2 * i + 1] = x + w - 1 - inset / 2;
+        }
+        // an empty row
+        rowBounds[2 * 100] = x;
+        rowBounds[2 * 100 + 1] = x - 1;
+        checkBands("alpha rows, gradient", pr -> {
+            setGradient(pr);
+            pr.fillAlphaRows(mask, rowBounds, x, y, w, h);
+        });
+        checkBands("alpha rows, texture", pr -> {
+            setTexture(pr);
+            pr.fillAlphaRows(mask, rowBounds, x, y, w, h);
+        });
+    }
+}